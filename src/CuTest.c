@@ -17,14 +17,32 @@
  * @date  24.04.2023
  * @date  01.08.2023  Replaced timestamp type
  * @date  02.08.2023  Added output toggles
+ * @date  17.10.2026  Added global state isolation
+ * @date  17.10.2026  Added peripheral simulation
+ * @date  17.10.2026  Added output capture
+ * @date  17.10.2026  Added in-memory file system
+ * @date  17.10.2026  Added per-test coverage
+ * @date  17.10.2026  Added mutation testing
+ * @date  17.10.2026  Added history-driven scheduling
+ * @date  17.10.2026  Added fail-fast
+ * @date  17.10.2026  Added nestable test suites
+ * @date  17.10.2026  Added concurrent test runs
+ * @date  17.10.2026  Added C++ front end support
+ * @date  17.10.2026  Added resource usage accounting
+ * @date  17.10.2026  Added sampling profiler
+ * @date  17.10.2026  Added differential test cases
+ * @date  17.10.2026  Added instruction counting
+ * @date  17.10.2026  Added test dependencies
  ******************************************************************************/
 
 /*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
 #include <assert.h>
 #include <math.h>
+#include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
-#include "CuTest.h"
+#include "CuTestPrivate.h"
 
 
 /*- Macro definitions --------------------------------------------------------*/
@@ -33,9 +51,6 @@
 #define CUTEST_VERSION                "unknown"
 #endif /* CUTEST_VERSION */
 
-/*! Noreturn attribute for functions using longjmp                            */
-#define _NORETURN                     __attribute__((noreturn))
-
 /*! Summary char for "passed" test cases                                      */
 #define CUTEST_SUMMARY_CHR_PASSED     '.'
 
@@ -45,9 +60,21 @@
 /*! Summary char for invalid test cases                                       */
 #define CUTEST_SUMMARY_CHR_INVALID    '?'
 
+/*! Summary char for test cases not run                                       */
+#define CUTEST_SUMMARY_CHR_SKIPPED    '-'
+
+/*! Summary char for test cases skipped due to a failed dependency            */
+#define CUTEST_SUMMARY_CHR_DEPSKIP    'S'
+
 /*! Maxium timestamp string length                                            */
 #define CUTEST_TIMESTAMP_MAX_LEN      24u
 
+/*! Number of functions listed per test case in the profile report            */
+#define CUTEST_PROFILE_REPORT_TOP     10u
+
+/*! Max. length of a folded stacks file path                                  */
+#define CUTEST_PROFILE_REPORT_PATH    512u
+
 
 /*- Type definitions ---------------------------------------------------------*/
 /*! Statistics counters                                                       */
@@ -56,6 +83,7 @@ typedef struct tag_cutest_stats_t
   unsigned long ulTotal;            ///< Total test cases
   unsigned long ulPassed;           ///< Number of "passed" test cases
   unsigned long ulFailed;           ///< Number of "failed" test cases
+  unsigned long ulSkipped;          ///< Number of test cases not run
 } cutest_stats_t;
 
 
@@ -64,28 +92,26 @@ static void           CuTestAssertPassed(cutest_case_ptr_t psTc);
 static void _NORETURN CuTestAssertFailed(cutest_case_ptr_t psTc);
 
 static void           CuTestPrintSummaryTape_Case(const cutest_case_ptr_t psCase);
-static void           CuTestPrintSummaryTape_Group(const cutest_group_ptr_t psGroup);
-static void           CuTestPrintSummaryTape_Module(const cutest_module_ptr_t psModule);
+static void           CuTestPrintSummaryTape_Node(const cutest_root_ptr_t psRoot, unsigned long ulNode);
 static void           CuTestPrintSummary(const cutest_root_ptr_t psRoot);
+static void           CuTestPrintDetails_Output(const char* pszOutput);
+static void           CuTestPrintDetails_Node(unsigned long* pulNum, const cutest_root_ptr_t psRoot, unsigned long ulNode);
 static void           CuTestPrintDetails(const cutest_root_ptr_t psRoot);
 
 static cutest_stats_t CuTestGetStats_Case(const cutest_case_ptr_t psCase);
-static cutest_stats_t CuTestGetStats_Group(const cutest_group_ptr_t psGroup);
-static cutest_stats_t CuTestGetStats_Module(const cutest_module_ptr_t psModule);
 static cutest_stats_t CuTestGetStats(const cutest_root_ptr_t psRoot);
 
 static void           CuTestGenerateReport_CaseHeader(FILE* f);
 static void           CuTestGenerateReport_CaseLine(FILE* f, unsigned long* pulNum, const cutest_case_ptr_t psCase);
 static void           CuTestGenerateReport_CaseFooter(FILE* f);
-static void           CuTestGenerateReport_Group(FILE* f, unsigned long* pulNum, const cutest_group_ptr_t psGroup);
-static void           CuTestGenerateReport_Module(FILE* f, unsigned long* pulNum, const cutest_module_ptr_t psModule);
+static void           CuTestGenerateReport_Profile(FILE* f, const cutest_root_ptr_t psRoot);
+static void           CuTestGenerateReport_Node(FILE* f, unsigned long* pulNum, const cutest_root_ptr_t psRoot, unsigned long ulNode, unsigned uDepth);
 
-static const char*    CuTestGetTimestampString(const time_t* pTime);
+static void           CuTestGenerateReport_Escaped(FILE* f, const char* pszText);
 
+static const char*    CuTestGetTimestampString(const time_t* pTime, char* pszBuf, size_t uSize);
 
-/*- Private variables --------------------------------------------------------*/
-/*! Buffer for ISO8601-formatted timestamp string                             */
-static char acTimestampBuffer[CUTEST_TIMESTAMP_MAX_LEN + 1u];
+static void           CuTestRunItem_Node(const cutest_root_ptr_t psRoot, unsigned long ulNode);
 
 
 /*- Local functions ----------------------------------------------------------*/
@@ -93,29 +119,35 @@ static char acTimestampBuffer[CUTEST_TIMESTAMP_MAX_LEN + 1u];
  * @brief
  * Assign 'passed' state and continue
  *
+ * A failure caught and discarded within a C++ test case is kept.
+ *
  * @param[in] psTc        Test case data
  * @date  26.04.2023
+ * @date  17.10.2026  Keep earlier failures
  ******************************************************************************/
 static void CuTestAssertPassed(cutest_case_ptr_t psTc)
 {
   assert(psTc != NULL);
 
-  psTc->eResult = EN_CUTEST_RESULT_PASS;
+  if (psTc->eResult != EN_CUTEST_RESULT_FAIL) psTc->eResult = EN_CUTEST_RESULT_PASS;
 }
 
 /*!****************************************************************************
  * @brief
- * Assign 'failed' state and exit by means of longjmp
+ * Assign 'failed' state and exit by means of longjmp, or the failure handler of
+ * the test case
  *
  * @note longjmp to calling handler
  * @param[in] psTc        Test case data
  * @date  26.04.2023
+ * @date  17.10.2026  Added failure handler
  ******************************************************************************/
 static void __attribute__((noreturn)) CuTestAssertFailed(cutest_case_ptr_t psTc)
 {
   assert(psTc != NULL);
 
   psTc->eResult = EN_CUTEST_RESULT_FAIL;
+  if (psTc->pfvFailFn != NULL) psTc->pfvFailFn(psTc);
   longjmp(psTc->sEnv, 0);
 
   __builtin_unreachable();
@@ -127,6 +159,8 @@ static void __attribute__((noreturn)) CuTestAssertFailed(cutest_case_ptr_t psTc)
  *
  * @param[in] psCase      Test case data
  * @date  26.04.2023
+ * @date  17.10.2026  Added "not run" result
+ * @date  17.10.2026  Added "skipped" result
  ******************************************************************************/
 static void CuTestPrintSummaryTape_Case(const cutest_case_ptr_t psCase)
 {
@@ -136,83 +170,69 @@ static void CuTestPrintSummaryTape_Case(const cutest_case_ptr_t psCase)
   {
     case EN_CUTEST_RESULT_PASS: putchar(CUTEST_SUMMARY_CHR_PASSED); break;
     case EN_CUTEST_RESULT_FAIL: putchar(CUTEST_SUMMARY_CHR_FAILED); break;
+    case EN_CUTEST_RESULT_SKIP: putchar(CuTestDependSkipped(psCase) ? CUTEST_SUMMARY_CHR_DEPSKIP : CUTEST_SUMMARY_CHR_SKIPPED); break;
     default:                    putchar(CUTEST_SUMMARY_CHR_INVALID);
   }
 }
 
 /*!****************************************************************************
  * @brief
- * Process summary results tape printout for all test cases in a group
+ * Process summary results tape printout for all test cases below a node
  *
- * @param[in] psGroup     Test case group
- * @date  26.04.2023
+ * @param[in] psRoot      Test run root
+ * @param[in] ulNode      Node index
+ * @date  17.10.2026
  ******************************************************************************/
-static void CuTestPrintSummaryTape_Group(const cutest_group_ptr_t psGroup)
+static void CuTestPrintSummaryTape_Node(const cutest_root_ptr_t psRoot, unsigned long ulNode)
 {
-  assert(psGroup != NULL);
-  assert(psGroup->ppItems != NULL);
+  const cutest_node_t* psNode = &psRoot->psNodes[ulNode];
+  if (psNode->sItem.eType == EN_CUTEST_TYPE_CASE) CuTestPrintSummaryTape_Case(psNode->psResult);
 
-  for (unsigned long i = 0; i < CUTEST_MAX_NUM_CASES; ++i)
-  {
-    const cutest_case_ptr_t psCase = psGroup->ppItems[i];
-
-    if (psCase != NULL) CuTestPrintSummaryTape_Case(psCase);
-    else break;
-  }
+  for (unsigned long i = 0; i < psNode->ulCount; ++i) CuTestPrintSummaryTape_Node(psRoot, psNode->ulFirst + i);
 }
 
 /*!****************************************************************************
  * @brief
- * Process summary results tape printout for all groups in a module
+ * Print test run summary
  *
- * @param[in] psModule    Test module
+ * @param[in] psRoot      Test run root
  * @date  26.04.2023
+ * @date  17.10.2026  Added "not run" result
+ * @date  17.10.2026  Traverse node table
+ * @date  17.10.2026  Added "skipped" result
  ******************************************************************************/
-static void CuTestPrintSummaryTape_Module(const cutest_module_ptr_t psModule)
+static void CuTestPrintSummary(const cutest_root_ptr_t psRoot)
 {
-  assert(psModule != NULL);
-  assert(psModule->ppItems != NULL);
+  assert(psRoot != NULL);
 
-  for (unsigned long i = 0; i < CUTEST_MAX_NUM_GROUPS; ++i)
-  {
-    const cutest_group_ptr_t psGroup = psModule->ppItems[i];
+  // Header
+  printf("Summary (%c=fail, %c=pass, %c=invalid, %c=not run, %c=skipped):\n\t", CUTEST_SUMMARY_CHR_FAILED, CUTEST_SUMMARY_CHR_PASSED, CUTEST_SUMMARY_CHR_INVALID, CUTEST_SUMMARY_CHR_SKIPPED, CUTEST_SUMMARY_CHR_DEPSKIP);
 
-    if (psGroup != NULL) CuTestPrintSummaryTape_Group(psGroup);
-    else break;
-  }
+  // Print result "tape"
+  for (unsigned long i = 0; i < psRoot->ulCount; ++i) CuTestPrintSummaryTape_Node(psRoot, i);
+
+  // Trailer
+  printf("\r\n");
 }
 
 /*!****************************************************************************
  * @brief
- * Print test run summary
+ * Print captured output of a test case, indented below its details line
  *
- * @param[in] psRoot      Test run root
- * @date  26.04.2023
+ * @param[in] *pszOutput  Captured output
+ * @date  17.10.2026
  ******************************************************************************/
-static void CuTestPrintSummary(const cutest_root_ptr_t psRoot)
+static void CuTestPrintDetails_Output(const char* pszOutput)
 {
-  assert(psRoot != NULL);
-  assert(psRoot->ulCount < CUTEST_MAX_NUM_ROOT_ITEM);
+  assert(pszOutput != NULL);
 
-  // Header
-  printf("Summary (%c=fail, %c=pass, %c=invalid):\n\t", CUTEST_SUMMARY_CHR_FAILED, CUTEST_SUMMARY_CHR_PASSED, CUTEST_SUMMARY_CHR_INVALID);
-
-  // Print result "tape"
-  for (unsigned long i = 0; i < psRoot->ulCount; ++i)
+  printf("\t   | ");
+  for (const char* p = pszOutput; *p != '\0'; ++p)
   {
-    const cutest_relem_ptr_t psItem = &psRoot->asItems[i];
-    if (psItem->pItem != NULL) switch (psItem->eType)
-    {
-      case EN_CUTEST_TYPE_CASE:   CuTestPrintSummaryTape_Case(psItem->psCase);      break;
-      case EN_CUTEST_TYPE_GROUP:  CuTestPrintSummaryTape_Group(psItem->psGroup);    break;
-      case EN_CUTEST_TYPE_MODULE: CuTestPrintSummaryTape_Module(psItem->psModule);  break;
-      default:;
-    }
-    else break;
+    putchar(*p);
+    if ((*p == '\n') && (p[1] != '\0')) printf("\t   | ");
   }
-
-  // Trailer
-  printf("\r\n");
+  if ((pszOutput[0] != '\0') && (pszOutput[strlen(pszOutput) - 1u] != '\n')) putchar('\n');
 }
 
 /*!****************************************************************************
@@ -233,11 +253,13 @@ static void CuTestPrintDetails_Case(unsigned long* pulNum, const cutest_case_ptr
     case EN_CUTEST_RESULT_FAIL:
       *pulNum += 1;
       printf("\t%ld) %s -- %s:%ld: %s\n", *pulNum, psCase->pszName, psCase->pszMsgFile, psCase->ulMsgLine, psCase->acMessage);
+      if (psCase->pszOutput != NULL) CuTestPrintDetails_Output(psCase->pszOutput);
       break;
 
     case EN_CUTEST_RESULT_UNDEF:
       *pulNum += 1;
       printf("\t%ld) %s -- %s:%ld: not evaluated\n", *pulNum, psCase->pszName, psCase->pszFile, psCase->ulLine);
+      if (psCase->pszOutput != NULL) CuTestPrintDetails_Output(psCase->pszOutput);
       break;
 
     default:;
@@ -246,42 +268,19 @@ static void CuTestPrintDetails_Case(unsigned long* pulNum, const cutest_case_ptr
 
 /*!****************************************************************************
  * @brief
- * Process printing test run details for all test cases in a group
- *
- * @param[in] *pulNum     Detail counter
- * @param psGroup         Test case group
- * @date  26.04.2023
- ******************************************************************************/
-static void CuTestPrintDetails_Group(unsigned long* pulNum, const cutest_group_ptr_t psGroup)
-{
-  assert(psGroup != NULL);
-  assert(psGroup->ppItems != NULL);
-
-  for (unsigned long i = 0; i < CUTEST_MAX_NUM_CASES; ++i)
-  {
-    const cutest_case_ptr_t psCase = psGroup->ppItems[i];
-    if (psCase != NULL) CuTestPrintDetails_Case(pulNum, psCase);
-  }
-}
-
-/*!****************************************************************************
- * @brief
- * Process printing test run details for all groups in a module
+ * Process printing test run details for all test cases below a node
  *
  * @param[in] *pulNum     Detail counter
- * @param psModule        Test module
- * @date  26.04.2023
+ * @param[in] psRoot      Test run root
+ * @param[in] ulNode      Node index
+ * @date  17.10.2026
  ******************************************************************************/
-static void CuTestPrintDetails_Module(unsigned long* pulNum, const cutest_module_ptr_t psModule)
+static void CuTestPrintDetails_Node(unsigned long* pulNum, const cutest_root_ptr_t psRoot, unsigned long ulNode)
 {
-  assert(psModule != NULL);
-  assert(psModule->ppItems != NULL);
+  const cutest_node_t* psNode = &psRoot->psNodes[ulNode];
+  if (psNode->sItem.eType == EN_CUTEST_TYPE_CASE) CuTestPrintDetails_Case(pulNum, psNode->psResult);
 
-  for (unsigned long i = 0; i < CUTEST_MAX_NUM_GROUPS; ++i)
-  {
-    const cutest_group_ptr_t psGroup = psModule->ppItems[i];
-    if (psGroup != NULL) CuTestPrintDetails_Group(pulNum, psGroup);
-  }
+  for (unsigned long i = 0; i < psNode->ulCount; ++i) CuTestPrintDetails_Node(pulNum, psRoot, psNode->ulFirst + i);
 }
 
 /*!****************************************************************************
@@ -290,39 +289,32 @@ static void CuTestPrintDetails_Module(unsigned long* pulNum, const cutest_module
  *
  * @param[in] psRoot      Test run root
  * @date  26.04.2023
+ * @date  17.10.2026  Added "not run" result
+ * @date  17.10.2026  Traverse node table
  ******************************************************************************/
 static void CuTestPrintDetails(const cutest_root_ptr_t psRoot)
 {
   assert(psRoot != NULL);
-  assert(psRoot->ulCount < CUTEST_MAX_NUM_ROOT_ITEM);
 
   cutest_stats_t sStats = CuTestGetStats(psRoot);
-  if (sStats.ulPassed == sStats.ulTotal)
+  if (sStats.ulPassed + sStats.ulSkipped == sStats.ulTotal)
   {
     printf("\nResult:\n\tPASS");
   }
   else
   {
-    unsigned long ulInvalid = sStats.ulTotal - sStats.ulPassed - sStats.ulFailed;
+    unsigned long ulInvalid = sStats.ulTotal - sStats.ulPassed - sStats.ulFailed - sStats.ulSkipped;
     printf("\nDetails (%ld fails, %ld invalid):\n", sStats.ulFailed, ulInvalid);
 
     unsigned long ulNum = 0;
-    for (unsigned long i = 0; i < psRoot->ulCount; ++i)
-    {
-      const cutest_relem_ptr_t psItem = &psRoot->asItems[i];
-      if (psItem->pItem != NULL) switch (psItem->eType)
-      {
-        case EN_CUTEST_TYPE_CASE:   CuTestPrintDetails_Case(&ulNum, psItem->psCase);      break;
-        case EN_CUTEST_TYPE_GROUP:  CuTestPrintDetails_Group(&ulNum, psItem->psGroup);    break;
-        case EN_CUTEST_TYPE_MODULE: CuTestPrintDetails_Module(&ulNum, psItem->psModule);  break;
-        default:;
-      }
-    }
+    for (unsigned long i = 0; i < psRoot->ulCount; ++i) CuTestPrintDetails_Node(&ulNum, psRoot, i);
 
     printf("\nResult:\n\tFAIL");
   }
 
-  printf(" (%ld runs, %ld passes, %ld fails)\n", sStats.ulTotal, sStats.ulPassed, sStats.ulFailed);
+  printf(" (%ld runs, %ld passes, %ld fails", sStats.ulTotal, sStats.ulPassed, sStats.ulFailed);
+  if (sStats.ulSkipped > 0u) printf(", %ld not run", sStats.ulSkipped);
+  printf(")\n");
 }
 
 /*!****************************************************************************
@@ -332,6 +324,7 @@ static void CuTestPrintDetails(const cutest_root_ptr_t psRoot)
  * @param[in] psCase      Test case data
  * @return  (cutest_stats_t)  Statistics counters
  * @date  26.04.2023
+ * @date  17.10.2026  Added "not run" result
  ******************************************************************************/
 static cutest_stats_t CuTestGetStats_Case(const cutest_case_ptr_t psCase)
 {
@@ -341,67 +334,10 @@ static cutest_stats_t CuTestGetStats_Case(const cutest_case_ptr_t psCase)
     .ulTotal = 1,
     .ulFailed = (psCase->eResult == EN_CUTEST_RESULT_FAIL) ? 1 : 0,
     .ulPassed = (psCase->eResult == EN_CUTEST_RESULT_PASS) ? 1 : 0,
+    .ulSkipped = (psCase->eResult == EN_CUTEST_RESULT_SKIP) ? 1 : 0
   };
 }
 
-/*!****************************************************************************
- * @brief
- * Calculate statistics for a group of test cases
- *
- * @param[in] psGroup     Test group
- * @return  (cutest_stats_t)  Statistics counters
- * @date  26.04.2023
- ******************************************************************************/
-static cutest_stats_t CuTestGetStats_Group(const cutest_group_ptr_t psGroup)
-{
-  assert(psGroup != NULL);
-  assert(psGroup->ppItems != NULL);
-
-  cutest_stats_t sGroup = { 0, 0, 0 };
-  for (unsigned long i = 0; i < CUTEST_MAX_NUM_CASES; ++i)
-  {
-    const cutest_case_ptr_t psCase = psGroup->ppItems[i];
-    if (psCase != NULL)
-    {
-      cutest_stats_t sCase = CuTestGetStats_Case(psCase);
-      sGroup.ulTotal += sCase.ulTotal;
-      sGroup.ulFailed += sCase.ulFailed;
-      sGroup.ulPassed += sCase.ulPassed;
-    }
-  }
-
-  return sGroup;
-}
-
-/*!****************************************************************************
- * @brief
- * Calculate statistics for a test module
- *
- * @param[in] psModule    Test module
- * @return  (cutest_stats_t)  Statistics counters
- * @date  26.04.2023
- ******************************************************************************/
-static cutest_stats_t CuTestGetStats_Module(const cutest_module_ptr_t psModule)
-{
-  assert(psModule != NULL);
-  assert(psModule->ppItems != NULL);
-
-  cutest_stats_t sModule = { 0, 0, 0 };
-  for (unsigned long i = 0; i < CUTEST_MAX_NUM_GROUPS; ++i)
-  {
-    const cutest_group_ptr_t psGroup = psModule->ppItems[i];
-    if (psGroup != NULL)
-    {
-      cutest_stats_t sGroup = CuTestGetStats_Group(psGroup);
-      sModule.ulTotal += sGroup.ulTotal;
-      sModule.ulFailed += sGroup.ulFailed;
-      sModule.ulPassed += sGroup.ulPassed;
-    }
-  }
-
-  return sModule;
-}
-
 /*!****************************************************************************
  * @brief
  * Calculate statistics for a test run
@@ -409,28 +345,24 @@ static cutest_stats_t CuTestGetStats_Module(const cutest_module_ptr_t psModule)
  * @param[in] psRoot      Test run root
  * @return  (cutest_stats_t)  Statistics counters
  * @date  26.04.2023
+ * @date  17.10.2026  Traverse node table
  ******************************************************************************/
 static cutest_stats_t CuTestGetStats(const cutest_root_ptr_t psRoot)
 {
   assert(psRoot != NULL);
-  assert(psRoot->ulCount < CUTEST_MAX_NUM_ROOT_ITEM);
 
-  cutest_stats_t sRun = { 0, 0, 0 };
-  for (unsigned long i = 0; i < psRoot->ulCount; ++i)
+  // Test cases are the leaves of the node table, in any order
+  cutest_stats_t sRun = { 0, 0, 0, 0 };
+  for (unsigned long i = 0; i < psRoot->ulNumNodes; ++i)
   {
-    cutest_stats_t sItem = { 0, 0, 0 };
-    const cutest_relem_ptr_t psItem = &psRoot->asItems[i];
-    if (psItem->pItem != NULL) switch (psItem->eType)
-    {
-      case EN_CUTEST_TYPE_CASE:   sItem = CuTestGetStats_Case(psItem->psCase);      break;
-      case EN_CUTEST_TYPE_GROUP:  sItem = CuTestGetStats_Group(psItem->psGroup);    break;
-      case EN_CUTEST_TYPE_MODULE: sItem = CuTestGetStats_Module(psItem->psModule);  break;
-      default:;
-    }
+    const cutest_node_t* psNode = &psRoot->psNodes[i];
+    if (psNode->sItem.eType != EN_CUTEST_TYPE_CASE) continue;
 
+    cutest_stats_t sItem = CuTestGetStats_Case(psNode->psResult);
     sRun.ulTotal += sItem.ulTotal;
     sRun.ulFailed += sItem.ulFailed;
     sRun.ulPassed += sItem.ulPassed;
+    sRun.ulSkipped += sItem.ulSkipped;
   }
 
   return sRun;
@@ -442,12 +374,17 @@ static cutest_stats_t CuTestGetStats(const cutest_root_ptr_t psRoot)
  *
  * @param[out] *f         Output file
  * @date  26.04.2023
+ * @date  17.10.2026  Added resource usage columns
+ * @date  17.10.2026  Added instruction count column
  ******************************************************************************/
 static void CuTestGenerateReport_CaseHeader(FILE* f)
 {
   assert(f != NULL);
 
-  fprintf(f, "<table border=\"1\"><tr><th>Nr.</th><th>Name</th><th>File</th><th>Result</th><th>Message</th></tr>");
+  fprintf(f, "<table border=\"1\"><tr><th>Nr.</th><th>Name</th><th>File</th><th>Result</th><th>Time [ms]</th>");
+  if (CuTestUsageEnabled()) fprintf(f, "<th>CPU user [ms]</th><th>CPU system [ms]</th><th>Page faults (major)</th><th>Context switches (involuntary)</th><th>Read [bytes]</th><th>Written [bytes]</th>");
+  if (CuTestInsnEnabled()) fprintf(f, "<th>Instructions</th>");
+  fprintf(f, "<th>Message</th></tr>");
 }
 
 /*!****************************************************************************
@@ -458,6 +395,13 @@ static void CuTestGenerateReport_CaseHeader(FILE* f)
  * @param[inout] *pulNum  Test case counter
  * @param[in] psCase      Test case data
  * @date  26.04.2023
+ * @date  17.10.2026  Added captured output
+ * @date  17.10.2026  Added run time
+ * @date  17.10.2026  Escaped names and messages
+ * @date  17.10.2026  Added resource usage columns
+ * @date  17.10.2026  Added diagnostic messages of passed test cases
+ * @date  17.10.2026  Added instruction count column
+ * @date  17.10.2026  Added "skipped" result
  ******************************************************************************/
 static void CuTestGenerateReport_CaseLine(FILE* f, unsigned long* pulNum, const cutest_case_ptr_t psCase)
 {
@@ -474,13 +418,59 @@ static void CuTestGenerateReport_CaseLine(FILE* f, unsigned long* pulNum, const
   {
     case EN_CUTEST_RESULT_PASS: pszColor = "lime";    pszResult = "pass";    bPrintMsg = 0; break;
     case EN_CUTEST_RESULT_FAIL: pszColor = "red";     pszResult = "fail";    bPrintMsg = 1; break;
+    case EN_CUTEST_RESULT_SKIP:
+      bPrintMsg = CuTestDependSkipped(psCase);
+      pszColor = bPrintMsg ? "yellow" : "white";
+      pszResult = bPrintMsg ? "skipped" : "not run";
+      break;
     default:                    pszColor = "silver";  pszResult = "invalid", bPrintMsg = 0;
   }
 
   const char* pszFile = bPrintMsg ? psCase->pszMsgFile : psCase->pszFile;
   unsigned long ulLine = bPrintMsg ? psCase->ulMsgLine : psCase->ulLine;
-  const char* pszMessage = bPrintMsg ? psCase->acMessage : "";
-  fprintf(f, "<tr><td>%ld</td><td>%s</td><td><a href=\"%s#L%ld\">%s#L%ld</a></td><td style=\"background-color: %s\">%s</td><td>%s</td></tr>", *pulNum, psCase->pszName, pszFile, ulLine, pszFile, ulLine, pszColor, pszResult, pszMessage);
+  const char* pszMessage = (bPrintMsg || (psCase->eResult == EN_CUTEST_RESULT_PASS)) ? psCase->acMessage : "";
+  fprintf(f, "<tr><td>%ld</td><td>", *pulNum);
+  CuTestGenerateReport_Escaped(f, psCase->pszName);
+  fprintf(f, "</td><td><a href=\"%s#L%ld\">%s#L%ld</a></td><td style=\"background-color: %s\">%s</td><td>%.3f</td>", pszFile, ulLine, pszFile, ulLine, pszColor, pszResult, (double)psCase->ullDuration / 1e6);
+  if (CuTestUsageEnabled())
+  {
+    const cutest_usage_t* psUse = &psCase->sUsage;
+    fprintf(f, "<td>%.3f</td><td>%.3f</td>", (double)psUse->ullUserTime / 1e6, (double)psUse->ullSysTime / 1e6);
+    fprintf(f, "<td>%llu (%llu)</td><td>%llu (%llu)</td>", (unsigned long long)(psUse->ullMinFlt + psUse->ullMajFlt), (unsigned long long)psUse->ullMajFlt, (unsigned long long)(psUse->ullNvcsw + psUse->ullNivcsw), (unsigned long long)psUse->ullNivcsw);
+    fprintf(f, "<td>%llu</td><td>%llu</td>", (unsigned long long)psUse->ullRead, (unsigned long long)psUse->ullWritten);
+  }
+  if (CuTestInsnEnabled()) fprintf(f, "<td>%llu</td>", (unsigned long long)psCase->sUsage.ullInsns);
+  fprintf(f, "<td>");
+  CuTestGenerateReport_Escaped(f, pszMessage);
+  if (psCase->pszOutput != NULL)
+  {
+    fprintf(f, "<pre>");
+    CuTestGenerateReport_Escaped(f, psCase->pszOutput);
+    fprintf(f, "</pre>");
+  }
+  fprintf(f, "</td></tr>");
+}
+
+/*!****************************************************************************
+ * @brief
+ * Emit text with HTML special characters escaped
+ *
+ * @param[out] *f         Output file
+ * @param[in] *pszText    Text to be emitted
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestGenerateReport_Escaped(FILE* f, const char* pszText)
+{
+  assert(f != NULL);
+  assert(pszText != NULL);
+
+  for (; *pszText != '\0'; ++pszText) switch (*pszText)
+  {
+    case '<': fputs("&lt;", f);   break;
+    case '>': fputs("&gt;", f);   break;
+    case '&': fputs("&amp;", f);  break;
+    default:  fputc(*pszText, f);
+  }
 }
 
 /*!****************************************************************************
@@ -499,52 +489,103 @@ static void CuTestGenerateReport_CaseFooter(FILE* f)
 
 /*!****************************************************************************
  * @brief
- * Emit group heading and process contained test cases
+ * Emit top functions of each profiled test case
  *
  * @param[out] *f         Output file
- * @param[inout] *pulNum  Test case counter
- * @param[in] psGroup     Test case group
- * @date  26.04.2023
+ * @param[in] psRoot      Test run root
+ * @date  17.10.2026
  ******************************************************************************/
-static void CuTestGenerateReport_Group(FILE* f, unsigned long* pulNum, const cutest_group_ptr_t psGroup)
+static void CuTestGenerateReport_Profile(FILE* f, const cutest_root_ptr_t psRoot)
 {
   assert(f != NULL);
-  assert(psGroup != NULL);
-  assert(psGroup->ppItems != NULL);
+  assert(psRoot != NULL);
 
-  fprintf(f, "<h3>%s</h3>", psGroup->pszName);
+  if (CuTestProfileDir() == NULL) return;
 
-  CuTestGenerateReport_CaseHeader(f);
-  for (unsigned long i = 0; i < CUTEST_MAX_NUM_CASES; ++i)
+  fprintf(f, "<hr/><h2>Profile</h2>");
+  for (unsigned long i = 0; i < psRoot->ulNumNodes; ++i)
   {
-    const cutest_case_ptr_t psCase = psGroup->ppItems[i];
-    if (psCase != NULL) CuTestGenerateReport_CaseLine(f, pulNum, psCase);
+    const cutest_case_ptr_t psCase = psRoot->psNodes[i].psResult;
+    if ((psCase == NULL) || ((psCase->eResult != EN_CUTEST_RESULT_PASS) && (psCase->eResult != EN_CUTEST_RESULT_FAIL))) continue;
+
+    char acPath[CUTEST_PROFILE_REPORT_PATH];
+    cutest_profile_func_t asTop[CUTEST_PROFILE_REPORT_TOP];
+    unsigned long ulNumTop = CuTestProfileTop(psCase, acPath, sizeof(acPath), asTop, CUTEST_PROFILE_REPORT_TOP);
+    if (ulNumTop == 0u) continue;
+
+    fprintf(f, "<h3>");
+    CuTestGenerateReport_Escaped(f, psCase->pszName);
+    fprintf(f, "</h3><p><a href=\"");
+    CuTestGenerateReport_Escaped(f, acPath);
+    fprintf(f, "\">Folded stacks</a></p>");
+    fprintf(f, "<table border=\"1\"><tr><th>Function</th><th>Self [samples]</th><th>Total [samples]</th></tr>");
+    for (unsigned long j = 0; j < ulNumTop; ++j)
+    {
+      fprintf(f, "<tr><td>");
+      CuTestGenerateReport_Escaped(f, asTop[j].acName);
+      fprintf(f, "</td><td>%lu</td><td>%lu</td></tr>", asTop[j].ulSelf, asTop[j].ulTotal);
+    }
+    fprintf(f, "</table>");
   }
-  CuTestGenerateReport_CaseFooter(f);
 }
 
 /*!****************************************************************************
  * @brief
- * Emit module heading and process contained groups
+ * Emit suite, module or group heading and process contained items
+ *
+ * Headings are nested by depth, groups always use at least level 3. Test
+ * cases are listed in one table per run of consecutive test cases.
  *
  * @param[out] *f         Output file
- * @param[inout] *pulNum  Test case conuter
- * @param[in] psModule    Test module
- * @date  26.04.2023
+ * @param[inout] *pulNum  Test case counter
+ * @param[in] psRoot      Test run root
+ * @param[in] ulNode      Node index
+ * @param[in] uDepth      Nesting depth, 0 for root items
+ * @date  17.10.2026
+ * @date  17.10.2026  Escape item names
  ******************************************************************************/
-static void CuTestGenerateReport_Module(FILE* f, unsigned long* pulNum, const cutest_module_ptr_t psModule)
+static void CuTestGenerateReport_Node(FILE* f, unsigned long* pulNum, const cutest_root_ptr_t psRoot, unsigned long ulNode, unsigned uDepth)
 {
   assert(f != NULL);
-  assert(psModule != NULL);
-  assert(psModule->ppItems != NULL);
 
-  fprintf(f, "<h2>%s</h2>", psModule->pszName);
+  const cutest_node_t* psNode = &psRoot->psNodes[ulNode];
+  if (psNode->sItem.eType != EN_CUTEST_TYPE_CASE)
+  {
+    unsigned uLevel = 2u + uDepth;
+    if ((psNode->sItem.eType == EN_CUTEST_TYPE_GROUP) && (uLevel < 3u)) uLevel = 3u;
+    if (uLevel > 6u) uLevel = 6u;
+    fprintf(f, "<h%u>", uLevel);
+    CuTestGenerateReport_Escaped(f, CuTestNodeName(psNode));
+    fprintf(f, "</h%u>", uLevel);
+  }
+
+  // A test case on its own gets its own table
+  if (psNode->ulCount == 0u)
+  {
+    if (psNode->sItem.eType != EN_CUTEST_TYPE_CASE) return;
+    CuTestGenerateReport_CaseHeader(f);
+    CuTestGenerateReport_CaseLine(f, pulNum, psNode->psResult);
+    CuTestGenerateReport_CaseFooter(f);
+    return;
+  }
 
-  for (unsigned long i = 0; i < CUTEST_MAX_NUM_GROUPS; ++i)
+  _Bool bTable = 0;
+  for (unsigned long i = 0; i < psNode->ulCount; ++i)
   {
-    const cutest_group_ptr_t psGroup = psModule->ppItems[i];
-    if (psGroup != NULL) CuTestGenerateReport_Group(f, pulNum, psGroup);
+    const cutest_node_t* psChild = &psRoot->psNodes[psNode->ulFirst + i];
+    if (psChild->sItem.eType == EN_CUTEST_TYPE_CASE)
+    {
+      if (!bTable) CuTestGenerateReport_CaseHeader(f);
+      CuTestGenerateReport_CaseLine(f, pulNum, psChild->psResult);
+      bTable = 1;
+      continue;
+    }
+
+    if (bTable) CuTestGenerateReport_CaseFooter(f);
+    bTable = 0;
+    CuTestGenerateReport_Node(f, pulNum, psRoot, psNode->ulFirst + i, uDepth + 1u);
   }
+  if (bTable) CuTestGenerateReport_CaseFooter(f);
 }
 
 /*!****************************************************************************
@@ -552,21 +593,111 @@ static void CuTestGenerateReport_Module(FILE* f, unsigned long* pulNum, const cu
  * Helper function for generating ISO8601-formatted timestamp strings
  *
  * @param[in] *pTime      Input timestamp
+ * @param[out] *pszBuf    Timestamp string buffer
+ * @param[in] uSize       Buffer size, at least CUTEST_TIMESTAMP_MAX_LEN + 1
  * @return  (const char*) Timestamp string buffer
  * @date  01.08.2023
+ * @date  17.10.2026  Reentrant, caller-provided buffer
  ******************************************************************************/
-static const char* CuTestGetTimestampString(const time_t* pTime)
+static const char* CuTestGetTimestampString(const time_t* pTime, char* pszBuf, size_t uSize)
 {
   assert(pTime != NULL);
+  assert(pszBuf != NULL);
 
-  const struct tm* psTm = gmtime(pTime);
+  struct tm sTm;
+  const struct tm* psTm = gmtime_r(pTime, &sTm);
   assert(psTm != NULL);
 
-  size_t ulLen = strftime(acTimestampBuffer, sizeof(acTimestampBuffer), "%FT%T%z", psTm);
-  assert(ulLen < sizeof(acTimestampBuffer));
-  acTimestampBuffer[ulLen] = '\0';
+  size_t ulLen = strftime(pszBuf, uSize, "%FT%T%z", psTm);
+  assert(ulLen < uSize);
+  pszBuf[ulLen] = '\0';
+
+  return pszBuf;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run the test cases below a node, depth-first, until a stop is requested
+ *
+ * @param[in] psRoot      Test hierarchy
+ * @param[in] ulNode      Node index
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestRunItem_Node(const cutest_root_ptr_t psRoot, unsigned long ulNode)
+{
+  const cutest_node_t* psNode = &psRoot->psNodes[ulNode];
+  if (psNode->sItem.eType == EN_CUTEST_TYPE_CASE)
+  {
+    cutest_case_ptr_t psCase = psNode->sItem.psCase;
+    if (CuTestStopRequested()) psCase->eResult = EN_CUTEST_RESULT_SKIP;
+    else CuTest_RunTestCase(psCase);
+  }
+
+  for (unsigned long i = 0; i < psNode->ulCount; ++i) CuTestRunItem_Node(psRoot, psNode->ulFirst + i);
+}
+
+
+/*- Framework internals ------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Assign 'passed' state from framework extension units
+ *
+ * @param[in] psTc        Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestPass(cutest_case_ptr_t psTc)
+{
+  CuTestAssertPassed(psTc);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Assign 'failed' state with a formatted message from framework extension units
+ *
+ * @note longjmp to calling handler
+ * @param[in] psTc        Test case data
+ * @param[in] *pszFile    File name
+ * @param[in] ulLine      Line number
+ * @param[in] *pszFmt     Message format string
+ * @param[in] ...         Format arguments
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestFail(cutest_case_ptr_t psTc, const char* pszFile, unsigned long ulLine, const char* pszFmt, ...)
+{
+  assert(psTc != NULL);
+  assert(pszFile != NULL);
+  assert(pszFmt != NULL);
+
+  va_list args;
+  va_start(args, pszFmt);
+  vsnprintf(psTc->acMessage, sizeof(psTc->acMessage), pszFmt, args);
+  va_end(args);
 
-  return acTimestampBuffer;
+  psTc->pszMsgFile = pszFile;
+  psTc->ulMsgLine = ulLine;
+  CuTestAssertFailed(psTc);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run all test cases below an item immediately, in the test run of the
+ * calling thread if any
+ *
+ * The item is expanded using a temporary node table. Results are stored in
+ * the test case descriptors.
+ *
+ * @param[in] eType       Item type
+ * @param[in] *pItem      Test case, group, module or suite
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestRunItem(cutest_type_t eType, void* pItem)
+{
+  cutest_root_t sRoot;
+  CuTest_InitRoot(&sRoot, "");
+  CuTestAddRootNode(&sRoot, eType, pItem);
+  CuTestExpandNodes(&sRoot);
+  CuTestRunItem_Node(&sRoot, 0u);
+  CuTest_ReleaseRoot(&sRoot);
 }
 
 
@@ -811,24 +942,75 @@ void CuTest_EvalAssertMemEquals (cutest_case_ptr_t psTc, const char* pszFile, un
 
 
 /*- Test run management ------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialize a test run root
+ *
+ * Each root holds its own test hierarchy, options and results, so several
+ * test runs can be set up and run concurrently on different threads.
+ * Release with CuTest_ReleaseRoot.
+ *
+ * @param[out] psRoot     Test run root
+ * @param[in] *pszName    Project name
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_InitRoot(cutest_root_ptr_t psRoot, const char* pszName)
+{
+  assert(psRoot != NULL);
+  assert(pszName != NULL);
+
+  *psRoot = (cutest_root_t){
+    .pszName = pszName,
+    .pszHistoryFile = NULL,
+    .uJobs = 1u,
+    .ulCount = 0u,
+    .psNodes = NULL,
+    .psResults = NULL
+  };
+}
+
+/*!****************************************************************************
+ * @brief
+ * Release the test hierarchy and results of a test run root
+ *
+ * @param[inout] psRoot   Test run root
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_ReleaseRoot(cutest_root_ptr_t psRoot)
+{
+  assert(psRoot != NULL);
+
+  CuTestReleaseResults(psRoot);
+  CuTestArenaRelease(&psRoot->sArena);
+  free(psRoot->psDepends);
+  psRoot->psDepends = NULL;
+  psRoot->ulNumDepends = 0u;
+  free(psRoot->psNodes);
+  psRoot->psNodes = NULL;
+  psRoot->ulNumNodes = 0u;
+  psRoot->ulMaxNodes = 0u;
+  psRoot->ulCount = 0u;
+}
+
 /*!****************************************************************************
  * @brief
  * Append root entry for a new test run item
  *
- * The root item list is used for report generation.
+ * The root item list is used for scheduling and report generation. Items are
+ * run by CuTest_RunTests.
  *
  * @param[inout] psRoot   Test run root
- * @param[in] eType       Item type (Test case, group or module)
+ * @param[in] eType       Item type (Test case, group, module or suite)
  * @param[in] *pItem      Item data structure pointer
  * @date  26.04.2023
+ * @date  17.10.2026  Unlimited number of root items
  ******************************************************************************/
 void CuTest_AppendRootItem(cutest_root_ptr_t psRoot, cutest_type_t eType, void* pItem)
 {
   assert(psRoot != NULL);
   assert(pItem != NULL);
-  assert(psRoot->ulCount < CUTEST_MAX_NUM_ROOT_ITEM);
 
-  psRoot->asItems[psRoot->ulCount++] = (cutest_relem_t){ .eType = eType, .pItem = pItem };
+  CuTestAddRootNode(psRoot, eType, pItem);
 }
 
 /*!****************************************************************************
@@ -838,67 +1020,114 @@ void CuTest_AppendRootItem(cutest_root_ptr_t psRoot, cutest_type_t eType, void*
  * @param[in] psTc        Test case to be run
  * @date  26.04.2023
  * @date  02.08.2023  Added error parser message toggle
+ * @date  17.10.2026  Added global state restore
+ * @date  17.10.2026  Added peripheral reset
+ * @date  17.10.2026  Added output capture
+ * @date  17.10.2026  Added in-memory file system reset
+ * @date  17.10.2026  Added per-test coverage
+ * @date  17.10.2026  Added run time measurement
+ * @date  17.10.2026  Added fail-fast result counting
+ * @date  17.10.2026  Added resource usage accounting
+ * @date  17.10.2026  Added sampling profiler
+ * @date  17.10.2026  Print diagnostic messages of passed test cases
+ * @date  17.10.2026  Added instruction counting
  ******************************************************************************/
 void CuTest_RunTestCase(cutest_case_ptr_t psTc)
 {
   assert(psTc != NULL);
   assert(psTc->pfvTestFn != NULL);
 
+  // Restore global state snapshot, simulated peripherals and files
+  CuTestRestoreState();
+  CuTestResetPeripherals();
+  CuTestResetVfs();
+
   // Reset result buffers
   psTc->eResult = EN_CUTEST_RESULT_UNDEF;
   memset(psTc->acMessage, '\0', sizeof(psTc->acMessage));
+  free(psTc->pszOutput);
+  psTc->pszOutput = NULL;
+  memset(&psTc->sUsage, 0, sizeof(psTc->sUsage));
 
   // Set return point and execute test case
+  CuTestCaptureBegin();
+  CuTestCoverageBegin();
+  cutest_usage_t sUsageStart;
+  CuTestUsageBegin(&sUsageStart);
+  struct timespec sStart, sEnd;
+  clock_gettime(CLOCK_MONOTONIC, &sStart);
+  CuTestProfileBegin(psTc);
+  CuTestInsnBegin();
   if (setjmp(psTc->sEnv) == 0) psTc->pfvTestFn(psTc);
+  CuTestInsnEnd(psTc);
+  CuTestProfileEnd(psTc);
+  clock_gettime(CLOCK_MONOTONIC, &sEnd);
+  CuTestUsageEnd(&sUsageStart, psTc);
+  CuTestCoverageEnd(psTc);
+  CuTestCaptureEnd(psTc);
+  psTc->ullDuration = (uint64_t)(sEnd.tv_sec - sStart.tv_sec) * 1000000000ull + (uint64_t)sEnd.tv_nsec - (uint64_t)sStart.tv_nsec;
 
   // Print results for Eclipse error parser
   if (psTc->bPrintResult) switch (psTc->eResult)
   {
-    case EN_CUTEST_RESULT_PASS: printf("%s:%ld:0: info: %s passed.\n",           psTc->pszFile,    psTc->ulLine,    psTc->pszName);   break;
+    case EN_CUTEST_RESULT_PASS: printf("%s:%ld:0: info: %s passed.\n",           psTc->pszFile,    psTc->ulLine,    psTc->pszName);
+                                if (psTc->acMessage[0] != '\0') printf("%s:%ld:0: info: %s\n", psTc->pszFile, psTc->ulLine, psTc->acMessage);
+                                break;
     case EN_CUTEST_RESULT_FAIL: printf("%s:%ld:0: error: %s failed.\n ",         psTc->pszFile,    psTc->ulLine,    psTc->pszName);
                                 printf("%s:%ld:0: error: %s\n ",                 psTc->pszMsgFile, psTc->ulMsgLine, psTc->acMessage); break;
     default:                    printf("%s:%ld:0: warning: %s not evaluated.\n", psTc->pszFile,    psTc->ulLine,    psTc->pszName);   break;
   }
+  CuTestCountResult(psTc);
 }
 
 /*!****************************************************************************
  * @brief
- * Run all test cases in a group
+ * Run all test cases in a group immediately, until a stop is requested
  *
  * @param[in] psGroup     Test case group
  * @date  26.04.2023
+ * @date  17.10.2026  Added fail-fast stop
+ * @date  17.10.2026  Added case list length
+ * @date  17.10.2026  Traverse node table
  ******************************************************************************/
 void CuTest_RunTestGroup(cutest_group_ptr_t psGroup)
 {
   assert(psGroup != NULL);
   assert(psGroup->ppItems != NULL);
 
-  // Iterate through available test cases
-  for (unsigned long i = 0; i < CUTEST_MAX_NUM_CASES; ++i)
-  {
-    cutest_case_ptr_t psCase = psGroup->ppItems[i];
-    if (psCase != NULL) CuTest_RunTestCase(psCase);
-  }
+  CuTestRunItem(EN_CUTEST_TYPE_GROUP, psGroup);
 }
 
 /*!****************************************************************************
  * @brief
- * Run all groups in a module
+ * Run all groups in a module immediately, until a stop is requested
  *
  * @param[in] psModule    Test module
  * @date  26.04.2023
+ * @date  17.10.2026  Traverse node table
  ******************************************************************************/
 void CuTest_RunTestModule(cutest_module_ptr_t psModule)
 {
   assert(psModule != NULL);
   assert(psModule->ppItems != NULL);
 
-  // Iterate through available groups
-  for (unsigned long i = 0; i < CUTEST_MAX_NUM_GROUPS; ++i)
-  {
-    cutest_group_ptr_t psGroup = psModule->ppItems[i];
-    if (psGroup != NULL) CuTest_RunTestGroup(psGroup);
-  }
+  CuTestRunItem(EN_CUTEST_TYPE_MODULE, psModule);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run all items in a suite immediately, including nested suites, until a
+ * stop is requested
+ *
+ * @param[in] psSuite     Test suite
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_RunTestSuite(cutest_suite_ptr_t psSuite)
+{
+  assert(psSuite != NULL);
+  assert(psSuite->psItems != NULL);
+
+  CuTestRunItem(EN_CUTEST_TYPE_SUITE, psSuite);
 }
 
 /*!****************************************************************************
@@ -909,20 +1138,26 @@ void CuTest_RunTestModule(cutest_module_ptr_t psModule)
  * @param[in] *pTime      Build timestamp
  * @date  26.04.2023
  * @date  01.08.2023  Replaced timestamp type
+ * @date  17.10.2026  Added nestable test suites
+ * @date  17.10.2026  Added resource usage lists
  ******************************************************************************/
 void CuTest_PrintRunResults(const cutest_root_ptr_t psRoot, const time_t* pTime)
 {
   assert(psRoot != NULL);
   assert(pTime != NULL);
 
+  CuTestExpandNodes(psRoot);
+
   printf("\n");
   printf("=================== Unit Test Report ===================\n");
   printf("Framework version:  " CUTEST_VERSION "\n");
   printf("Project:            %s\n\n", psRoot->pszName);
   CuTestPrintSummary(psRoot);
   CuTestPrintDetails(psRoot);
+  CuTestPrintUsage(psRoot);
   printf("\n");
-  printf("Done.\t %s\n", CuTestGetTimestampString(pTime));
+  char acTimestamp[CUTEST_TIMESTAMP_MAX_LEN + 1u];
+  printf("Done.\t %s\n", CuTestGetTimestampString(pTime, acTimestamp, sizeof(acTimestamp)));
   printf("========================================================\n");
 }
 
@@ -935,19 +1170,26 @@ void CuTest_PrintRunResults(const cutest_root_ptr_t psRoot, const time_t* pTime)
  * @param[in] *pszFile    Output filename
  * @date  26.04.2023
  * @date  01.08.2023  Replaced timestamp type
+ * @date  17.10.2026  Added per-test coverage link
+ * @date  17.10.2026  Added nestable test suites
+ * @date  17.10.2026  Added profile section
+ * @date  17.10.2026  Added "not run" count
+ * @date  17.10.2026  Escape test run name
  ******************************************************************************/
 void CuTest_GenerateRunReport(const cutest_root_ptr_t psRoot, const time_t* pTime, const char* pszFile)
 {
   assert(psRoot != NULL);
   assert(psRoot->pszName != NULL);
-  assert(psRoot->ulCount < CUTEST_MAX_NUM_ROOT_ITEM);
   assert(pTime != NULL);
   assert(pszFile != NULL);
 
+  CuTestExpandNodes(psRoot);
+
   // Open output file
   FILE* f = fopen(pszFile, "w");
   if (f == NULL) return;
 
+  char acTimestamp[CUTEST_TIMESTAMP_MAX_LEN + 1u];
   // Header
   fprintf(f,
     "<!DOCTYPE html>\n"
@@ -956,41 +1198,35 @@ void CuTest_GenerateRunReport(const cutest_root_ptr_t psRoot, const time_t* pTim
     "        <title>Unit Test Report</title>\n"
     "    </head>\n"
     "    <body>\n"
-    "        <h1>Unit Test Report &ndash; %s</h1><hr/>"
+    "        <h1>Unit Test Report &ndash; "
+  );
+  CuTestGenerateReport_Escaped(f, psRoot->pszName);
+  fprintf(f,
+    "</h1><hr/>"
     "        <p><b>Framework Version:</b> CuTest " CUTEST_VERSION "<br/>"
     "           <b>Test run completed at:</b> %s</p>\n",
-    psRoot->pszName, CuTestGetTimestampString(pTime)
+    CuTestGetTimestampString(pTime, acTimestamp, sizeof(acTimestamp))
   );
 
-  // Test results
-  unsigned long ulNum = 0;
-  for (unsigned long i = 0; i < psRoot->ulCount; ++i)
+  // Per-test coverage, generated by cutest-coverage
+  if (CuTestCoverageDir() != NULL)
   {
-    const cutest_relem_ptr_t psItem = &psRoot->asItems[i];
-    if (psItem != NULL) switch (psItem->eType)
-    {
-      case EN_CUTEST_TYPE_CASE:
-        CuTestGenerateReport_CaseHeader(f);
-        CuTestGenerateReport_CaseLine(f, &ulNum, psItem->psCase);
-        CuTestGenerateReport_CaseFooter(f);
-        break;
-
-      case EN_CUTEST_TYPE_GROUP:
-        CuTestGenerateReport_Group(f, &ulNum, psItem->psGroup);
-        break;
-
-      case EN_CUTEST_TYPE_MODULE:
-        CuTestGenerateReport_Module(f, &ulNum, psItem->psModule);
-        break;
-    }
+    fprintf(f, "        <p><a href=\"%s/coverage.html\">Per-test coverage</a></p>\n", CuTestCoverageDir());
   }
 
+  // Test results
+  unsigned long ulNum = 0;
+  for (unsigned long i = 0; i < psRoot->ulCount; ++i) CuTestGenerateReport_Node(f, &ulNum, psRoot, i, 0u);
+  CuTestGenerateReport_Profile(f, psRoot);
+
   // Statistics
   cutest_stats_t sStats = CuTestGetStats(psRoot);
+  fprintf(f, "        <hr/><p>%ld runs, %ld passes, %ld fails", sStats.ulTotal, sStats.ulPassed, sStats.ulFailed);
+  if (sStats.ulSkipped > 0u) fprintf(f, ", %ld not run", sStats.ulSkipped);
   fprintf(f,
-    "        <hr/><p>%ld runs, %ld passes, %ld fails\n</p>"
+    "\n</p>"
     "    </body>\n"
-    "</html>", sStats.ulTotal, sStats.ulPassed, sStats.ulFailed
+    "</html>"
   );
   fclose(f);
 }
@@ -1000,11 +1236,15 @@ void CuTest_GenerateRunReport(const cutest_root_ptr_t psRoot, const time_t* pTim
  * Evaluate overall run result
  *
  * @param[in] psRoot      Test run root
- * @return  (cutest_result_t) PASS, if all test cases are marked as "passed".
+ * @return  (cutest_result_t) PASS, if all test cases run are marked as
+ *                            "passed".
  * @date  26.04.2023
+ * @date  17.10.2026  Ignore test cases not run
+ * @date  17.10.2026  Added nestable test suites
  ******************************************************************************/
 cutest_result_t CuTest_GetRunResult(const cutest_root_ptr_t psRoot)
 {
+  CuTestExpandNodes(psRoot);
   cutest_stats_t sRun = CuTestGetStats(psRoot);
-  return (sRun.ulPassed == sRun.ulTotal) ? EN_CUTEST_RESULT_PASS : EN_CUTEST_RESULT_FAIL;
+  return (sRun.ulPassed + sRun.ulSkipped == sRun.ulTotal) ? EN_CUTEST_RESULT_PASS : EN_CUTEST_RESULT_FAIL;
 }
@@ -17,6 +17,29 @@
  * @date  24.04.2023
  * @date  01.08.2023  Replaced timestamp type
  * @date  02.08.2023  Added output toggles
+ * @date  17.10.2026  Added global state isolation
+ * @date  17.10.2026  Added peripheral simulation
+ * @date  17.10.2026  Added golden file assertion
+ * @date  17.10.2026  Added hash assertions
+ * @date  17.10.2026  Added output capture
+ * @date  17.10.2026  Added in-memory file system
+ * @date  17.10.2026  Added per-test coverage
+ * @date  17.10.2026  Added mutation testing
+ * @date  17.10.2026  Added history-driven scheduling
+ * @date  17.10.2026  Added distributed execution
+ * @date  17.10.2026  Added fail-fast
+ * @date  17.10.2026  Added nestable test suites
+ * @date  17.10.2026  Added concurrent test runs
+ * @date  17.10.2026  Added C++ front end support
+ * @date  17.10.2026  Added compile-time test cases
+ * @date  17.10.2026  Added resource usage accounting
+ * @date  17.10.2026  Added sampling profiler
+ * @date  17.10.2026  Added differential test cases
+ * @date  17.10.2026  Added instruction counting
+ * @date  17.10.2026  Added runtime test registration
+ * @date  17.10.2026  Added test vector files
+ * @date  17.10.2026  Added progress journal
+ * @date  17.10.2026  Added test dependencies
  ******************************************************************************/
 
 #ifndef _CUTEST_H_
@@ -28,6 +51,13 @@
 #include <setjmp.h>
 #include <time.h>
 
+#ifdef __cplusplus
+#ifndef _Bool
+#define _Bool bool
+#endif /* _Bool */
+extern "C" {
+#endif /* __cplusplus */
+
 
 /*- Common definitions -------------------------------------------------------*/
 /*! Max. message length                                                       */
@@ -39,8 +69,42 @@
 /*! Max. number of groups per module                                          */
 #define CUTEST_MAX_NUM_GROUPS         128u
 
-/*! Max. number of root items                                                 */
-#define CUTEST_MAX_NUM_ROOT_ITEM      32u
+/*! Max. number of items per suite                                            */
+#define CUTEST_MAX_NUM_SUITE_ITEMS    128u
+
+/*! Max. number of state isolation regions                                    */
+#define CUTEST_MAX_NUM_STATE_REGIONS  32u
+
+/*! Max. number of simulated peripheral register banks                        */
+#define CUTEST_MAX_NUM_PERIPHERALS    16u
+
+/*! Max. number of simulated register hooks per test case                     */
+#define CUTEST_MAX_NUM_REG_HOOKS      64u
+
+/*! Max. number of traced register accesses per test case                     */
+#define CUTEST_MAX_NUM_REG_TRACE      1024u
+
+/*! Max. number of in-memory files                                            */
+#define CUTEST_MAX_NUM_VFS_FILES      64u
+
+/*! Max. in-memory file path length                                           */
+#define CUTEST_MAX_LEN_VFS_PATH       128u
+
+/*! Max. number of mutated source files                                       */
+#define CUTEST_MAX_NUM_MUTANT_TABLES  64u
+
+/*! Framework data section, excluded from state isolation                     */
+#define CUTEST_PERSISTENT             __attribute__((section("cutest_persist")))
+
+/*! Linkage of test item definitions and declarations, shared between C and
+ *  C++ sources                                                               */
+#ifdef __cplusplus
+#define CUTEST_LINKAGE                extern "C"
+#define CUTEST_EXTERN                 extern "C"
+#else
+#define CUTEST_LINKAGE
+#define CUTEST_EXTERN                 extern
+#endif /* __cplusplus */
 
 /*! Project name (override-able)                                              */
 #ifndef CUTEST_PROJECT_NAME
@@ -67,33 +131,134 @@
 #define CUTEST_PRINT_TESTCASE_RESULT  1u
 #endif /* CUTEST_PRINT_TESTCASE_RESULT */
 
+/*! Restore global state before each test case (override-able)                */
+#ifndef CUTEST_STATE_ISOLATION
+#define CUTEST_STATE_ISOLATION        0u
+#endif /* CUTEST_STATE_ISOLATION */
+
+/*! Capture test case output, attach to failed cases (override-able)          */
+#ifndef CUTEST_CAPTURE_OUTPUT
+#define CUTEST_CAPTURE_OUTPUT         0u
+#endif /* CUTEST_CAPTURE_OUTPUT */
+
+/*! Max. captured output length per failed test case (override-able)          */
+#ifndef CUTEST_CAPTURE_MAX_LEN
+#define CUTEST_CAPTURE_MAX_LEN        4096u
+#endif /* CUTEST_CAPTURE_MAX_LEN */
+
+/*! Record resource usage per test case (override-able)                       */
+#ifndef CUTEST_RESOURCE_USAGE
+#define CUTEST_RESOURCE_USAGE         0u
+#endif /* CUTEST_RESOURCE_USAGE */
+
+/*! Number of test cases listed per resource in the summary (override-able)   */
+#ifndef CUTEST_RESOURCE_USAGE_TOP
+#define CUTEST_RESOURCE_USAGE_TOP     5u
+#endif /* CUTEST_RESOURCE_USAGE_TOP */
+
+/*! Sampling profiler output directory, NULL if disabled (override-able)      */
+#ifndef CUTEST_PROFILE_DIR
+#define CUTEST_PROFILE_DIR            NULL
+#endif /* CUTEST_PROFILE_DIR */
+
+/*! Profiler sampling frequency [Hz] (override-able)                          */
+#ifndef CUTEST_PROFILE_FREQ
+#define CUTEST_PROFILE_FREQ           1000u
+#endif /* CUTEST_PROFILE_FREQ */
+
+/*! In-memory file system path prefix, NULL if disabled (override-able)       */
+#ifndef CUTEST_VFS_PREFIX
+#define CUTEST_VFS_PREFIX             NULL
+#endif /* CUTEST_VFS_PREFIX */
+
+/*! Per-test coverage data directory, requires --coverage (override-able)     */
+#ifdef CUTEST_COVERAGE_DIR
+void __gcov_reset(void);
+void __gcov_dump(void);
+#define CUTEST_COVERAGE_SETUP()       CuTest_EnableCoverage(CUTEST_COVERAGE_DIR, __gcov_reset, __gcov_dump)
+#else
+#define CUTEST_COVERAGE_SETUP()       ((void)0)
+#endif /* CUTEST_COVERAGE_DIR */
+
+/*! Test case duration history file, NULL if disabled (override-able)         */
+#ifndef CUTEST_HISTORY_FILE
+#define CUTEST_HISTORY_FILE           NULL
+#endif /* CUTEST_HISTORY_FILE */
+
+/*! Progress journal file, NULL if disabled (override-able, see --resume)     */
+#ifndef CUTEST_JOURNAL_FILE
+#define CUTEST_JOURNAL_FILE           NULL
+#endif /* CUTEST_JOURNAL_FILE */
+
+/*! Run mutants after the test run, requires cutest-mutate (override-able)    */
+#ifndef CUTEST_MUTATION_TESTING
+#define CUTEST_MUTATION_TESTING       0u
+#endif /* CUTEST_MUTATION_TESTING */
+
+/*! Number of parallel mutant workers, 0 for one per CPU (override-able)      */
+#ifndef CUTEST_MUTATION_JOBS
+#define CUTEST_MUTATION_JOBS          0u
+#endif /* CUTEST_MUTATION_JOBS */
+
+/*! Time limit per mutant in seconds, 0 for none (override-able)              */
+#ifndef CUTEST_MUTATION_TIMEOUT
+#define CUTEST_MUTATION_TIMEOUT       10u
+#endif /* CUTEST_MUTATION_TIMEOUT */
+
 
 /*- Type definitions ---------------------------------------------------------*/
 /*! Forward declarations                                                      */
 struct tag_cutest_case_t;
 struct tag_cutest_group_t;
 struct tag_cutest_module_t;
+struct tag_cutest_suite_t;
 struct tag_cutest_relem_t;
+struct tag_cutest_node_t;
 struct tag_cutest_root_t;
+struct tag_cutest_hash_t;
+struct tag_cutest_mutant_table_t;
+struct tag_cutest_journal_t;
 
 /*! Pointer declarations                                                      */
 typedef struct tag_cutest_case_t* cutest_case_ptr_t;
 typedef struct tag_cutest_group_t* cutest_group_ptr_t;
 typedef struct tag_cutest_module_t* cutest_module_ptr_t;
+typedef struct tag_cutest_suite_t* cutest_suite_ptr_t;
 typedef struct tag_cutest_relem_t* cutest_relem_ptr_t;
+typedef struct tag_cutest_node_t* cutest_node_ptr_t;
 typedef struct tag_cutest_root_t* cutest_root_ptr_t;
+typedef struct tag_cutest_hash_t* cutest_hash_ptr_t;
+typedef struct tag_cutest_mutant_table_t* cutest_mutant_table_ptr_t;
 
 /*! Test function                                                             */
 typedef void (*cutest_test_fn_t)(cutest_case_ptr_t _tc);
 
+/*! Failure handler, must not return (see CuTest.hpp)                         */
+typedef void (*cutest_fail_fn_t)(cutest_case_ptr_t _tc);
+
 /*! Test result                                                               */
 typedef enum
 {
   EN_CUTEST_RESULT_UNDEF,           ///< Result undefined
   EN_CUTEST_RESULT_PASS,            ///< Result "passed"
-  EN_CUTEST_RESULT_FAIL             ///< Result "failed"
+  EN_CUTEST_RESULT_FAIL,            ///< Result "failed"
+  EN_CUTEST_RESULT_SKIP             ///< Result "not run"
 } cutest_result_t;
 
+/*! Resource usage of a test case run                                         */
+typedef struct tag_cutest_usage_t
+{
+  uint64_t ullUserTime;             ///< User CPU time [ns]
+  uint64_t ullSysTime;              ///< System CPU time [ns]
+  uint64_t ullMinFlt;               ///< Minor page faults
+  uint64_t ullMajFlt;               ///< Major page faults
+  uint64_t ullNvcsw;                ///< Voluntary context switches
+  uint64_t ullNivcsw;               ///< Involuntary context switches
+  uint64_t ullRead;                 ///< Bytes read
+  uint64_t ullWritten;              ///< Bytes written
+  uint64_t ullInsns;                ///< Instructions executed (cutest-qemu)
+} cutest_usage_t;
+
 /*! Test case data container                                                  */
 typedef struct tag_cutest_case_t
 {
@@ -105,12 +270,18 @@ typedef struct tag_cutest_case_t
   // Processing
   cutest_test_fn_t pfvTestFn;       ///< Test function
   jmp_buf sEnv;                     ///< Setjmp context buffer
+  cutest_fail_fn_t pfvFailFn;       ///< Failure handler, NULL: longjmp
+  void* pUser;                      ///< User data, see NEW_TEST_CASE()
 
   // Results
   cutest_result_t eResult;          ///< Result code
   char acMessage[CUTEST_MAX_LEN_MESSAGE]; ///< Error or diagnostic message
   const char* pszMsgFile;           ///< Message file name
   unsigned long ulMsgLine;          ///< Message line
+  char* pszOutput;                  ///< Captured output (failed cases only)
+  char* pszPath;                    ///< Path in the test hierarchy, run data only
+  uint64_t ullDuration;             ///< Run time [ns]
+  cutest_usage_t sUsage;            ///< Resource usage
 
   // Output config
   _Bool bPrintResult;               ///< Print run result to stdout
@@ -126,6 +297,7 @@ typedef struct tag_cutest_group_t
 
   // Test case list
   cutest_case_ptr_t* const ppItems; ///< Assigned test cases
+  unsigned long ulNumItems;         ///< Length of the test case list
 } cutest_group_t;
 
 /*! Test module (set of groups)                                               */
@@ -145,7 +317,8 @@ typedef enum
 {
   EN_CUTEST_TYPE_CASE,
   EN_CUTEST_TYPE_GROUP,
-  EN_CUTEST_TYPE_MODULE
+  EN_CUTEST_TYPE_MODULE,
+  EN_CUTEST_TYPE_SUITE
 } cutest_type_t;
 
 /*! Test run root element                                                     */
@@ -153,6 +326,7 @@ typedef struct tag_cutest_relem_t
 {
   cutest_type_t eType;              ///< Element type
   union {
+    cutest_suite_ptr_t psSuite;   ///< Suite type pointer
     cutest_module_ptr_t psModule; ///< Module type pointer
     cutest_group_ptr_t psGroup;   ///< Group type pointer
     cutest_case_ptr_t psCase;     ///< Case type pointer
@@ -160,18 +334,180 @@ typedef struct tag_cutest_relem_t
   };
 } cutest_relem_t;
 
+/*! Test suite (set of suites, modules, groups and test cases)                */
+typedef struct tag_cutest_suite_t
+{
+  // Suite description
+  const char* pszName;              ///< Suite name
+  const char* pszFile;              ///< Source file name
+  unsigned long ulLine;             ///< Line number
+
+  // Item list
+  cutest_relem_t* const psItems;    ///< Assigned items
+} cutest_suite_t;
+
+/*! Test hierarchy node. The children of a node are stored contiguously in the
+ *  node table of the test run root.                                          */
+typedef struct tag_cutest_node_t
+{
+  cutest_relem_t sItem;             ///< Suite, module, group or test case
+  cutest_case_ptr_t psResult;       ///< Test case data of this run, or NULL
+  unsigned long ulParent;           ///< Parent node, ULONG_MAX for root items
+  unsigned long ulFirst;            ///< First child node
+  unsigned long ulCount;            ///< Number of child nodes
+} cutest_node_t;
+
+/*! Declared dependency between test items                                    */
+typedef struct tag_cutest_depend_t
+{
+  cutest_relem_t sItem;             ///< Dependent item
+  cutest_relem_t sDep;              ///< Item depended on
+} cutest_depend_t;
+
+/*! Memory arena, for test items created at run time                          */
+typedef struct tag_cutest_arena_t
+{
+  void* pBlock;                     ///< Current block, linked to previous ones
+  size_t uUsed;                     ///< Bytes used in the current block
+  size_t uSize;                     ///< Size of the current block
+} cutest_arena_t;
+
 /*! Test run root                                                             */
 typedef struct tag_cutest_root_t
 {
   const char* pszName;              ///< Project name
 
-  // Report items
-  unsigned long ulCount;            ///< Current number of items
-  cutest_relem_t asItems[CUTEST_MAX_NUM_ROOT_ITEM];  ///< List of elements
+  // Run options
+  const char* pszHistoryFile;       ///< Duration history file, NULL if unused
+  unsigned uJobs;                   ///< Number of parallel jobs
+  unsigned long ulTimeBudget;       ///< Time budget [ms], 0 for unlimited
+  const char* pszCoordinator;       ///< Coordinator listening address
+  const char* pszWorker;            ///< Worker: coordinator address
+  unsigned long ulFailFast;         ///< Stop after N failed test cases, 0: off
+  const char* pszJournalFile;       ///< Progress journal file, NULL if unused
+  _Bool bResume;                    ///< Resume from the progress journal
+
+  // Test hierarchy
+  unsigned long ulCount;            ///< Number of root items (nodes 0..n-1)
+  cutest_node_ptr_t psNodes;        ///< Node table, grown on demand
+  unsigned long ulNumNodes;         ///< Number of nodes, including children
+  unsigned long ulMaxNodes;         ///< Allocated number of nodes
+  cutest_case_ptr_t psResults;      ///< Test case data, one per test case node
+  cutest_arena_t sArena;            ///< Test items created at run time
+  cutest_depend_t* psDepends;       ///< Declared dependencies
+  unsigned long ulNumDepends;       ///< Number of declared dependencies
+
+  // Run state
+  unsigned long ulFailures;         ///< Failed test cases so far
+  unsigned long ulNumDone;          ///< Root items already run on the spot
+  _Bool bStop;                      ///< Stop requested by fail-fast
+  struct tag_cutest_journal_t* psJournal; ///< Open progress journal, or NULL
 } cutest_root_t;
 
+/*! Simulated register hook, returns the value read or latched                */
+typedef uint32_t (*cutest_reg_hook_fn_t)(uintptr_t uAddr, uint32_t ulValue, void* pUser);
+
+/*! Simulated register access trace entry                                     */
+typedef struct tag_cutest_reg_access_t
+{
+  uint32_t ulAddr;                  ///< Register address
+  uint32_t ulValue;                 ///< Register value read or written
+  uint8_t ucWidth;                  ///< Access width in bytes (1, 2, 4 or 8)
+  _Bool bWrite;                     ///< Write access
+} cutest_reg_access_t;
+
+/*! Hash algorithm                                                            */
+typedef enum
+{
+  EN_CUTEST_HASH_CRC32C,            ///< CRC32C (Castagnoli)
+  EN_CUTEST_HASH_XXH64              ///< XXH64, seed 0
+} cutest_hash_type_t;
+
+/*! Incremental hash calculation context                                      */
+typedef struct tag_cutest_hash_t
+{
+  cutest_hash_type_t eType;         ///< Hash algorithm
+  uint64_t ullTotal;                ///< Total number of bytes
+  uint32_t ulCrc;                   ///< CRC32C running value
+  uint64_t aullAcc[4];              ///< XXH64 accumulators
+  uint8_t aucBuf[32];               ///< XXH64 partial stripe
+  size_t uBufLen;                   ///< XXH64 partial stripe length
+} cutest_hash_t;
+
+/*! Mutant location and description                                           */
+typedef struct tag_cutest_mutant_site_t
+{
+  unsigned long ulLine;             ///< Source line
+  const char* pszDesc;              ///< Applied mutation
+} cutest_mutant_site_t;
+
+/*! Mutants of a source file, generated by cutest-mutate                      */
+typedef struct tag_cutest_mutant_table_t
+{
+  const char* pszFile;              ///< Original source file
+  const cutest_mutant_site_t* psSites; ///< Mutant list
+  unsigned long ulCount;            ///< Number of mutants
+  unsigned long ulBase;             ///< Global ID offset, set on registration
+} cutest_mutant_table_t;
+
+/*! Differential test implementation, computes the output of one input        */
+typedef void (*cutest_diff_fn_t)(const void* pIn, void* pOut);
+
+/*! Differential test input generator, see CuTest_Random                      */
+typedef void (*cutest_diff_gen_t)(unsigned long ulIndex, uint64_t* pullRng, void* pIn);
+
+/*! Differential test output comparison                                       */
+typedef _Bool (*cutest_diff_eq_t)(const void* pRef, const void* pOpt);
 
-/*- Test case, group and module macros ---------------------------------------*/
+/*! Differential test configuration                                           */
+typedef struct tag_cutest_diff_t
+{
+  size_t uInSize;                   ///< Input size [bytes]
+  size_t uOutSize;                  ///< Output size [bytes]
+  unsigned long ulInputs;           ///< Number of inputs, 0 for default
+  unsigned long ulEdgeCases;        ///< Leading inputs used as edge cases
+  cutest_diff_eq_t pfbEqual;        ///< Output comparison, NULL: bytewise
+  double dMinSpeedup;               ///< Min. speedup, 0 if not checked
+  uint64_t ullSeed;                 ///< Random seed, 0 for default
+} cutest_diff_t;
+
+/*! Test vector file format                                                   */
+typedef enum
+{
+  EN_CUTEST_VEC_KV,                 ///< CAVP-style "key = value" records
+  EN_CUTEST_VEC_CSV,                ///< Comma-separated, names in first line
+  EN_CUTEST_VEC_RAW                 ///< Fixed-size binary records
+} cutest_vec_format_t;
+
+/*! Test vector file configuration                                            */
+typedef struct tag_cutest_vec_t
+{
+  const char* pszPath;              ///< Vector file
+  cutest_vec_format_t eFormat;      ///< File format
+  size_t uRecordSize;               ///< Binary record size [bytes]
+  unsigned uThreads;                ///< Worker threads, 0 or 1 for none
+} cutest_vec_t;
+
+/*! Test vector record, pointing into the mapped file (not terminated)        */
+typedef struct tag_cutest_vec_record_t
+{
+  cutest_vec_format_t eFormat;      ///< File format
+  unsigned long ulIndex;            ///< Record number, from 1
+  unsigned long ulLine;             ///< First line, 0 for binary records
+  size_t uOffset;                   ///< Offset in the file [bytes]
+  const char* pcData;               ///< Record text or data
+  size_t uSize;                     ///< Record size [bytes]
+  const char* pcSection;            ///< KV: preceding "[...]" lines, or NULL
+  size_t uSectionSize;              ///< KV: section size [bytes]
+  const char* pcHeader;             ///< CSV: field name line
+  size_t uHeaderSize;               ///< CSV: field name line size [bytes]
+} cutest_vec_record_t;
+
+/*! Test vector case body, run once per record                                */
+typedef void (*cutest_vec_fn_t)(cutest_case_ptr_t _tc, const cutest_vec_record_t* _rec);
+
+
+/*- Test case, group, module and suite macros ---------------------------------*/
 /*! Test case definition. Usage:
  *
  * test.c:
@@ -182,7 +518,7 @@ typedef struct tag_cutest_root_t
  *   } // No semicolon - internally, this is a function body                  */
 #define TEST_CASE(x)                                                           \
   void _##x##__TestFn(cutest_case_ptr_t);                                      \
-  cutest_case_t _##x##__TestCase = {                                           \
+  cutest_case_t _##x##__TestCase CUTEST_PERSISTENT = {                         \
     .pszName = #x,                                                             \
     .pszFile = __FILE__,                                                       \
     .ulLine = __LINE__,                                                        \
@@ -193,14 +529,77 @@ typedef struct tag_cutest_root_t
     .ulMsgLine = __LINE__,                                                     \
     .bPrintResult = CUTEST_PRINT_TESTCASE_RESULT                               \
   };                                                                           \
-  cutest_case_ptr_t const x = &_##x##__TestCase;                               \
+  CUTEST_LINKAGE cutest_case_ptr_t const x = &_##x##__TestCase;                \
   void _##x##__TestFn(cutest_case_ptr_t _tc __attribute__((unused)))
 
+/*! Compile-time test case definition, for checks of pure functions. In C++
+ *  sources including CuTest.hpp, the body is evaluated at compile time. In C
+ *  sources, this is a regular test case. Usage:
+ *
+ * test.c:
+ *   CONSTEXPR_TEST_CASE(TEST_MyConstTest)
+ *   {
+ *     CuConstAssert(crc8(0x00u) == 0x00u); // CuConstAssert only
+ *     ...
+ *   } // No semicolon - internally, this is a function body                  */
+#define CONSTEXPR_TEST_CASE(x) TEST_CASE(x)
+
+/*! Differential test case definition. Runs a reference and an optimized
+ *  implementation on the same generated inputs, fails if their outputs differ
+ *  or the optimized one is slower than required. Usage:
+ *
+ * test.c:
+ *   static void crcRefFn(const void* in, void* out) { ... }
+ *   static void crcOptFn(const void* in, void* out) { ... }
+ *   static void crcGenFn(unsigned long index, uint64_t* rng, void* in)
+ *   {
+ *     // index < .ulEdgeCases: edge case, otherwise CuTest_Random(rng)
+ *   }
+ *
+ *   DIFF_CASE(TEST_MyDiffTest, crcRefFn, crcOptFn, crcGenFn)
+ *   {
+ *     .uInSize = sizeof(crc_input_t),
+ *     .uOutSize = sizeof(uint32_t),
+ *     .ulEdgeCases = 4,
+ *     .dMinSpeedup = 2.0
+ *   };                                                                       */
+#define DIFF_CASE(x, ref, opt, gen)                                            \
+  extern const cutest_diff_t _##x##__Diff;                                     \
+  TEST_CASE(x)                                                                 \
+  {                                                                            \
+    CuTest_EvalDiff(_tc, __FILE__, __LINE__, &_##x##__Diff, ref, opt, gen);    \
+  }                                                                            \
+  const cutest_diff_t _##x##__Diff =
+
+/*! Test vector case definition. Memory-maps a vector file and runs the body
+ *  once per record, parsed on demand. Failed records are counted, the first
+ *  one is reported with its record number and line. Usage:
+ *
+ * test.c:
+ *   VECTOR_CASE(TEST_MyKat, .pszPath = "SHA256ShortMsg.rsp",
+ *               .eFormat = EN_CUTEST_VEC_KV, .uThreads = 4)
+ *   {
+ *     uint8_t msg[1024], md[32];
+ *     size_t len = CuVecHex("Msg", msg, sizeof(msg));
+ *     CuVecHex("MD", md, sizeof(md));
+ *     ...
+ *     CuAssert...
+ *   } // No semicolon - internally, this is a function body                  */
+#define VECTOR_CASE(x, ...)                                                    \
+  static void _##x##__VecFn(cutest_case_ptr_t, const cutest_vec_record_t*);    \
+  static const cutest_vec_t _##x##__Vec = { __VA_ARGS__ };                     \
+  TEST_CASE(x)                                                                 \
+  {                                                                            \
+    CuTest_EvalVectors(_tc, __FILE__, __LINE__, &_##x##__Vec, _##x##__VecFn);  \
+  }                                                                            \
+  static void _##x##__VecFn(cutest_case_ptr_t _tc __attribute__((unused)),     \
+    const cutest_vec_record_t* _rec __attribute__((unused)))
+
 /*! External test case declaration. Usage:
  *
  * test.h:
  *   EXTERN_TEST_CASE(TEST_MyTest);                                           */
-#define EXTERN_TEST_CASE(x) extern cutest_case_ptr_t const x
+#define EXTERN_TEST_CASE(x) CUTEST_EXTERN cutest_case_ptr_t const x
 
 /*! Test group definition (set of test cases). Usage:
  *
@@ -212,20 +611,21 @@ typedef struct tag_cutest_root_t
  *   }; // Semicolon required - internally, this is an array definition       */
 #define TEST_GROUP(x)                                                          \
   extern cutest_case_ptr_t _##x##__GroupItems[CUTEST_MAX_NUM_CASES];           \
-  cutest_group_t _##x##__Group = {                                             \
+  cutest_group_t _##x##__Group CUTEST_PERSISTENT = {                           \
     .pszName = #x,                                                             \
     .pszFile = __FILE__,                                                       \
     .ulLine = __LINE__,                                                        \
     .ppItems = _##x##__GroupItems,                                             \
+    .ulNumItems = CUTEST_MAX_NUM_CASES,                                        \
   };                                                                           \
-  cutest_group_ptr_t const x = &_##x##__Group;                                 \
-  cutest_case_ptr_t _##x##__GroupItems[CUTEST_MAX_NUM_CASES] =
+  CUTEST_LINKAGE cutest_group_ptr_t const x = &_##x##__Group;                  \
+  cutest_case_ptr_t _##x##__GroupItems[CUTEST_MAX_NUM_CASES] CUTEST_PERSISTENT =
 
 /*! External test group declaration. Usage:
  *
  * test.h:
  *   EXTERN_TEST_GROUP(TestMyGroup);                                          */
-#define EXTERN_TEST_GROUP(x) extern cutest_group_ptr_t const x
+#define EXTERN_TEST_GROUP(x) CUTEST_EXTERN cutest_group_ptr_t const x
 
 /*! Test module definition (set of groups). Usage:
  *
@@ -237,20 +637,56 @@ typedef struct tag_cutest_root_t
  *   }; // Semicolon required - internally, this is an array definition       */
 #define TEST_MODULE(x)                                                         \
   extern cutest_group_ptr_t _##x##__ModuleItems[CUTEST_MAX_NUM_GROUPS];        \
-  cutest_module_t _##x##__Module = {                                           \
+  cutest_module_t _##x##__Module CUTEST_PERSISTENT = {                         \
     .pszName = #x,                                                             \
     .pszFile = __FILE__,                                                       \
     .ulLine = __LINE__,                                                        \
     .ppItems = _##x##__ModuleItems                                             \
   };                                                                           \
-  cutest_module_ptr_t const x = &_##x##__Module;                               \
-  cutest_group_ptr_t _##x##__ModuleItems[CUTEST_MAX_NUM_GROUPS] =
+  CUTEST_LINKAGE cutest_module_ptr_t const x = &_##x##__Module;                \
+  cutest_group_ptr_t _##x##__ModuleItems[CUTEST_MAX_NUM_GROUPS] CUTEST_PERSISTENT =
 
 /*! External test module declaration. Usage:
  *
  * test.h:
  *   EXTERN_TEST_MODULE(TestMyModule);                                        */
-#define EXTERN_TEST_MODULE(x) extern cutest_module_ptr_t const x
+#define EXTERN_TEST_MODULE(x) CUTEST_EXTERN cutest_module_ptr_t const x
+
+/*! Test suite definition (set of suites, modules, groups and test cases).
+ *  Suites can be nested to any depth. Usage:
+ *
+ * test.c:
+ *   TEST_SUITE(TestMySuite)
+ *   {
+ *     TEST_SUITE_ITEM(TestMyModule),
+ *     TEST_SUITE_ITEM(TestMyOtherSuite),
+ *     ...
+ *   }; // Semicolon required - internally, this is an array definition       */
+#define TEST_SUITE(x)                                                          \
+  extern cutest_relem_t _##x##__SuiteItems[CUTEST_MAX_NUM_SUITE_ITEMS];        \
+  cutest_suite_t _##x##__Suite CUTEST_PERSISTENT = {                           \
+    .pszName = #x,                                                             \
+    .pszFile = __FILE__,                                                       \
+    .ulLine = __LINE__,                                                        \
+    .psItems = _##x##__SuiteItems                                              \
+  };                                                                           \
+  CUTEST_LINKAGE cutest_suite_ptr_t const x = &_##x##__Suite;                  \
+  cutest_relem_t _##x##__SuiteItems[CUTEST_MAX_NUM_SUITE_ITEMS] CUTEST_PERSISTENT =
+
+/*! Test suite item (test case, group, module or suite)                       */
+#define TEST_SUITE_ITEM(x)                                                     \
+  { .eType = _Generic((x),                                                     \
+      cutest_case_ptr_t:   EN_CUTEST_TYPE_CASE,                                \
+      cutest_group_ptr_t:  EN_CUTEST_TYPE_GROUP,                               \
+      cutest_module_ptr_t: EN_CUTEST_TYPE_MODULE,                              \
+      cutest_suite_ptr_t:  EN_CUTEST_TYPE_SUITE),                              \
+    .pItem = (x) }
+
+/*! External test suite declaration. Usage:
+ *
+ * test.h:
+ *   EXTERN_TEST_SUITE(TestMySuite);                                          */
+#define EXTERN_TEST_SUITE(x) CUTEST_EXTERN cutest_suite_ptr_t const x
 
 
 /*- Result evaluation --------------------------------------------------------*/
@@ -261,6 +697,10 @@ void CuTest_EvalAssertPtrEquals(cutest_case_ptr_t,  const char*, unsigned long,
 void CuTest_EvalAssertPtrNotNull(cutest_case_ptr_t, const char*, unsigned long,              const void*);
 void CuTest_EvalAssertStrEquals(cutest_case_ptr_t,  const char*, unsigned long, const char*, const char*);
 void CuTest_EvalAssertMemEquals(cutest_case_ptr_t,  const char*, unsigned long, const void*, const void*, size_t);
+void CuTest_EvalAssertGoldenFile(cutest_case_ptr_t, const char*, unsigned long, const char*, const void*, size_t);
+void CuTest_EvalAssertHashEquals(cutest_case_ptr_t, const char*, unsigned long, cutest_hash_type_t, uint64_t, const void*, size_t);
+void CuTest_EvalAssertHashState(cutest_case_ptr_t,  const char*, unsigned long, uint64_t, const cutest_hash_ptr_t);
+void CuTest_EvalAssertVfsFile(cutest_case_ptr_t,    const char*, unsigned long, const char*, const void*, size_t);
 
 /*! Result evaluation assert macros. Usage example:
  *
@@ -275,32 +715,176 @@ void CuTest_EvalAssertMemEquals(cutest_case_ptr_t,  const char*, unsigned long,
 #define CuPass()                                        CuTest_EvalAssert         (_tc,  __FILE__, __LINE__, (_Bool)1,           NULL     )
 #define CuFail(message)                                 CuTest_EvalAssert         (_tc,  __FILE__, __LINE__, (_Bool)0,           (message))
 #define CuAssert(condition, message)                    CuTest_EvalAssert         (_tc,  __FILE__, __LINE__, (_Bool)(condition), (message))
+#define CuConstAssert(condition)                        CuTest_EvalAssert         (_tc,  __FILE__, __LINE__, (_Bool)(condition), #condition)
 #define CuAssertIntEquals(expected, actual)             CuTest_EvalAssertIntEquals(_tc,  __FILE__, __LINE__, (intmax_t)(expected),    (intmax_t)(actual))
 #define CuAssertFltEquals(expected, actual, tolerance)  CuTest_EvalAssertFltEquals(_tc,  __FILE__, __LINE__, (long double)(expected), (long double)(actual), (long double)(tolerance))
 #define CuAssertPtrEquals(expected, actual)             CuTest_EvalAssertPtrEquals(_tc,  __FILE__, __LINE__, (const void*)(expected), (const void*)(actual))
 #define CuAssertPtrNotNull(actual)                      CuTest_EvalAssertPtrNotNull(_tc, __FILE__, __LINE__,                          (const void*)(actual))
 #define CuAssertStrEquals(expected, actual)             CuTest_EvalAssertStrEquals(_tc,  __FILE__, __LINE__, (const char*)(expected), (const char*)(actual))
 #define CuAssertMemEquals(expected, actual, size)       CuTest_EvalAssertMemEquals(_tc,  __FILE__, __LINE__, (const void*)(expected), (const void*)(actual), (size_t)(size))
+#define CuAssertMatchesGoldenFile(path, actual, size)   CuTest_EvalAssertGoldenFile(_tc, __FILE__, __LINE__, (const char*)(path),     (const void*)(actual), (size_t)(size))
+#define CuAssertHashEquals(expected, actual, size)      CuTest_EvalAssertHashEquals(_tc, __FILE__, __LINE__, EN_CUTEST_HASH_XXH64,  (uint64_t)(expected), (const void*)(actual), (size_t)(size))
+#define CuAssertCrc32cEquals(expected, actual, size)    CuTest_EvalAssertHashEquals(_tc, __FILE__, __LINE__, EN_CUTEST_HASH_CRC32C, (uint64_t)(expected), (const void*)(actual), (size_t)(size))
+#define CuAssertHashStateEquals(expected, hash)         CuTest_EvalAssertHashState(_tc,  __FILE__, __LINE__, (uint64_t)(expected), (hash))
+#define CuAssertVfsFileEquals(path, expected, size)     CuTest_EvalAssertVfsFile(_tc,    __FILE__, __LINE__, (const char*)(path),     (const void*)(expected), (size_t)(size))
+
+
+/*- Hash functions -----------------------------------------------------------*/
+void     CuTest_HashInit  (cutest_hash_ptr_t, cutest_hash_type_t);
+void     CuTest_HashUpdate(cutest_hash_ptr_t, const void*, size_t);
+uint64_t CuTest_HashFinal (const cutest_hash_ptr_t);
+uint64_t CuTest_Hash      (cutest_hash_type_t, const void*, size_t);
+
+/*! Incremental hashing usage example:
+ *
+ * test.c:
+ *   TEST_CASE(...)
+ *   {
+ *     cutest_hash_t hash;
+ *     CuTest_HashInit(&hash, EN_CUTEST_HASH_XXH64);
+ *     while (encodeChunk(chunk, sizeof(chunk), &len)) CuTest_HashUpdate(&hash, chunk, len);
+ *
+ *     CuAssertHashStateEquals(0x0123456789ABCDEFull, &hash);
+ *   }                                                                        */
+
+
+/*- Differential testing -----------------------------------------------------*/
+uint64_t CuTest_Random  (uint64_t*);
+void     CuTest_EvalDiff(cutest_case_ptr_t, const char*, unsigned long, const cutest_diff_t*, cutest_diff_fn_t, cutest_diff_fn_t, cutest_diff_gen_t);
+
+
+/*- Test vectors -------------------------------------------------------------*/
+void        CuTest_EvalVectors(cutest_case_ptr_t, const char*, unsigned long, const cutest_vec_t*, cutest_vec_fn_t);
+const char* CuTest_VecField   (const cutest_vec_record_t*, const char*, size_t*);
+uint64_t    CuTest_VecInt     (cutest_case_ptr_t, const char*, unsigned long, const cutest_vec_record_t*, const char*);
+size_t      CuTest_VecHex     (cutest_case_ptr_t, const char*, unsigned long, const cutest_vec_record_t*, const char*, void*, size_t);
+
+/*! Test vector field access, within VECTOR_CASE bodies                       */
+#define CuVecField(name, len)                           CuTest_VecField(_rec, name, len)
+#define CuVecInt(name)                                  CuTest_VecInt(_tc, __FILE__, __LINE__, _rec, name)
+#define CuVecHex(name, buf, size)                       CuTest_VecHex(_tc, __FILE__, __LINE__, _rec, name, buf, size)
+
+
+/*- Global state isolation ---------------------------------------------------*/
+void CuTest_RegisterStateRegion(void*, size_t);
+void CuTest_SnapshotState(void);
+
+/*! The default snapshot covers the writable data segment of the test binary.
+ * Heap memory and shared library data are not restored. This includes library
+ * objects copied into the test binary at load time (copy relocations, e.g.
+ * environ or stdout), so changes to the environment and standard streams are
+ * kept between test cases.                                                  */
+
+
+/*- Peripheral simulation ----------------------------------------------------*/
+_Bool    CuTest_MapPeripheral   (const char*, uintptr_t, size_t);
+void     CuTest_SetRegisterReset(uintptr_t, uint32_t);
+void     CuTest_HookRegister    (uintptr_t, cutest_reg_hook_fn_t, cutest_reg_hook_fn_t, void*);
+void     CuTest_PokeRegister    (uintptr_t, uint32_t);
+uint32_t CuTest_PeekRegister    (uintptr_t);
+const cutest_reg_access_t* CuTest_GetRegisterTrace(size_t*);
+void     CuTest_EvalAssertRegWrites(cutest_case_ptr_t, const char*, unsigned long, uintptr_t, const uint32_t*, size_t);
+
+/*! Peripheral simulation usage example:
+ *
+ * main.c:
+ *   CuTest_MapPeripheral("USART1", 0x40011000u, 0x400u);
+ *   CuTest_SetRegisterReset(0x40011000u, 0x000000C0u);  // SR: TXE, TC
+ *
+ * test.c:
+ *   TEST_CASE(...)
+ *   {
+ *     CuTest_HookRegister(0x40011000u, readStatus, NULL, NULL);
+ *     uartSend("AB", 2);
+ *
+ *     const uint32_t expected[] = { 'A', 'B' };
+ *     CuAssertRegWrites(0x40011004u, expected, 2);
+ *   }                                                                        */
+#define CuAssertRegWrites(address, expected, count)     CuTest_EvalAssertRegWrites(_tc, __FILE__, __LINE__, (uintptr_t)(address), (const uint32_t*)(expected), (size_t)(count))
+
+
+/*- Output capture -----------------------------------------------------------*/
+void CuTest_EnableOutputCapture(size_t);
+
+
+/*- Resource usage -----------------------------------------------------------*/
+void CuTest_EnableResourceUsage(unsigned);
+
+
+/*- Sampling profiler --------------------------------------------------------*/
+void CuTest_EnableProfiler(const char*, unsigned);
+
+
+/*- In-memory file system ----------------------------------------------------*/
+void  CuTest_MountVfs   (const char*);
+_Bool CuTest_VfsAddFile (const char*, const void*, size_t);
+long  CuTest_VfsReadFile(const char*, void*, size_t);
+
+/*! In-memory file system usage example. Link the test runner with
+ *  -Wl,--wrap=fopen,--wrap=open,--wrap=remove,--wrap=unlink and define
+ *  CUTEST_VFS_PREFIX="\"/vfs/\"":
+ *
+ * test.c:
+ *   TEST_CASE(...)
+ *   {
+ *     CuTest_VfsAddFile("/vfs/config.ini", "baud=9600\n", 10);
+ *     configLoad("/vfs/config.ini");
+ *     configSave("/vfs/config.ini");
+ *
+ *     CuAssertVfsFileEquals("/vfs/config.ini", "baud=9600\n", 10);
+ *   }                                                                        */
+
+
+/*- Per-test coverage --------------------------------------------------------*/
+void CuTest_EnableCoverage(const char*, void (*)(void), void (*)(void));
+
+
+/*- Mutation testing ---------------------------------------------------------*/
+void          CuTest_RegisterMutants  (cutest_mutant_table_ptr_t);
+_Bool         CuTest_IsMutant         (const cutest_mutant_table_ptr_t, unsigned long);
+unsigned long CuTest_RunMutationTests (const cutest_root_ptr_t, unsigned, unsigned);
+
+/*! Mutation testing usage example. Generate a mutant schema of each included
+ *  application source, and build a separate test runner with
+ *  CUTEST_MUTATION_TESTING=1:
+ *
+ * shell:
+ *   cutest-mutate -o build/mutants/uart.c src/uart.c
+ *
+ * test_uart.c:
+ *   #include "CuTest.h"
+ *   #include "uart.c"          // resolved to build/mutants/uart.c via -I
+ *                                                                            */
 
 
 /*- Test run setup -----------------------------------------------------------*/
+void CuTest_InitRoot      (cutest_root_ptr_t, const char*);
+void CuTest_ReleaseRoot   (cutest_root_ptr_t);
+void CuTest_ParseOptions  (cutest_root_ptr_t, int, char*[]);
 void CuTest_AppendRootItem(cutest_root_ptr_t, cutest_type_t, void*);
+void CuTest_RunRootItem   (cutest_root_ptr_t, cutest_type_t, void*);
+void CuTest_RunTests     (cutest_root_ptr_t);
 void CuTest_RunTestCase  (cutest_case_ptr_t);
 void CuTest_RunTestGroup (cutest_group_ptr_t);
 void CuTest_RunTestModule(cutest_module_ptr_t);
+void CuTest_RunTestSuite (cutest_suite_ptr_t);
 void CuTest_PrintRunResults        (const cutest_root_ptr_t, const time_t*);
 void CuTest_GenerateRunReport      (const cutest_root_ptr_t, const time_t*, const char*);
 cutest_result_t CuTest_GetRunResult(const cutest_root_ptr_t);
+cutest_group_ptr_t CuTest_NewGroup (cutest_root_ptr_t, const char*, unsigned long, const char*);
+cutest_case_ptr_t  CuTest_NewCase  (cutest_root_ptr_t, const char*, unsigned long, cutest_group_ptr_t, const char*, cutest_test_fn_t, void*, _Bool);
+void CuTest_AddDependency(cutest_root_ptr_t, cutest_type_t, void*, cutest_type_t, void*);
 
 /*! Test run setup macros. Usage example:
  *
  * main.c:
- *   int main(void)
+ *   int main(int argc, char* argv[])
  *   {
  *     EXTERN_TEST_MODULE(TestMyModule);
  *     ...
  *
  *     BEGIN_TEST_RUN();
+ *     PARSE_TEST_ARGS(argc, argv); // Optional: --jobs=N, --worker=ADDR, ...
  *     RUN_TEST_MODULE(TestMyModule);
  *     ...
  *     END_TEST_RUN();
@@ -308,26 +892,96 @@ cutest_result_t CuTest_GetRunResult(const cutest_root_ptr_t);
  *     return GET_RUN_RESULT();
  *   }                                                                        */
 #define BEGIN_TEST_RUN()                                                       \
-  cutest_root_t _root = { .pszName = CUTEST_PROJECT_NAME, .ulCount = 0u }
-
+  cutest_root_t _root;                                                         \
+  CuTest_InitRoot(&_root, CUTEST_PROJECT_NAME);                                \
+  _root.pszHistoryFile = CUTEST_HISTORY_FILE;                                  \
+  _root.pszJournalFile = CUTEST_JOURNAL_FILE;                                  \
+  if (CUTEST_STATE_ISOLATION) CuTest_SnapshotState();                          \
+  if (CUTEST_CAPTURE_OUTPUT)                                                   \
+    CuTest_EnableOutputCapture(CUTEST_CAPTURE_MAX_LEN);                        \
+  if (CUTEST_RESOURCE_USAGE)                                                   \
+    CuTest_EnableResourceUsage(CUTEST_RESOURCE_USAGE_TOP);                     \
+  CuTest_EnableProfiler(CUTEST_PROFILE_DIR, CUTEST_PROFILE_FREQ);              \
+  CuTest_MountVfs(CUTEST_VFS_PREFIX);                                          \
+  CUTEST_COVERAGE_SETUP()
+
+#define PARSE_TEST_ARGS(argc, argv)                                            \
+  CuTest_ParseOptions(&_root, argc, argv)
+
+/*! Run a test item of the test run. Test cases are run on the spot, unless
+ *  --jobs, --time-budget, --coordinator, --worker, a progress journal,
+ *  mutants or declared dependencies require scheduling the whole run: then
+ *  all items are run by END_TEST_RUN(). Call PARSE_TEST_ARGS() and declare
+ *  dependencies before the first RUN_TEST_...().                             */
 #define RUN_TEST_CASE(x)                                                       \
-  CuTest_AppendRootItem(&_root, EN_CUTEST_TYPE_CASE, x);                       \
-  CuTest_RunTestCase(x)
+  CuTest_RunRootItem(&_root, EN_CUTEST_TYPE_CASE, x)
 
 #define RUN_TEST_GROUP(x)                                                      \
-  CuTest_AppendRootItem(&_root, EN_CUTEST_TYPE_GROUP, x);                      \
-  CuTest_RunTestGroup(x)
+  CuTest_RunRootItem(&_root, EN_CUTEST_TYPE_GROUP, x)
 
 #define RUN_TEST_MODULE(x)                                                     \
-  CuTest_AppendRootItem(&_root, EN_CUTEST_TYPE_MODULE, x);                     \
-  CuTest_RunTestModule(x)
+  CuTest_RunRootItem(&_root, EN_CUTEST_TYPE_MODULE, x)
+
+#define RUN_TEST_SUITE(x)                                                      \
+  CuTest_RunRootItem(&_root, EN_CUTEST_TYPE_SUITE, x)
+
+/*! Dependencies between test items, declared before END_TEST_RUN(). The test
+ *  cases of x are run after all test cases of dep, and skipped if one of them
+ *  failed or was skipped due to a failed dependency. Dependency cycles are
+ *  reported at the start of the test run, and fail it. Use
+ *  CuTest_AddDependency() for items of different types.                      */
+#define TEST_CASE_DEPENDS(x, dep)                                              \
+  CuTest_AddDependency(&_root, EN_CUTEST_TYPE_CASE, x, EN_CUTEST_TYPE_CASE, dep)
+
+#define TEST_GROUP_DEPENDS(x, dep)                                             \
+  CuTest_AddDependency(&_root, EN_CUTEST_TYPE_GROUP, x,                        \
+    EN_CUTEST_TYPE_GROUP, dep)
+
+#define TEST_MODULE_DEPENDS(x, dep)                                            \
+  CuTest_AddDependency(&_root, EN_CUTEST_TYPE_MODULE, x,                       \
+    EN_CUTEST_TYPE_MODULE, dep)
+
+#define TEST_SUITE_DEPENDS(x, dep)                                             \
+  CuTest_AddDependency(&_root, EN_CUTEST_TYPE_SUITE, x,                        \
+    EN_CUTEST_TYPE_SUITE, dep)
+
+/*! Runtime test registration, e.g. one test case per input file. Names are
+ *  copied, all items are kept in the arena of the test run root. Usage:
+ *
+ * main.c:
+ *   void TestTrace(cutest_case_ptr_t _tc)
+ *   {
+ *     const char* pszPath = _tc->pUser;
+ *     ...
+ *     CuAssert...
+ *   }
+ *   ...
+ *   BEGIN_TEST_RUN();
+ *   cutest_group_ptr_t psTraces = NEW_TEST_GROUP("Traces");
+ *   for (...) NEW_TEST_CASE(psTraces, pszName, TestTrace, pszPath);
+ *   RUN_TEST_GROUP(psTraces);
+ *   END_TEST_RUN();                                                          */
+#define NEW_TEST_GROUP(name)                                                   \
+  CuTest_NewGroup(&_root, __FILE__, __LINE__, name)
+
+#define NEW_TEST_CASE(group, name, fn, user)                                   \
+  CuTest_NewCase(&_root, __FILE__, __LINE__, group, name, fn, user,            \
+    CUTEST_PRINT_TESTCASE_RESULT)
 
 #define END_TEST_RUN()                                                         \
+  CuTest_RunTests(&_root);                                                     \
   time_t _ts = time(NULL);                                                     \
-  if (CUTEST_GENERATE_SUMMARY) CuTest_PrintRunResults(&_root, &_ts);             \
-  if (CUTEST_GENERATE_REPORT)  CuTest_GenerateRunReport(&_root, &_ts, CUTEST_REPORT_FILE)
+  if (CUTEST_GENERATE_SUMMARY) CuTest_PrintRunResults(&_root, &_ts);           \
+  if (CUTEST_GENERATE_REPORT)                                                  \
+    CuTest_GenerateRunReport(&_root, &_ts, CUTEST_REPORT_FILE);                \
+  if (CUTEST_MUTATION_TESTING)                                                 \
+    CuTest_RunMutationTests(&_root, CUTEST_MUTATION_JOBS, CUTEST_MUTATION_TIMEOUT)
 
 #define GET_RUN_RESULT()                                                       \
   ((CuTest_GetRunResult(&_root) == EN_CUTEST_RESULT_PASS) ? EXIT_SUCCESS : EXIT_FAILURE)
 
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
 #endif /* _CUTEST_H_ */
@@ -0,0 +1,314 @@
+/*!*****************************************************************************
+ * @file
+ * CuTest.hpp
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - C++ front end
+ *
+ * Test cases defined in C++ sources fail by throwing cutest_failure_t instead
+ * of using longjmp, so destructors of local objects are run on failed asser-
+ * tions. The failure is caught by the test case wrapper, before returning to
+ * the C test runner; any other exception escaping the test case is reported
+ * as failure, including the what() message of std::exception. Test cases,
+ * groups, modules and suites produce the same descriptors as their C counter-
+ * parts, and can be mixed freely with C test sources. Typed test cases run
+ * one test body template for each of a list of types. Compile-time test
+ * cases are evaluated by the compiler as well (C++14 or later), failing the
+ * build on a failed assertion. This source file is licensed under The MIT
+ * License. See https://opensource.org/license/mit/ for full license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+#ifndef _CUTEST_HPP_
+#define _CUTEST_HPP_
+
+/*- Header files -------------------------------------------------------------*/
+#include <cstdio>
+#include <exception>
+#include "CuTest.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Re-run compile-time test cases at run time, e.g. for coverage
+ *  (override-able)                                                           */
+#ifndef CUTEST_CONSTEXPR_RERUN
+#define CUTEST_CONSTEXPR_RERUN        0u
+#endif /* CUTEST_CONSTEXPR_RERUN */
+
+/*! Max. number of types per typed test case                                  */
+#define CUTEST_MAX_NUM_TYPES          16u
+
+/*! Number of macro arguments (1 ... CUTEST_MAX_NUM_TYPES)                    */
+#define CUTEST_NARGS(...)             CUTEST_NARGS_(__VA_ARGS__, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define CUTEST_NARGS_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, n, ...) n
+
+/*! Token concatenation after argument expansion                              */
+#define CUTEST_CAT(a, b)              CUTEST_CAT_(a, b)
+#define CUTEST_CAT_(a, b)             a##b
+
+/*! Apply m(x, n, index, arg) to each argument, n: number of arguments        */
+#define CUTEST_FOR_EACH(m, x, ...)    CUTEST_CAT(CUTEST_FOR_EACH_, CUTEST_NARGS(__VA_ARGS__))(m, x, CUTEST_NARGS(__VA_ARGS__), __VA_ARGS__)
+#define CUTEST_FOR_EACH_1(m, x, n, a)       m(x, n, (n) - 1, a)
+#define CUTEST_FOR_EACH_2(m, x, n, a, ...)  m(x, n, (n) - 2, a)  CUTEST_FOR_EACH_1(m, x, n, __VA_ARGS__)
+#define CUTEST_FOR_EACH_3(m, x, n, a, ...)  m(x, n, (n) - 3, a)  CUTEST_FOR_EACH_2(m, x, n, __VA_ARGS__)
+#define CUTEST_FOR_EACH_4(m, x, n, a, ...)  m(x, n, (n) - 4, a)  CUTEST_FOR_EACH_3(m, x, n, __VA_ARGS__)
+#define CUTEST_FOR_EACH_5(m, x, n, a, ...)  m(x, n, (n) - 5, a)  CUTEST_FOR_EACH_4(m, x, n, __VA_ARGS__)
+#define CUTEST_FOR_EACH_6(m, x, n, a, ...)  m(x, n, (n) - 6, a)  CUTEST_FOR_EACH_5(m, x, n, __VA_ARGS__)
+#define CUTEST_FOR_EACH_7(m, x, n, a, ...)  m(x, n, (n) - 7, a)  CUTEST_FOR_EACH_6(m, x, n, __VA_ARGS__)
+#define CUTEST_FOR_EACH_8(m, x, n, a, ...)  m(x, n, (n) - 8, a)  CUTEST_FOR_EACH_7(m, x, n, __VA_ARGS__)
+#define CUTEST_FOR_EACH_9(m, x, n, a, ...)  m(x, n, (n) - 9, a)  CUTEST_FOR_EACH_8(m, x, n, __VA_ARGS__)
+#define CUTEST_FOR_EACH_10(m, x, n, a, ...) m(x, n, (n) - 10, a) CUTEST_FOR_EACH_9(m, x, n, __VA_ARGS__)
+#define CUTEST_FOR_EACH_11(m, x, n, a, ...) m(x, n, (n) - 11, a) CUTEST_FOR_EACH_10(m, x, n, __VA_ARGS__)
+#define CUTEST_FOR_EACH_12(m, x, n, a, ...) m(x, n, (n) - 12, a) CUTEST_FOR_EACH_11(m, x, n, __VA_ARGS__)
+#define CUTEST_FOR_EACH_13(m, x, n, a, ...) m(x, n, (n) - 13, a) CUTEST_FOR_EACH_12(m, x, n, __VA_ARGS__)
+#define CUTEST_FOR_EACH_14(m, x, n, a, ...) m(x, n, (n) - 14, a) CUTEST_FOR_EACH_13(m, x, n, __VA_ARGS__)
+#define CUTEST_FOR_EACH_15(m, x, n, a, ...) m(x, n, (n) - 15, a) CUTEST_FOR_EACH_14(m, x, n, __VA_ARGS__)
+#define CUTEST_FOR_EACH_16(m, x, n, a, ...) m(x, n, (n) - 16, a) CUTEST_FOR_EACH_15(m, x, n, __VA_ARGS__)
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! Test case failure, thrown by assertions. Result and message are already
+ *  stored in the test case data. Not derived from std::exception, so that
+ *  failures pass through handlers of the code under test.                    */
+struct cutest_failure_t
+{
+  cutest_case_ptr_t psTc;           ///< Failed test case
+};
+
+/*! Run time evaluation of compile-time test case assertions                  */
+struct cutest_run_check_t
+{
+  cutest_case_ptr_t psTc;           ///< Test case data
+
+  void Check(bool bCondition, const char* pszFile, unsigned long ulLine, const char* pszExpr) const
+  {
+    CuTest_EvalAssert(psTc, pszFile, ulLine, bCondition, pszExpr);
+  }
+};
+
+#if __cplusplus >= 201402L
+/*! Reached by a failed assertion during compile-time evaluation, and reported
+ *  by the compiler as non-constant expression                                */
+inline void CuTestConstAssertFailed(const char*) { }
+
+/*! Compile-time evaluation of compile-time test case assertions. Dependent
+ *  on I, to defer evaluation past the test case body definition.             */
+template <int I>
+struct cutest_const_check_t
+{
+  constexpr void Check(bool bCondition, const char*, unsigned long, const char* pszExpr) const
+  {
+    if (!bCondition) CuTestConstAssertFailed(pszExpr);
+  }
+};
+#endif /* __cplusplus */
+
+
+/*- Failure handling ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Failure handler of C++ test cases
+ *
+ * @param[in] psTc        Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+[[noreturn]] inline void CuTestThrowFailure(cutest_case_ptr_t psTc)
+{
+  throw cutest_failure_t{ psTc };
+}
+
+/*!****************************************************************************
+ * @brief
+ * Report an exception escaping a test case as failure
+ *
+ * @param[in] psTc        Test case data
+ * @param[in] *pszWhat    Exception description
+ * @date  17.10.2026
+ ******************************************************************************/
+inline void CuTestFailException(cutest_case_ptr_t psTc, const char* pszWhat) noexcept
+{
+  char acMessage[CUTEST_MAX_LEN_MESSAGE];
+  std::snprintf(acMessage, sizeof(acMessage), "unexpected exception: %s", pszWhat);
+
+  try
+  {
+    CuTest_EvalAssert(psTc, psTc->pszFile, psTc->ulLine, false, acMessage);
+  }
+  catch (const cutest_failure_t&) { }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run a C++ test case body, catching all exceptions
+ *
+ * @param[in] psTc        Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+template <void (*pfvBody)(cutest_case_ptr_t)>
+void CuTestRunBody(cutest_case_ptr_t psTc) noexcept
+{
+  try
+  {
+    pfvBody(psTc);
+  }
+  catch (const cutest_failure_t&) { }
+  catch (const std::exception& e) { CuTestFailException(psTc, e.what()); }
+  catch (...)                     { CuTestFailException(psTc, "unknown type"); }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get the suite item type of a test item
+ *
+ * @return  (cutest_type_t)  Item type
+ * @date  17.10.2026
+ ******************************************************************************/
+constexpr cutest_type_t CuTestItemType(cutest_case_ptr_t)   { return EN_CUTEST_TYPE_CASE; }
+constexpr cutest_type_t CuTestItemType(cutest_group_ptr_t)  { return EN_CUTEST_TYPE_GROUP; }
+constexpr cutest_type_t CuTestItemType(cutest_module_ptr_t) { return EN_CUTEST_TYPE_MODULE; }
+constexpr cutest_type_t CuTestItemType(cutest_suite_ptr_t)  { return EN_CUTEST_TYPE_SUITE; }
+
+
+/*- Test case and suite macros -----------------------------------------------*/
+/*! Test case definition. Usage:
+ *
+ * test.cpp:
+ *   TEST_CASE(TEST_MyTest)
+ *   {
+ *     std::vector<int> v{ 1, 2 };      // Released on failure
+ *     CuAssert...
+ *   } // No semicolon - internally, this is a function body
+ *
+ *  Use EXTERN_TEST_... declarations at namespace scope in C++ sources.       */
+#undef TEST_CASE
+#define TEST_CASE(x)                                                           \
+  static void _##x##__TestBody(cutest_case_ptr_t);                             \
+  cutest_case_t _##x##__TestCase CUTEST_PERSISTENT =                           \
+    CUTEST_CASE_INIT(#x, CuTestRunBody<_##x##__TestBody>);                     \
+  CUTEST_LINKAGE cutest_case_ptr_t const x = &_##x##__TestCase;                \
+  static void _##x##__TestBody(cutest_case_ptr_t _tc __attribute__((unused)))
+
+/*! Test case descriptor of a C++ test function. Positional initialization,
+ *  designated initializers are not available before C++20.                   */
+#define CUTEST_CASE_INIT(name, fn)                                             \
+  {                                                                            \
+    name, __FILE__, __LINE__,                     /* Description */            \
+    fn, {}, CuTestThrowFailure, NULL,             /* Processing */             \
+    EN_CUTEST_RESULT_UNDEF, "", __FILE__, __LINE__, /* Results */              \
+    NULL, NULL, 0u, {},                                                        \
+    CUTEST_PRINT_TESTCASE_RESULT                  /* Output config */          \
+  }
+
+/*! Compile-time test case definition. The body is evaluated at compile time
+ *  (C++14 or later), and registered as a test case. Assertions are checked at
+ *  run time with CUTEST_CONSTEXPR_RERUN, or before C++14 only. There is no
+ *  run time fallback: from C++14 on, a body that is not a constant expression,
+ *  e.g. calling a function that is not constexpr, fails the build like a
+ *  failed assertion. Use TEST_CASE for such checks. Usage:
+ *
+ * test.cpp:
+ *   CONSTEXPR_TEST_CASE(TEST_MyConstTest)
+ *   {
+ *     CuConstAssert(crc8(0x00u) == 0x00u); // CuConstAssert only
+ *     ...
+ *   } // No semicolon - internally, this is a function template body         */
+#undef CONSTEXPR_TEST_CASE
+#undef CuConstAssert
+#if __cplusplus >= 201402L
+#define CONSTEXPR_TEST_CASE(x)                                                 \
+  template <typename C> static constexpr void _##x##__ConstBody(C);            \
+  template <int I> static void _##x##__ConstRun(cutest_case_ptr_t _tc)         \
+  {                                                                            \
+    static_assert((_##x##__ConstBody(cutest_const_check_t<I>{}), true),        \
+      "compile-time test case " #x " failed");                                 \
+    if (CUTEST_CONSTEXPR_RERUN) _##x##__ConstBody(cutest_run_check_t{ _tc });  \
+    else CuPass();                                                             \
+  }                                                                            \
+  TEST_CASE(x) { _##x##__ConstRun<0>(_tc); }                                   \
+  template <typename C> static constexpr void _##x##__ConstBody(C _cc)
+#else
+#define CONSTEXPR_TEST_CASE(x)                                                 \
+  template <typename C> static void _##x##__ConstBody(C);                      \
+  TEST_CASE(x) { _##x##__ConstBody(cutest_run_check_t{ _tc }); }               \
+  template <typename C> static void _##x##__ConstBody(C _cc)
+#endif /* __cplusplus */
+#define CuConstAssert(condition) _cc.Check((condition), __FILE__, __LINE__, #condition)
+
+/*! Typed test case definition: one test case per type, named x<type>, in a
+ *  test group named x. The body is a function template, TypeParam is the
+ *  type under test. Usage:
+ *
+ * test.cpp:
+ *   TYPED_TEST_CASE(TEST_MyTypedTest, int8_t, int16_t, float, q15_t)
+ *   {
+ *     TypeParam a = 1;
+ *     CuAssert...
+ *   } // No semicolon - internally, this is a function template body
+ *
+ *  Use type aliases for types containing commas.                             */
+#define TYPED_TEST_CASE(x, ...)                                                \
+  static_assert(CUTEST_NARGS(__VA_ARGS__) <= CUTEST_MAX_NUM_TYPES,             \
+    "too many types");                                                         \
+  template <typename TypeParam>                                                \
+  static void _##x##__TypedBody(cutest_case_ptr_t);                            \
+  cutest_case_t _##x##__TypedCases[] CUTEST_PERSISTENT = {                     \
+    CUTEST_FOR_EACH(CUTEST_TYPED_CASE, x, __VA_ARGS__)                         \
+  };                                                                           \
+  extern cutest_case_ptr_t _##x##__GroupItems[CUTEST_MAX_NUM_CASES];           \
+  cutest_group_t _##x##__Group CUTEST_PERSISTENT = {                           \
+    #x, __FILE__, __LINE__, _##x##__GroupItems, CUTEST_MAX_NUM_CASES           \
+  };                                                                           \
+  CUTEST_LINKAGE cutest_group_ptr_t const x = &_##x##__Group;                  \
+  cutest_case_ptr_t _##x##__GroupItems[CUTEST_MAX_NUM_CASES]                   \
+    CUTEST_PERSISTENT = {                                                      \
+    CUTEST_FOR_EACH(CUTEST_TYPED_ITEM, x, __VA_ARGS__)                         \
+  };                                                                           \
+  template <typename TypeParam>                                                \
+  static void _##x##__TypedBody(cutest_case_ptr_t _tc __attribute__((unused)))
+
+/*! Typed test case descriptor and group item, see TYPED_TEST_CASE            */
+#define CUTEST_TYPED_CASE(x, n, i, type)                                       \
+  CUTEST_CASE_INIT(#x "<" #type ">", CuTestRunBody<_##x##__TypedBody<type>>),
+#define CUTEST_TYPED_ITEM(x, n, i, type) &_##x##__TypedCases[i],
+
+/*! Test group, module and suite definitions, positional initialization       */
+#undef TEST_GROUP
+#define TEST_GROUP(x)                                                          \
+  extern cutest_case_ptr_t _##x##__GroupItems[CUTEST_MAX_NUM_CASES];           \
+  cutest_group_t _##x##__Group CUTEST_PERSISTENT = {                           \
+    #x, __FILE__, __LINE__, _##x##__GroupItems, CUTEST_MAX_NUM_CASES           \
+  };                                                                           \
+  CUTEST_LINKAGE cutest_group_ptr_t const x = &_##x##__Group;                  \
+  cutest_case_ptr_t _##x##__GroupItems[CUTEST_MAX_NUM_CASES] CUTEST_PERSISTENT =
+
+#undef TEST_MODULE
+#define TEST_MODULE(x)                                                         \
+  extern cutest_group_ptr_t _##x##__ModuleItems[CUTEST_MAX_NUM_GROUPS];        \
+  cutest_module_t _##x##__Module CUTEST_PERSISTENT = {                         \
+    #x, __FILE__, __LINE__, _##x##__ModuleItems                                \
+  };                                                                           \
+  CUTEST_LINKAGE cutest_module_ptr_t const x = &_##x##__Module;                \
+  cutest_group_ptr_t _##x##__ModuleItems[CUTEST_MAX_NUM_GROUPS] CUTEST_PERSISTENT =
+
+#undef TEST_SUITE
+#define TEST_SUITE(x)                                                          \
+  extern cutest_relem_t _##x##__SuiteItems[CUTEST_MAX_NUM_SUITE_ITEMS];        \
+  cutest_suite_t _##x##__Suite CUTEST_PERSISTENT = {                           \
+    #x, __FILE__, __LINE__, _##x##__SuiteItems                                 \
+  };                                                                           \
+  CUTEST_LINKAGE cutest_suite_ptr_t const x = &_##x##__Suite;                  \
+  cutest_relem_t _##x##__SuiteItems[CUTEST_MAX_NUM_SUITE_ITEMS] CUTEST_PERSISTENT =
+
+/*! Test suite item (test case, group, module or suite). The item pointer is
+ *  stored in the first union member, all members share the representation.   */
+#undef TEST_SUITE_ITEM
+#define TEST_SUITE_ITEM(x)                                                     \
+  { CuTestItemType(x), { reinterpret_cast<cutest_suite_ptr_t>(x) } }
+
+#endif /* _CUTEST_HPP_ */
@@ -0,0 +1,195 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestCapture.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - output capture
+ *
+ * Redirects stdout and stderr into an in-memory file while a test case is run.
+ * The captured output is discarded for passed test cases, and attached to the
+ * test case result otherwise. This source file is licensed under The MIT Li-
+ * cense. See https://opensource.org/license/mit/ for full license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "CuTestPrivate.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Marker for truncated output                                               */
+#define CUTEST_CAPTURE_TRUNCATED      "[...]\n"
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! Output capture data                                                       */
+typedef struct tag_cutest_capture_t
+{
+  _Bool bEnabled;                   ///< Capture enabled
+  _Bool bActive;                    ///< Output currently redirected
+  size_t uMaxLen;                   ///< Max. captured bytes per test case
+  int iFd;                          ///< Capture file
+  int iStdout;                      ///< Saved stdout descriptor
+  int iStderr;                      ///< Saved stderr descriptor
+} cutest_capture_t;
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static int CuTestCaptureOpen(void);
+
+
+/*- Private variables --------------------------------------------------------*/
+/*! Output capture data                                                       */
+static cutest_capture_t sCapture _PERSISTENT;
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Create the in-memory capture file
+ *
+ * @return  (int)  File descriptor, -1 on error
+ * @date  17.10.2026
+ ******************************************************************************/
+static int CuTestCaptureOpen(void)
+{
+  int iFd = memfd_create("cutest-capture", MFD_CLOEXEC);
+  if (iFd < 0)
+  {
+    FILE* f = tmpfile();
+    if (f != NULL) iFd = dup(fileno(f));
+    if (f != NULL) fclose(f);
+  }
+
+  return iFd;
+}
+
+
+/*- Output capture -----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Enable per-test case output capture
+ *
+ * @param[in] uMaxLen     Max. number of bytes attached to a failed test case.
+ *                        Longer output is truncated at the beginning.
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_EnableOutputCapture(size_t uMaxLen)
+{
+  if (sCapture.bEnabled) return;
+
+  int iFd = CuTestCaptureOpen();
+  if (iFd < 0)
+  {
+    fprintf(stderr, "CuTest: output capture unavailable.\n");
+    return;
+  }
+
+  sCapture = (cutest_capture_t){
+    .bEnabled = 1,
+    .bActive = 0,
+    .uMaxLen = uMaxLen,
+    .iFd = iFd,
+    .iStdout = dup(STDOUT_FILENO),
+    .iStderr = dup(STDERR_FILENO)
+  };
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start capturing stdout and stderr for a test case
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestCaptureBegin(void)
+{
+  if (!sCapture.bEnabled || sCapture.bActive) return;
+
+  fflush(stdout);
+  fflush(stderr);
+  if (ftruncate(sCapture.iFd, 0) != 0) return;
+  lseek(sCapture.iFd, 0, SEEK_SET);
+
+  dup2(sCapture.iFd, STDOUT_FILENO);
+  dup2(sCapture.iFd, STDERR_FILENO);
+  sCapture.bActive = 1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stop capturing and attach the output to a failed test case
+ *
+ * @param[inout] psTc     Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestCaptureEnd(cutest_case_ptr_t psTc)
+{
+  assert(psTc != NULL);
+
+  if (!sCapture.bActive) return;
+
+  fflush(stdout);
+  fflush(stderr);
+  dup2(sCapture.iStdout, STDOUT_FILENO);
+  dup2(sCapture.iStderr, STDERR_FILENO);
+  sCapture.bActive = 0;
+
+  if (psTc->eResult == EN_CUTEST_RESULT_PASS) return;
+
+  off_t lSize = lseek(sCapture.iFd, 0, SEEK_END);
+  if (lSize <= 0) return;
+
+  // Keep the end of the output if exceeding the size limit
+  size_t uLen = (size_t)lSize;
+  off_t lOffset = 0;
+  size_t uPrefix = 0u;
+  if (uLen > sCapture.uMaxLen)
+  {
+    lOffset = lSize - (off_t)sCapture.uMaxLen;
+    uLen = sCapture.uMaxLen;
+    uPrefix = sizeof(CUTEST_CAPTURE_TRUNCATED) - 1u;
+  }
+
+  char* pszOutput = malloc(uPrefix + uLen + 1u);
+  if (pszOutput == NULL) return;
+
+  memcpy(pszOutput, CUTEST_CAPTURE_TRUNCATED, uPrefix);
+  ssize_t iRead = pread(sCapture.iFd, &pszOutput[uPrefix], uLen, lOffset);
+  if (iRead < 0) iRead = 0;
+  pszOutput[uPrefix + (size_t)iRead] = '\0';
+
+  psTc->pszOutput = pszOutput;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Use a separate capture file in a forked worker process
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestCaptureDetach(void)
+{
+  if (!sCapture.bEnabled) return;
+
+  int iFd = CuTestCaptureOpen();
+  if (iFd < 0)
+  {
+    sCapture.bEnabled = 0;
+    return;
+  }
+
+  close(sCapture.iFd);
+  sCapture.iFd = iFd;
+}
@@ -0,0 +1,131 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestCoverage.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - per-test coverage
+ *
+ * For test runners built with --coverage, the gcov counters are cleared before
+ * and written out after each test case. The data of each test case is placed
+ * in a separate directory below the coverage output directory (through the
+ * GCOV_PREFIX variable), to be merged by the cutest-coverage tool. This
+ * source file is licensed under The MIT License. See
+ * https://opensource.org/license/mit/ for full license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include "CuTestPrivate.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Max. length of a per-test case data directory                             */
+#define CUTEST_COVERAGE_MAX_PATH      512u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! Per-test coverage data                                                    */
+typedef struct tag_cutest_coverage_t
+{
+  const char* pszDir;               ///< Output directory, NULL if disabled
+  void (*pfvReset)(void);           ///< gcov counter reset
+  void (*pfvDump)(void);            ///< gcov data dump
+} cutest_coverage_t;
+
+
+/*- Private variables --------------------------------------------------------*/
+/*! Per-test coverage data                                                    */
+static cutest_coverage_t sCoverage _PERSISTENT;
+
+
+/*- Per-test coverage --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Enable per-test case coverage capture
+ *
+ * The gcov interface functions are passed in by the test runner (see
+ * BEGIN_TEST_RUN), since only runners built with --coverage provide them.
+ *
+ * @param[in] *pszDir     Output directory, NULL to disable
+ * @param[in] pfvReset    __gcov_reset
+ * @param[in] pfvDump     __gcov_dump
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_EnableCoverage(const char* pszDir, void (*pfvReset)(void), void (*pfvDump)(void))
+{
+  assert(pfvReset != NULL);
+  assert(pfvDump != NULL);
+
+  sCoverage = (cutest_coverage_t){ .pszDir = pszDir, .pfvReset = pfvReset, .pfvDump = pfvDump };
+}
+
+/*!****************************************************************************
+ * @brief
+ * Clear coverage counters before running a test case
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestCoverageBegin(void)
+{
+  if (sCoverage.pszDir == NULL) return;
+
+  sCoverage.pfvReset();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Write coverage data of a test case into its data directory
+ *
+ * The directory is named after the path of the test case in the test hier-
+ * archy, e.g. "Module.Group.Case", so that test cases with equal names in
+ * different groups are kept apart. Test cases run directly (outside of a test
+ * run) use their name only.
+ *
+ * @param[in] psTc        Test case data
+ * @date  17.10.2026
+ * @date  17.10.2026  Name directories after the test case path
+ ******************************************************************************/
+void CuTestCoverageEnd(const cutest_case_ptr_t psTc)
+{
+  assert(psTc != NULL);
+
+  if (sCoverage.pszDir == NULL) return;
+
+  char acPrefix[CUTEST_COVERAGE_MAX_PATH];
+  const char* pszPath = (psTc->pszPath != NULL) ? psTc->pszPath : psTc->pszName;
+  int iLen = snprintf(acPrefix, sizeof(acPrefix), "%s/%s", sCoverage.pszDir, pszPath);
+  if ((iLen < 0) || ((size_t)iLen >= sizeof(acPrefix))) return;
+
+  // Keep directory names usable for test names with special characters
+  for (char* p = &acPrefix[strlen(sCoverage.pszDir) + 1u]; *p != '\0'; ++p)
+  {
+    if (*p == '/') *p = '.';
+    else if ((*p == ' ') || (*p == '\\')) *p = '_';
+  }
+
+  setenv("GCOV_PREFIX", acPrefix, 1);
+  sCoverage.pfvDump();
+  unsetenv("GCOV_PREFIX");
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get the coverage output directory
+ *
+ * @return  (const char*)  Output directory, NULL if disabled
+ * @date  17.10.2026
+ ******************************************************************************/
+const char* CuTestCoverageDir(void)
+{
+  return sCoverage.pszDir;
+}
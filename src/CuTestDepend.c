@@ -0,0 +1,870 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestDepend.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - test dependencies
+ *
+ * Dependencies are declared between test cases, groups, modules and suites of
+ * a test run root. At the start of a test run, they are resolved to the test
+ * cases below the dependent item, waiting for all test cases below the item
+ * depended on. Root items are run in dependency order, and the test cases of
+ * each root item are reordered accordingly; both orders are topological and
+ * keep the declaration order where possible. Cycles are reported, and fail the
+ * test run before any test case is run. Test cases whose dependency failed are
+ * skipped and reported as "skipped: dependency <item> failed"; if the
+ * dependency was skipped itself, as "skipped: dependency <item> skipped" and
+ * the failed item causing it. This source file is licensed under The MIT
+ * License. See
+ * https://opensource.org/license/mit/ for full license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <assert.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include "CuTestPrivate.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Initial length of the dependency declaration list                         */
+#define CUTEST_DEPEND_INIT            8u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! Resolved dependency declaration. Its ranges are pairs of declaration order
+ *  indices [start, end), the dependent ones first.                           */
+typedef struct tag_cutest_dep_barrier_t
+{
+  const cutest_depend_t* psDecl;    ///< Declaration
+  const char* pszItem;              ///< Dependent item name
+  const char* pszDep;               ///< Name of the item depended on
+  unsigned long ulFirst;            ///< First range
+  unsigned long ulNumItem;          ///< Number of dependent ranges
+  unsigned long ulNumDep;           ///< Number of ranges depended on
+  unsigned long ulRange;            ///< Range depended on, checked next
+  unsigned long ulPos;              ///< Test case depended on, checked next
+  _Bool bFailed;                    ///< A test case depended on failed or was
+                                    ///< skipped
+  _Bool bSkipped;                   ///< Skipped, not failed
+  const char* pszCause;             ///< Failed item causing the skip, or NULL
+} cutest_dep_barrier_t;
+
+/*! Test case dependencies of a test run                                      */
+typedef struct tag_cutest_dep_graph_t
+{
+  cutest_case_ptr_t* ppsCases;      ///< Test cases in declaration order
+  unsigned long* pulDecl;           ///< Declaration order index per test case
+  cutest_dep_barrier_t* psBarriers; ///< Resolved dependencies
+  unsigned long ulNumBarriers;      ///< Number of resolved dependencies
+  unsigned long* pulRanges;         ///< Test case ranges of all dependencies
+  unsigned long* pulCaseFirst;      ///< First dependency per test case, plus end
+  unsigned long* pulCaseDeps;       ///< Dependencies of the test cases
+  unsigned long* pulItemOrder;      ///< Root items in dependency order
+  unsigned long* pulItemFirst;      ///< First root item depended on, plus end
+  unsigned long* pulItemDeps;       ///< Root items depended on
+  _Bool* pbItemDone;                ///< All test cases of a root item finished
+} cutest_dep_graph_t;
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static void          CuTestHeapPush(unsigned long* pulHeap, unsigned long* pulLen, unsigned long ulValue);
+static unsigned long CuTestHeapPop(unsigned long* pulHeap, unsigned long* pulLen);
+static unsigned long CuTestDependRanges(const cutest_root_ptr_t psRoot, const cutest_relem_t* psItem, const unsigned long* pulNodeRange, unsigned long* pulRanges, const char** ppszName);
+static unsigned long CuTestDependWaitsFor(const cutest_dep_graph_t* psGraph, unsigned long ulCount, const unsigned long* pulPending, unsigned long ulVertex);
+static _Bool         CuTestDependSortCases(const cutest_dep_graph_t* psGraph, unsigned long ulCount, unsigned long* pulOrder);
+static _Bool         CuTestDependSortItems(const cutest_root_ptr_t psRoot, cutest_dep_graph_t* psGraph, const unsigned long* pulCaseItem, unsigned long ulItems);
+static const cutest_dep_barrier_t* CuTestDependFailed(const cutest_dep_graph_t* psGraph, unsigned long c);
+static void          CuTestDependUpdate(const cutest_dep_graph_t* psGraph, cutest_dep_barrier_t* psBarrier);
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Insert a value into a min-heap
+ *
+ * @param[inout] *pulHeap Heap
+ * @param[inout] *pulLen  Number of values
+ * @param[in] ulValue     Value
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestHeapPush(unsigned long* pulHeap, unsigned long* pulLen, unsigned long ulValue)
+{
+  unsigned long i = (*pulLen)++;
+  while ((i > 0u) && (pulHeap[(i - 1u) / 2u] > ulValue))
+  {
+    pulHeap[i] = pulHeap[(i - 1u) / 2u];
+    i = (i - 1u) / 2u;
+  }
+  pulHeap[i] = ulValue;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Remove the smallest value from a min-heap
+ *
+ * @param[inout] *pulHeap Heap, not empty
+ * @param[inout] *pulLen  Number of values
+ * @return  (unsigned long)  Smallest value
+ * @date  17.10.2026
+ ******************************************************************************/
+static unsigned long CuTestHeapPop(unsigned long* pulHeap, unsigned long* pulLen)
+{
+  const unsigned long ulTop = pulHeap[0];
+  const unsigned long ulLast = pulHeap[--(*pulLen)];
+
+  unsigned long i = 0u;
+  for (unsigned long c = 1u; c < *pulLen; c = 2u * i + 1u)
+  {
+    if ((c + 1u < *pulLen) && (pulHeap[c + 1u] < pulHeap[c])) ++c;
+    if (pulHeap[c] >= ulLast) break;
+    pulHeap[i] = pulHeap[c];
+    i = c;
+  }
+  pulHeap[i] = ulLast;
+  return ulTop;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Collect the test case ranges of all nodes of an item
+ *
+ * @param[in] psRoot      Test run root
+ * @param[in] psItem      Item
+ * @param[in] *pulNodeRange Test case range per node, start ULONG_MAX if empty
+ * @param[out] *pulRanges Test case ranges, or NULL to count only
+ * @param[out] *ppszName  Item name, unchanged if not part of the test run
+ * @return  (unsigned long)  Number of ranges
+ * @date  17.10.2026
+ ******************************************************************************/
+static unsigned long CuTestDependRanges(const cutest_root_ptr_t psRoot, const cutest_relem_t* psItem, const unsigned long* pulNodeRange, unsigned long* pulRanges, const char** ppszName)
+{
+  unsigned long ulCount = 0u;
+  for (unsigned long j = 0; j < psRoot->ulNumNodes; ++j)
+  {
+    const cutest_node_t* psNode = &psRoot->psNodes[j];
+    if ((psNode->sItem.eType != psItem->eType) || (psNode->sItem.pItem != psItem->pItem)) continue;
+
+    *ppszName = CuTestNodeName(psNode);
+    if (pulNodeRange[2u * j] == ULONG_MAX) continue;
+    if (pulRanges != NULL)
+    {
+      pulRanges[2u * ulCount] = pulNodeRange[2u * j];
+      pulRanges[2u * ulCount + 1u] = pulNodeRange[2u * j + 1u];
+    }
+    ulCount++;
+  }
+
+  return ulCount;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Find a vertex that a vertex left over by the topological sort waits for
+ *
+ * Test cases wait for their dependencies, dependencies for the test cases
+ * depended on. Each vertex left over waits for another one left over.
+ *
+ * @param[in] psGraph     Test case dependencies
+ * @param[in] ulCount     Number of test cases, first dependency vertex
+ * @param[in] *pulPending Number of vertices waited for per vertex
+ * @param[in] ulVertex    Vertex left over
+ * @return  (unsigned long)  Vertex left over, waited for
+ * @date  17.10.2026
+ ******************************************************************************/
+static unsigned long CuTestDependWaitsFor(const cutest_dep_graph_t* psGraph, unsigned long ulCount, const unsigned long* pulPending, unsigned long ulVertex)
+{
+  if (ulVertex < ulCount)
+  {
+    for (unsigned long k = psGraph->pulCaseFirst[ulVertex]; k < psGraph->pulCaseFirst[ulVertex + 1u]; ++k)
+    {
+      if (pulPending[ulCount + psGraph->pulCaseDeps[k]] > 0u) return ulCount + psGraph->pulCaseDeps[k];
+    }
+  }
+  else
+  {
+    const cutest_dep_barrier_t* psBarrier = &psGraph->psBarriers[ulVertex - ulCount];
+    const unsigned long* pulDep = &psGraph->pulRanges[2u * (psBarrier->ulFirst + psBarrier->ulNumItem)];
+    for (unsigned long r = 0; r < psBarrier->ulNumDep; ++r)
+    {
+      for (unsigned long c = pulDep[2u * r]; c < pulDep[2u * r + 1u]; ++c)
+      {
+        if (pulPending[c] > 0u) return c;
+      }
+    }
+  }
+
+  assert(0);
+  return ulVertex;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Sort the test cases topologically, lowest declaration order index first
+ *
+ * The dependencies are vertices of their own, following the test cases, so
+ * that the number of edges grows linearly with the number of test cases.
+ * Cycles are reported.
+ *
+ * @param[in] psGraph     Test case dependencies
+ * @param[in] ulCount     Number of test cases
+ * @param[out] *pulOrder  Declaration order indices in run order
+ * @return  (_Bool)  false, if the dependencies form a cycle
+ * @date  17.10.2026
+ * @date  17.10.2026  Return cycles instead of exiting
+ ******************************************************************************/
+static _Bool CuTestDependSortCases(const cutest_dep_graph_t* psGraph, unsigned long ulCount, unsigned long* pulOrder)
+{
+  const unsigned long ulNumVertices = ulCount + psGraph->ulNumBarriers;
+  unsigned long* pulPending = calloc(ulNumVertices + 1u, sizeof(unsigned long));
+  unsigned long* pulSuccFirst = calloc(ulCount + 2u, sizeof(unsigned long));
+  unsigned long* pulHeap = malloc((ulNumVertices + 1u) * sizeof(unsigned long));
+  assert((pulPending != NULL) && (pulSuccFirst != NULL) && (pulHeap != NULL));
+
+  // Dependencies waiting for each test case
+  unsigned long* pulSucc = NULL;
+  for (int iPass = 0; iPass < 2; ++iPass)
+  {
+    for (unsigned long b = 0; b < psGraph->ulNumBarriers; ++b)
+    {
+      const cutest_dep_barrier_t* psBarrier = &psGraph->psBarriers[b];
+      const unsigned long* pulDep = &psGraph->pulRanges[2u * (psBarrier->ulFirst + psBarrier->ulNumItem)];
+      for (unsigned long r = 0; r < psBarrier->ulNumDep; ++r)
+      {
+        for (unsigned long c = pulDep[2u * r]; c < pulDep[2u * r + 1u]; ++c)
+        {
+          if (iPass == 0) pulSuccFirst[c + 2u]++;
+          else pulSucc[pulSuccFirst[c + 1u]++] = b;
+        }
+        if (iPass == 0) pulPending[ulCount + b] += pulDep[2u * r + 1u] - pulDep[2u * r];
+      }
+    }
+    if (iPass > 0) break;
+
+    for (unsigned long c = 0; c < ulCount; ++c) pulSuccFirst[c + 2u] += pulSuccFirst[c + 1u];
+    pulSucc = malloc((pulSuccFirst[ulCount + 1u] + 1u) * sizeof(unsigned long));
+    assert(pulSucc != NULL);
+  }
+  for (unsigned long c = 0; c < ulCount; ++c) pulPending[c] = psGraph->pulCaseFirst[c + 1u] - psGraph->pulCaseFirst[c];
+
+  // Kahn's algorithm, lowest vertex first
+  unsigned long ulHeap = 0u;
+  unsigned long ulDone = 0u;
+  unsigned long ulSorted = 0u;
+  for (unsigned long v = 0; v < ulNumVertices; ++v)
+  {
+    if (pulPending[v] == 0u) CuTestHeapPush(pulHeap, &ulHeap, v);
+  }
+  while (ulHeap > 0u)
+  {
+    const unsigned long v = CuTestHeapPop(pulHeap, &ulHeap);
+    ulDone++;
+    if (v < ulCount)
+    {
+      pulOrder[ulSorted++] = v;
+      for (unsigned long k = pulSuccFirst[v]; k < pulSuccFirst[v + 1u]; ++k)
+      {
+        if (--pulPending[ulCount + pulSucc[k]] == 0u) CuTestHeapPush(pulHeap, &ulHeap, ulCount + pulSucc[k]);
+      }
+      continue;
+    }
+
+    const cutest_dep_barrier_t* psBarrier = &psGraph->psBarriers[v - ulCount];
+    const unsigned long* pulItem = &psGraph->pulRanges[2u * psBarrier->ulFirst];
+    for (unsigned long r = 0; r < psBarrier->ulNumItem; ++r)
+    {
+      for (unsigned long c = pulItem[2u * r]; c < pulItem[2u * r + 1u]; ++c)
+      {
+        if (--pulPending[c] == 0u) CuTestHeapPush(pulHeap, &ulHeap, c);
+      }
+    }
+  }
+
+  if (ulDone < ulNumVertices)
+  {
+    // Follow the vertices left over until one repeats, then print the cycle
+    for (unsigned long v = 0; v < ulNumVertices; ++v) pulHeap[v] = 0u;
+    unsigned long v = 0u;
+    while (pulPending[v] == 0u) ++v;
+    for (; pulHeap[v] == 0u; v = CuTestDependWaitsFor(psGraph, ulCount, pulPending, v)) pulHeap[v] = 1u;
+
+    const unsigned long ulFirst = v;
+    const char* pszSep = " ";
+    fprintf(stderr, "CuTest: dependency cycle:");
+    do
+    {
+      if (v >= ulCount)
+      {
+        fprintf(stderr, "%s%s -> %s", pszSep, psGraph->psBarriers[v - ulCount].pszItem, psGraph->psBarriers[v - ulCount].pszDep);
+        pszSep = ", ";
+      }
+      v = CuTestDependWaitsFor(psGraph, ulCount, pulPending, v);
+    } while (v != ulFirst);
+    fprintf(stderr, "\n");
+  }
+
+  free(pulPending);
+  free(pulSuccFirst);
+  free(pulSucc);
+  free(pulHeap);
+  return ulDone == ulNumVertices;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Resolve the dependencies between root items, and sort the root items
+ * topologically, lowest index first
+ *
+ * A root item depends on another one if one of its test cases does. Cycles
+ * are reported.
+ *
+ * @param[in] psRoot      Test run root
+ * @param[inout] psGraph  Test case dependencies
+ * @param[in] *pulCaseItem Root item per declaration order index
+ * @param[in] ulItems     Number of root items
+ * @return  (_Bool)  false, if the dependencies form a cycle
+ * @date  17.10.2026
+ * @date  17.10.2026  Return cycles instead of exiting
+ ******************************************************************************/
+static _Bool CuTestDependSortItems(const cutest_root_ptr_t psRoot, cutest_dep_graph_t* psGraph, const unsigned long* pulCaseItem, unsigned long ulItems)
+{
+  unsigned long* pulPending = calloc(ulItems + 1u, sizeof(unsigned long));
+  unsigned long* pulSuccFirst = calloc(ulItems + 2u, sizeof(unsigned long));
+  unsigned long* pulSucc = NULL;
+  psGraph->pulItemFirst = calloc(ulItems + 2u, sizeof(unsigned long));
+  assert((pulPending != NULL) && (pulSuccFirst != NULL) && (psGraph->pulItemFirst != NULL));
+
+  // Root items depended on per root item, and vice versa
+  for (int iPass = 0; iPass < 2; ++iPass)
+  {
+    for (unsigned long b = 0; b < psGraph->ulNumBarriers; ++b)
+    {
+      const cutest_dep_barrier_t* psBarrier = &psGraph->psBarriers[b];
+      const unsigned long* pulItem = &psGraph->pulRanges[2u * psBarrier->ulFirst];
+      const unsigned long* pulDep = &pulItem[2u * psBarrier->ulNumItem];
+      for (unsigned long i = 0; i < psBarrier->ulNumItem; ++i)
+      {
+        for (unsigned long d = 0; d < psBarrier->ulNumDep; ++d)
+        {
+          const unsigned long ulItem = pulCaseItem[pulItem[2u * i]];
+          const unsigned long ulDep = pulCaseItem[pulDep[2u * d]];
+          if (ulItem == ulDep) continue;
+          if (iPass == 0)
+          {
+            psGraph->pulItemFirst[ulItem + 2u]++;
+            pulSuccFirst[ulDep + 2u]++;
+            pulPending[ulItem]++;
+          }
+          else
+          {
+            psGraph->pulItemDeps[psGraph->pulItemFirst[ulItem + 1u]++] = ulDep;
+            pulSucc[pulSuccFirst[ulDep + 1u]++] = ulItem;
+          }
+        }
+      }
+    }
+    if (iPass > 0) break;
+
+    for (unsigned long u = 0; u < ulItems; ++u)
+    {
+      psGraph->pulItemFirst[u + 2u] += psGraph->pulItemFirst[u + 1u];
+      pulSuccFirst[u + 2u] += pulSuccFirst[u + 1u];
+    }
+    psGraph->pulItemDeps = malloc((psGraph->pulItemFirst[ulItems] + 1u) * sizeof(unsigned long));
+    pulSucc = malloc((pulSuccFirst[ulItems] + 1u) * sizeof(unsigned long));
+    assert((psGraph->pulItemDeps != NULL) && (pulSucc != NULL));
+  }
+
+  // Kahn's algorithm, lowest root item first
+  unsigned long* pulHeap = malloc((ulItems + 1u) * sizeof(unsigned long));
+  assert(pulHeap != NULL);
+  unsigned long ulHeap = 0u;
+  unsigned long ulSorted = 0u;
+  for (unsigned long u = 0; u < ulItems; ++u)
+  {
+    if (pulPending[u] == 0u) CuTestHeapPush(pulHeap, &ulHeap, u);
+  }
+  while (ulHeap > 0u)
+  {
+    const unsigned long u = CuTestHeapPop(pulHeap, &ulHeap);
+    psGraph->pulItemOrder[ulSorted++] = u;
+    for (unsigned long k = pulSuccFirst[u]; k < pulSuccFirst[u + 1u]; ++k)
+    {
+      if (--pulPending[pulSucc[k]] == 0u) CuTestHeapPush(pulHeap, &ulHeap, pulSucc[k]);
+    }
+  }
+
+  if (ulSorted < ulItems)
+  {
+    // Follow the root items left over until one repeats, then print the cycle
+    for (unsigned long u = 0; u < ulItems; ++u) pulHeap[u] = 0u;
+    unsigned long u = 0u;
+    while (pulPending[u] == 0u) ++u;
+    while (pulHeap[u] == 0u)
+    {
+      pulHeap[u] = 1u;
+      unsigned long k = psGraph->pulItemFirst[u];
+      while (pulPending[psGraph->pulItemDeps[k]] == 0u) ++k;
+      u = psGraph->pulItemDeps[k];
+    }
+
+    const unsigned long ulFirst = u;
+    fprintf(stderr, "CuTest: dependency cycle between root items: %s", CuTestNodeName(&psRoot->psNodes[u]));
+    do
+    {
+      unsigned long k = psGraph->pulItemFirst[u];
+      while (pulPending[psGraph->pulItemDeps[k]] == 0u) ++k;
+      u = psGraph->pulItemDeps[k];
+      fprintf(stderr, " -> %s", CuTestNodeName(&psRoot->psNodes[u]));
+    } while (u != ulFirst);
+    fprintf(stderr, "\n");
+  }
+
+  free(pulPending);
+  free(pulSuccFirst);
+  free(pulSucc);
+  free(pulHeap);
+  return ulSorted == ulItems;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Find the first failed dependency of a finished test case
+ *
+ * @param[in] psGraph     Test case dependencies
+ * @param[in] c           Declaration order index of the test case
+ * @return  (const cutest_dep_barrier_t*)  Failed dependency, or NULL
+ * @date  17.10.2026
+ ******************************************************************************/
+static const cutest_dep_barrier_t* CuTestDependFailed(const cutest_dep_graph_t* psGraph, unsigned long c)
+{
+  for (unsigned long k = psGraph->pulCaseFirst[c]; k < psGraph->pulCaseFirst[c + 1u]; ++k)
+  {
+    cutest_dep_barrier_t* psBarrier = &psGraph->psBarriers[psGraph->pulCaseDeps[k]];
+    CuTestDependUpdate(psGraph, psBarrier);
+    if (psBarrier->bFailed) return psBarrier;
+  }
+
+  return NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check the test cases depended on, up to the first one not finished yet
+ *
+ * Test cases only ever finish, so checking continues where it stopped. The
+ * first failed or skipped test case is kept as the reason for skipping.
+ *
+ * @param[in] psGraph     Test case dependencies
+ * @param[inout] psBarrier Dependency
+ * @date  17.10.2026
+ * @date  17.10.2026  Keep the failed item causing a skip
+ ******************************************************************************/
+static void CuTestDependUpdate(const cutest_dep_graph_t* psGraph, cutest_dep_barrier_t* psBarrier)
+{
+  const unsigned long* pulDep = &psGraph->pulRanges[2u * (psBarrier->ulFirst + psBarrier->ulNumItem)];
+  while (psBarrier->ulRange < psBarrier->ulNumDep)
+  {
+    for (; psBarrier->ulPos < pulDep[2u * psBarrier->ulRange + 1u]; ++psBarrier->ulPos)
+    {
+      const cutest_case_ptr_t psCase = psGraph->ppsCases[psBarrier->ulPos];
+      if (psCase->eResult == EN_CUTEST_RESULT_UNDEF) return;
+      if (psBarrier->bFailed) continue;
+      if (psCase->eResult == EN_CUTEST_RESULT_FAIL)
+      {
+        psBarrier->bFailed = 1;
+      }
+      else if (CuTestDependSkipped(psCase))
+      {
+        // Dependencies are acyclic, the cause is found in finished test cases
+        const cutest_dep_barrier_t* psCause = CuTestDependFailed(psGraph, psBarrier->ulPos);
+        psBarrier->bFailed = 1;
+        psBarrier->bSkipped = 1;
+        if (psCause != NULL) psBarrier->pszCause = (psCause->pszCause != NULL) ? psCause->pszCause : psCause->pszDep;
+      }
+    }
+
+    if (++psBarrier->ulRange < psBarrier->ulNumDep) psBarrier->ulPos = pulDep[2u * psBarrier->ulRange];
+  }
+}
+
+
+/*- Test dependencies --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Resolve the declared dependencies for a test run
+ *
+ * Reorders the test cases within each root item. Must be called before the
+ * test case indices are used, also by distributed workers. Dependencies on
+ * items not part of the test run are reported and ignored. Cycles are
+ * reported, and leave the test cases in declaration order.
+ *
+ * @param[in] psRoot      Test run root
+ * @param[inout] psRun    Test cases in declaration order
+ * @return  (_Bool)  false, if the dependencies form a cycle
+ * @date  17.10.2026
+ * @date  17.10.2026  Return cycles instead of exiting
+ ******************************************************************************/
+_Bool CuTestDependResolve(const cutest_root_ptr_t psRoot, cutest_run_list_t* psRun)
+{
+  assert(psRoot != NULL);
+  assert(psRun != NULL);
+
+  psRun->psDepend = NULL;
+  if (psRoot->ulNumDepends == 0u) return 1;
+
+  // Test case range below each node, from the test case nodes up
+  const unsigned long ulCount = psRun->ulCount;
+  unsigned long* pulNodeRange = malloc((2u * psRoot->ulNumNodes + 1u) * sizeof(unsigned long));
+  unsigned long* pulCaseItem = malloc((ulCount + 1u) * sizeof(unsigned long));
+  assert((pulNodeRange != NULL) && (pulCaseItem != NULL));
+  for (unsigned long j = 0; j < psRoot->ulNumNodes; ++j)
+  {
+    pulNodeRange[2u * j] = ULONG_MAX;
+    pulNodeRange[2u * j + 1u] = 0u;
+  }
+  for (unsigned long c = 0; c < ulCount; ++c) pulCaseItem[psRun->ppsCases[c] - psRoot->psResults] = c;
+  for (unsigned long j = 0; j < psRoot->ulNumNodes; ++j)
+  {
+    if (psRoot->psNodes[j].psResult == NULL) continue;
+    const unsigned long c = pulCaseItem[psRoot->psNodes[j].psResult - psRoot->psResults];
+    for (unsigned long k = j; k != ULONG_MAX; k = psRoot->psNodes[k].ulParent)
+    {
+      if (c < pulNodeRange[2u * k]) pulNodeRange[2u * k] = c;
+      if (c >= pulNodeRange[2u * k + 1u]) pulNodeRange[2u * k + 1u] = c + 1u;
+    }
+  }
+
+  cutest_dep_graph_t* psGraph = calloc(1u, sizeof(cutest_dep_graph_t));
+  assert(psGraph != NULL);
+  psGraph->psBarriers = calloc(psRoot->ulNumDepends, sizeof(cutest_dep_barrier_t));
+  assert(psGraph->psBarriers != NULL);
+
+  // Dependencies with test cases on both sides
+  unsigned long ulNumRanges = 0u;
+  for (unsigned long d = 0; d < psRoot->ulNumDepends; ++d)
+  {
+    const cutest_depend_t* psDecl = &psRoot->psDepends[d];
+    const char* pszItem = NULL;
+    const char* pszDep = NULL;
+    unsigned long ulNumItem = CuTestDependRanges(psRoot, &psDecl->sItem, pulNodeRange, NULL, &pszItem);
+    unsigned long ulNumDep = CuTestDependRanges(psRoot, &psDecl->sDep, pulNodeRange, NULL, &pszDep);
+    if ((pszItem != NULL) && (pszDep == NULL))
+    {
+      fprintf(stderr, "CuTest: dependency %s of %s is not part of the test run, ignored\n", CuTestNodeName(&(cutest_node_t){ .sItem = psDecl->sDep }), pszItem);
+    }
+    if ((ulNumItem == 0u) || (ulNumDep == 0u)) continue;
+
+    psGraph->psBarriers[psGraph->ulNumBarriers++] = (cutest_dep_barrier_t){
+      .psDecl = psDecl,
+      .pszItem = pszItem,
+      .pszDep = pszDep,
+      .ulFirst = ulNumRanges,
+      .ulNumItem = ulNumItem,
+      .ulNumDep = ulNumDep
+    };
+    ulNumRanges += ulNumItem + ulNumDep;
+  }
+  if (psGraph->ulNumBarriers == 0u)
+  {
+    free(psGraph->psBarriers);
+    free(psGraph);
+    free(pulNodeRange);
+    free(pulCaseItem);
+    return 1;
+  }
+
+  psGraph->pulRanges = malloc((2u * ulNumRanges + 1u) * sizeof(unsigned long));
+  assert(psGraph->pulRanges != NULL);
+  for (unsigned long b = 0; b < psGraph->ulNumBarriers; ++b)
+  {
+    cutest_dep_barrier_t* psBarrier = &psGraph->psBarriers[b];
+    unsigned long* pulItem = &psGraph->pulRanges[2u * psBarrier->ulFirst];
+    CuTestDependRanges(psRoot, &psBarrier->psDecl->sItem, pulNodeRange, pulItem, &psBarrier->pszItem);
+    CuTestDependRanges(psRoot, &psBarrier->psDecl->sDep, pulNodeRange, &pulItem[2u * psBarrier->ulNumItem], &psBarrier->pszDep);
+    psBarrier->ulPos = pulItem[2u * psBarrier->ulNumItem];
+  }
+  free(pulNodeRange);
+
+  // Dependencies of each test case
+  psGraph->pulCaseFirst = calloc(ulCount + 2u, sizeof(unsigned long));
+  assert(psGraph->pulCaseFirst != NULL);
+  for (int iPass = 0; iPass < 2; ++iPass)
+  {
+    for (unsigned long b = 0; b < psGraph->ulNumBarriers; ++b)
+    {
+      const cutest_dep_barrier_t* psBarrier = &psGraph->psBarriers[b];
+      const unsigned long* pulItem = &psGraph->pulRanges[2u * psBarrier->ulFirst];
+      for (unsigned long r = 0; r < psBarrier->ulNumItem; ++r)
+      {
+        for (unsigned long c = pulItem[2u * r]; c < pulItem[2u * r + 1u]; ++c)
+        {
+          if (iPass == 0) psGraph->pulCaseFirst[c + 2u]++;
+          else psGraph->pulCaseDeps[psGraph->pulCaseFirst[c + 1u]++] = b;
+        }
+      }
+    }
+    if (iPass > 0) break;
+
+    for (unsigned long c = 0; c < ulCount; ++c) psGraph->pulCaseFirst[c + 2u] += psGraph->pulCaseFirst[c + 1u];
+    psGraph->pulCaseDeps = malloc((psGraph->pulCaseFirst[ulCount + 1u] + 1u) * sizeof(unsigned long));
+    assert(psGraph->pulCaseDeps != NULL);
+  }
+
+  // Root items in dependency order, then test cases within each root item
+  for (unsigned long u = 0; u < psRun->ulItems; ++u)
+  {
+    for (unsigned long c = psRun->pulItemStart[u]; c < psRun->pulItemStart[u + 1u]; ++c) pulCaseItem[c] = u;
+  }
+  psGraph->pulItemOrder = malloc((psRun->ulItems + 1u) * sizeof(unsigned long));
+  psGraph->pbItemDone = calloc(psRun->ulItems + 1u, sizeof(_Bool));
+  assert((psGraph->pulItemOrder != NULL) && (psGraph->pbItemDone != NULL));
+  psRun->psDepend = psGraph;
+  if (!CuTestDependSortItems(psRoot, psGraph, pulCaseItem, psRun->ulItems))
+  {
+    free(pulCaseItem);
+    CuTestDependRelease(psRun);
+    return 0;
+  }
+
+  unsigned long* pulOrder = malloc((ulCount + 1u) * sizeof(unsigned long));
+  unsigned long* pulSlot = malloc((psRun->ulItems + 1u) * sizeof(unsigned long));
+  psGraph->ppsCases = malloc((ulCount + 1u) * sizeof(cutest_case_ptr_t));
+  psGraph->pulDecl = malloc((ulCount + 1u) * sizeof(unsigned long));
+  assert((pulOrder != NULL) && (pulSlot != NULL) && (psGraph->ppsCases != NULL) && (psGraph->pulDecl != NULL));
+  if (!CuTestDependSortCases(psGraph, ulCount, pulOrder))
+  {
+    free(pulOrder);
+    free(pulSlot);
+    free(pulCaseItem);
+    CuTestDependRelease(psRun);
+    return 0;
+  }
+
+  memcpy(psGraph->ppsCases, psRun->ppsCases, ulCount * sizeof(cutest_case_ptr_t));
+  memcpy(pulSlot, psRun->pulItemStart, psRun->ulItems * sizeof(unsigned long));
+  for (unsigned long k = 0; k < ulCount; ++k)
+  {
+    const unsigned long c = pulOrder[k];
+    const unsigned long i = pulSlot[pulCaseItem[c]]++;
+    psRun->ppsCases[i] = psGraph->ppsCases[c];
+    psGraph->pulDecl[i] = c;
+  }
+
+  free(pulOrder);
+  free(pulSlot);
+  free(pulCaseItem);
+  return 1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Release the resolved dependencies of a test run
+ *
+ * @param[inout] psRun    Test cases
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestDependRelease(cutest_run_list_t* psRun)
+{
+  assert(psRun != NULL);
+
+  cutest_dep_graph_t* psGraph = psRun->psDepend;
+  if (psGraph == NULL) return;
+
+  free(psGraph->ppsCases);
+  free(psGraph->pulDecl);
+  free(psGraph->psBarriers);
+  free(psGraph->pulRanges);
+  free(psGraph->pulCaseFirst);
+  free(psGraph->pulCaseDeps);
+  free(psGraph->pulItemOrder);
+  free(psGraph->pulItemFirst);
+  free(psGraph->pulItemDeps);
+  free(psGraph->pbItemDone);
+  free(psGraph);
+  psRun->psDepend = NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get a root item in dependency order
+ *
+ * @param[in] psRun       Test cases
+ * @param[in] ulPos       Position in dependency order
+ * @return  (unsigned long)  Root item
+ * @date  17.10.2026
+ ******************************************************************************/
+unsigned long CuTestDependItem(const cutest_run_list_t* psRun, unsigned long ulPos)
+{
+  assert(psRun != NULL);
+
+  return (psRun->psDepend != NULL) ? psRun->psDepend->pulItemOrder[ulPos] : ulPos;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if all root items a root item depends on are finished
+ *
+ * @param[in] psRun       Test cases
+ * @param[in] ulItem      Root item
+ * @return  (_Bool)  true, if the root item may be started
+ * @date  17.10.2026
+ ******************************************************************************/
+_Bool CuTestDependItemReady(const cutest_run_list_t* psRun, unsigned long ulItem)
+{
+  assert(psRun != NULL);
+
+  cutest_dep_graph_t* psGraph = psRun->psDepend;
+  if (psGraph == NULL) return 1;
+
+  for (unsigned long k = psGraph->pulItemFirst[ulItem]; k < psGraph->pulItemFirst[ulItem + 1u]; ++k)
+  {
+    const unsigned long ulDep = psGraph->pulItemDeps[k];
+    if (psGraph->pbItemDone[ulDep]) continue;
+    for (unsigned long i = psRun->pulItemStart[ulDep]; i < psRun->pulItemStart[ulDep + 1u]; ++i)
+    {
+      if (psRun->ppsCases[i]->eResult == EN_CUTEST_RESULT_UNDEF) return 0;
+    }
+    psGraph->pbItemDone[ulDep] = 1;
+  }
+
+  return 1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if all test cases a test case depends on are finished
+ *
+ * @param[in] psRun       Test cases
+ * @param[in] ulCase      Test case index
+ * @return  (_Bool)  true, if the test case may be run or skipped
+ * @date  17.10.2026
+ ******************************************************************************/
+_Bool CuTestDependReady(const cutest_run_list_t* psRun, unsigned long ulCase)
+{
+  assert(psRun != NULL);
+
+  cutest_dep_graph_t* psGraph = psRun->psDepend;
+  if (psGraph == NULL) return 1;
+
+  const unsigned long c = psGraph->pulDecl[ulCase];
+  for (unsigned long k = psGraph->pulCaseFirst[c]; k < psGraph->pulCaseFirst[c + 1u]; ++k)
+  {
+    cutest_dep_barrier_t* psBarrier = &psGraph->psBarriers[psGraph->pulCaseDeps[k]];
+    CuTestDependUpdate(psGraph, psBarrier);
+    if (psBarrier->ulRange < psBarrier->ulNumDep) return 0;
+  }
+
+  return 1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Skip a test case if one of its dependencies failed
+ *
+ * The test case is marked as not run, with the failed dependency as message,
+ * and counted as finished. If the dependency was skipped itself, the failed
+ * item causing it is named as well.
+ *
+ * @param[in] psRun       Test cases
+ * @param[in] ulCase      Test case index
+ * @return  (_Bool)  true, if the test case was skipped
+ * @date  17.10.2026
+ * @date  17.10.2026  Name the failed item causing a transitive skip
+ ******************************************************************************/
+_Bool CuTestDependSkip(const cutest_run_list_t* psRun, unsigned long ulCase)
+{
+  assert(psRun != NULL);
+
+  cutest_dep_graph_t* psGraph = psRun->psDepend;
+  if (psGraph == NULL) return 0;
+
+  const unsigned long c = psGraph->pulDecl[ulCase];
+  for (unsigned long k = psGraph->pulCaseFirst[c]; k < psGraph->pulCaseFirst[c + 1u]; ++k)
+  {
+    cutest_dep_barrier_t* psBarrier = &psGraph->psBarriers[psGraph->pulCaseDeps[k]];
+    CuTestDependUpdate(psGraph, psBarrier);
+    if (!psBarrier->bFailed) continue;
+
+    cutest_case_ptr_t psTc = psRun->ppsCases[ulCase];
+    psTc->eResult = EN_CUTEST_RESULT_SKIP;
+    if (!psBarrier->bSkipped) snprintf(psTc->acMessage, sizeof(psTc->acMessage), "dependency %s failed", psBarrier->pszDep);
+    else if (psBarrier->pszCause == NULL) snprintf(psTc->acMessage, sizeof(psTc->acMessage), "dependency %s skipped", psBarrier->pszDep);
+    else snprintf(psTc->acMessage, sizeof(psTc->acMessage), "dependency %s skipped, %s failed", psBarrier->pszDep, psBarrier->pszCause);
+    psTc->pszMsgFile = psTc->pszFile;
+    psTc->ulMsgLine = psTc->ulLine;
+    psTc->ullDuration = 0u;
+    if (psTc->bPrintResult) printf("%s:%ld:0: info: %s skipped: %s.\n", psTc->pszFile, psTc->ulLine, psTc->pszName, psTc->acMessage);
+    CuTestCountResult(psTc);
+    return 1;
+  }
+
+  return 0;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if a test case was skipped due to a failed dependency
+ *
+ * @param[in] psTc        Test case data
+ * @return  (_Bool)  true, if skipped
+ * @date  17.10.2026
+ ******************************************************************************/
+_Bool CuTestDependSkipped(const cutest_case_ptr_t psTc)
+{
+  assert(psTc != NULL);
+
+  return (psTc->eResult == EN_CUTEST_RESULT_SKIP) && (psTc->acMessage[0] != '\0');
+}
+
+
+/*- Test run setup -----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Declare a dependency between two test items
+ *
+ * The test cases below pItem are run after all test cases below pDep, and
+ * skipped if one of these failed or was skipped due to a failed dependency.
+ * Must be declared before the test run starts, and before any item is run on
+ * the spot by CuTest_RunRootItem.
+ *
+ * @param[inout] psRoot   Test run root
+ * @param[in] eType       Type of the dependent item
+ * @param[in] *pItem      Dependent test case, group, module or suite
+ * @param[in] eDepType    Type of the item depended on
+ * @param[in] *pDep       Test case, group, module or suite depended on
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_AddDependency(cutest_root_ptr_t psRoot, cutest_type_t eType, void* pItem, cutest_type_t eDepType, void* pDep)
+{
+  assert(psRoot != NULL);
+  assert(pItem != NULL);
+  assert(pDep != NULL);
+
+  if (psRoot->ulNumDone > 0u) fprintf(stderr, "CuTest: dependency declared after test items were run, declare it before RUN_TEST_...()\n");
+
+  // The list grows by doubling, once the initial length is reached
+  const unsigned long ulNum = psRoot->ulNumDepends;
+  if ((ulNum == 0u) || ((ulNum >= CUTEST_DEPEND_INIT) && ((ulNum & (ulNum - 1u)) == 0u)))
+  {
+    unsigned long ulMax = (ulNum == 0u) ? CUTEST_DEPEND_INIT : 2u * ulNum;
+    cutest_depend_t* psDepends = realloc(psRoot->psDepends, ulMax * sizeof(cutest_depend_t));
+    assert(psDepends != NULL);
+    psRoot->psDepends = psDepends;
+  }
+
+  psRoot->psDepends[ulNum] = (cutest_depend_t){
+    .sItem = { .eType = eType, .pItem = pItem },
+    .sDep = { .eType = eDepType, .pItem = pDep }
+  };
+  psRoot->ulNumDepends = ulNum + 1u;
+}
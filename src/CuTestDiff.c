@@ -0,0 +1,179 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestDiff.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - differential testing
+ *
+ * Checks an optimized implementation against a simple reference one: both are
+ * run on the same generated inputs (edge cases first, then random ones) and
+ * their outputs compared. Both are timed on the full input set, the faster of
+ * several passes is used for the speedup. This source file is licensed under
+ * The MIT License. See https://opensource.org/license/mit/ for full license
+ * text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <assert.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "CuTestPrivate.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Default number of inputs                                                  */
+#define CUTEST_DIFF_INPUTS            1000u
+
+/*! Number of timed passes over all inputs, per implementation                */
+#define CUTEST_DIFF_PASSES            5u
+
+/*! Default random seed                                                       */
+#define CUTEST_DIFF_SEED              0x9E3779B97F4A7C15ull
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static uint64_t CuTestDiffTime(cutest_diff_fn_t pfvFn, const uint8_t* pucIn, uint8_t* pucOut, const cutest_diff_t* psDiff, unsigned long ulInputs);
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Run an implementation on all inputs
+ *
+ * @param[in] pfvFn       Implementation
+ * @param[in] *pucIn      Inputs
+ * @param[out] *pucOut    Outputs
+ * @param[in] psDiff      Differential test configuration
+ * @param[in] ulInputs    Number of inputs
+ * @return  (uint64_t)  Run time [ns]
+ * @date  17.10.2026
+ ******************************************************************************/
+static uint64_t CuTestDiffTime(cutest_diff_fn_t pfvFn, const uint8_t* pucIn, uint8_t* pucOut, const cutest_diff_t* psDiff, unsigned long ulInputs)
+{
+  struct timespec sStart, sEnd;
+  clock_gettime(CLOCK_MONOTONIC, &sStart);
+  for (unsigned long i = 0; i < ulInputs; ++i) pfvFn(&pucIn[i * psDiff->uInSize], &pucOut[i * psDiff->uOutSize]);
+  clock_gettime(CLOCK_MONOTONIC, &sEnd);
+
+  return (uint64_t)(sEnd.tv_sec - sStart.tv_sec) * 1000000000ull + (uint64_t)sEnd.tv_nsec - (uint64_t)sStart.tv_nsec;
+}
+
+
+/*- Differential testing -----------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Get the next pseudo-random number (SplitMix64)
+ *
+ * @param[inout] pullRng  Generator state
+ * @return  (uint64_t)  Random number
+ * @date  17.10.2026
+ ******************************************************************************/
+uint64_t CuTest_Random(uint64_t* pullRng)
+{
+  assert(pullRng != NULL);
+
+  uint64_t z = (*pullRng += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Evaluate a differential test
+ *
+ * Each input is generated from its own generator state, derived from the seed
+ * and the input index, so that a diverging input can be reproduced alone. On
+ * success, the speedup is kept as diagnostic message.
+ *
+ * @note longjmp on diverging outputs, or a speedup below the minimum
+ * @param[in] psTc        Test case data
+ * @param[in] *pszFile    File name
+ * @param[in] ulLine      Line number
+ * @param[in] psDiff      Differential test configuration
+ * @param[in] pfvRef      Reference implementation
+ * @param[in] pfvOpt      Optimized implementation
+ * @param[in] pfvGen      Input generator
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_EvalDiff(cutest_case_ptr_t psTc, const char* pszFile, unsigned long ulLine, const cutest_diff_t* psDiff, cutest_diff_fn_t pfvRef, cutest_diff_fn_t pfvOpt, cutest_diff_gen_t pfvGen)
+{
+  assert(psTc != NULL);
+  assert(pszFile != NULL);
+  assert(psDiff != NULL);
+  assert(pfvRef != NULL);
+  assert(pfvOpt != NULL);
+  assert(pfvGen != NULL);
+  assert((psDiff->uInSize > 0u) && (psDiff->uOutSize > 0u));
+
+  const unsigned long ulInputs = (psDiff->ulInputs > 0u) ? psDiff->ulInputs : CUTEST_DIFF_INPUTS;
+  const uint64_t ullSeed = (psDiff->ullSeed != 0u) ? psDiff->ullSeed : CUTEST_DIFF_SEED;
+
+  // Outputs are cleared, so that bytes not written by either compare equal
+  uint8_t* pucIn = calloc(ulInputs, psDiff->uInSize);
+  uint8_t* pucRef = calloc(ulInputs, psDiff->uOutSize);
+  uint8_t* pucOpt = calloc(ulInputs, psDiff->uOutSize);
+  if ((pucIn == NULL) || (pucRef == NULL) || (pucOpt == NULL))
+  {
+    free(pucIn);
+    free(pucRef);
+    free(pucOpt);
+    CuTestFail(psTc, pszFile, ulLine, "Differential test: cannot allocate <%lu> inputs", ulInputs);
+  }
+
+  for (unsigned long i = 0; i < ulInputs; ++i)
+  {
+    uint64_t ullRng = ullSeed + i;
+    pfvGen(i, &ullRng, &pucIn[i * psDiff->uInSize]);
+  }
+
+  // Alternate implementations, keep the fastest pass of each
+  uint64_t ullRefTime = UINT64_MAX;
+  uint64_t ullOptTime = UINT64_MAX;
+  unsigned long ulDiverging = ULONG_MAX;
+  for (unsigned uPass = 0u; uPass < CUTEST_DIFF_PASSES; ++uPass)
+  {
+    uint64_t ullTime = CuTestDiffTime(pfvRef, pucIn, pucRef, psDiff, ulInputs);
+    if (ullTime < ullRefTime) ullRefTime = ullTime;
+    ullTime = CuTestDiffTime(pfvOpt, pucIn, pucOpt, psDiff, ulInputs);
+    if (ullTime < ullOptTime) ullOptTime = ullTime;
+
+    if (uPass > 0u) continue;
+    for (unsigned long i = 0; (i < ulInputs) && (ulDiverging == ULONG_MAX); ++i)
+    {
+      const uint8_t* pucRefOut = &pucRef[i * psDiff->uOutSize];
+      const uint8_t* pucOptOut = &pucOpt[i * psDiff->uOutSize];
+      _Bool bEqual = (psDiff->pfbEqual != NULL) ? psDiff->pfbEqual(pucRefOut, pucOptOut) : (memcmp(pucRefOut, pucOptOut, psDiff->uOutSize) == 0);
+      if (!bEqual) ulDiverging = i;
+    }
+    if (ulDiverging != ULONG_MAX) break;
+  }
+
+  free(pucIn);
+  free(pucRef);
+  free(pucOpt);
+
+  if (ulDiverging != ULONG_MAX)
+  {
+    CuTestFail(psTc, pszFile, ulLine, "Differential test: outputs differ for input <%lu> (%s, seed <0x%016llX>)", ulDiverging, (ulDiverging < psDiff->ulEdgeCases) ? "edge case" : "random", (unsigned long long)ullSeed);
+  }
+
+  double dSpeedup = (double)ullRefTime / (double)((ullOptTime > 0u) ? ullOptTime : 1u);
+  if ((psDiff->dMinSpeedup > 0.0) && (dSpeedup < psDiff->dMinSpeedup))
+  {
+    CuTestFail(psTc, pszFile, ulLine, "Differential test: speedup <%.2f> below minimum <%.2f> (reference %.3f ms, optimized %.3f ms)", dSpeedup, psDiff->dMinSpeedup, (double)ullRefTime / 1e6, (double)ullOptTime / 1e6);
+  }
+
+  snprintf(psTc->acMessage, sizeof(psTc->acMessage), "equivalent on %lu inputs, speedup %.2f (reference %.3f ms, optimized %.3f ms)", ulInputs, dSpeedup, (double)ullRefTime / 1e6, (double)ullOptTime / 1e6);
+  CuTestPass(psTc);
+}
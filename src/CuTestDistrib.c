@@ -0,0 +1,466 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestDistrib.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - distributed execution
+ *
+ * A coordinator process owns the test case list and hands out single test
+ * cases to worker processes connecting over a TCP or Unix domain socket.
+ * Workers are instances of the same test runner, started with --worker. Each
+ * worker pulls the next test case after returning the result of the previous
+ * one. The results are merged into the summary and report of the coordinator.
+ * This source file is licensed under The MIT License. See
+ * https://opensource.org/license/mit/ for full license text.
+ *
+ * Addresses: unix:<path>, tcp:<host>:<port> or <host>:<port>
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "CuTestPrivate.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Worker greeting magic                                                     */
+#define CUTEST_DISTRIB_MAGIC          0x57547543ul
+
+/*! Coordinator reply: no more test cases                                     */
+#define CUTEST_DISTRIB_DONE           0xFFFFFFFFul
+
+/*! Max. number of connected workers                                          */
+#define CUTEST_DISTRIB_MAX_WORKERS    256u
+
+/*! Value for idle connections                                                */
+#define CUTEST_DISTRIB_IDLE           ((unsigned long)-1)
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! Worker greeting, identifies the test runner build                         */
+typedef struct tag_cutest_distrib_hello_t
+{
+  uint32_t ulMagic;                 ///< CUTEST_DISTRIB_MAGIC
+  uint32_t ulNumCases;              ///< Number of test cases of the runner
+  uint64_t ullHash;                 ///< Hash of the test case names, in order
+} cutest_distrib_hello_t;
+
+/*! Coordinator-side worker connection                                        */
+typedef struct tag_cutest_distrib_conn_t
+{
+  int iFd;                          ///< Socket, -1 if unused
+  _Bool bGreeted;                   ///< Greeting received
+  unsigned long ulCase;             ///< Test case in flight
+  char* pcBuf;                      ///< Received data
+  size_t uLen;                      ///< Received length
+} cutest_distrib_conn_t;
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static int   CuTestDistribSocket(const char* pszAddress, _Bool bListen);
+static _Bool CuTestDistribSend(int iFd, const void* pData, size_t uLen);
+static _Bool CuTestDistribRecv(int iFd, void* pData, size_t uLen);
+static void  CuTestDistribAssign(cutest_distrib_conn_t* psConn, const cutest_run_list_t* psRun, unsigned long* pulOrder, unsigned long ulNumOrder, unsigned long* pulNext, unsigned long* pulDone);
+static void  CuTestDistribDrop(cutest_distrib_conn_t* psConn, const cutest_run_list_t* psRun);
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Create a listening or connected socket
+ *
+ * @param[in] *pszAddress Address (unix:<path>, [tcp:]<host>:<port>)
+ * @param[in] bListen     Listen (coordinator) instead of connect (worker)
+ * @return  (int)  Socket, -1 on error
+ * @date  17.10.2026
+ ******************************************************************************/
+static int CuTestDistribSocket(const char* pszAddress, _Bool bListen)
+{
+  assert(pszAddress != NULL);
+
+  // Unix domain socket
+  if (strncmp(pszAddress, "unix:", 5u) == 0)
+  {
+    struct sockaddr_un sAddr = { .sun_family = AF_UNIX };
+    if (strlen(&pszAddress[5]) >= sizeof(sAddr.sun_path)) return -1;
+    strcpy(sAddr.sun_path, &pszAddress[5]);
+
+    int iFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (iFd < 0) return -1;
+
+    if (bListen) unlink(sAddr.sun_path);
+    int iRet = bListen ? bind(iFd, (struct sockaddr*)&sAddr, sizeof(sAddr)) : connect(iFd, (struct sockaddr*)&sAddr, sizeof(sAddr));
+    if ((iRet == 0) && bListen) iRet = listen(iFd, SOMAXCONN);
+    if (iRet != 0)
+    {
+      close(iFd);
+      return -1;
+    }
+    return iFd;
+  }
+
+  // TCP socket, host name optional for listening
+  if (strncmp(pszAddress, "tcp:", 4u) == 0) pszAddress += 4;
+  const char* pszPort = strrchr(pszAddress, ':');
+  if (pszPort == NULL) return -1;
+
+  char* pszHost = strndup(pszAddress, (size_t)(pszPort - pszAddress));
+  if (pszHost == NULL) return -1;
+
+  struct addrinfo sHints = { .ai_family = AF_UNSPEC, .ai_socktype = SOCK_STREAM, .ai_flags = bListen ? AI_PASSIVE : 0 };
+  struct addrinfo* psInfo = NULL;
+  int iErr = getaddrinfo((pszHost[0] != '\0') ? pszHost : NULL, pszPort + 1, &sHints, &psInfo);
+  free(pszHost);
+  if (iErr != 0) return -1;
+
+  int iFd = -1;
+  for (const struct addrinfo* p = psInfo; (p != NULL) && (iFd < 0); p = p->ai_next)
+  {
+    iFd = socket(p->ai_family, p->ai_socktype | SOCK_CLOEXEC, p->ai_protocol);
+    if (iFd < 0) continue;
+
+    int iOne = 1;
+    int iRet;
+    if (bListen)
+    {
+      setsockopt(iFd, SOL_SOCKET, SO_REUSEADDR, &iOne, sizeof(iOne));
+      iRet = bind(iFd, p->ai_addr, p->ai_addrlen);
+      if (iRet == 0) iRet = listen(iFd, SOMAXCONN);
+    }
+    else
+    {
+      iRet = connect(iFd, p->ai_addr, p->ai_addrlen);
+      if (iRet == 0) setsockopt(iFd, IPPROTO_TCP, TCP_NODELAY, &iOne, sizeof(iOne));
+    }
+    if (iRet != 0)
+    {
+      close(iFd);
+      iFd = -1;
+    }
+  }
+  freeaddrinfo(psInfo);
+
+  return iFd;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Send data completely
+ *
+ * @param[in] iFd         Socket
+ * @param[in] *pData      Data
+ * @param[in] uLen        Data length
+ * @return  (_Bool)  true on success
+ * @date  17.10.2026
+ ******************************************************************************/
+static _Bool CuTestDistribSend(int iFd, const void* pData, size_t uLen)
+{
+  const char* p = pData;
+  while (uLen > 0u)
+  {
+    ssize_t iRet = send(iFd, p, uLen, MSG_NOSIGNAL);
+    if ((iRet < 0) && (errno == EINTR)) continue;
+    if (iRet <= 0) return 0;
+    p += iRet;
+    uLen -= (size_t)iRet;
+  }
+
+  return 1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Receive data completely
+ *
+ * @param[in] iFd         Socket
+ * @param[out] *pData     Data
+ * @param[in] uLen        Data length
+ * @return  (_Bool)  true on success, false on error or connection closed
+ * @date  17.10.2026
+ ******************************************************************************/
+static _Bool CuTestDistribRecv(int iFd, void* pData, size_t uLen)
+{
+  char* p = pData;
+  while (uLen > 0u)
+  {
+    ssize_t iRet = recv(iFd, p, uLen, 0);
+    if ((iRet < 0) && (errno == EINTR)) continue;
+    if (iRet <= 0) return 0;
+    p += iRet;
+    uLen -= (size_t)iRet;
+  }
+
+  return 1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Hand out the next test case to a worker, or tell it to finish if all
+ * test cases were handed out or a stop was requested
+ *
+ * The next test case is the first one in dispatch order whose dependencies
+ * are finished. Test cases with a failed dependency are skipped on the way.
+ * The worker is left idle if no remaining test case is ready yet.
+ *
+ * @param[inout] psConn   Worker connection
+ * @param[in] psRun       Test cases
+ * @param[inout] *pulOrder Test case dispatch order
+ * @param[in] ulNumOrder  Number of test cases to dispatch
+ * @param[inout] *pulNext Next test case in dispatch order
+ * @param[inout] *pulDone Number of finished test cases
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestDistribAssign(cutest_distrib_conn_t* psConn, const cutest_run_list_t* psRun, unsigned long* pulOrder, unsigned long ulNumOrder, unsigned long* pulNext, unsigned long* pulDone)
+{
+  uint32_t ulMsg = CUTEST_DISTRIB_DONE;
+  psConn->ulCase = CUTEST_DISTRIB_IDLE;
+  while ((*pulNext < ulNumOrder) && !CuTestStopRequested())
+  {
+    unsigned long j = *pulNext;
+    while ((j < ulNumOrder) && !CuTestDependReady(psRun, pulOrder[j])) ++j;
+    if (j == ulNumOrder) return;
+
+    const unsigned long ulCase = pulOrder[j];
+    memmove(&pulOrder[*pulNext + 1u], &pulOrder[*pulNext], (j - *pulNext) * sizeof(unsigned long));
+    pulOrder[(*pulNext)++] = ulCase;
+    if (CuTestDependSkip(psRun, ulCase))
+    {
+      (*pulDone)++;
+      continue;
+    }
+
+    psConn->ulCase = ulCase;
+    ulMsg = (uint32_t)ulCase;
+    break;
+  }
+
+  if (!CuTestDistribSend(psConn->iFd, &ulMsg, sizeof(ulMsg)) && (psConn->ulCase != CUTEST_DISTRIB_IDLE))
+  {
+    // Re-queue on send failure, the connection is dropped on the next poll
+    (*pulNext)--;
+    psConn->ulCase = CUTEST_DISTRIB_IDLE;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Close a worker connection. A test case in flight is marked as failed,
+ * since it may have terminated the worker.
+ *
+ * @param[inout] psConn   Worker connection
+ * @param[in] psRun       Test cases
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestDistribDrop(cutest_distrib_conn_t* psConn, const cutest_run_list_t* psRun)
+{
+  if (psConn->ulCase != CUTEST_DISTRIB_IDLE)
+  {
+    cutest_case_ptr_t psCase = psRun->ppsCases[psConn->ulCase];
+    psCase->eResult = EN_CUTEST_RESULT_FAIL;
+    psCase->pszMsgFile = psCase->pszFile;
+    psCase->ulMsgLine = psCase->ulLine;
+    snprintf(psCase->acMessage, sizeof(psCase->acMessage), "Worker connection lost");
+    CuTestCountResult(psCase);
+  }
+
+  close(psConn->iFd);
+  free(psConn->pcBuf);
+  *psConn = (cutest_distrib_conn_t){ .iFd = -1, .ulCase = CUTEST_DISTRIB_IDLE };
+}
+
+
+/*- Distributed execution ----------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Coordinator: hand out test cases to connecting workers until all results
+ * were returned, or a stop was requested. Test cases in flight at a stop are
+ * abandoned; their workers exit on the closed connection. Test cases waiting
+ * for dependencies are handed out once these are finished. Workers with a
+ * different list of test cases are rejected.
+ *
+ * @param[in] *pszAddress Listening address
+ * @param[in] psRun       Test cases
+ * @param[inout] *pulOrder Test case dispatch order
+ * @param[in] ulNumOrder  Number of test cases to dispatch
+ * @return  (_Bool)  false, if the listening socket could not be created
+ * @date  17.10.2026
+ * @date  17.10.2026  Check the test case names of workers
+ ******************************************************************************/
+_Bool CuTestRunCoordinator(const char* pszAddress, const cutest_run_list_t* psRun, unsigned long* pulOrder, unsigned long ulNumOrder)
+{
+  assert(psRun != NULL);
+  assert(pulOrder != NULL);
+
+  int iListen = CuTestDistribSocket(pszAddress, 1);
+  if (iListen < 0)
+  {
+    fprintf(stderr, "CuTest: cannot listen on '%s': %s\n", pszAddress, strerror(errno));
+    return 0;
+  }
+  printf("CuTest: coordinator listening on %s, %lu test cases\n", pszAddress, ulNumOrder);
+  fflush(stdout);
+
+  cutest_distrib_conn_t* asConns = calloc(CUTEST_DISTRIB_MAX_WORKERS, sizeof(cutest_distrib_conn_t));
+  struct pollfd* asPoll = calloc(CUTEST_DISTRIB_MAX_WORKERS + 1u, sizeof(struct pollfd));
+  assert((asConns != NULL) && (asPoll != NULL));
+  for (unsigned i = 0; i < CUTEST_DISTRIB_MAX_WORKERS; ++i) asConns[i] = (cutest_distrib_conn_t){ .iFd = -1, .ulCase = CUTEST_DISTRIB_IDLE };
+
+  const uint64_t ullHash = CuTestRunListHash(psRun);
+  unsigned long ulNext = 0u;
+  unsigned long ulDone = 0u;
+  while ((ulDone < ulNumOrder) && !CuTestStopRequested())
+  {
+    asPoll[0] = (struct pollfd){ .fd = iListen, .events = POLLIN };
+    for (unsigned i = 0; i < CUTEST_DISTRIB_MAX_WORKERS; ++i) asPoll[i + 1u] = (struct pollfd){ .fd = asConns[i].iFd, .events = POLLIN };
+    if (poll(asPoll, CUTEST_DISTRIB_MAX_WORKERS + 1u, -1) < 0) continue;
+
+    // New workers
+    if (asPoll[0].revents & POLLIN)
+    {
+      int iFd = accept4(iListen, NULL, NULL, SOCK_CLOEXEC);
+      unsigned i = 0;
+      while ((i < CUTEST_DISTRIB_MAX_WORKERS) && (asConns[i].iFd >= 0)) ++i;
+      if ((iFd >= 0) && (i < CUTEST_DISTRIB_MAX_WORKERS)) asConns[i] = (cutest_distrib_conn_t){ .iFd = iFd, .bGreeted = 0, .ulCase = CUTEST_DISTRIB_IDLE };
+      else if (iFd >= 0) close(iFd);
+    }
+
+    // Results
+    for (unsigned i = 0; i < CUTEST_DISTRIB_MAX_WORKERS; ++i)
+    {
+      cutest_distrib_conn_t* psConn = &asConns[i];
+      if ((psConn->iFd < 0) || !(asPoll[i + 1u].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+
+      char acChunk[4096];
+      ssize_t iRead = recv(psConn->iFd, acChunk, sizeof(acChunk), 0);
+      if ((iRead < 0) && (errno == EINTR)) continue;
+      if (iRead <= 0)
+      {
+        if (psConn->ulCase != CUTEST_DISTRIB_IDLE) ulDone++;
+        CuTestDistribDrop(psConn, psRun);
+        continue;
+      }
+
+      char* pcBuf = realloc(psConn->pcBuf, psConn->uLen + (size_t)iRead);
+      assert(pcBuf != NULL);
+      memcpy(&pcBuf[psConn->uLen], acChunk, (size_t)iRead);
+      psConn->pcBuf = pcBuf;
+      psConn->uLen += (size_t)iRead;
+
+      size_t uPos = 0u;
+      if (!psConn->bGreeted)
+      {
+        cutest_distrib_hello_t sHello;
+        if (psConn->uLen < sizeof(sHello)) continue;
+        memcpy(&sHello, psConn->pcBuf, sizeof(sHello));
+        uPos = sizeof(sHello);
+        if ((sHello.ulMagic != CUTEST_DISTRIB_MAGIC) || (sHello.ulNumCases != psRun->ulCount) || (sHello.ullHash != ullHash))
+        {
+          fprintf(stderr, "CuTest: rejected worker running a different test runner\n");
+          CuTestDistribDrop(psConn, psRun);
+          continue;
+        }
+        psConn->bGreeted = 1;
+        CuTestDistribAssign(psConn, psRun, pulOrder, ulNumOrder, &ulNext, &ulDone);
+      }
+
+      cutest_record_t sRecord;
+      size_t uRecLen;
+      while ((uRecLen = CuTestRecordParse(&psConn->pcBuf[uPos], psConn->uLen - uPos, psRun->ulCount, &sRecord)) > 0u)
+      {
+        if (uRecLen == CUTEST_RECORD_INVALID) break;
+        uPos += uRecLen;
+        if (sRecord.ulIndex != psConn->ulCase) continue;
+
+        CuTestRecordApply(&sRecord, psRun->ppsCases[sRecord.ulIndex]);
+        CuTestCountResult(psRun->ppsCases[sRecord.ulIndex]);
+        ulDone++;
+        CuTestDistribAssign(psConn, psRun, pulOrder, ulNumOrder, &ulNext, &ulDone);
+      }
+      if (uRecLen == CUTEST_RECORD_INVALID)
+      {
+        fprintf(stderr, "CuTest: rejected malformed result record from worker\n");
+        if (psConn->ulCase != CUTEST_DISTRIB_IDLE) ulDone++;
+        CuTestDistribDrop(psConn, psRun);
+        continue;
+      }
+
+      memmove(psConn->pcBuf, &psConn->pcBuf[uPos], psConn->uLen - uPos);
+      psConn->uLen -= uPos;
+    }
+
+    // Idle workers, waiting for test cases whose dependencies are now finished
+    for (unsigned i = 0; (i < CUTEST_DISTRIB_MAX_WORKERS) && (ulNext < ulNumOrder); ++i)
+    {
+      if ((asConns[i].iFd >= 0) && asConns[i].bGreeted && (asConns[i].ulCase == CUTEST_DISTRIB_IDLE)) CuTestDistribAssign(&asConns[i], psRun, pulOrder, ulNumOrder, &ulNext, &ulDone);
+    }
+  }
+
+  // Release remaining workers
+  for (unsigned i = 0; i < CUTEST_DISTRIB_MAX_WORKERS; ++i)
+  {
+    if (asConns[i].iFd < 0) continue;
+    if (asConns[i].bGreeted && (asConns[i].ulCase == CUTEST_DISTRIB_IDLE)) CuTestDistribAssign(&asConns[i], psRun, pulOrder, ulNumOrder, &ulNext, &ulDone);
+    asConns[i].ulCase = CUTEST_DISTRIB_IDLE;
+    CuTestDistribDrop(&asConns[i], psRun);
+  }
+  free(asConns);
+  free(asPoll);
+  close(iListen);
+  if (strncmp(pszAddress, "unix:", 5u) == 0) unlink(&pszAddress[5]);
+
+  return 1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Worker: run test cases handed out by the coordinator, then exit
+ *
+ * @param[in] *pszAddress Coordinator address
+ * @param[in] psRun       Test cases
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestRunWorker(const char* pszAddress, const cutest_run_list_t* psRun)
+{
+  assert(psRun != NULL);
+
+  signal(SIGPIPE, SIG_IGN);
+
+  int iFd = CuTestDistribSocket(pszAddress, 0);
+  if (iFd < 0)
+  {
+    fprintf(stderr, "CuTest: cannot connect to coordinator '%s': %s\n", pszAddress, strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+
+  cutest_distrib_hello_t sHello = { .ulMagic = CUTEST_DISTRIB_MAGIC, .ulNumCases = (uint32_t)psRun->ulCount, .ullHash = CuTestRunListHash(psRun) };
+  _Bool bOk = CuTestDistribSend(iFd, &sHello, sizeof(sHello));
+
+  uint32_t ulCase;
+  while (bOk && CuTestDistribRecv(iFd, &ulCase, sizeof(ulCase)) && (ulCase < psRun->ulCount))
+  {
+    CuTest_RunTestCase(psRun->ppsCases[ulCase]);
+    fflush(stdout);
+    bOk = CuTestRecordWrite(iFd, ulCase, psRun->ppsCases[ulCase]);
+  }
+
+  close(iFd);
+  exit(bOk ? EXIT_SUCCESS : EXIT_FAILURE);
+}
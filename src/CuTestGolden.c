@@ -0,0 +1,204 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestGolden.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - golden file assertions
+ *
+ * Compares test output against reference ("golden") files. The reference file
+ * is memory-mapped instead of being read into a buffer; file writes only occur
+ * in update mode. This source file is licensed under The MIT License. See
+ * https://opensource.org/license/mit/ for full license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "CuTestPrivate.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Environment variable enabling golden file updates                         */
+#define CUTEST_GOLDEN_UPDATE_ENV      "CUTEST_UPDATE_GOLDEN"
+
+/*! Block size for locating the first mismatch                                */
+#define CUTEST_GOLDEN_BLOCK_SIZE      4096u
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static size_t         CuTestGoldenFindMismatch(const uint8_t* pucA, const uint8_t* pucB, size_t uSize);
+static _Bool          CuTestGoldenWrite(const char* pszPath, const void* pData, size_t uSize);
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Locate the first differing byte of two buffers
+ *
+ * Blocks are compared with memcmp, only a mismatching block is scanned byte-
+ * wise.
+ *
+ * @param[in] *pucA       First buffer
+ * @param[in] *pucB       Second buffer
+ * @param[in] uSize       Number of bytes to compare
+ * @return  (size_t)  Offset of first mismatch, or uSize if equal
+ * @date  17.10.2026
+ ******************************************************************************/
+static size_t CuTestGoldenFindMismatch(const uint8_t* pucA, const uint8_t* pucB, size_t uSize)
+{
+  for (size_t uOffset = 0u; uOffset < uSize; uOffset += CUTEST_GOLDEN_BLOCK_SIZE)
+  {
+    size_t uLen = uSize - uOffset;
+    if (uLen > CUTEST_GOLDEN_BLOCK_SIZE) uLen = CUTEST_GOLDEN_BLOCK_SIZE;
+
+    if (memcmp(&pucA[uOffset], &pucB[uOffset], uLen) != 0)
+    {
+      size_t i = uOffset;
+      while (pucA[i] == pucB[i]) ++i;
+      return i;
+    }
+  }
+
+  return uSize;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Atomically replace a golden file
+ *
+ * Data is written to a temporary file in the same directory, which is then
+ * renamed onto the target path.
+ *
+ * @param[in] *pszPath    Golden file path
+ * @param[in] *pData      New file contents
+ * @param[in] uSize       Size of data in bytes
+ * @return  (_Bool)  true, if the file was replaced
+ * @date  17.10.2026
+ ******************************************************************************/
+static _Bool CuTestGoldenWrite(const char* pszPath, const void* pData, size_t uSize)
+{
+  char acTemp[CUTEST_MAX_LEN_MESSAGE];
+  if (snprintf(acTemp, sizeof(acTemp), "%s.XXXXXX", pszPath) >= (int)sizeof(acTemp)) return 0;
+
+  int fd = mkstemp(acTemp);
+  if (fd < 0) return 0;
+
+  const uint8_t* pucData = pData;
+  size_t uDone = 0u;
+  while (uDone < uSize)
+  {
+    ssize_t iRet = write(fd, &pucData[uDone], uSize - uDone);
+    if (iRet <= 0) break;
+    uDone += (size_t)iRet;
+  }
+
+  _Bool bOk = (uDone == uSize) && (fchmod(fd, 0644) == 0) && (fsync(fd) == 0);
+  bOk = (close(fd) == 0) && bOk;
+  if (bOk) bOk = (rename(acTemp, pszPath) == 0);
+  if (!bOk) unlink(acTemp);
+
+  return bOk;
+}
+
+
+/*- Result evaluation functions ----------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Evaluate data to match the contents of a golden file
+ *
+ * If the environment variable CUTEST_UPDATE_GOLDEN is set, missing or mis-
+ * matching golden files are replaced with the actual data.
+ *
+ * @note longjmp on mismatch
+ * @param[in] psTc        Test case data
+ * @param[in] *pszFile    File name
+ * @param[in] ulLine      Line number
+ * @param[in] *pszPath    Golden file path
+ * @param[in] *pActual    Actual data
+ * @param[in] uSize       Size of data in bytes
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_EvalAssertGoldenFile(cutest_case_ptr_t psTc, const char* pszFile, unsigned long ulLine, const char* pszPath, const void* pActual, size_t uSize)
+{
+  assert(psTc != NULL);
+  assert(pszFile != NULL);
+  assert(pszPath != NULL);
+  assert((pActual != NULL) || (uSize == 0u));
+
+  const char* pszUpdate = getenv(CUTEST_GOLDEN_UPDATE_ENV);
+  const _Bool bUpdate = (pszUpdate != NULL) && (pszUpdate[0] != '\0') && (strcmp(pszUpdate, "0") != 0);
+
+  // Map golden file
+  int fd = open(pszPath, O_RDONLY | O_CLOEXEC);
+  struct stat sStat;
+  _Bool bFound = (fd >= 0) && (fstat(fd, &sStat) == 0);
+  size_t uGolden = bFound ? (size_t)sStat.st_size : 0u;
+  const uint8_t* pucGolden = NULL;
+
+  if (bFound && (uGolden > 0u))
+  {
+    void* pMap = mmap(NULL, uGolden, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (pMap != MAP_FAILED) pucGolden = pMap;
+    else                    bFound = 0;
+  }
+  if (fd >= 0) close(fd);
+
+  // Compare contents
+  size_t uOffset = 0u;
+  if (bFound)
+  {
+    size_t uCommon = (uGolden < uSize) ? uGolden : uSize;
+    uOffset = CuTestGoldenFindMismatch(pucGolden, pActual, uCommon);
+  }
+
+  const _Bool bMatch = bFound && (uOffset == uSize) && (uGolden == uSize);
+  if (bMatch)
+  {
+    if (pucGolden != NULL) munmap((void*)pucGolden, uGolden);
+    CuTestPass(psTc);
+    return;
+  }
+
+  // Build mismatch message before releasing the mapping
+  char acMessage[CUTEST_MAX_LEN_MESSAGE];
+  if (!bFound)
+  {
+    snprintf(acMessage, sizeof(acMessage), "unable to open golden file <%s>", pszPath);
+  }
+  else if (uOffset < ((uGolden < uSize) ? uGolden : uSize))
+  {
+    snprintf(acMessage, sizeof(acMessage), "<%s> mismatch at offset <%zu>: expected <0x%02X>, but was <0x%02X>", pszPath, uOffset, (unsigned)pucGolden[uOffset], (unsigned)((const uint8_t*)pActual)[uOffset]);
+  }
+  else
+  {
+    snprintf(acMessage, sizeof(acMessage), "<%s> size mismatch: expected <%zu> bytes, but was <%zu>", pszPath, uGolden, uSize);
+  }
+  if (pucGolden != NULL) munmap((void*)pucGolden, uGolden);
+
+  if (bUpdate)
+  {
+    if (CuTestGoldenWrite(pszPath, pActual, uSize))
+    {
+      printf("%s:%ld:0: info: golden file %s updated.\n", pszFile, ulLine, pszPath);
+      CuTestPass(psTc);
+      return;
+    }
+
+    CuTestFail(psTc, pszFile, ulLine, "unable to update golden file <%s>", pszPath);
+  }
+
+  CuTestFail(psTc, pszFile, ulLine, "%s", acMessage);
+}
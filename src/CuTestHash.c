@@ -0,0 +1,464 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestHash.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - hash assertions
+ *
+ * CRC32C (Castagnoli) and XXH64 checksums for verifying large outputs without
+ * holding a reference copy. Both algorithms support incremental hashing of
+ * data produced in chunks. CRC32C uses the SSE4.2 or ARMv8 CRC instructions
+ * where available. This source file is licensed under The MIT License. See
+ * https://opensource.org/license/mit/ for full license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <assert.h>
+#include <string.h>
+#include "CuTestPrivate.h"
+
+#if defined(__i386__) || defined(__x86_64__)
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! CRC32C polynomial (reflected)                                             */
+#define CUTEST_CRC32C_POLY            0x82F63B78ul
+
+/*! XXH64 primes                                                              */
+#define CUTEST_XXH_PRIME1             0x9E3779B185EBCA87ull
+#define CUTEST_XXH_PRIME2             0xC2B2AE3D27D4EB4Full
+#define CUTEST_XXH_PRIME3             0x165667B19E3779F9ull
+#define CUTEST_XXH_PRIME4             0x85EBCA77C2B2AE63ull
+#define CUTEST_XXH_PRIME5             0x27D4EB2F165667C5ull
+
+/*! XXH64 stripe length                                                       */
+#define CUTEST_XXH_STRIPE             32u
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static void           CuTestCrc32cInit(void) __attribute__((constructor));
+static uint32_t       CuTestCrc32cSw(uint32_t ulCrc, const uint8_t* pucData, size_t uSize);
+static uint32_t       CuTestCrc32c(uint32_t ulCrc, const uint8_t* pucData, size_t uSize);
+static uint64_t       CuTestXxhRead64(const uint8_t* pucData);
+static uint32_t       CuTestXxhRead32(const uint8_t* pucData);
+static uint64_t       CuTestXxhRotl(uint64_t ullValue, unsigned uBits);
+static uint64_t       CuTestXxhRound(uint64_t ullAcc, uint64_t ullInput);
+static uint64_t       CuTestXxhMerge(uint64_t ullHash, uint64_t ullAcc);
+
+
+/*- Private variables --------------------------------------------------------*/
+/*! CRC32C lookup table                                                       */
+static uint32_t aulCrc32cTable[256] _PERSISTENT;
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialize the CRC32C lookup table
+ *
+ * Runs before main, so that concurrent test runs never see a partially
+ * initialized table.
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestCrc32cInit(void)
+{
+  for (uint32_t i = 0; i < 256u; ++i)
+  {
+    uint32_t ulEntry = i;
+    for (unsigned j = 0; j < 8u; ++j) ulEntry = (ulEntry >> 1) ^ ((ulEntry & 1u) ? CUTEST_CRC32C_POLY : 0u);
+    aulCrc32cTable[i] = ulEntry;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Table-driven CRC32C update
+ *
+ * @param[in] ulCrc       Running CRC (not inverted)
+ * @param[in] *pucData    Input data
+ * @param[in] uSize       Size of data in bytes
+ * @return  (uint32_t)  Updated CRC
+ * @date  17.10.2026
+ ******************************************************************************/
+static uint32_t CuTestCrc32cSw(uint32_t ulCrc, const uint8_t* pucData, size_t uSize)
+{
+  while (uSize--) ulCrc = (ulCrc >> 8) ^ aulCrc32cTable[(ulCrc ^ *pucData++) & 0xFFu];
+  return ulCrc;
+}
+
+#if defined(__i386__) || defined(__x86_64__)
+/*!****************************************************************************
+ * @brief
+ * CRC32C update using the SSE4.2 CRC32 instruction
+ *
+ * @param[in] ulCrc       Running CRC (not inverted)
+ * @param[in] *pucData    Input data
+ * @param[in] uSize       Size of data in bytes
+ * @return  (uint32_t)  Updated CRC
+ * @date  17.10.2026
+ ******************************************************************************/
+__attribute__((target("sse4.2"))) static uint32_t CuTestCrc32cHw(uint32_t ulCrc, const uint8_t* pucData, size_t uSize)
+{
+  for (; (uSize > 0u) && ((uintptr_t)pucData & 7u); --uSize) ulCrc = _mm_crc32_u8(ulCrc, *pucData++);
+
+#if defined(__x86_64__)
+  for (; uSize >= 8u; uSize -= 8u, pucData += 8u)
+  {
+    uint64_t ullWord;
+    memcpy(&ullWord, pucData, sizeof(ullWord));
+    ulCrc = (uint32_t)_mm_crc32_u64(ulCrc, ullWord);
+  }
+#endif
+  for (; uSize >= 4u; uSize -= 4u, pucData += 4u)
+  {
+    uint32_t ulWord;
+    memcpy(&ulWord, pucData, sizeof(ulWord));
+    ulCrc = _mm_crc32_u32(ulCrc, ulWord);
+  }
+
+  for (; uSize > 0u; --uSize) ulCrc = _mm_crc32_u8(ulCrc, *pucData++);
+  return ulCrc;
+}
+#elif defined(__ARM_FEATURE_CRC32)
+/*!****************************************************************************
+ * @brief
+ * CRC32C update using the ARMv8 CRC32C instructions
+ *
+ * @param[in] ulCrc       Running CRC (not inverted)
+ * @param[in] *pucData    Input data
+ * @param[in] uSize       Size of data in bytes
+ * @return  (uint32_t)  Updated CRC
+ * @date  17.10.2026
+ ******************************************************************************/
+static uint32_t CuTestCrc32cHw(uint32_t ulCrc, const uint8_t* pucData, size_t uSize)
+{
+  for (; (uSize > 0u) && ((uintptr_t)pucData & 7u); --uSize) ulCrc = __crc32cb(ulCrc, *pucData++);
+
+  for (; uSize >= 8u; uSize -= 8u, pucData += 8u)
+  {
+    uint64_t ullWord;
+    memcpy(&ullWord, pucData, sizeof(ullWord));
+    ulCrc = __crc32cd(ulCrc, ullWord);
+  }
+
+  for (; uSize > 0u; --uSize) ulCrc = __crc32cb(ulCrc, *pucData++);
+  return ulCrc;
+}
+#endif
+
+/*!****************************************************************************
+ * @brief
+ * CRC32C update, hardware-accelerated if supported
+ *
+ * @param[in] ulCrc       Running CRC (not inverted)
+ * @param[in] *pucData    Input data
+ * @param[in] uSize       Size of data in bytes
+ * @return  (uint32_t)  Updated CRC
+ * @date  17.10.2026
+ ******************************************************************************/
+static uint32_t CuTestCrc32c(uint32_t ulCrc, const uint8_t* pucData, size_t uSize)
+{
+#if defined(__i386__) || defined(__x86_64__)
+  if (__builtin_cpu_supports("sse4.2")) return CuTestCrc32cHw(ulCrc, pucData, uSize);
+#elif defined(__ARM_FEATURE_CRC32)
+  return CuTestCrc32cHw(ulCrc, pucData, uSize);
+#endif
+
+  return CuTestCrc32cSw(ulCrc, pucData, uSize);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Read unaligned little-endian 64-bit word
+ *
+ * @param[in] *pucData    Input data
+ * @return  (uint64_t)  Word value
+ * @date  17.10.2026
+ ******************************************************************************/
+static uint64_t CuTestXxhRead64(const uint8_t* pucData)
+{
+  uint64_t ullValue = 0u;
+  for (unsigned i = 0; i < 8u; ++i) ullValue |= (uint64_t)pucData[i] << (8u * i);
+  return ullValue;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Read unaligned little-endian 32-bit word
+ *
+ * @param[in] *pucData    Input data
+ * @return  (uint32_t)  Word value
+ * @date  17.10.2026
+ ******************************************************************************/
+static uint32_t CuTestXxhRead32(const uint8_t* pucData)
+{
+  uint32_t ulValue = 0u;
+  for (unsigned i = 0; i < 4u; ++i) ulValue |= (uint32_t)pucData[i] << (8u * i);
+  return ulValue;
+}
+
+/*!****************************************************************************
+ * @brief
+ * 64-bit rotate left
+ *
+ * @param[in] ullValue    Input value
+ * @param[in] uBits       Rotation (1..63)
+ * @return  (uint64_t)  Rotated value
+ * @date  17.10.2026
+ ******************************************************************************/
+static uint64_t CuTestXxhRotl(uint64_t ullValue, unsigned uBits)
+{
+  return (ullValue << uBits) | (ullValue >> (64u - uBits));
+}
+
+/*!****************************************************************************
+ * @brief
+ * XXH64 accumulator round
+ *
+ * @param[in] ullAcc      Accumulator
+ * @param[in] ullInput    Input lane
+ * @return  (uint64_t)  Updated accumulator
+ * @date  17.10.2026
+ ******************************************************************************/
+static uint64_t CuTestXxhRound(uint64_t ullAcc, uint64_t ullInput)
+{
+  ullAcc += ullInput * CUTEST_XXH_PRIME2;
+  ullAcc = CuTestXxhRotl(ullAcc, 31u);
+  return ullAcc * CUTEST_XXH_PRIME1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * XXH64 accumulator merge
+ *
+ * @param[in] ullHash     Intermediate hash
+ * @param[in] ullAcc      Accumulator
+ * @return  (uint64_t)  Updated hash
+ * @date  17.10.2026
+ ******************************************************************************/
+static uint64_t CuTestXxhMerge(uint64_t ullHash, uint64_t ullAcc)
+{
+  ullHash ^= CuTestXxhRound(0u, ullAcc);
+  return ullHash * CUTEST_XXH_PRIME1 + CUTEST_XXH_PRIME4;
+}
+
+
+/*- Hash functions -----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Initialize incremental hash calculation
+ *
+ * @param[out] psHash     Hash context
+ * @param[in] eType       Hash algorithm
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_HashInit(cutest_hash_ptr_t psHash, cutest_hash_type_t eType)
+{
+  assert(psHash != NULL);
+
+  memset(psHash, 0, sizeof(*psHash));
+  psHash->eType = eType;
+  psHash->ulCrc = 0xFFFFFFFFul;
+  psHash->aullAcc[0] = CUTEST_XXH_PRIME1 + CUTEST_XXH_PRIME2;
+  psHash->aullAcc[1] = CUTEST_XXH_PRIME2;
+  psHash->aullAcc[2] = 0u;
+  psHash->aullAcc[3] = 0u - CUTEST_XXH_PRIME1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Add data to incremental hash calculation
+ *
+ * @param[inout] psHash   Hash context
+ * @param[in] *pData      Input data
+ * @param[in] uSize       Size of data in bytes
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_HashUpdate(cutest_hash_ptr_t psHash, const void* pData, size_t uSize)
+{
+  assert(psHash != NULL);
+  assert((pData != NULL) || (uSize == 0u));
+
+  const uint8_t* pucData = pData;
+  psHash->ullTotal += uSize;
+
+  if (psHash->eType == EN_CUTEST_HASH_CRC32C)
+  {
+    psHash->ulCrc = CuTestCrc32c(psHash->ulCrc, pucData, uSize);
+    return;
+  }
+
+  // Complete buffered stripe
+  if (psHash->uBufLen > 0u)
+  {
+    size_t uFill = CUTEST_XXH_STRIPE - psHash->uBufLen;
+    if (uFill > uSize) uFill = uSize;
+    memcpy(&psHash->aucBuf[psHash->uBufLen], pucData, uFill);
+    psHash->uBufLen += uFill;
+    pucData += uFill;
+    uSize -= uFill;
+
+    if (psHash->uBufLen < CUTEST_XXH_STRIPE) return;
+    for (unsigned i = 0; i < 4u; ++i) psHash->aullAcc[i] = CuTestXxhRound(psHash->aullAcc[i], CuTestXxhRead64(&psHash->aucBuf[8u * i]));
+    psHash->uBufLen = 0u;
+  }
+
+  // Process full stripes directly from input
+  for (; uSize >= CUTEST_XXH_STRIPE; uSize -= CUTEST_XXH_STRIPE, pucData += CUTEST_XXH_STRIPE)
+  {
+    for (unsigned i = 0; i < 4u; ++i) psHash->aullAcc[i] = CuTestXxhRound(psHash->aullAcc[i], CuTestXxhRead64(&pucData[8u * i]));
+  }
+
+  memcpy(psHash->aucBuf, pucData, uSize);
+  psHash->uBufLen = uSize;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get the hash value of all data added so far
+ *
+ * The context is not modified, more data may be added afterwards.
+ *
+ * @param[in] psHash      Hash context
+ * @return  (uint64_t)  Hash value (CRC32C in the lower 32 bits)
+ * @date  17.10.2026
+ ******************************************************************************/
+uint64_t CuTest_HashFinal(const cutest_hash_ptr_t psHash)
+{
+  assert(psHash != NULL);
+
+  if (psHash->eType == EN_CUTEST_HASH_CRC32C) return psHash->ulCrc ^ 0xFFFFFFFFul;
+
+  uint64_t ullHash;
+  if (psHash->ullTotal >= CUTEST_XXH_STRIPE)
+  {
+    const uint64_t* pullAcc = psHash->aullAcc;
+    ullHash = CuTestXxhRotl(pullAcc[0], 1u) + CuTestXxhRotl(pullAcc[1], 7u) + CuTestXxhRotl(pullAcc[2], 12u) + CuTestXxhRotl(pullAcc[3], 18u);
+    for (unsigned i = 0; i < 4u; ++i) ullHash = CuTestXxhMerge(ullHash, pullAcc[i]);
+  }
+  else
+  {
+    ullHash = CUTEST_XXH_PRIME5;
+  }
+  ullHash += psHash->ullTotal;
+
+  // Remaining buffered bytes
+  const uint8_t* pucData = psHash->aucBuf;
+  size_t uSize = psHash->uBufLen;
+  for (; uSize >= 8u; uSize -= 8u, pucData += 8u)
+  {
+    ullHash ^= CuTestXxhRound(0u, CuTestXxhRead64(pucData));
+    ullHash = CuTestXxhRotl(ullHash, 27u) * CUTEST_XXH_PRIME1 + CUTEST_XXH_PRIME4;
+  }
+  if (uSize >= 4u)
+  {
+    ullHash ^= (uint64_t)CuTestXxhRead32(pucData) * CUTEST_XXH_PRIME1;
+    ullHash = CuTestXxhRotl(ullHash, 23u) * CUTEST_XXH_PRIME2 + CUTEST_XXH_PRIME3;
+    uSize -= 4u;
+    pucData += 4u;
+  }
+  for (; uSize > 0u; --uSize, ++pucData)
+  {
+    ullHash ^= *pucData * CUTEST_XXH_PRIME5;
+    ullHash = CuTestXxhRotl(ullHash, 11u) * CUTEST_XXH_PRIME1;
+  }
+
+  // Avalanche
+  ullHash ^= ullHash >> 33;
+  ullHash *= CUTEST_XXH_PRIME2;
+  ullHash ^= ullHash >> 29;
+  ullHash *= CUTEST_XXH_PRIME3;
+  ullHash ^= ullHash >> 32;
+
+  return ullHash;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Calculate hash value of a buffer
+ *
+ * @param[in] eType       Hash algorithm
+ * @param[in] *pData      Input data
+ * @param[in] uSize       Size of data in bytes
+ * @return  (uint64_t)  Hash value (CRC32C in the lower 32 bits)
+ * @date  17.10.2026
+ ******************************************************************************/
+uint64_t CuTest_Hash(cutest_hash_type_t eType, const void* pData, size_t uSize)
+{
+  cutest_hash_t sHash;
+  CuTest_HashInit(&sHash, eType);
+  CuTest_HashUpdate(&sHash, pData, uSize);
+  return CuTest_HashFinal(&sHash);
+}
+
+
+/*- Result evaluation functions ----------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Evaluate the hash value of an incremental calculation
+ *
+ * The actual hash value is part of the failure message, for updating the
+ * expected value.
+ *
+ * @note longjmp on mismatch
+ * @param[in] psTc        Test case data
+ * @param[in] *pszFile    File name
+ * @param[in] ulLine      Line number
+ * @param[in] ullExpected Expected hash value
+ * @param[in] psHash      Hash context
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_EvalAssertHashState(cutest_case_ptr_t psTc, const char* pszFile, unsigned long ulLine, uint64_t ullExpected, const cutest_hash_ptr_t psHash)
+{
+  assert(psTc != NULL);
+  assert(pszFile != NULL);
+  assert(psHash != NULL);
+
+  uint64_t ullActual = CuTest_HashFinal(psHash);
+  if (ullActual == ullExpected)
+  {
+    CuTestPass(psTc);
+  }
+  else if (psHash->eType == EN_CUTEST_HASH_CRC32C)
+  {
+    CuTestFail(psTc, pszFile, ulLine, "CRC32C of <%llu> bytes: expected <0x%08llX>, but was <0x%08llX>", (unsigned long long)psHash->ullTotal, (unsigned long long)ullExpected, (unsigned long long)ullActual);
+  }
+  else
+  {
+    CuTestFail(psTc, pszFile, ulLine, "XXH64 of <%llu> bytes: expected <0x%016llX>, but was <0x%016llX>", (unsigned long long)psHash->ullTotal, (unsigned long long)ullExpected, (unsigned long long)ullActual);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Evaluate the hash value of a buffer
+ *
+ * @note longjmp on mismatch
+ * @param[in] psTc        Test case data
+ * @param[in] *pszFile    File name
+ * @param[in] ulLine      Line number
+ * @param[in] eType       Hash algorithm
+ * @param[in] ullExpected Expected hash value
+ * @param[in] *pActual    Actual data
+ * @param[in] uSize       Size of data in bytes
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_EvalAssertHashEquals(cutest_case_ptr_t psTc, const char* pszFile, unsigned long ulLine, cutest_hash_type_t eType, uint64_t ullExpected, const void* pActual, size_t uSize)
+{
+  cutest_hash_t sHash;
+  CuTest_HashInit(&sHash, eType);
+  CuTest_HashUpdate(&sHash, pActual, uSize);
+  CuTest_EvalAssertHashState(psTc, pszFile, ulLine, ullExpected, &sHash);
+}
@@ -0,0 +1,178 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestInsn.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - instruction counting
+ *
+ * Test runners cross-compiled for the target ISA can be run under QEMU user
+ * mode with the cutest-insn TCG plugin (see cutest-qemu). The plugin counts
+ * the instructions executed between calls to the marker functions below, and
+ * stores the count in a file named after CUTEST_INSN_FILE and the process ID,
+ * read back after each test case. Without the plugin, the markers are empty
+ * functions. This source file is licensed under The MIT License. See
+ * https://opensource.org/license/mit/ for full license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "CuTestPrivate.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Environment variable naming the count file, set by cutest-qemu            */
+#define CUTEST_INSN_ENV               "CUTEST_INSN_FILE"
+
+/*! Max. count file path length                                               */
+#define CUTEST_INSN_MAX_PATH          512u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! Instruction counting data                                                 */
+typedef struct tag_cutest_insn_t
+{
+  const char* pszFile;              ///< Count file base name, NULL if disabled
+  uint64_t ullOverhead;             ///< Instructions counted between markers
+} cutest_insn_t;
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static _Bool CuTestInsnRead(uint64_t* pullCount);
+static void  CuTestInsnInit(void) __attribute__((constructor));
+
+
+/*- Private variables --------------------------------------------------------*/
+/*! Instruction counting data                                                 */
+static cutest_insn_t sInsn _PERSISTENT;
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Read the instruction count stored by the plugin at the end marker
+ *
+ * @param[out] pullCount  Instruction count
+ * @return  (_Bool)  true, if a count was read
+ * @date  17.10.2026
+ ******************************************************************************/
+static _Bool CuTestInsnRead(uint64_t* pullCount)
+{
+  char acPath[CUTEST_INSN_MAX_PATH];
+  int iLen = snprintf(acPath, sizeof(acPath), "%s.%ld", sInsn.pszFile, (long)getpid());
+  if ((iLen < 0) || ((size_t)iLen >= sizeof(acPath))) return 0;
+
+  int iFd = open(acPath, O_RDONLY | O_CLOEXEC);
+  if (iFd < 0) return 0;
+  char acBuf[32];
+  ssize_t iRead = read(iFd, acBuf, sizeof(acBuf) - 1u);
+  close(iFd);
+  if (iRead <= 0) return 0;
+  acBuf[iRead] = '\0';
+
+  *pullCount = strtoull(acBuf, NULL, 10);
+  return 1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Enable instruction counting if run by cutest-qemu, measure the counting
+ * overhead
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestInsnInit(void)
+{
+  sInsn.pszFile = getenv(CUTEST_INSN_ENV);
+  if (sInsn.pszFile == NULL) return;
+
+  uint64_t ullCount;
+  CuTest_InsnMarkBegin();
+  CuTest_InsnMarkEnd();
+  if (!CuTestInsnRead(&ullCount))
+  {
+    fprintf(stderr, "%s:0:0: warning: instruction counting disabled, run under cutest-qemu\n", sInsn.pszFile);
+    sInsn.pszFile = NULL;
+    return;
+  }
+  sInsn.ullOverhead = ullCount;
+}
+
+
+/*- Instruction counting -----------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Start of a counted section, instrumented by the cutest-insn plugin
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+void __attribute__((noinline)) CuTest_InsnMarkBegin(void)
+{
+  __asm__ volatile ("" ::: "memory");
+}
+
+/*!****************************************************************************
+ * @brief
+ * End of a counted section, instrumented by the cutest-insn plugin
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+void __attribute__((noinline)) CuTest_InsnMarkEnd(void)
+{
+  __asm__ volatile ("" ::: "memory");
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if instructions are counted
+ *
+ * @return  (_Bool)  true, if run under cutest-qemu
+ * @date  17.10.2026
+ ******************************************************************************/
+_Bool CuTestInsnEnabled(void)
+{
+  return sInsn.pszFile != NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start counting instructions of a test case
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestInsnBegin(void)
+{
+  if (sInsn.pszFile == NULL) return;
+
+  CuTest_InsnMarkBegin();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Store the number of instructions executed by a test case
+ *
+ * @param[out] psTc       Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestInsnEnd(cutest_case_ptr_t psTc)
+{
+  assert(psTc != NULL);
+
+  if (sInsn.pszFile == NULL) return;
+
+  CuTest_InsnMarkEnd();
+  uint64_t ullCount;
+  if (!CuTestInsnRead(&ullCount)) return;
+  psTc->sUsage.ullInsns = (ullCount > sInsn.ullOverhead) ? ullCount - sInsn.ullOverhead : 0u;
+}
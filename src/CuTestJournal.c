@@ -0,0 +1,282 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestJournal.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - progress journal
+ *
+ * The result of each finished test case is appended to a journal file, as a
+ * result record (see CuTestRecord.c). Records are synced to disk in batches,
+ * so a crashed or killed test run loses at most the last batch. With --resume,
+ * the test cases recorded in the journal are not run again; their results are
+ * taken from the journal, so the summary and report still cover all test
+ * cases. The journal header identifies the test cases of the run, a journal of
+ * a different test binary or test selection is discarded. This source file is
+ * licensed under The MIT License. See https://opensource.org/license/mit/ for
+ * full license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "CuTestPrivate.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Journal file identification                                               */
+#define CUTEST_JOURNAL_MAGIC          "CUTESTJ1"
+
+/*! Max. number of records written between syncs                              */
+#define CUTEST_JOURNAL_SYNC_RECORDS   64u
+
+/*! Max. time between syncs [ns]                                              */
+#define CUTEST_JOURNAL_SYNC_TIME      1000000000ull
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! Journal file header, followed by result records                           */
+typedef struct tag_cutest_journal_hdr_t
+{
+  char acMagic[8];                  ///< CUTEST_JOURNAL_MAGIC
+  uint32_t ulCount;                 ///< Number of test cases
+  uint32_t ulReserved;              ///< Reserved, 0
+  uint64_t ullHash;                 ///< Hash of the test case names and files
+} cutest_journal_hdr_t;
+
+/*! Open progress journal                                                     */
+typedef struct tag_cutest_journal_t
+{
+  int iFd;                          ///< Journal file
+  pid_t iPid;                       ///< Writing process
+  unsigned long* pulIndex;          ///< Run list index per test case data
+  unsigned long ulCount;            ///< Number of test cases
+  unsigned long ulPending;          ///< Records written since the last sync
+  uint64_t ullLastSync;             ///< Time of the last sync [ns]
+} cutest_journal_t;
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static uint64_t CuTestJournalTime(void);
+static size_t   CuTestJournalLoad(cutest_root_ptr_t psRoot, const cutest_run_list_t* psRun, const cutest_journal_hdr_t* psHdr, _Bool* pbSelected, unsigned long* pulResumed);
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Get the monotonic time
+ *
+ * @return  (uint64_t)  Time [ns]
+ * @date  17.10.2026
+ ******************************************************************************/
+static uint64_t CuTestJournalTime(void)
+{
+  struct timespec sNow;
+  clock_gettime(CLOCK_MONOTONIC, &sNow);
+  return (uint64_t)sNow.tv_sec * 1000000000ull + (uint64_t)sNow.tv_nsec;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Load the results recorded in a journal file
+ *
+ * Reading stops at the first incomplete or invalid record, e.g. one partially
+ * written before a crash.
+ *
+ * @param[inout] psRoot   Test run root, with the journal file open
+ * @param[in] psRun       Test cases
+ * @param[in] psHdr       Expected journal header
+ * @param[inout] *pbSelected Selection per test case, cleared if resumed
+ * @param[out] *pulResumed Number of test cases resumed
+ * @return  (size_t)  Length of the valid journal part, 0 if not matching
+ * @date  17.10.2026
+ ******************************************************************************/
+static size_t CuTestJournalLoad(cutest_root_ptr_t psRoot, const cutest_run_list_t* psRun, const cutest_journal_hdr_t* psHdr, _Bool* pbSelected, unsigned long* pulResumed)
+{
+  const int iFd = psRoot->psJournal->iFd;
+  *pulResumed = 0u;
+
+  struct stat sStat;
+  if ((fstat(iFd, &sStat) != 0) || ((size_t)sStat.st_size < sizeof(cutest_journal_hdr_t))) return 0u;
+
+  char* pcBuf = malloc((size_t)sStat.st_size);
+  assert(pcBuf != NULL);
+  size_t uLen = 0u;
+  while (uLen < (size_t)sStat.st_size)
+  {
+    ssize_t iRet = pread(iFd, &pcBuf[uLen], (size_t)sStat.st_size - uLen, (off_t)uLen);
+    if ((iRet < 0) && (errno == EINTR)) continue;
+    if (iRet <= 0) break;
+    uLen += (size_t)iRet;
+  }
+  if ((uLen < sizeof(cutest_journal_hdr_t)) || (memcmp(pcBuf, psHdr, sizeof(cutest_journal_hdr_t)) != 0))
+  {
+    free(pcBuf);
+    return 0u;
+  }
+
+  size_t uPos = sizeof(cutest_journal_hdr_t);
+  cutest_record_t sRecord;
+  size_t uRecLen;
+  while ((uRecLen = CuTestRecordParse(&pcBuf[uPos], uLen - uPos, psRun->ulCount, &sRecord)) > 0u)
+  {
+    if ((uRecLen == CUTEST_RECORD_INVALID) || (sRecord.eResult > EN_CUTEST_RESULT_FAIL)) break;
+    if (pbSelected[sRecord.ulIndex]) ++*pulResumed;
+    CuTestRecordApply(&sRecord, psRun->ppsCases[sRecord.ulIndex]);
+    pbSelected[sRecord.ulIndex] = 0;
+    uPos += uRecLen;
+
+    // Failures recorded before count towards fail-fast
+    if ((sRecord.eResult == EN_CUTEST_RESULT_FAIL) && (psRoot->ulFailFast > 0u) && (++psRoot->ulFailures >= psRoot->ulFailFast)) psRoot->bStop = 1;
+  }
+
+  free(pcBuf);
+  return uPos;
+}
+
+
+/*- Progress journal ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Open the progress journal of a test run
+ *
+ * Without resume, or if the journal does not match the test cases of the run,
+ * the journal is restarted. Otherwise, the recorded results are applied to
+ * the test cases, and these are deselected.
+ *
+ * @param[inout] psRoot   Test run root
+ * @param[in] psRun       Test cases
+ * @param[inout] *pbSelected Selection per test case
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestJournalBegin(cutest_root_ptr_t psRoot, const cutest_run_list_t* psRun, _Bool* pbSelected)
+{
+  assert(psRoot != NULL);
+  assert(psRun != NULL);
+  assert(pbSelected != NULL);
+
+  psRoot->psJournal = NULL;
+  if (psRoot->pszJournalFile == NULL) return;
+
+  int iFd = open(psRoot->pszJournalFile, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (iFd < 0)
+  {
+    fprintf(stderr, "CuTest: cannot open journal '%s': %s\n", psRoot->pszJournalFile, strerror(errno));
+    return;
+  }
+
+  cutest_journal_t* psJournal = calloc(1u, sizeof(cutest_journal_t));
+  assert(psJournal != NULL);
+  psJournal->pulIndex = malloc((psRun->ulCount + 1u) * sizeof(unsigned long));
+  assert(psJournal->pulIndex != NULL);
+  psJournal->iFd = iFd;
+  psJournal->iPid = getpid();
+  psJournal->ulCount = psRun->ulCount;
+  psJournal->ullLastSync = CuTestJournalTime();
+  for (unsigned long i = 0; i < psRun->ulCount; ++i)
+  {
+    psJournal->pulIndex[psRun->ppsCases[i] - psRoot->psResults] = i;
+  }
+  psRoot->psJournal = psJournal;
+
+  cutest_journal_hdr_t sHdr = {
+    .ulCount = (uint32_t)psRun->ulCount,
+    .ulReserved = 0u,
+    .ullHash = CuTestRunListHash(psRun)
+  };
+  memcpy(sHdr.acMagic, CUTEST_JOURNAL_MAGIC, sizeof(sHdr.acMagic));
+
+  size_t uValid = 0u;
+  if (psRoot->bResume)
+  {
+    unsigned long ulResumed;
+    uValid = CuTestJournalLoad(psRoot, psRun, &sHdr, pbSelected, &ulResumed);
+    if (uValid == 0u) fprintf(stderr, "CuTest: journal '%s' does not match the test run, restarting\n", psRoot->pszJournalFile);
+    else printf("CuTest: resumed %lu of %lu test cases from journal %s\n", ulResumed, psRun->ulCount, psRoot->pszJournalFile);
+  }
+
+  // Drop incomplete records, or restart with a new header
+  if ((ftruncate(iFd, (off_t)uValid) != 0) ||
+      ((uValid == 0u) && (pwrite(iFd, &sHdr, sizeof(sHdr), 0) != (ssize_t)sizeof(sHdr))) ||
+      (lseek(iFd, 0, SEEK_END) < 0) || (fdatasync(iFd) != 0))
+  {
+    fprintf(stderr, "CuTest: cannot write journal '%s': %s\n", psRoot->pszJournalFile, strerror(errno));
+    CuTestJournalEnd(psRoot);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Append the result of a finished test case to the progress journal
+ *
+ * Only results counted by the process that opened the journal are recorded;
+ * forked workers report theirs to it. Test cases not run are not recorded.
+ *
+ * @param[inout] psRoot   Test run root
+ * @param[in] psTc        Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestJournalWrite(cutest_root_ptr_t psRoot, const cutest_case_ptr_t psTc)
+{
+  assert(psRoot != NULL);
+  assert(psTc != NULL);
+
+  cutest_journal_t* psJournal = psRoot->psJournal;
+  if ((psJournal == NULL) || (psJournal->iPid != getpid())) return;
+  if ((psTc->eResult != EN_CUTEST_RESULT_PASS) && (psTc->eResult != EN_CUTEST_RESULT_FAIL)) return;
+
+  // Test case data outside of this root, e.g. a test case run directly
+  uintptr_t uOffset = (uintptr_t)psTc - (uintptr_t)psRoot->psResults;
+  if ((psRoot->psResults == NULL) || (uOffset >= psJournal->ulCount * sizeof(cutest_case_t))) return;
+
+  if (!CuTestRecordWrite(psJournal->iFd, psJournal->pulIndex[uOffset / sizeof(cutest_case_t)], psTc))
+  {
+    fprintf(stderr, "CuTest: cannot write journal '%s': %s\n", psRoot->pszJournalFile, strerror(errno));
+    CuTestJournalEnd(psRoot);
+    return;
+  }
+
+  uint64_t ullNow = CuTestJournalTime();
+  if ((++psJournal->ulPending >= CUTEST_JOURNAL_SYNC_RECORDS) || (ullNow - psJournal->ullLastSync >= CUTEST_JOURNAL_SYNC_TIME))
+  {
+    fdatasync(psJournal->iFd);
+    psJournal->ulPending = 0u;
+    psJournal->ullLastSync = ullNow;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Sync and close the progress journal of a test run
+ *
+ * The journal file is kept, for resuming a later test run.
+ *
+ * @param[inout] psRoot   Test run root
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestJournalEnd(cutest_root_ptr_t psRoot)
+{
+  assert(psRoot != NULL);
+
+  cutest_journal_t* psJournal = psRoot->psJournal;
+  if (psJournal == NULL) return;
+
+  fdatasync(psJournal->iFd);
+  close(psJournal->iFd);
+  free(psJournal->pulIndex);
+  free(psJournal);
+  psRoot->psJournal = NULL;
+}
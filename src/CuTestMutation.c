@@ -0,0 +1,355 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestMutation.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - mutation testing
+ *
+ * Runtime support for mutant schema builds created by the cutest-mutate tool.
+ * All mutants are compiled into the test runner and selected by a runtime ID.
+ * During the regular test run, the root items reaching each mutant are
+ * recorded. Afterwards, every mutant is run in a forked worker process, exe-
+ * cuting only the root items reaching it and stopping at the first failing
+ * test case. This source file is licensed under The MIT License. See
+ * https://opensource.org/license/mit/ for full license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "CuTestPrivate.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Worker exit code: all test cases passed                                   */
+#define CUTEST_MUTANT_SURVIVED        0
+
+/*! Worker exit code: test case failed                                        */
+#define CUTEST_MUTANT_KILLED          1
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! Mutation testing data                                                     */
+typedef struct tag_cutest_mutation_t
+{
+  unsigned long ulNumTables;        ///< Number of registered tables
+  cutest_mutant_table_ptr_t apsTables[CUTEST_MAX_NUM_MUTANT_TABLES]; ///< Tables
+  unsigned long ulNumMutants;       ///< Total number of mutants
+  uint32_t* pulReach;               ///< Root items reaching each mutant (bits)
+  unsigned long ulReachWords;       ///< Reach bit set size per mutant
+  unsigned long ulItems;            ///< Number of root items
+  unsigned long ulActive;           ///< Active mutant ID, 0 if none
+  unsigned long ulItem;             ///< Currently running root item
+} cutest_mutation_t;
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static const cutest_mutant_site_t* CuTestMutantSite(unsigned long ulId, const char** ppszFile);
+static _Bool          CuTestMutantReached(unsigned long ulId, unsigned long ulItem);
+static void _NORETURN CuTestMutantWorker(const cutest_root_ptr_t psRoot, unsigned long ulId, unsigned uTimeout);
+
+
+/*- Private variables --------------------------------------------------------*/
+/*! Mutation testing data                                                     */
+static cutest_mutation_t sMutation _PERSISTENT;
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Look up the source location of a mutant
+ *
+ * @param[in] ulId        Global mutant ID
+ * @param[out] **ppszFile Source file name
+ * @return  (const cutest_mutant_site_t*)  Mutant site
+ * @date  17.10.2026
+ ******************************************************************************/
+static const cutest_mutant_site_t* CuTestMutantSite(unsigned long ulId, const char** ppszFile)
+{
+  assert(ppszFile != NULL);
+
+  for (unsigned long i = 0; i < sMutation.ulNumTables; ++i)
+  {
+    const cutest_mutant_table_ptr_t psTable = sMutation.apsTables[i];
+    if ((ulId > psTable->ulBase) && (ulId <= psTable->ulBase + psTable->ulCount))
+    {
+      *ppszFile = psTable->pszFile;
+      return &psTable->psSites[ulId - psTable->ulBase - 1u];
+    }
+  }
+
+  assert(0);
+  return NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if a root item reached a mutant in the regular test run
+ *
+ * @param[in] ulId        Global mutant ID
+ * @param[in] ulItem      Root item index, ULONG_MAX for any
+ * @return  (_Bool)  true, if the mutant was reached
+ * @date  17.10.2026
+ ******************************************************************************/
+static _Bool CuTestMutantReached(unsigned long ulId, unsigned long ulItem)
+{
+  if (sMutation.pulReach == NULL) return 0;
+
+  const uint32_t* pulBits = &sMutation.pulReach[ulId * sMutation.ulReachWords];
+  if (ulItem < sMutation.ulItems) return (pulBits[ulItem / 32u] & (1ul << (ulItem % 32u))) != 0u;
+
+  for (unsigned long i = 0; i < sMutation.ulReachWords; ++i) if (pulBits[i] != 0u) return 1;
+  return 0;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Worker process: run all root items reaching a mutant
+ *
+ * @param[in] psRoot      Test run root
+ * @param[in] ulId        Global mutant ID
+ * @param[in] uTimeout    Time limit in seconds, 0 for none
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestMutantWorker(const cutest_root_ptr_t psRoot, unsigned long ulId, unsigned uTimeout)
+{
+  // Silence test case output
+  int fd = open("/dev/null", O_WRONLY);
+  if (fd >= 0)
+  {
+    dup2(fd, STDOUT_FILENO);
+    dup2(fd, STDERR_FILENO);
+    close(fd);
+  }
+
+  // Endless loops are killed by SIGALRM
+  if (uTimeout > 0u) alarm(uTimeout);
+  sMutation.ulActive = ulId;
+
+  // Stop at the first failing test case
+  cutest_run_list_t sRun;
+  CuTestGetRunList(psRoot, &sRun);
+  for (unsigned long ulItem = 0; ulItem < sRun.ulItems; ++ulItem)
+  {
+    if (!CuTestMutantReached(ulId, ulItem)) continue;
+
+    for (unsigned long i = sRun.pulItemStart[ulItem]; i < sRun.pulItemStart[ulItem + 1u]; ++i)
+    {
+      CuTest_RunTestCase(sRun.ppsCases[i]);
+      if (sRun.ppsCases[i]->eResult != EN_CUTEST_RESULT_PASS) _exit(CUTEST_MUTANT_KILLED);
+    }
+  }
+
+  _exit(CUTEST_MUTANT_SURVIVED);
+}
+
+
+/*- Mutation testing ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Register the mutant table of a mutated source file
+ *
+ * Called from a constructor emitted by cutest-mutate. Assigns the global ID
+ * range of the table.
+ *
+ * @param[inout] psTable  Mutant table
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_RegisterMutants(cutest_mutant_table_ptr_t psTable)
+{
+  assert(psTable != NULL);
+  assert(sMutation.ulNumTables < CUTEST_MAX_NUM_MUTANT_TABLES);
+
+  psTable->ulBase = sMutation.ulNumMutants;
+  sMutation.apsTables[sMutation.ulNumTables++] = psTable;
+  sMutation.ulNumMutants += psTable->ulCount;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if a mutant is active. Records the running root item during the
+ * regular test run.
+ *
+ * @param[in] psTable     Mutant table
+ * @param[in] ulId        Mutant ID within table (1-based)
+ * @return  (_Bool)  true, if the mutated variant is to be used
+ * @date  17.10.2026
+ ******************************************************************************/
+_Bool CuTest_IsMutant(const cutest_mutant_table_ptr_t psTable, unsigned long ulId)
+{
+  const unsigned long ulGlobal = psTable->ulBase + ulId;
+
+  if (sMutation.ulActive == 0u)
+  {
+    if ((sMutation.pulReach != NULL) && (sMutation.ulItem < sMutation.ulItems))
+    {
+      sMutation.pulReach[ulGlobal * sMutation.ulReachWords + sMutation.ulItem / 32u] |= 1ul << (sMutation.ulItem % 32u);
+    }
+    return 0;
+  }
+
+  return ulGlobal == sMutation.ulActive;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Prepare reach recording for the regular test run
+ *
+ * @param[in] ulItems     Number of root items
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestMutationBegin(unsigned long ulItems)
+{
+  free(sMutation.pulReach);
+  sMutation.ulItems = ulItems;
+  sMutation.ulReachWords = (ulItems + 31u) / 32u;
+  sMutation.pulReach = calloc((sMutation.ulNumMutants + 1u) * sMutation.ulReachWords + 1u, sizeof(uint32_t));
+  assert(sMutation.pulReach != NULL);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Set the currently running root item for reach recording
+ *
+ * @param[in] ulItem      Root item index
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestMutationSetItem(unsigned long ulItem)
+{
+  sMutation.ulItem = ulItem;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if mutant tables are registered
+ *
+ * @return  (_Bool)  true, if the test runner contains mutants
+ * @date  17.10.2026
+ ******************************************************************************/
+_Bool CuTestMutationEnabled(void)
+{
+  return sMutation.ulNumMutants > 0u;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run all mutants in parallel worker processes and print surviving mutants
+ *
+ * Surviving mutants are reported in Eclipse error parser format. Mutants that
+ * could not be run (no worker process) are reported as errors, and excluded
+ * from the score.
+ *
+ * @param[in] psRoot      Test run root (after the regular test run)
+ * @param[in] uJobs       Number of parallel workers, 0 for one per CPU
+ * @param[in] uTimeout    Time limit per mutant in seconds, 0 for none
+ * @return  (unsigned long)  Number of surviving mutants
+ * @date  17.10.2026
+ * @date  17.10.2026  Report mutants without worker process as errors
+ ******************************************************************************/
+unsigned long CuTest_RunMutationTests(const cutest_root_ptr_t psRoot, unsigned uJobs, unsigned uTimeout)
+{
+  assert(psRoot != NULL);
+
+  if (uJobs == 0u)
+  {
+    long lCpus = sysconf(_SC_NPROCESSORS_ONLN);
+    uJobs = (lCpus > 0) ? (unsigned)lCpus : 1u;
+  }
+
+  pid_t* piPids = calloc(uJobs, sizeof(pid_t));
+  unsigned long* pulIds = calloc(uJobs, sizeof(unsigned long));
+  _Bool* pbSurvived = calloc(sMutation.ulNumMutants + 1u, sizeof(_Bool));
+  assert((piPids != NULL) && (pulIds != NULL) && (pbSurvived != NULL));
+
+  fflush(stdout);
+  fflush(stderr);
+
+  // Dispatch mutants to workers
+  unsigned long ulNext = 1u;
+  unsigned uRunning = 0u;
+  unsigned long ulUncovered = 0u;
+  unsigned long ulErrors = 0u;
+  while ((ulNext <= sMutation.ulNumMutants) || (uRunning > 0u))
+  {
+    if ((ulNext <= sMutation.ulNumMutants) && (uRunning < uJobs))
+    {
+      const unsigned long ulId = ulNext++;
+      if (!CuTestMutantReached(ulId, ULONG_MAX))
+      {
+        pbSurvived[ulId] = 1;
+        ulUncovered++;
+        continue;
+      }
+
+      pid_t iPid = fork();
+      if (iPid == 0) CuTestMutantWorker(psRoot, ulId, uTimeout);
+      if (iPid < 0)
+      {
+        const char* pszFile;
+        const cutest_mutant_site_t* psSite = CuTestMutantSite(ulId, &pszFile);
+        fprintf(stderr, "%s:%lu:0: error: mutant #%lu not tested, unable to start worker: %s\n", pszFile, psSite->ulLine, ulId, strerror(errno));
+        ulErrors++;
+        continue;
+      }
+
+      for (unsigned i = 0; i < uJobs; ++i) if (piPids[i] == 0)
+      {
+        piPids[i] = iPid;
+        pulIds[i] = ulId;
+        break;
+      }
+      uRunning++;
+      continue;
+    }
+
+    // Collect finished worker
+    int iStatus;
+    pid_t iPid = waitpid(-1, &iStatus, 0);
+    if (iPid < 0) break;
+    for (unsigned i = 0; i < uJobs; ++i) if (piPids[i] == iPid)
+    {
+      pbSurvived[pulIds[i]] = WIFEXITED(iStatus) && (WEXITSTATUS(iStatus) == CUTEST_MUTANT_SURVIVED);
+      piPids[i] = 0;
+      uRunning--;
+      break;
+    }
+  }
+
+  // Report
+  unsigned long ulSurvived = 0u;
+  for (unsigned long ulId = 1u; ulId <= sMutation.ulNumMutants; ++ulId)
+  {
+    if (!pbSurvived[ulId]) continue;
+    ulSurvived++;
+
+    const char* pszFile;
+    const cutest_mutant_site_t* psSite = CuTestMutantSite(ulId, &pszFile);
+    printf("%s:%lu:0: warning: mutant #%lu survived: %s%s\n", pszFile, psSite->ulLine, ulId, psSite->pszDesc, CuTestMutantReached(ulId, ULONG_MAX) ? "" : " (not covered)");
+  }
+
+  const unsigned long ulTested = sMutation.ulNumMutants - ulErrors;
+  const unsigned long ulKilled = ulTested - ulSurvived;
+  printf("\nMutation testing:\n\t%lu mutants, %lu killed, %lu survived (%lu not covered), %lu errors, score %lu%%\n",
+    sMutation.ulNumMutants, ulKilled, ulSurvived, ulUncovered, ulErrors, (ulTested > 0u) ? (100u * ulKilled / ulTested) : 100u);
+
+  free(piPids);
+  free(pulIds);
+  free(pbSurvived);
+
+  return ulSurvived;
+}
@@ -0,0 +1,302 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestNode.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - test hierarchy
+ *
+ * The root items of a test run and all suites, modules, groups and test cases
+ * below them are stored in a single node table, grown on demand. Root items
+ * occupy the first nodes; the table is expanded breadth-first, so that the
+ * children of every node form a contiguous index range. Runner, statistics
+ * and reporters traverse the table instead of the fixed-size item lists.
+ * Every test case node gets its own copy of the test case data, so that
+ * results are kept per test run, and test runs sharing test cases can run
+ * concurrently. This source file is licensed under The MIT License. See
+ * https://opensource.org/license/mit/ for full license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <assert.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include "CuTestPrivate.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Initial node table size                                                   */
+#define CUTEST_NODE_TABLE_INIT        64u
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static unsigned long CuTestNodeAdd(cutest_root_ptr_t psRoot, cutest_type_t eType, void* pItem, unsigned long ulParent);
+static _Bool         CuTestNodeIsAncestor(const cutest_root_ptr_t psRoot, unsigned long ulNode, const void* pItem);
+static void          CuTestNodePath(FILE* f, const cutest_root_ptr_t psRoot, unsigned long ulNode);
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Append a node to the node table
+ *
+ * @param[inout] psRoot   Test run root
+ * @param[in] eType       Item type
+ * @param[in] *pItem      Item data structure pointer
+ * @param[in] ulParent    Parent node, ULONG_MAX for root items
+ * @return  (unsigned long)  Node index
+ * @date  17.10.2026
+ ******************************************************************************/
+static unsigned long CuTestNodeAdd(cutest_root_ptr_t psRoot, cutest_type_t eType, void* pItem, unsigned long ulParent)
+{
+  if (psRoot->ulNumNodes == psRoot->ulMaxNodes)
+  {
+    unsigned long ulMax = (psRoot->ulMaxNodes == 0u) ? CUTEST_NODE_TABLE_INIT : 2u * psRoot->ulMaxNodes;
+    cutest_node_ptr_t psNodes = realloc(psRoot->psNodes, ulMax * sizeof(cutest_node_t));
+    assert(psNodes != NULL);
+    psRoot->psNodes = psNodes;
+    psRoot->ulMaxNodes = ulMax;
+  }
+
+  psRoot->psNodes[psRoot->ulNumNodes] = (cutest_node_t){
+    .sItem = { .eType = eType, .pItem = pItem },
+    .psResult = NULL,
+    .ulParent = ulParent,
+    .ulFirst = 0u,
+    .ulCount = 0u
+  };
+  return psRoot->ulNumNodes++;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if an item is a node or one of its ancestors
+ *
+ * @param[in] psRoot      Test run root
+ * @param[in] ulNode      Node index
+ * @param[in] *pItem      Item data structure pointer
+ * @return  (_Bool)  true, if adding the item below the node creates a cycle
+ * @date  17.10.2026
+ ******************************************************************************/
+static _Bool CuTestNodeIsAncestor(const cutest_root_ptr_t psRoot, unsigned long ulNode, const void* pItem)
+{
+  for (; ulNode != ULONG_MAX; ulNode = psRoot->psNodes[ulNode].ulParent)
+  {
+    if (psRoot->psNodes[ulNode].sItem.pItem == pItem) return 1;
+  }
+
+  return 0;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Write the path of a node: the names of the node and its ancestors, separated
+ * by '/'. Backslashes, separators, tabs and line breaks in names are escaped.
+ *
+ * @param[out] *f         Output stream
+ * @param[in] psRoot      Test run root
+ * @param[in] ulNode      Node index
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestNodePath(FILE* f, const cutest_root_ptr_t psRoot, unsigned long ulNode)
+{
+  const cutest_node_t* psNode = &psRoot->psNodes[ulNode];
+  if (psNode->ulParent != ULONG_MAX)
+  {
+    CuTestNodePath(f, psRoot, psNode->ulParent);
+    fputc('/', f);
+  }
+
+  for (const char* p = CuTestNodeName(psNode); *p != '\0'; ++p)
+  {
+    switch (*p)
+    {
+      case '\\': fputs("\\\\", f); break;
+      case '/':  fputs("\\/", f);  break;
+      case '\t': fputs("\\t", f);  break;
+      case '\n': fputs("\\n", f);  break;
+      case '\r': fputs("\\r", f);  break;
+      default:   fputc(*p, f);
+    }
+  }
+}
+
+
+/*- Test hierarchy -----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Append a root item node
+ *
+ * Child nodes and test case data of an earlier expansion are discarded, and
+ * expanded again on demand.
+ *
+ * @param[inout] psRoot   Test run root
+ * @param[in] eType       Item type
+ * @param[in] *pItem      Item data structure pointer
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestAddRootNode(cutest_root_ptr_t psRoot, cutest_type_t eType, void* pItem)
+{
+  assert(psRoot != NULL);
+  assert(pItem != NULL);
+  assert(psRoot->ulNumNodes >= psRoot->ulCount);
+
+  CuTestReleaseResults(psRoot);
+  psRoot->ulNumNodes = psRoot->ulCount;
+  CuTestNodeAdd(psRoot, eType, pItem, ULONG_MAX);
+  psRoot->ulCount++;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Release the test case data of a test run
+ *
+ * @param[inout] psRoot   Test run root
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestReleaseResults(cutest_root_ptr_t psRoot)
+{
+  assert(psRoot != NULL);
+
+  if (psRoot->psResults == NULL) return;
+  for (unsigned long i = 0; i < psRoot->ulNumNodes; ++i)
+  {
+    cutest_node_ptr_t psNode = &psRoot->psNodes[i];
+    if (psNode->psResult == NULL) continue;
+    free(psNode->psResult->pszOutput);
+    free(psNode->psResult->pszPath);
+    psNode->psResult = NULL;
+  }
+
+  free(psRoot->psResults);
+  psRoot->psResults = NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Expand the node table below the root items, breadth-first, and set up the
+ * test case data of this run, including the path of each test case
+ *
+ * Does nothing if the table was expanded already. Suites containing them-
+ * selves are reported and not expanded again. Test cases of root items run on
+ * the spot keep the results stored in their descriptors.
+ *
+ * @param[inout] psRoot   Test run root
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestExpandNodes(cutest_root_ptr_t psRoot)
+{
+  assert(psRoot != NULL);
+
+  if (psRoot->psResults != NULL) return;
+  psRoot->ulNumNodes = psRoot->ulCount;
+
+  // The table grows while iterating, node pointers are not kept
+  for (unsigned long ulNode = 0; ulNode < psRoot->ulNumNodes; ++ulNode)
+  {
+    const cutest_relem_t sItem = psRoot->psNodes[ulNode].sItem;
+    const unsigned long ulFirst = psRoot->ulNumNodes;
+
+    switch (sItem.eType)
+    {
+      case EN_CUTEST_TYPE_GROUP:
+        for (unsigned long i = 0; i < sItem.psGroup->ulNumItems; ++i)
+        {
+          if (sItem.psGroup->ppItems[i] != NULL) CuTestNodeAdd(psRoot, EN_CUTEST_TYPE_CASE, sItem.psGroup->ppItems[i], ulNode);
+        }
+        break;
+
+      case EN_CUTEST_TYPE_MODULE:
+        for (unsigned long i = 0; i < CUTEST_MAX_NUM_GROUPS; ++i)
+        {
+          if (sItem.psModule->ppItems[i] != NULL) CuTestNodeAdd(psRoot, EN_CUTEST_TYPE_GROUP, sItem.psModule->ppItems[i], ulNode);
+        }
+        break;
+
+      case EN_CUTEST_TYPE_SUITE:
+        for (unsigned long i = 0; i < CUTEST_MAX_NUM_SUITE_ITEMS; ++i)
+        {
+          const cutest_relem_t* psChild = &sItem.psSuite->psItems[i];
+          if (psChild->pItem == NULL) continue;
+          if ((psChild->eType == EN_CUTEST_TYPE_SUITE) && CuTestNodeIsAncestor(psRoot, ulNode, psChild->pItem))
+          {
+            fprintf(stderr, "%s:%lu:0: error: suite %s contains itself\n", sItem.psSuite->pszFile, sItem.psSuite->ulLine, psChild->psSuite->pszName);
+            continue;
+          }
+          CuTestNodeAdd(psRoot, psChild->eType, psChild->pItem, ulNode);
+        }
+        break;
+
+      default:;
+    }
+
+    psRoot->psNodes[ulNode].ulFirst = ulFirst;
+    psRoot->psNodes[ulNode].ulCount = psRoot->ulNumNodes - ulFirst;
+  }
+
+  // Test case data of this run, copied from the shared descriptors
+  unsigned long ulNumCases = 0u;
+  for (unsigned long i = 0; i < psRoot->ulNumNodes; ++i)
+  {
+    if (psRoot->psNodes[i].sItem.eType == EN_CUTEST_TYPE_CASE) ulNumCases++;
+  }
+  psRoot->psResults = calloc(ulNumCases + 1u, sizeof(cutest_case_t));
+  assert(psRoot->psResults != NULL);
+
+  cutest_case_ptr_t psResult = psRoot->psResults;
+  for (unsigned long i = 0; i < psRoot->ulNumNodes; ++i)
+  {
+    cutest_node_ptr_t psNode = &psRoot->psNodes[i];
+    if (psNode->sItem.eType != EN_CUTEST_TYPE_CASE) continue;
+
+    memcpy(psResult, psNode->sItem.psCase, sizeof(cutest_case_t));
+    psResult->pszOutput = NULL;
+
+    // Test cases of items run on the spot take over the stored results
+    unsigned long ulItem = i;
+    while (psRoot->psNodes[ulItem].ulParent != ULONG_MAX) ulItem = psRoot->psNodes[ulItem].ulParent;
+    if (ulItem >= psRoot->ulNumDone) psResult->eResult = EN_CUTEST_RESULT_UNDEF;
+    else if (psNode->sItem.psCase->pszOutput != NULL)
+    {
+      psResult->pszOutput = strdup(psNode->sItem.psCase->pszOutput);
+      assert(psResult->pszOutput != NULL);
+    }
+
+    size_t uLen = 0u;
+    FILE* m = open_memstream(&psResult->pszPath, &uLen);
+    assert(m != NULL);
+    CuTestNodePath(m, psRoot, i);
+    fclose(m);
+    psNode->psResult = psResult++;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get the name of a node
+ *
+ * @param[in] psNode      Node
+ * @return  (const char*)  Suite, module, group or test case name
+ * @date  17.10.2026
+ ******************************************************************************/
+const char* CuTestNodeName(const cutest_node_t* psNode)
+{
+  assert(psNode != NULL);
+
+  switch (psNode->sItem.eType)
+  {
+    case EN_CUTEST_TYPE_CASE:   return psNode->sItem.psCase->pszName;
+    case EN_CUTEST_TYPE_GROUP:  return psNode->sItem.psGroup->pszName;
+    case EN_CUTEST_TYPE_MODULE: return psNode->sItem.psModule->pszName;
+    case EN_CUTEST_TYPE_SUITE:  return psNode->sItem.psSuite->pszName;
+    default:                    return "";
+  }
+}
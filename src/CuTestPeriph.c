@@ -0,0 +1,695 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestPeriph.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - peripheral simulation
+ *
+ * Simulated register banks, mapped at the MCU peripheral addresses. The banks
+ * are kept inaccessible (PROT_NONE), so every access by the code under test
+ * raises SIGSEGV. The handler runs the read hook, unlocks the bank and single-
+ * steps the faulting instruction; the following SIGTRAP records the access,
+ * runs the write hook and locks the bank again. Values presented by the read
+ * hook are only seen by the reading instruction, the register content is
+ * restored afterwards. Read-modify-write instructions are recorded as a read
+ * followed by a write. This source file is licensed
+ * under The MIT License. See https://opensource.org/license/mit/ for full
+ * license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include "CuTestPrivate.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Single-stepping support (x86 trap flag)                                   */
+#if defined(__i386__) || defined(__x86_64__)
+#define CUTEST_PERIPH_SUPPORTED       1u
+#define CUTEST_TRAP_FLAG              0x100u
+#else
+#define CUTEST_PERIPH_SUPPORTED       0u
+#endif
+
+/*! Page fault error code: write access                                       */
+#define CUTEST_PF_WRITE               0x2u
+
+/*! Maximum number of x86 instruction prefix bytes                            */
+#define CUTEST_MAX_NUM_PREFIXES       14u
+
+/*! Register alignment mask                                                   */
+#define CUTEST_REG_ALIGN              (sizeof(uint32_t) - 1u)
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! Simulated register bank                                                   */
+typedef struct tag_cutest_periph_t
+{
+  const char* pszName;              ///< Bank name
+  uintptr_t uBase;                  ///< Mapped base address (page-aligned)
+  size_t uSize;                     ///< Mapped size (page-aligned)
+  uint8_t* pucReset;                ///< Reset value image
+} cutest_periph_t;
+
+/*! Register access hook                                                      */
+typedef struct tag_cutest_reg_hook_t
+{
+  uintptr_t uAddr;                  ///< Register address
+  cutest_reg_hook_fn_t pfnRead;     ///< Read hook
+  cutest_reg_hook_fn_t pfnWrite;    ///< Write hook
+  void* pUser;                      ///< User data
+} cutest_reg_hook_t;
+
+/*! Peripheral simulation data                                                */
+typedef struct tag_cutest_periph_data_t
+{
+  unsigned long ulNumBanks;         ///< Number of mapped banks
+  cutest_periph_t asBanks[CUTEST_MAX_NUM_PERIPHERALS];  ///< Mapped banks
+  unsigned long ulNumHooks;         ///< Number of installed hooks
+  cutest_reg_hook_t asHooks[CUTEST_MAX_NUM_REG_HOOKS];  ///< Installed hooks
+  unsigned long ulNumTrace;         ///< Number of recorded accesses
+  cutest_reg_access_t asTrace[CUTEST_MAX_NUM_REG_TRACE]; ///< Access trace
+
+  // Pending single-step
+  cutest_periph_t* psPending;       ///< Unlocked bank
+  uintptr_t uPendingAddr;           ///< Accessed register
+  _Bool bPendingWrite;              ///< Write access
+  uint8_t ucPendingWidth;           ///< Access width in bytes
+  _Bool bPendingHooked;             ///< Read hook value presented
+  uint32_t ulPendingSaved;          ///< Register content before read hook
+
+  // Signal handlers
+  _Bool bInstalled;                 ///< Handlers installed
+  struct sigaction sOldSegv;        ///< Previous SIGSEGV action
+  struct sigaction sOldTrap;        ///< Previous SIGTRAP action
+} cutest_periph_data_t;
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static cutest_periph_t*   CuTestPeriphFind(uintptr_t uAddr);
+static cutest_reg_hook_t* CuTestPeriphFindHook(uintptr_t uAddr);
+static void               CuTestPeriphRecord(uintptr_t uAddr, uint32_t ulValue, uint8_t ucWidth, _Bool bWrite);
+static const uint8_t*     CuTestPeriphSkipPrefixes(const uint8_t* pucInsn, uint8_t* pucWidth);
+static _Bool              CuTestPeriphIsStore(const uint8_t* pucInsn);
+static uint8_t            CuTestPeriphWidth(const uint8_t* pucInsn);
+static void               CuTestPeriphOnSegv(int iSig, siginfo_t* psInfo, void* pCtx);
+static void               CuTestPeriphOnTrap(int iSig, siginfo_t* psInfo, void* pCtx);
+
+
+/*- Private variables --------------------------------------------------------*/
+/*! Peripheral simulation data                                                */
+static cutest_periph_data_t sPeriph _PERSISTENT;
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Find the register bank containing an address
+ *
+ * @param[in] uAddr       Address
+ * @return  (cutest_periph_t*)  Register bank, or NULL if not mapped
+ * @date  17.10.2026
+ ******************************************************************************/
+static cutest_periph_t* CuTestPeriphFind(uintptr_t uAddr)
+{
+  for (unsigned long i = 0; i < sPeriph.ulNumBanks; ++i)
+  {
+    cutest_periph_t* psBank = &sPeriph.asBanks[i];
+    if ((uAddr >= psBank->uBase) && (uAddr < psBank->uBase + psBank->uSize)) return psBank;
+  }
+
+  return NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Find the hook entry for a register
+ *
+ * @param[in] uAddr       Register address
+ * @return  (cutest_reg_hook_t*)  Hook entry, or NULL if not hooked
+ * @date  17.10.2026
+ ******************************************************************************/
+static cutest_reg_hook_t* CuTestPeriphFindHook(uintptr_t uAddr)
+{
+  for (unsigned long i = 0; i < sPeriph.ulNumHooks; ++i)
+  {
+    if (sPeriph.asHooks[i].uAddr == uAddr) return &sPeriph.asHooks[i];
+  }
+
+  return NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Append a register access to the trace
+ *
+ * The total count keeps incrementing when the trace is full, which is used for
+ * overflow detection.
+ *
+ * @param[in] uAddr       Register address
+ * @param[in] ulValue     Value read or written
+ * @param[in] ucWidth     Access width in bytes
+ * @param[in] bWrite      Write access
+ * @date  17.10.2026
+ * @date  17.10.2026  Added access width
+ ******************************************************************************/
+static void CuTestPeriphRecord(uintptr_t uAddr, uint32_t ulValue, uint8_t ucWidth, _Bool bWrite)
+{
+  if (sPeriph.ulNumTrace < CUTEST_MAX_NUM_REG_TRACE)
+  {
+    sPeriph.asTrace[sPeriph.ulNumTrace] = (cutest_reg_access_t){ .ulAddr = (uint32_t)uAddr, .ulValue = ulValue, .ucWidth = ucWidth, .bWrite = bWrite };
+  }
+  sPeriph.ulNumTrace++;
+}
+
+#if CUTEST_PERIPH_SUPPORTED
+/*!****************************************************************************
+ * @brief
+ * Skip the prefixes of an x86 instruction
+ *
+ * @param[in] *pucInsn    Instruction
+ * @param[out] *pucWidth  Operand size selected by prefixes (2, 4 or 8 bytes)
+ * @return  (const uint8_t*)  Opcode
+ * @date  17.10.2026
+ ******************************************************************************/
+static const uint8_t* CuTestPeriphSkipPrefixes(const uint8_t* pucInsn, uint8_t* pucWidth)
+{
+  assert(pucInsn != NULL);
+  assert(pucWidth != NULL);
+
+  // Skip legacy prefixes (operand/address size, lock, rep, segment) and REX
+  *pucWidth = 4u;
+  for (unsigned i = 0; i < CUTEST_MAX_NUM_PREFIXES; ++i)
+  {
+    const uint8_t ucByte = *pucInsn;
+    const _Bool bLegacy = (ucByte == 0x66u) || (ucByte == 0x67u) || (ucByte == 0xF0u) || (ucByte == 0xF2u) || (ucByte == 0xF3u) ||
+                          (ucByte == 0x26u) || (ucByte == 0x2Eu) || (ucByte == 0x36u) || (ucByte == 0x3Eu) || (ucByte == 0x64u) || (ucByte == 0x65u);
+#if defined(__x86_64__)
+    const _Bool bRex = (ucByte & 0xF0u) == 0x40u;
+#else
+    const _Bool bRex = 0;
+#endif
+    if (!bLegacy && !bRex) break;
+    if ((ucByte == 0x66u) && (*pucWidth == 4u)) *pucWidth = 2u;
+    if (bRex && (ucByte & 0x08u)) *pucWidth = 8u;
+    pucInsn++;
+  }
+
+  return pucInsn;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if a writing x86 instruction only stores to memory
+ *
+ * The page fault error code reports read-modify-write instructions (e.g. "or"
+ * with a memory operand) as writes. Plain stores are told apart by opcode:
+ * mov, movs/stos, setcc and SSE/AVX stores. All other writing instructions
+ * also read their memory operand.
+ *
+ * @param[in] *pucInsn    Faulting instruction
+ * @return  (_Bool)  true, if the instruction does not read its memory operand
+ * @date  17.10.2026
+ ******************************************************************************/
+static _Bool CuTestPeriphIsStore(const uint8_t* pucInsn)
+{
+  uint8_t ucWidth;
+  pucInsn = CuTestPeriphSkipPrefixes(pucInsn, &ucWidth);
+
+  switch (pucInsn[0])
+  {
+    case 0x88u: case 0x89u:               // mov r/m, reg
+    case 0xA2u: case 0xA3u:               // mov moffs, al/eax
+    case 0xA4u: case 0xA5u:               // movs
+    case 0xAAu: case 0xABu:               // stos
+    case 0xC6u: case 0xC7u:               // mov r/m, imm
+    case 0xC4u: case 0xC5u:               // VEX-encoded (AVX) stores
+      return 1;
+
+    case 0x0Fu:
+      switch (pucInsn[1])
+      {
+        case 0x11u: case 0x13u: case 0x17u: // movups/movss/movlps/movhps
+        case 0x29u: case 0x2Bu:           // movaps/movntps
+        case 0x7Eu: case 0x7Fu:           // movd/movq/movdqa/movdqu
+        case 0xC3u: case 0xD6u:           // movnti, movq
+        case 0xE7u:                       // movntq/movntdq
+          return 1;
+
+        default:
+          return (pucInsn[1] & 0xF0u) == 0x90u;  // setcc
+      }
+
+    default:
+      return 0;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get the memory operand width of an x86 instruction
+ *
+ * Byte-sized forms are told apart by opcode, all other instructions use the
+ * operand size selected by prefixes. SSE/AVX accesses are reported as 4 bytes.
+ *
+ * @param[in] *pucInsn    Faulting instruction
+ * @return  (uint8_t)  Access width in bytes
+ * @date  17.10.2026
+ ******************************************************************************/
+static uint8_t CuTestPeriphWidth(const uint8_t* pucInsn)
+{
+  uint8_t ucWidth;
+  pucInsn = CuTestPeriphSkipPrefixes(pucInsn, &ucWidth);
+
+  // ALU instructions (add, or, adc, sbb, and, sub, xor, cmp) on r/m8
+  if ((pucInsn[0] < 0x40u) && (((pucInsn[0] & 0x07u) == 0x00u) || ((pucInsn[0] & 0x07u) == 0x02u))) return 1u;
+
+  switch (pucInsn[0])
+  {
+    case 0x80u: case 0x84u: case 0x86u:   // alu/test/xchg r/m8
+    case 0x88u: case 0x8Au:               // mov r/m8
+    case 0xA0u: case 0xA2u:               // mov al, moffs
+    case 0xA4u: case 0xA6u:               // movsb/cmpsb
+    case 0xAAu: case 0xACu: case 0xAEu:   // stosb/lodsb/scasb
+    case 0xC0u: case 0xC6u:               // shift/mov r/m8, imm
+    case 0xD0u: case 0xD2u:               // shift r/m8
+    case 0xF6u: case 0xFEu:               // test/not/neg/inc/dec r/m8
+      return 1u;
+
+    case 0x0Fu:
+      switch (pucInsn[1])
+      {
+        case 0xB6u: case 0xBEu:           // movzx/movsx r, r/m8
+        case 0xB0u: case 0xC0u:           // cmpxchg/xadd r/m8
+          return 1u;
+
+        case 0xB7u: case 0xBFu:           // movzx/movsx r, r/m16
+          return 2u;
+
+        default:
+          return ((pucInsn[1] & 0xF0u) == 0x90u) ? 1u : ucWidth;  // setcc
+      }
+
+    default:
+      return ucWidth;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * SIGSEGV handler: start a register access
+ *
+ * @param[in] iSig        Signal number
+ * @param[in] *psInfo     Fault information
+ * @param[inout] *pCtx    Interrupted context
+ * @date  17.10.2026
+ * @date  17.10.2026  Keep read hook values out of the register content
+ ******************************************************************************/
+static void CuTestPeriphOnSegv(int iSig, siginfo_t* psInfo, void* pCtx)
+{
+  ucontext_t* psCtx = pCtx;
+  uintptr_t uAddr = (uintptr_t)psInfo->si_addr & ~(uintptr_t)CUTEST_REG_ALIGN;
+  cutest_periph_t* psBank = CuTestPeriphFind(uAddr);
+
+  if ((psBank == NULL) || (sPeriph.psPending != NULL))
+  {
+    // Not a simulated register: restore previous action and re-fault
+    (void)iSig;
+    sigaction(SIGSEGV, &sPeriph.sOldSegv, NULL);
+    return;
+  }
+
+  sPeriph.psPending = psBank;
+  sPeriph.uPendingAddr = uAddr;
+  sPeriph.bPendingWrite = (psCtx->uc_mcontext.gregs[REG_ERR] & CUTEST_PF_WRITE) != 0;
+#if defined(__x86_64__)
+  const uint8_t* pucInsn = (const uint8_t*)psCtx->uc_mcontext.gregs[REG_RIP];
+#else
+  const uint8_t* pucInsn = (const uint8_t*)psCtx->uc_mcontext.gregs[REG_EIP];
+#endif
+  const _Bool bRead = !sPeriph.bPendingWrite || !CuTestPeriphIsStore(pucInsn);
+  sPeriph.ucPendingWidth = CuTestPeriphWidth(pucInsn);
+  sPeriph.bPendingHooked = 0;
+  mprotect((void*)psBank->uBase, psBank->uSize, PROT_READ | PROT_WRITE);
+
+  // Present hooked value to the reading instruction only, e.g. for read-to-
+  // clear flags or FIFO data registers
+  cutest_reg_hook_t* psHook = CuTestPeriphFindHook(uAddr);
+  volatile uint32_t* pulReg = (volatile uint32_t*)uAddr;
+  if (bRead && (psHook != NULL) && (psHook->pfnRead != NULL))
+  {
+    const uint32_t ulValue = psHook->pfnRead(uAddr, *pulReg, psHook->pUser);
+
+    // Poking from within the hook locks the bank again
+    mprotect((void*)psBank->uBase, psBank->uSize, PROT_READ | PROT_WRITE);
+    sPeriph.ulPendingSaved = *pulReg;
+    sPeriph.bPendingHooked = 1;
+    *pulReg = ulValue;
+  }
+
+  // Read part of a read-modify-write access, the write is recorded on SIGTRAP
+  if (bRead && sPeriph.bPendingWrite) CuTestPeriphRecord(uAddr, *pulReg, sPeriph.ucPendingWidth, 0);
+
+  // Single-step the faulting instruction
+  psCtx->uc_mcontext.gregs[REG_EFL] |= CUTEST_TRAP_FLAG;
+}
+
+/*!****************************************************************************
+ * @brief
+ * SIGTRAP handler: complete a register access
+ *
+ * @param[in] iSig        Signal number
+ * @param[in] *psInfo     Trap information
+ * @param[inout] *pCtx    Interrupted context
+ * @date  17.10.2026
+ * @date  17.10.2026  Keep read hook values out of the register content
+ ******************************************************************************/
+static void CuTestPeriphOnTrap(int iSig, siginfo_t* psInfo, void* pCtx)
+{
+  ucontext_t* psCtx = pCtx;
+  cutest_periph_t* psBank = sPeriph.psPending;
+
+  if (psBank == NULL)
+  {
+    // Not caused by a register access: forward to previous action
+    if (sPeriph.sOldTrap.sa_flags & SA_SIGINFO)
+    {
+      if (sPeriph.sOldTrap.sa_sigaction != NULL) sPeriph.sOldTrap.sa_sigaction(iSig, psInfo, pCtx);
+    }
+    else if ((sPeriph.sOldTrap.sa_handler != SIG_IGN) && (sPeriph.sOldTrap.sa_handler != SIG_DFL))
+    {
+      sPeriph.sOldTrap.sa_handler(iSig);
+    }
+    else if (sPeriph.sOldTrap.sa_handler == SIG_DFL)
+    {
+      sigaction(SIGTRAP, &sPeriph.sOldTrap, NULL);
+      raise(SIGTRAP);
+    }
+    return;
+  }
+
+  uintptr_t uAddr = sPeriph.uPendingAddr;
+  _Bool bWrite = sPeriph.bPendingWrite;
+  volatile uint32_t* pulReg = (volatile uint32_t*)uAddr;
+
+  sPeriph.psPending = NULL;
+  psCtx->uc_mcontext.gregs[REG_EFL] &= ~CUTEST_TRAP_FLAG;
+
+  // Record access and latch value through write hook
+  uint32_t ulValue = *pulReg;
+  CuTestPeriphRecord(uAddr, ulValue, sPeriph.ucPendingWidth, bWrite);
+
+  // Pure reads leave the register content unchanged
+  if (!bWrite && sPeriph.bPendingHooked) *pulReg = sPeriph.ulPendingSaved;
+
+  cutest_reg_hook_t* psHook = CuTestPeriphFindHook(uAddr);
+  if (bWrite && (psHook != NULL) && (psHook->pfnWrite != NULL))
+  {
+    *pulReg = psHook->pfnWrite(uAddr, ulValue, psHook->pUser);
+  }
+
+  mprotect((void*)psBank->uBase, psBank->uSize, PROT_NONE);
+}
+#endif /* CUTEST_PERIPH_SUPPORTED */
+
+
+/*- Peripheral simulation ----------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Map a simulated register bank at its real address
+ *
+ * The bank is mapped with page granularity. Banks sharing a page must be
+ * declared as a single bank. Register contents are reset to zero (or to the
+ * values set by CuTest_SetRegisterReset) before each test case. Existing
+ * mappings are never replaced: mapping fails if any page is already in use.
+ *
+ * @param[in] *pszName    Bank name
+ * @param[in] uBase       Base address
+ * @param[in] uSize       Size in bytes
+ * @return  (_Bool)  true, if the bank was mapped
+ * @date  17.10.2026
+ * @date  17.10.2026  Never replace existing mappings
+ ******************************************************************************/
+_Bool CuTest_MapPeripheral(const char* pszName, uintptr_t uBase, size_t uSize)
+{
+  assert(pszName != NULL);
+  assert(sPeriph.ulNumBanks < CUTEST_MAX_NUM_PERIPHERALS);
+
+#if CUTEST_PERIPH_SUPPORTED
+  const uintptr_t uPageMask = (uintptr_t)sysconf(_SC_PAGESIZE) - 1u;
+  const uintptr_t uStart = uBase & ~uPageMask;
+  const size_t uLen = ((uBase + uSize + uPageMask) & ~uPageMask) - uStart;
+
+  // Without MAP_FIXED_NOREPLACE (or on kernels ignoring it), the address is a
+  // hint only: the kernel picks another address if the range is in use
+#ifdef MAP_FIXED_NOREPLACE
+  const int iFlags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE;
+#else
+  const int iFlags = MAP_PRIVATE | MAP_ANONYMOUS;
+#endif
+  void* pMap = mmap((void*)uStart, uLen, PROT_NONE, iFlags, -1, 0);
+  if (pMap != (void*)uStart)
+  {
+    const _Bool bInUse = (pMap != MAP_FAILED) || (errno == EEXIST);
+    if (pMap != MAP_FAILED) munmap(pMap, uLen);
+    if (bInUse)
+    {
+      fprintf(stderr, "CuTest: unable to map peripheral %s at %p: address range %p-%p is already in use.\n",
+              pszName, (void*)uBase, (void*)uStart, (void*)(uStart + uLen));
+    }
+    else
+    {
+      fprintf(stderr, "CuTest: unable to map peripheral %s at %p: %s.\n", pszName, (void*)uBase, strerror(errno));
+    }
+    return 0;
+  }
+
+  uint8_t* pucReset = calloc(1u, uLen);
+  if (pucReset == NULL)
+  {
+    munmap(pMap, uLen);
+    return 0;
+  }
+
+  // Trap accesses
+  if (!sPeriph.bInstalled)
+  {
+    struct sigaction sAct;
+    memset(&sAct, 0, sizeof(sAct));
+    sigemptyset(&sAct.sa_mask);
+    sAct.sa_flags = SA_SIGINFO | SA_NODEFER;
+
+    sAct.sa_sigaction = CuTestPeriphOnSegv;
+    sigaction(SIGSEGV, &sAct, &sPeriph.sOldSegv);
+    sAct.sa_sigaction = CuTestPeriphOnTrap;
+    sigaction(SIGTRAP, &sAct, &sPeriph.sOldTrap);
+    sPeriph.bInstalled = 1;
+  }
+
+  sPeriph.asBanks[sPeriph.ulNumBanks++] = (cutest_periph_t){
+    .pszName = pszName,
+    .uBase = uStart,
+    .uSize = uLen,
+    .pucReset = pucReset
+  };
+  return 1;
+#else
+  (void)uBase;
+  (void)uSize;
+  fprintf(stderr, "CuTest: peripheral simulation is not supported on this host (%s).\n", pszName);
+  return 0;
+#endif /* CUTEST_PERIPH_SUPPORTED */
+}
+
+/*!****************************************************************************
+ * @brief
+ * Set the reset value of a simulated register
+ *
+ * @param[in] uAddr       Register address
+ * @param[in] ulValue     Value after reset
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_SetRegisterReset(uintptr_t uAddr, uint32_t ulValue)
+{
+  cutest_periph_t* psBank = CuTestPeriphFind(uAddr);
+  assert(psBank != NULL);
+
+  memcpy(&psBank->pucReset[uAddr - psBank->uBase], &ulValue, sizeof(ulValue));
+  CuTest_PokeRegister(uAddr, ulValue);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Install read and write hooks for a simulated register
+ *
+ * The read hook receives the current register value and returns the value seen
+ * by the code under test, without changing the register content. Registers
+ * changing on read (e.g. read-to-clear flags) are modelled by poking the new
+ * content from within the read hook. The write hook receives the written value and
+ * returns the value latched into the register. Hooks are removed before each
+ * test case.
+ *
+ * @param[in] uAddr       Register address
+ * @param[in] pfnRead     Read hook (optional)
+ * @param[in] pfnWrite    Write hook (optional)
+ * @param[in] *pUser      User data passed to both hooks
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_HookRegister(uintptr_t uAddr, cutest_reg_hook_fn_t pfnRead, cutest_reg_hook_fn_t pfnWrite, void* pUser)
+{
+  assert(CuTestPeriphFind(uAddr) != NULL);
+
+  uAddr &= ~(uintptr_t)CUTEST_REG_ALIGN;
+  cutest_reg_hook_t* psHook = CuTestPeriphFindHook(uAddr);
+  if (psHook == NULL)
+  {
+    assert(sPeriph.ulNumHooks < CUTEST_MAX_NUM_REG_HOOKS);
+    psHook = &sPeriph.asHooks[sPeriph.ulNumHooks++];
+  }
+
+  *psHook = (cutest_reg_hook_t){ .uAddr = uAddr, .pfnRead = pfnRead, .pfnWrite = pfnWrite, .pUser = pUser };
+}
+
+/*!****************************************************************************
+ * @brief
+ * Write a simulated register without tracing or hooks
+ *
+ * @param[in] uAddr       Register address
+ * @param[in] ulValue     New value
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_PokeRegister(uintptr_t uAddr, uint32_t ulValue)
+{
+  cutest_periph_t* psBank = CuTestPeriphFind(uAddr);
+  assert(psBank != NULL);
+
+  mprotect((void*)psBank->uBase, psBank->uSize, PROT_READ | PROT_WRITE);
+  *(volatile uint32_t*)uAddr = ulValue;
+  mprotect((void*)psBank->uBase, psBank->uSize, PROT_NONE);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Read a simulated register without tracing or hooks
+ *
+ * @param[in] uAddr       Register address
+ * @return  (uint32_t)  Register value
+ * @date  17.10.2026
+ ******************************************************************************/
+uint32_t CuTest_PeekRegister(uintptr_t uAddr)
+{
+  cutest_periph_t* psBank = CuTestPeriphFind(uAddr);
+  assert(psBank != NULL);
+
+  mprotect((void*)psBank->uBase, psBank->uSize, PROT_READ);
+  uint32_t ulValue = *(volatile uint32_t*)uAddr;
+  mprotect((void*)psBank->uBase, psBank->uSize, PROT_NONE);
+
+  return ulValue;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get the register access trace of the current test case
+ *
+ * @param[out] *puCount   Number of recorded accesses (optional)
+ * @return  (const cutest_reg_access_t*)  Access trace
+ * @date  17.10.2026
+ ******************************************************************************/
+const cutest_reg_access_t* CuTest_GetRegisterTrace(size_t* puCount)
+{
+  if (puCount != NULL)
+  {
+    *puCount = (sPeriph.ulNumTrace < CUTEST_MAX_NUM_REG_TRACE) ? sPeriph.ulNumTrace : CUTEST_MAX_NUM_REG_TRACE;
+  }
+
+  return sPeriph.asTrace;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Reset all simulated registers, hooks and the access trace
+ *
+ * Does nothing without mapped peripherals, so that concurrent test runs not
+ * using peripheral simulation do not share any state.
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestResetPeripherals(void)
+{
+  if (sPeriph.ulNumBanks == 0u) return;
+
+  for (unsigned long i = 0; i < sPeriph.ulNumBanks; ++i)
+  {
+    cutest_periph_t* psBank = &sPeriph.asBanks[i];
+    mprotect((void*)psBank->uBase, psBank->uSize, PROT_READ | PROT_WRITE);
+    memcpy((void*)psBank->uBase, psBank->pucReset, psBank->uSize);
+    mprotect((void*)psBank->uBase, psBank->uSize, PROT_NONE);
+  }
+
+  sPeriph.ulNumHooks = 0u;
+  sPeriph.ulNumTrace = 0u;
+  sPeriph.psPending = NULL;
+}
+
+
+/*- Result evaluation functions ----------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Evaluate the sequence of values written to a simulated register
+ *
+ * @note longjmp on mismatch or trace overflow
+ * @param[in] psTc        Test case data
+ * @param[in] *pszFile    File name
+ * @param[in] ulLine      Line number
+ * @param[in] uAddr       Register address
+ * @param[in] *pulExpected  Expected written values (non-null if count > 0)
+ * @param[in] uCount      Number of expected writes
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_EvalAssertRegWrites(cutest_case_ptr_t psTc, const char* pszFile, unsigned long ulLine, uintptr_t uAddr, const uint32_t* pulExpected, size_t uCount)
+{
+  assert(psTc != NULL);
+  assert(pszFile != NULL);
+  assert((pulExpected != NULL) || (uCount == 0u));
+
+  if (sPeriph.ulNumTrace > CUTEST_MAX_NUM_REG_TRACE)
+  {
+    CuTestFail(psTc, pszFile, ulLine, "register trace overflow (%lu accesses)", sPeriph.ulNumTrace);
+  }
+
+  size_t uWrites = 0u;
+  for (unsigned long i = 0; i < sPeriph.ulNumTrace; ++i)
+  {
+    const cutest_reg_access_t* psAccess = &sPeriph.asTrace[i];
+    if (!psAccess->bWrite || (psAccess->ulAddr != (uint32_t)uAddr)) continue;
+
+    if ((uWrites < uCount) && (psAccess->ulValue != pulExpected[uWrites]))
+    {
+      CuTestFail(psTc, pszFile, ulLine, "register <0x%08lX> write %zu: expected <0x%08lX>, but was <0x%08lX>", (unsigned long)uAddr, uWrites, (unsigned long)pulExpected[uWrites], (unsigned long)psAccess->ulValue);
+    }
+    uWrites++;
+  }
+
+  if (uWrites != uCount)
+  {
+    CuTestFail(psTc, pszFile, ulLine, "register <0x%08lX>: expected <%zu> writes, but was <%zu>", (unsigned long)uAddr, uCount, uWrites);
+  }
+
+  CuTestPass(psTc);
+}
@@ -0,0 +1,183 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestPrivate.h
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - framework internals
+ *
+ * Declarations shared between the framework source files. This header is not
+ * part of the public interface and is not installed alongside CuTest.h. This
+ * source file is licensed under The MIT License. See
+ * https://opensource.org/license/mit/ for full license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+#ifndef _CUTEST_PRIVATE_H_
+#define _CUTEST_PRIVATE_H_
+
+/*- Header files -------------------------------------------------------------*/
+#include "CuTest.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Framework-internal variable, excluded from state isolation                */
+#define _PERSISTENT                   CUTEST_PERSISTENT
+
+/*! Noreturn attribute for functions using longjmp                            */
+#define _NORETURN                     __attribute__((noreturn))
+
+/*! Printf-style format checking                                              */
+#define _PRINTF(fmt, args)            __attribute__((format(printf, fmt, args)))
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! Forward declarations                                                      */
+struct tag_cutest_dep_graph_t;
+
+/*! Test cases of a test run in declaration order, or dependency order within
+ *  each root item                                                            */
+typedef struct tag_cutest_run_list_t
+{
+  cutest_case_ptr_t* ppsCases;      ///< Test cases
+  unsigned long ulCount;            ///< Number of test cases
+  unsigned long ulItems;            ///< Number of root items
+  unsigned long* pulItemStart;      ///< First case per root item, plus end
+  struct tag_cutest_dep_graph_t* psDepend; ///< Dependencies, NULL if none
+} cutest_run_list_t;
+
+/*! Parsed test case result record                                            */
+typedef struct tag_cutest_record_t
+{
+  unsigned long ulIndex;            ///< Test case index
+  cutest_result_t eResult;          ///< Result code
+  unsigned long ulMsgLine;          ///< Message line
+  uint64_t ullDuration;             ///< Run time [ns]
+  cutest_usage_t sUsage;            ///< Resource usage
+  const char* pszMsgFile;           ///< Message file name
+  const char* pszMessage;           ///< Message
+  const char* pszOutput;            ///< Captured output, NULL if none
+} cutest_record_t;
+
+/*! Profiled function                                                         */
+typedef struct tag_cutest_profile_func_t
+{
+  char acName[128];                 ///< Function name
+  unsigned long ulSelf;             ///< Samples within the function
+  unsigned long ulTotal;            ///< Samples within the function or callees
+  unsigned long ulStack;            ///< Last stack counted, internal use
+} cutest_profile_func_t;
+
+
+/*- Test hierarchy -----------------------------------------------------------*/
+void        CuTestAddRootNode(cutest_root_ptr_t psRoot, cutest_type_t eType, void* pItem);
+void        CuTestReleaseResults(cutest_root_ptr_t psRoot);
+void        CuTestExpandNodes(cutest_root_ptr_t psRoot);
+const char* CuTestNodeName(const cutest_node_t* psNode);
+
+
+/*- Runtime test registration ------------------------------------------------*/
+void CuTestArenaRelease(cutest_arena_t* psArena);
+
+
+/*- Result evaluation --------------------------------------------------------*/
+void           CuTestPass(cutest_case_ptr_t psTc);
+void _NORETURN CuTestFail(cutest_case_ptr_t psTc, const char* pszFile, unsigned long ulLine, const char* pszFmt, ...) _PRINTF(4, 5);
+
+
+/*- Global state isolation ---------------------------------------------------*/
+void CuTestRestoreState(void);
+
+
+/*- Peripheral simulation ----------------------------------------------------*/
+void CuTestResetPeripherals(void);
+
+
+/*- Output capture -----------------------------------------------------------*/
+void CuTestCaptureBegin(void);
+void CuTestCaptureEnd(cutest_case_ptr_t psTc);
+void CuTestCaptureDetach(void);
+
+
+/*- In-memory file system ----------------------------------------------------*/
+void CuTestResetVfs(void);
+
+
+/*- Per-test coverage --------------------------------------------------------*/
+void        CuTestCoverageBegin(void);
+void        CuTestCoverageEnd(const cutest_case_ptr_t psTc);
+const char* CuTestCoverageDir(void);
+
+
+/*- Resource usage -----------------------------------------------------------*/
+_Bool CuTestUsageEnabled(void);
+void  CuTestUsageBegin(cutest_usage_t* psStart);
+void  CuTestUsageEnd(const cutest_usage_t* psStart, cutest_case_ptr_t psTc);
+void  CuTestPrintUsage(const cutest_root_ptr_t psRoot);
+
+
+/*- Sampling profiler --------------------------------------------------------*/
+void          CuTestProfileBegin(const cutest_case_ptr_t psTc);
+void          CuTestProfileEnd(const cutest_case_ptr_t psTc);
+const char*   CuTestProfileDir(void);
+unsigned long CuTestProfileTop(const cutest_case_ptr_t psTc, char* pszPath, size_t uSize, cutest_profile_func_t* psTop, unsigned long ulMax);
+
+
+/*- Instruction counting -----------------------------------------------------*/
+void  CuTest_InsnMarkBegin(void);
+void  CuTest_InsnMarkEnd(void);
+_Bool CuTestInsnEnabled(void);
+void  CuTestInsnBegin(void);
+void  CuTestInsnEnd(cutest_case_ptr_t psTc);
+
+
+/*- Mutation testing ---------------------------------------------------------*/
+void  CuTestMutationBegin(unsigned long ulItems);
+void  CuTestMutationSetItem(unsigned long ulItem);
+_Bool CuTestMutationEnabled(void);
+
+
+/*- Result records -----------------------------------------------------------*/
+/*! Record parser result: malformed record                                    */
+#define CUTEST_RECORD_INVALID         ((size_t)-1)
+
+_Bool  CuTestRecordWrite(int iFd, unsigned long ulIndex, const cutest_case_ptr_t psTc);
+size_t CuTestRecordParse(const void* pBuf, size_t uLen, unsigned long ulNumCases, cutest_record_t* psRecord);
+void   CuTestRecordApply(const cutest_record_t* psRecord, cutest_case_ptr_t psTc);
+
+
+/*- Test run scheduling ------------------------------------------------------*/
+void     CuTestCountResult(const cutest_case_ptr_t psTc);
+_Bool    CuTestStopRequested(void);
+void     CuTestRunItem(cutest_type_t eType, void* pItem);
+void     CuTestGetRunList(const cutest_root_ptr_t psRoot, cutest_run_list_t* psRun);
+void     CuTestFreeRunList(cutest_run_list_t* psRun);
+uint64_t CuTestRunListHash(const cutest_run_list_t* psRun);
+
+
+/*- Test dependencies --------------------------------------------------------*/
+_Bool         CuTestDependResolve(const cutest_root_ptr_t psRoot, cutest_run_list_t* psRun);
+void          CuTestDependRelease(cutest_run_list_t* psRun);
+unsigned long CuTestDependItem(const cutest_run_list_t* psRun, unsigned long ulPos);
+_Bool         CuTestDependItemReady(const cutest_run_list_t* psRun, unsigned long ulItem);
+_Bool         CuTestDependReady(const cutest_run_list_t* psRun, unsigned long ulCase);
+_Bool         CuTestDependSkip(const cutest_run_list_t* psRun, unsigned long ulCase);
+_Bool         CuTestDependSkipped(const cutest_case_ptr_t psTc);
+
+
+/*- Progress journal ---------------------------------------------------------*/
+void  CuTestJournalBegin(cutest_root_ptr_t psRoot, const cutest_run_list_t* psRun, _Bool* pbSelected);
+void  CuTestJournalWrite(cutest_root_ptr_t psRoot, const cutest_case_ptr_t psTc);
+void  CuTestJournalEnd(cutest_root_ptr_t psRoot);
+
+
+/*- Distributed execution ----------------------------------------------------*/
+_Bool          CuTestRunCoordinator(const char* pszAddress, const cutest_run_list_t* psRun, unsigned long* pulOrder, unsigned long ulNumOrder);
+void _NORETURN CuTestRunWorker(const char* pszAddress, const cutest_run_list_t* psRun);
+
+#endif /* _CUTEST_PRIVATE_H_ */
@@ -0,0 +1,712 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestProfile.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - sampling profiler
+ *
+ * While a test case is running, a CPU time interval timer (ITIMER_PROF)
+ * interrupts the test runner. The signal handler walks the frame pointer
+ * chain of the interrupted code, up to the test runner's frame, into a
+ * preallocated sample buffer. After the test case, the samples are symbolized
+ * and written as folded stacks (one file per test case), as used by flame
+ * graph tools. The code under test must keep frame pointers. Addresses are
+ * named by the dynamic symbol table, or else by the symbol table of the object
+ * file, so static functions are merged as well. This source file is licensed
+ * under The MIT License. See https://opensource.org/license/mit/ for full
+ * license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <assert.h>
+#include <dlfcn.h>
+#include <elf.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <link.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include "CuTestPrivate.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Frame pointer unwinding support                                           */
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+#define CUTEST_PROFILE_SUPPORTED      1u
+#else
+#define CUTEST_PROFILE_SUPPORTED      0u
+#endif
+
+/*! Max. number of samples per test case                                      */
+#define CUTEST_PROFILE_MAX_SAMPLES    16384u
+
+/*! Max. number of frames per sample                                          */
+#define CUTEST_PROFILE_MAX_DEPTH      64u
+
+/*! Max. length of a folded stacks file path                                  */
+#define CUTEST_PROFILE_MAX_PATH       512u
+
+/*! Max. length of a folded stacks line                                       */
+#define CUTEST_PROFILE_MAX_LINE       8192u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! Sampling profiler data                                                    */
+typedef struct tag_cutest_profile_t
+{
+  const char* pszDir;               ///< Output directory, NULL if disabled
+  unsigned uFreq;                   ///< Sampling frequency [Hz]
+  uintptr_t* puFrames;              ///< Sample buffer, max. depth per sample
+  unsigned char* pucDepth;          ///< Number of frames per sample
+  volatile unsigned long ulSamples; ///< Samples taken
+  volatile unsigned long ulDropped; ///< Samples dropped, buffer full
+  uintptr_t uBoundary;              ///< Stack address of the test runner
+  pid_t iTid;                       ///< Thread running the test case
+} cutest_profile_t;
+
+/*! Symbol table of a loaded object file                                      */
+typedef struct tag_cutest_profile_elf_t
+{
+  const void* pBase;                ///< Load address
+  void* pMap;                       ///< Mapped file, NULL if not available
+  size_t uSize;                     ///< Mapped file size
+  const ElfW(Sym)* psSyms;          ///< Symbols, NULL if stripped
+  unsigned long ulNumSyms;          ///< Number of symbols
+  const char* pcStrings;            ///< Symbol name table
+  size_t uStrSize;                  ///< Symbol name table size
+  uintptr_t uBias;                  ///< Offset of symbol values to addresses
+} cutest_profile_elf_t;
+
+/*! Symbol tables loaded while symbolizing the samples of a test case         */
+typedef struct tag_cutest_profile_elfs_t
+{
+  cutest_profile_elf_t* psElfs;     ///< Object files
+  unsigned long ulCount;            ///< Number of object files
+} cutest_profile_elfs_t;
+
+/*! Symbolized code address                                                   */
+typedef struct tag_cutest_profile_sym_t
+{
+  uintptr_t uAddr;                  ///< Code address
+  char* pszName;                    ///< Function name
+} cutest_profile_sym_t;
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static void  CuTestProfileHandler(int iSig, siginfo_t* psInfo, void* pContext);
+static void  CuTestProfileArm(unsigned long ulPeriod);
+static _Bool CuTestProfileGetPath(const cutest_case_ptr_t psTc, char* pszPath, size_t uSize);
+static void  CuTestProfileLoadElf(cutest_profile_elf_t* psElf, const char* pszFile);
+static const char* CuTestProfileFindElf(const cutest_profile_elf_t* psElf, uintptr_t uAddr);
+static char* CuTestProfileSymbolize(uintptr_t uAddr, cutest_profile_elfs_t* psElfs);
+static int   CuTestProfileCompareAddr(const void* pA, const void* pB);
+static int   CuTestProfileCompareLine(const void* pA, const void* pB);
+static int   CuTestProfileCompareFunc(const void* pA, const void* pB);
+static void  CuTestProfileWrite(const cutest_case_ptr_t psTc);
+
+
+/*- Private variables --------------------------------------------------------*/
+/*! Sampling profiler data                                                    */
+static cutest_profile_t sProfile _PERSISTENT;
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Profiling timer signal handler
+ *
+ * Only reads stack memory between the interrupted stack pointer and the test
+ * runner's frame, so frames of code built without frame pointers end the walk
+ * early instead of faulting.
+ *
+ * @param[in] iSig        Signal number
+ * @param[in] *psInfo     Signal information
+ * @param[in] *pContext   Interrupted context
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestProfileHandler(int iSig, siginfo_t* psInfo, void* pContext)
+{
+  (void)iSig;
+  (void)psInfo;
+
+  if ((pid_t)syscall(SYS_gettid) != sProfile.iTid) return;
+  if (sProfile.ulSamples >= CUTEST_PROFILE_MAX_SAMPLES)
+  {
+    sProfile.ulDropped++;
+    return;
+  }
+
+  const ucontext_t* psCtx = (const ucontext_t*)pContext;
+#if defined(__x86_64__)
+  uintptr_t uPc = (uintptr_t)psCtx->uc_mcontext.gregs[REG_RIP];
+  uintptr_t uFp = (uintptr_t)psCtx->uc_mcontext.gregs[REG_RBP];
+  uintptr_t uSp = (uintptr_t)psCtx->uc_mcontext.gregs[REG_RSP];
+#elif defined(__i386__)
+  uintptr_t uPc = (uintptr_t)psCtx->uc_mcontext.gregs[REG_EIP];
+  uintptr_t uFp = (uintptr_t)psCtx->uc_mcontext.gregs[REG_EBP];
+  uintptr_t uSp = (uintptr_t)psCtx->uc_mcontext.gregs[REG_ESP];
+#elif defined(__aarch64__)
+  uintptr_t uPc = (uintptr_t)psCtx->uc_mcontext.pc;
+  uintptr_t uFp = (uintptr_t)psCtx->uc_mcontext.regs[29];
+  uintptr_t uSp = (uintptr_t)psCtx->uc_mcontext.sp;
+#else
+  (void)psCtx;
+  return;
+#endif
+
+  // Frame records: previous frame pointer, followed by the return address
+  uintptr_t* puFrames = &sProfile.puFrames[sProfile.ulSamples * CUTEST_PROFILE_MAX_DEPTH];
+  unsigned uDepth = 0u;
+  puFrames[uDepth++] = uPc;
+  while ((uDepth < CUTEST_PROFILE_MAX_DEPTH) && (uFp >= uSp) && (uFp + 2u * sizeof(uintptr_t) <= sProfile.uBoundary) && ((uFp % sizeof(uintptr_t)) == 0u))
+  {
+    const uintptr_t* puRecord = (const uintptr_t*)uFp;
+    uintptr_t uNext = puRecord[0];
+    if ((uNext <= uFp) || (uNext >= sProfile.uBoundary)) break;
+    puFrames[uDepth++] = puRecord[1];
+    uFp = uNext;
+  }
+
+  sProfile.pucDepth[sProfile.ulSamples] = (unsigned char)uDepth;
+  sProfile.ulSamples++;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start or stop the profiling timer
+ *
+ * @param[in] ulPeriod    Sampling period [us], 0 to stop
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestProfileArm(unsigned long ulPeriod)
+{
+  struct itimerval sTimer = {
+    .it_interval = { .tv_sec = (time_t)(ulPeriod / 1000000u), .tv_usec = (suseconds_t)(ulPeriod % 1000000u) },
+    .it_value    = { .tv_sec = (time_t)(ulPeriod / 1000000u), .tv_usec = (suseconds_t)(ulPeriod % 1000000u) }
+  };
+  setitimer(ITIMER_PROF, &sTimer, NULL);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get the folded stacks file path of a test case
+ *
+ * @param[in] psTc        Test case data
+ * @param[out] *pszPath   Path buffer
+ * @param[in] uSize       Path buffer size
+ * @return  (_Bool)  true, if the path fits into the buffer
+ * @date  17.10.2026
+ ******************************************************************************/
+static _Bool CuTestProfileGetPath(const cutest_case_ptr_t psTc, char* pszPath, size_t uSize)
+{
+  int iLen = snprintf(pszPath, uSize, "%s/%s.folded", sProfile.pszDir, psTc->pszName);
+  if ((iLen < 0) || ((size_t)iLen >= uSize)) return 0;
+
+  // Keep file names usable for test names with special characters
+  for (char* p = &pszPath[strlen(sProfile.pszDir) + 1u]; *p != '\0'; ++p)
+  {
+    if ((*p == '/') || (*p == ' ')) *p = '_';
+  }
+  return 1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Load the symbol table of an object file
+ *
+ * The file is mapped read-only. Without symbol table (stripped file), or if the
+ * file cannot be read, no symbols are loaded.
+ *
+ * @param[inout] psElf    Object file, with the load address set
+ * @param[in] *pszFile    File name
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestProfileLoadElf(cutest_profile_elf_t* psElf, const char* pszFile)
+{
+  int iFd = open(pszFile, O_RDONLY | O_CLOEXEC);
+  if (iFd < 0) return;
+
+  struct stat sStat;
+  void* pMap = MAP_FAILED;
+  if ((fstat(iFd, &sStat) == 0) && ((size_t)sStat.st_size >= sizeof(ElfW(Ehdr))))
+  {
+    pMap = mmap(NULL, (size_t)sStat.st_size, PROT_READ, MAP_PRIVATE, iFd, 0);
+  }
+  close(iFd);
+  if (pMap == MAP_FAILED) return;
+
+  psElf->pMap = pMap;
+  psElf->uSize = (size_t)sStat.st_size;
+
+  // Native object files only, section headers within the file
+  const ElfW(Ehdr)* psHdr = pMap;
+  const unsigned char ucClass = (sizeof(void*) == 8u) ? ELFCLASS64 : ELFCLASS32;
+  if ((memcmp(psHdr->e_ident, ELFMAG, SELFMAG) != 0) || (psHdr->e_ident[EI_CLASS] != ucClass) ||
+      (psHdr->e_shentsize != sizeof(ElfW(Shdr))) || (psHdr->e_shoff > psElf->uSize) ||
+      ((size_t)psHdr->e_shnum > (psElf->uSize - psHdr->e_shoff) / sizeof(ElfW(Shdr)))) return;
+
+  const ElfW(Shdr)* psSections = (const ElfW(Shdr)*)((const char*)pMap + psHdr->e_shoff);
+  for (unsigned i = 0; i < psHdr->e_shnum; ++i)
+  {
+    const ElfW(Shdr)* psSymtab = &psSections[i];
+    if ((psSymtab->sh_type != SHT_SYMTAB) || (psSymtab->sh_link >= psHdr->e_shnum)) continue;
+
+    const ElfW(Shdr)* psStrtab = &psSections[psSymtab->sh_link];
+    if ((psSymtab->sh_offset > psElf->uSize) || (psSymtab->sh_size > psElf->uSize - psSymtab->sh_offset) ||
+        (psStrtab->sh_offset > psElf->uSize) || (psStrtab->sh_size > psElf->uSize - psStrtab->sh_offset)) return;
+
+    psElf->psSyms = (const ElfW(Sym)*)((const char*)pMap + psSymtab->sh_offset);
+    psElf->ulNumSyms = (unsigned long)(psSymtab->sh_size / sizeof(ElfW(Sym)));
+    psElf->pcStrings = (const char*)pMap + psStrtab->sh_offset;
+    psElf->uStrSize = psStrtab->sh_size;
+    psElf->uBias = (psHdr->e_type == ET_DYN) ? (uintptr_t)psElf->pBase : 0u;
+    return;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Find the function containing a code address in a symbol table
+ *
+ * @param[in] psElf       Object file
+ * @param[in] uAddr       Code address
+ * @return  (const char*)  Function name, NULL if not found
+ * @date  17.10.2026
+ ******************************************************************************/
+static const char* CuTestProfileFindElf(const cutest_profile_elf_t* psElf, uintptr_t uAddr)
+{
+  for (unsigned long i = 0; i < psElf->ulNumSyms; ++i)
+  {
+    const ElfW(Sym)* psSym = &psElf->psSyms[i];
+    if ((ELF32_ST_TYPE(psSym->st_info) != STT_FUNC) || (psSym->st_shndx == SHN_UNDEF) || (psSym->st_name >= psElf->uStrSize)) continue;
+
+    const uintptr_t uStart = psElf->uBias + (uintptr_t)psSym->st_value;
+    if ((uAddr >= uStart) && (uAddr - uStart < (uintptr_t)psSym->st_size)) return &psElf->pcStrings[psSym->st_name];
+  }
+
+  return NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get the function name of a code address
+ *
+ * Functions in the dynamic symbol table are named by dladdr, others by the
+ * symbol table of their object file. Addresses in stripped object files are
+ * merged per object file.
+ *
+ * @param[in] uAddr       Code address
+ * @param[inout] psElfs   Symbol tables loaded so far
+ * @return  (char*)  Function name, to be freed by the caller
+ * @date  17.10.2026
+ * @date  17.10.2026  Added object file symbol tables
+ ******************************************************************************/
+static char* CuTestProfileSymbolize(uintptr_t uAddr, cutest_profile_elfs_t* psElfs)
+{
+  Dl_info sInfo;
+  char* pszName = NULL;
+  int iRet;
+
+  if ((dladdr((void*)uAddr, &sInfo) == 0) || (sInfo.dli_fname == NULL))
+  {
+    iRet = asprintf(&pszName, "0x%lx", (unsigned long)uAddr);
+  }
+  else if (sInfo.dli_sname != NULL)
+  {
+    iRet = asprintf(&pszName, "%s", sInfo.dli_sname);
+  }
+  else
+  {
+    // Symbol table of the object file, loaded once
+    cutest_profile_elf_t* psElf = NULL;
+    for (unsigned long i = 0; (i < psElfs->ulCount) && (psElf == NULL); ++i)
+    {
+      if (psElfs->psElfs[i].pBase == sInfo.dli_fbase) psElf = &psElfs->psElfs[i];
+    }
+    if (psElf == NULL)
+    {
+      cutest_profile_elf_t* psNew = realloc(psElfs->psElfs, (psElfs->ulCount + 1u) * sizeof(cutest_profile_elf_t));
+      assert(psNew != NULL);
+      psElfs->psElfs = psNew;
+      psElf = &psNew[psElfs->ulCount++];
+      *psElf = (cutest_profile_elf_t){ .pBase = sInfo.dli_fbase, .pMap = NULL, .psSyms = NULL };
+
+      // The test runner itself may have been started by a relative path
+      Dl_info sSelf;
+      const _Bool bSelf = (dladdr((void*)(uintptr_t)CuTestProfileSymbolize, &sSelf) != 0) && (sSelf.dli_fbase == sInfo.dli_fbase);
+      CuTestProfileLoadElf(psElf, bSelf ? "/proc/self/exe" : sInfo.dli_fname);
+    }
+
+    const char* pszSym = CuTestProfileFindElf(psElf, uAddr);
+    const char* pszFile = strrchr(sInfo.dli_fname, '/');
+    pszFile = (pszFile != NULL) ? pszFile + 1 : sInfo.dli_fname;
+    iRet = (pszSym != NULL) ? asprintf(&pszName, "%s", pszSym) : asprintf(&pszName, "[%s]", pszFile);
+  }
+  if (iRet < 0) return NULL;
+
+  // Frame separator must not appear within names
+  for (char* p = pszName; *p != '\0'; ++p)
+  {
+    if (*p == ';') *p = ':';
+  }
+  return pszName;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Order code addresses, ascending
+ *
+ * @param[in] *pA         Address A
+ * @param[in] *pB         Address B
+ * @return  (int)  Comparison result
+ * @date  17.10.2026
+ ******************************************************************************/
+static int CuTestProfileCompareAddr(const void* pA, const void* pB)
+{
+  uintptr_t uA = *(const uintptr_t*)pA;
+  uintptr_t uB = *(const uintptr_t*)pB;
+
+  return (uA > uB) - (uA < uB);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Order folded stack lines alphabetically
+ *
+ * @param[in] *pA         Line A
+ * @param[in] *pB         Line B
+ * @return  (int)  Comparison result
+ * @date  17.10.2026
+ ******************************************************************************/
+static int CuTestProfileCompareLine(const void* pA, const void* pB)
+{
+  return strcmp(*(char* const*)pA, *(char* const*)pB);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Order functions by self samples, then total samples, highest first
+ *
+ * @param[in] *pA         Function A
+ * @param[in] *pB         Function B
+ * @return  (int)  Comparison result
+ * @date  17.10.2026
+ ******************************************************************************/
+static int CuTestProfileCompareFunc(const void* pA, const void* pB)
+{
+  const cutest_profile_func_t* psA = (const cutest_profile_func_t*)pA;
+  const cutest_profile_func_t* psB = (const cutest_profile_func_t*)pB;
+
+  if (psA->ulSelf != psB->ulSelf) return (psA->ulSelf > psB->ulSelf) ? -1 : 1;
+  if (psA->ulTotal != psB->ulTotal) return (psA->ulTotal > psB->ulTotal) ? -1 : 1;
+  return strcmp(psA->acName, psB->acName);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Write the samples of a test case as folded stacks
+ *
+ * Each line holds the frames of one stack, outermost first and starting with
+ * the test case name, followed by the number of samples.
+ *
+ * @param[in] psTc        Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestProfileWrite(const cutest_case_ptr_t psTc)
+{
+  const unsigned long ulSamples = sProfile.ulSamples;
+  char acPath[CUTEST_PROFILE_MAX_PATH];
+  if (!CuTestProfileGetPath(psTc, acPath, sizeof(acPath))) return;
+
+  // Symbolize each address once, return addresses within the calling line
+  unsigned long ulNumAddr = 0u;
+  uintptr_t* puAddr = malloc((ulSamples * CUTEST_PROFILE_MAX_DEPTH + 1u) * sizeof(uintptr_t));
+  char** ppszLines = calloc(ulSamples + 1u, sizeof(char*));
+  cutest_profile_sym_t* psSyms = NULL;
+  cutest_profile_elfs_t sElfs = { .psElfs = NULL, .ulCount = 0u };
+  if ((puAddr == NULL) || (ppszLines == NULL)) goto cleanup;
+
+  for (unsigned long i = 0; i < ulSamples; ++i)
+  {
+    const uintptr_t* puFrames = &sProfile.puFrames[i * CUTEST_PROFILE_MAX_DEPTH];
+    for (unsigned j = 0; j < sProfile.pucDepth[i]; ++j) puAddr[ulNumAddr++] = puFrames[j] - ((j > 0u) ? 1u : 0u);
+  }
+  qsort(puAddr, ulNumAddr, sizeof(uintptr_t), CuTestProfileCompareAddr);
+
+  unsigned long ulNumSyms = 0u;
+  psSyms = malloc((ulNumAddr + 1u) * sizeof(cutest_profile_sym_t));
+  if (psSyms == NULL) goto cleanup;
+  for (unsigned long i = 0; i < ulNumAddr; ++i)
+  {
+    if ((i > 0u) && (puAddr[i] == puAddr[i - 1u])) continue;
+    psSyms[ulNumSyms++] = (cutest_profile_sym_t){ .uAddr = puAddr[i], .pszName = CuTestProfileSymbolize(puAddr[i], &sElfs) };
+  }
+
+  // One line per sample, merged after sorting
+  for (unsigned long i = 0; i < ulSamples; ++i)
+  {
+    const uintptr_t* puFrames = &sProfile.puFrames[i * CUTEST_PROFILE_MAX_DEPTH];
+    size_t uLen;
+    FILE* f = open_memstream(&ppszLines[i], &uLen);
+    if (f == NULL) continue;
+
+    fputs(psTc->pszName, f);
+    for (unsigned j = sProfile.pucDepth[i]; j > 0u; --j)
+    {
+      uintptr_t uAddr = puFrames[j - 1u] - ((j > 1u) ? 1u : 0u);
+      const cutest_profile_sym_t* psSym = bsearch(&uAddr, psSyms, ulNumSyms, sizeof(cutest_profile_sym_t), CuTestProfileCompareAddr);
+      fprintf(f, ";%s", ((psSym != NULL) && (psSym->pszName != NULL)) ? psSym->pszName : "?");
+    }
+    fclose(f);
+  }
+  qsort(ppszLines, ulSamples, sizeof(char*), CuTestProfileCompareLine);
+
+  FILE* f = fopen(acPath, "w");
+  if (f == NULL) goto cleanup;
+  for (unsigned long i = 0; i < ulSamples; )
+  {
+    unsigned long ulCount = 1u;
+    while ((i + ulCount < ulSamples) && (strcmp(ppszLines[i], ppszLines[i + ulCount]) == 0)) ulCount++;
+    fprintf(f, "%s %lu\n", ppszLines[i], ulCount);
+    i += ulCount;
+  }
+  fclose(f);
+
+cleanup:
+  if (psSyms != NULL)
+  {
+    for (unsigned long i = 0; i < ulNumSyms; ++i) free(psSyms[i].pszName);
+  }
+  if (ppszLines != NULL)
+  {
+    for (unsigned long i = 0; i < ulSamples; ++i) free(ppszLines[i]);
+  }
+  for (unsigned long i = 0; i < sElfs.ulCount; ++i)
+  {
+    if (sElfs.psElfs[i].pMap != NULL) munmap(sElfs.psElfs[i].pMap, sElfs.psElfs[i].uSize);
+  }
+  free(sElfs.psElfs);
+  free(psSyms);
+  free(ppszLines);
+  free(puAddr);
+}
+
+
+/*- Sampling profiler --------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Enable the per-test case sampling profiler
+ *
+ * On hosts without frame pointer unwinding support, a warning is issued and
+ * the profiler stays disabled.
+ *
+ * @param[in] *pszDir     Folded stacks output directory, NULL to disable
+ * @param[in] uFreq       Sampling frequency [Hz]
+ * @date  17.10.2026
+ * @date  17.10.2026  Added i386 support, warning on unsupported hosts
+ ******************************************************************************/
+void CuTest_EnableProfiler(const char* pszDir, unsigned uFreq)
+{
+  if ((pszDir == NULL) || (uFreq == 0u) || (sProfile.pszDir != NULL)) return;
+
+  if (!CUTEST_PROFILE_SUPPORTED)
+  {
+    fprintf(stderr, "%s:0:0: warning: profiler disabled: not supported on this host\n", pszDir);
+    return;
+  }
+
+  if ((mkdir(pszDir, 0755) != 0) && (errno != EEXIST))
+  {
+    fprintf(stderr, "%s:0:0: warning: profiler disabled: %s\n", pszDir, strerror(errno));
+    return;
+  }
+
+  // Sample buffer is preallocated, the signal handler must not allocate
+  uintptr_t* puFrames = calloc((size_t)CUTEST_PROFILE_MAX_SAMPLES * CUTEST_PROFILE_MAX_DEPTH, sizeof(uintptr_t));
+  unsigned char* pucDepth = calloc(CUTEST_PROFILE_MAX_SAMPLES, sizeof(unsigned char));
+  if ((puFrames == NULL) || (pucDepth == NULL))
+  {
+    free(puFrames);
+    free(pucDepth);
+    return;
+  }
+
+  struct sigaction sAction;
+  memset(&sAction, 0, sizeof(sAction));
+  sAction.sa_sigaction = CuTestProfileHandler;
+  sAction.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&sAction.sa_mask);
+  sigaction(SIGPROF, &sAction, NULL);
+
+  sProfile = (cutest_profile_t){
+    .pszDir = pszDir,
+    .uFreq = uFreq,
+    .puFrames = puFrames,
+    .pucDepth = pucDepth,
+    .ulSamples = 0u,
+    .ulDropped = 0u,
+    .uBoundary = 0u,
+    .iTid = 0
+  };
+}
+
+/*!****************************************************************************
+ * @brief
+ * Start sampling before running a test case
+ *
+ * Sampled stacks end below the frame of the calling test runner function.
+ *
+ * @param[in] psTc        Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestProfileBegin(const cutest_case_ptr_t psTc)
+{
+  assert(psTc != NULL);
+
+  if (sProfile.pszDir == NULL) return;
+
+  // Remove stale results, test cases without samples have no file
+  char acPath[CUTEST_PROFILE_MAX_PATH];
+  if (CuTestProfileGetPath(psTc, acPath, sizeof(acPath))) unlink(acPath);
+
+  sProfile.ulSamples = 0u;
+  sProfile.ulDropped = 0u;
+  sProfile.uBoundary = (uintptr_t)__builtin_dwarf_cfa();
+  sProfile.iTid = (pid_t)syscall(SYS_gettid);
+
+  unsigned long ulPeriod = 1000000u / sProfile.uFreq;
+  CuTestProfileArm((ulPeriod > 0u) ? ulPeriod : 1u);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Stop sampling after a test case, write its folded stacks
+ *
+ * @param[in] psTc        Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestProfileEnd(const cutest_case_ptr_t psTc)
+{
+  assert(psTc != NULL);
+
+  if (sProfile.pszDir == NULL) return;
+
+  CuTestProfileArm(0u);
+  sProfile.iTid = 0;
+
+  if (sProfile.ulDropped > 0u)
+  {
+    fprintf(stderr, "%s:%lu:0: warning: %s: %lu profiler samples dropped\n", psTc->pszFile, psTc->ulLine, psTc->pszName, sProfile.ulDropped);
+  }
+  if (sProfile.ulSamples > 0u) CuTestProfileWrite(psTc);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get the folded stacks output directory
+ *
+ * @return  (const char*)  Output directory, NULL if disabled
+ * @date  17.10.2026
+ ******************************************************************************/
+const char* CuTestProfileDir(void)
+{
+  return sProfile.pszDir;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get the functions using most samples of a test case
+ *
+ * Evaluates the folded stacks file of the test case. Samples are counted as
+ * self samples of the innermost function and as total samples of every
+ * function on the stack.
+ *
+ * @param[in] psTc        Test case data
+ * @param[out] *pszPath   Folded stacks file path
+ * @param[in] uSize       Path buffer size
+ * @param[out] psTop      Functions, by self samples
+ * @param[in] ulMax       Max. number of functions
+ * @return  (unsigned long)  Number of functions, 0 if not profiled
+ * @date  17.10.2026
+ ******************************************************************************/
+unsigned long CuTestProfileTop(const cutest_case_ptr_t psTc, char* pszPath, size_t uSize, cutest_profile_func_t* psTop, unsigned long ulMax)
+{
+  assert(psTc != NULL);
+  assert(pszPath != NULL);
+  assert(psTop != NULL);
+
+  if ((sProfile.pszDir == NULL) || !CuTestProfileGetPath(psTc, pszPath, uSize)) return 0u;
+  FILE* f = fopen(pszPath, "r");
+  if (f == NULL) return 0u;
+
+  cutest_profile_func_t* psFuncs = NULL;
+  unsigned long ulNumFuncs = 0u;
+  unsigned long ulMaxFuncs = 0u;
+  unsigned long ulStack = 0u;
+  char* pszLine = malloc(CUTEST_PROFILE_MAX_LINE);
+  while ((pszLine != NULL) && (fgets(pszLine, CUTEST_PROFILE_MAX_LINE, f) != NULL))
+  {
+    char* pszCount = strrchr(pszLine, ' ');
+    if (pszCount == NULL) continue;
+    *pszCount++ = '\0';
+    unsigned long ulCount = strtoul(pszCount, NULL, 10);
+    ulStack++;
+
+    // Skip the test case name, count recursive functions once per stack
+    cutest_profile_func_t* psLast = NULL;
+    char* pszSave = NULL;
+    strtok_r(pszLine, ";", &pszSave);
+    for (char* pszFrame = strtok_r(NULL, ";", &pszSave); pszFrame != NULL; pszFrame = strtok_r(NULL, ";", &pszSave))
+    {
+      cutest_profile_func_t* psFunc = NULL;
+      for (unsigned long i = 0; (i < ulNumFuncs) && (psFunc == NULL); ++i)
+      {
+        if (strncmp(psFuncs[i].acName, pszFrame, sizeof(psFuncs[i].acName) - 1u) == 0) psFunc = &psFuncs[i];
+      }
+      if (psFunc == NULL)
+      {
+        if (ulNumFuncs == ulMaxFuncs)
+        {
+          unsigned long ulNewMax = (ulMaxFuncs == 0u) ? 64u : 2u * ulMaxFuncs;
+          cutest_profile_func_t* psNew = realloc(psFuncs, ulNewMax * sizeof(cutest_profile_func_t));
+          if (psNew == NULL) break;
+          psFuncs = psNew;
+          ulMaxFuncs = ulNewMax;
+        }
+        psFunc = &psFuncs[ulNumFuncs++];
+        *psFunc = (cutest_profile_func_t){ .ulSelf = 0u, .ulTotal = 0u, .ulStack = 0u };
+        strncpy(psFunc->acName, pszFrame, sizeof(psFunc->acName) - 1u);
+      }
+      if (psFunc->ulStack != ulStack)
+      {
+        psFunc->ulTotal += ulCount;
+        psFunc->ulStack = ulStack;
+      }
+      psLast = psFunc;
+    }
+    if (psLast != NULL) psLast->ulSelf += ulCount;
+  }
+  free(pszLine);
+  fclose(f);
+
+  qsort(psFuncs, ulNumFuncs, sizeof(cutest_profile_func_t), CuTestProfileCompareFunc);
+  if (ulNumFuncs > ulMax) ulNumFuncs = ulMax;
+  if (ulNumFuncs > 0u) memcpy(psTop, psFuncs, ulNumFuncs * sizeof(cutest_profile_func_t));
+  free(psFuncs);
+  return ulNumFuncs;
+}
@@ -0,0 +1,200 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestRecord.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - result records
+ *
+ * Serialized test case results, exchanged between the test run and worker
+ * processes. Records are only read by the same test binary, hence use host
+ * byte order. This source file is licensed under The MIT License. See
+ * https://opensource.org/license/mit/ for full license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include "CuTestPrivate.h"
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! Record header, followed by the message file, message and output strings
+ *  (each NUL-terminated)                                                     */
+typedef struct tag_cutest_record_hdr_t
+{
+  uint32_t ulIndex;                 ///< Test case index
+  uint32_t ulResult;                ///< Result code
+  uint32_t ulMsgLine;               ///< Message line
+  uint32_t ulFileLen;               ///< Message file name length
+  uint32_t ulMsgLen;                ///< Message length
+  uint32_t ulOutLen;                ///< Captured output length, 0 if none
+  uint64_t ullDuration;             ///< Run time [ns]
+  cutest_usage_t sUsage;            ///< Resource usage
+} cutest_record_hdr_t;
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static _Bool CuTestRecordAddString(size_t* puLen, uint32_t ulStrLen);
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Add the length of a NUL-terminated string to a record length
+ *
+ * @param[inout] *puLen   Record length
+ * @param[in] ulStrLen    String length, excluding the terminator
+ * @return  (_Bool)  false, if the record length would overflow
+ * @date  17.10.2026
+ ******************************************************************************/
+static _Bool CuTestRecordAddString(size_t* puLen, uint32_t ulStrLen)
+{
+  if ((uintmax_t)ulStrLen >= (uintmax_t)(SIZE_MAX - *puLen)) return 0;
+  *puLen += (size_t)ulStrLen + 1u;
+  return 1;
+}
+
+
+/*- Result records -----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Write the result record of a test case
+ *
+ * @param[in] iFd         Output file descriptor
+ * @param[in] ulIndex     Test case index
+ * @param[in] psTc        Test case data
+ * @return  (_Bool)  true, if the record was written completely
+ * @date  17.10.2026
+ ******************************************************************************/
+_Bool CuTestRecordWrite(int iFd, unsigned long ulIndex, const cutest_case_ptr_t psTc)
+{
+  assert(psTc != NULL);
+
+  const char* pszFile = (psTc->pszMsgFile != NULL) ? psTc->pszMsgFile : "";
+  cutest_record_hdr_t sHdr = {
+    .ulIndex = (uint32_t)ulIndex,
+    .ulResult = (uint32_t)psTc->eResult,
+    .ulMsgLine = (uint32_t)psTc->ulMsgLine,
+    .ulFileLen = (uint32_t)strlen(pszFile),
+    .ulMsgLen = (uint32_t)strnlen(psTc->acMessage, sizeof(psTc->acMessage) - 1u),
+    .ulOutLen = (psTc->pszOutput != NULL) ? (uint32_t)strlen(psTc->pszOutput) : 0u,
+    .ullDuration = psTc->ullDuration,
+    .sUsage = psTc->sUsage
+  };
+
+  size_t uLen = sizeof(sHdr) + sHdr.ulFileLen + sHdr.ulMsgLen + sHdr.ulOutLen + 3u;
+  char* pcBuf = malloc(uLen);
+  if (pcBuf == NULL) return 0;
+
+  char* p = pcBuf;
+  memcpy(p, &sHdr, sizeof(sHdr));                   p += sizeof(sHdr);
+  memcpy(p, pszFile, sHdr.ulFileLen + 1u);          p += sHdr.ulFileLen + 1u;
+  memcpy(p, psTc->acMessage, sHdr.ulMsgLen);        p += sHdr.ulMsgLen;
+  *p++ = '\0';
+  if (sHdr.ulOutLen > 0u) memcpy(p, psTc->pszOutput, sHdr.ulOutLen);
+  p[sHdr.ulOutLen] = '\0';
+
+  // Single write per record, retried on partial writes
+  size_t uDone = 0u;
+  while (uDone < uLen)
+  {
+    ssize_t iRet = write(iFd, &pcBuf[uDone], uLen - uDone);
+    if ((iRet < 0) && (errno == EINTR)) continue;
+    if (iRet <= 0) break;
+    uDone += (size_t)iRet;
+  }
+
+  free(pcBuf);
+  return uDone == uLen;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Parse a result record from a receive buffer
+ *
+ * The string pointers of the record point into the buffer. Records with a
+ * test case index out of range, an unknown result code, string lengths not
+ * representable on the host or strings not NUL-terminated are rejected.
+ *
+ * @param[in] *pBuf       Receive buffer
+ * @param[in] uLen        Number of bytes received
+ * @param[in] ulNumCases  Number of test cases of the run
+ * @param[out] psRecord   Parsed record
+ * @return  (size_t)  Record length, 0 if incomplete, CUTEST_RECORD_INVALID if
+ *                    malformed
+ * @date  17.10.2026
+ * @date  17.10.2026  Added record validation
+ ******************************************************************************/
+size_t CuTestRecordParse(const void* pBuf, size_t uLen, unsigned long ulNumCases, cutest_record_t* psRecord)
+{
+  assert(pBuf != NULL);
+  assert(psRecord != NULL);
+
+  cutest_record_hdr_t sHdr;
+  if (uLen < sizeof(sHdr)) return 0u;
+  memcpy(&sHdr, pBuf, sizeof(sHdr));
+
+  // Index below the number of test cases, hence never ULONG_MAX
+  if ((sHdr.ulIndex >= ulNumCases) || (sHdr.ulResult > EN_CUTEST_RESULT_SKIP)) return CUTEST_RECORD_INVALID;
+
+  size_t uRecLen = sizeof(sHdr);
+  if (!CuTestRecordAddString(&uRecLen, sHdr.ulFileLen) || !CuTestRecordAddString(&uRecLen, sHdr.ulMsgLen) ||
+      !CuTestRecordAddString(&uRecLen, sHdr.ulOutLen) || (uRecLen == CUTEST_RECORD_INVALID)) return CUTEST_RECORD_INVALID;
+  if (uLen < uRecLen) return 0u;
+
+  const char* p = (const char*)pBuf + sizeof(sHdr);
+  if ((p[sHdr.ulFileLen] != '\0') || (p[(size_t)sHdr.ulFileLen + sHdr.ulMsgLen + 1u] != '\0') ||
+      (p[(size_t)sHdr.ulFileLen + sHdr.ulMsgLen + sHdr.ulOutLen + 2u] != '\0')) return CUTEST_RECORD_INVALID;
+
+  *psRecord = (cutest_record_t){
+    .ulIndex = sHdr.ulIndex,
+    .eResult = (cutest_result_t)sHdr.ulResult,
+    .ulMsgLine = sHdr.ulMsgLine,
+    .ullDuration = sHdr.ullDuration,
+    .sUsage = sHdr.sUsage,
+    .pszMsgFile = p,
+    .pszMessage = &p[(size_t)sHdr.ulFileLen + 1u],
+    .pszOutput = (sHdr.ulOutLen > 0u) ? &p[(size_t)sHdr.ulFileLen + sHdr.ulMsgLen + 2u] : NULL
+  };
+
+  return uRecLen;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Apply a parsed result record to a test case
+ *
+ * @param[in] psRecord    Parsed record
+ * @param[out] psTc       Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestRecordApply(const cutest_record_t* psRecord, cutest_case_ptr_t psTc)
+{
+  assert(psRecord != NULL);
+  assert(psTc != NULL);
+
+  psTc->eResult = psRecord->eResult;
+  psTc->ulMsgLine = psRecord->ulMsgLine;
+  psTc->ullDuration = psRecord->ullDuration;
+  psTc->sUsage = psRecord->sUsage;
+  strncpy(psTc->acMessage, psRecord->pszMessage, sizeof(psTc->acMessage) - 1u);
+  psTc->acMessage[sizeof(psTc->acMessage) - 1u] = '\0';
+
+  // Message file names are kept for the lifetime of the test run
+  if (strcmp(psRecord->pszMsgFile, psTc->pszFile) == 0) psTc->pszMsgFile = psTc->pszFile;
+  else psTc->pszMsgFile = strdup(psRecord->pszMsgFile);
+
+  free(psTc->pszOutput);
+  psTc->pszOutput = (psRecord->pszOutput != NULL) ? strdup(psRecord->pszOutput) : NULL;
+}
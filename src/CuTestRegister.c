@@ -0,0 +1,242 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestRegister.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - runtime registration
+ *
+ * Test groups and test cases created at run time, e.g. one test case per input
+ * file. They are allocated from the memory arena of a test run root, in blocks
+ * released with the root, and run like statically defined ones. Group case
+ * lists grow by doubling, so there is no limit on the number of test cases per
+ * group. This source file is licensed under The MIT License. See
+ * https://opensource.org/license/mit/ for full license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+#include "CuTestPrivate.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Arena block size                                                          */
+#define CUTEST_ARENA_BLOCK_SIZE       65536u
+
+/*! Arena allocation alignment, also the size of the block header             */
+#define CUTEST_ARENA_ALIGN            _Alignof(max_align_t)
+
+/*! Initial length of a group case list                                       */
+#define CUTEST_ARENA_MIN_ITEMS        8u
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static void* CuTestArenaAlloc(cutest_arena_t* psArena, size_t uSize);
+static char* CuTestArenaStrdup(cutest_arena_t* psArena, const char* pszText);
+static void  CuTestGroupAppend(cutest_arena_t* psArena, cutest_group_ptr_t psGroup, cutest_case_ptr_t psCase);
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Allocate memory from an arena
+ *
+ * Blocks are linked through their first word. Allocations larger than a block
+ * get a block of their own, linked behind the current one, so that the rest
+ * of the current block is still used.
+ *
+ * @param[inout] psArena  Memory arena
+ * @param[in] uSize       Number of bytes
+ * @return  (void*)  Allocated memory, aligned for any type
+ * @date  17.10.2026
+ ******************************************************************************/
+static void* CuTestArenaAlloc(cutest_arena_t* psArena, size_t uSize)
+{
+  assert(psArena != NULL);
+
+  uSize = (uSize + CUTEST_ARENA_ALIGN - 1u) & ~(CUTEST_ARENA_ALIGN - 1u);
+  if (uSize + CUTEST_ARENA_ALIGN > CUTEST_ARENA_BLOCK_SIZE)
+  {
+    void** ppBlock = malloc(uSize + CUTEST_ARENA_ALIGN);
+    assert(ppBlock != NULL);
+    if (psArena->pBlock != NULL)
+    {
+      *ppBlock = *(void**)psArena->pBlock;
+      *(void**)psArena->pBlock = ppBlock;
+    }
+    else
+    {
+      *ppBlock = NULL;
+      psArena->pBlock = ppBlock;
+      psArena->uUsed = uSize + CUTEST_ARENA_ALIGN;
+      psArena->uSize = uSize + CUTEST_ARENA_ALIGN;
+    }
+    return (uint8_t*)ppBlock + CUTEST_ARENA_ALIGN;
+  }
+
+  if ((psArena->pBlock == NULL) || (psArena->uUsed + uSize > psArena->uSize))
+  {
+    void** ppBlock = malloc(CUTEST_ARENA_BLOCK_SIZE);
+    assert(ppBlock != NULL);
+    *ppBlock = psArena->pBlock;
+    psArena->pBlock = ppBlock;
+    psArena->uUsed = CUTEST_ARENA_ALIGN;
+    psArena->uSize = CUTEST_ARENA_BLOCK_SIZE;
+  }
+
+  void* pMem = (uint8_t*)psArena->pBlock + psArena->uUsed;
+  psArena->uUsed += uSize;
+  return pMem;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Copy a string into an arena
+ *
+ * @param[inout] psArena  Memory arena
+ * @param[in] *pszText    String
+ * @return  (char*)  Copy
+ * @date  17.10.2026
+ ******************************************************************************/
+static char* CuTestArenaStrdup(cutest_arena_t* psArena, const char* pszText)
+{
+  size_t uLen = strlen(pszText) + 1u;
+  char* pszCopy = CuTestArenaAlloc(psArena, uLen);
+  memcpy(pszCopy, pszText, uLen);
+  return pszCopy;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Append a test case to a group created at run time
+ *
+ * The case list holds CUTEST_ARENA_MIN_ITEMS entries, or the next power of two
+ * above the number of test cases. It is full if that number is reached, and
+ * replaced by one of twice the size. The group descriptor is rewritten as a
+ * whole, as its list pointer is read-only.
+ *
+ * @param[inout] psArena  Memory arena
+ * @param[inout] psGroup  Test group
+ * @param[in] psCase      Test case
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestGroupAppend(cutest_arena_t* psArena, cutest_group_ptr_t psGroup, cutest_case_ptr_t psCase)
+{
+  const unsigned long ulNum = psGroup->ulNumItems;
+  if ((ulNum >= CUTEST_ARENA_MIN_ITEMS) && ((ulNum & (ulNum - 1u)) == 0u))
+  {
+    cutest_case_ptr_t* ppItems = CuTestArenaAlloc(psArena, 2u * ulNum * sizeof(cutest_case_ptr_t));
+    memcpy(ppItems, psGroup->ppItems, ulNum * sizeof(cutest_case_ptr_t));
+    memcpy(psGroup, &(cutest_group_t){
+      .pszName = psGroup->pszName,
+      .pszFile = psGroup->pszFile,
+      .ulLine = psGroup->ulLine,
+      .ppItems = ppItems,
+      .ulNumItems = ulNum
+    }, sizeof(cutest_group_t));
+  }
+
+  psGroup->ppItems[ulNum] = psCase;
+  psGroup->ulNumItems = ulNum + 1u;
+}
+
+
+/*- Runtime test registration ------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Release all blocks of a memory arena
+ *
+ * @param[inout] psArena  Memory arena
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestArenaRelease(cutest_arena_t* psArena)
+{
+  assert(psArena != NULL);
+
+  void* pBlock = psArena->pBlock;
+  while (pBlock != NULL)
+  {
+    void* pPrev = *(void**)pBlock;
+    free(pBlock);
+    pBlock = pPrev;
+  }
+  *psArena = (cutest_arena_t){ .pBlock = NULL };
+}
+
+/*!****************************************************************************
+ * @brief
+ * Create an empty test group at run time
+ *
+ * @param[inout] psRoot   Test run root, owning the group
+ * @param[in] *pszFile    File name
+ * @param[in] ulLine      Line number
+ * @param[in] *pszName    Group name, copied
+ * @return  (cutest_group_ptr_t)  Test group
+ * @date  17.10.2026
+ ******************************************************************************/
+cutest_group_ptr_t CuTest_NewGroup(cutest_root_ptr_t psRoot, const char* pszFile, unsigned long ulLine, const char* pszName)
+{
+  assert(psRoot != NULL);
+  assert(pszFile != NULL);
+  assert(pszName != NULL);
+
+  cutest_group_ptr_t psGroup = CuTestArenaAlloc(&psRoot->sArena, sizeof(cutest_group_t));
+  memcpy(psGroup, &(cutest_group_t){
+    .pszName = CuTestArenaStrdup(&psRoot->sArena, pszName),
+    .pszFile = pszFile,
+    .ulLine = ulLine,
+    .ppItems = CuTestArenaAlloc(&psRoot->sArena, CUTEST_ARENA_MIN_ITEMS * sizeof(cutest_case_ptr_t)),
+    .ulNumItems = 0u
+  }, sizeof(cutest_group_t));
+  return psGroup;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Create a test case at run time
+ *
+ * The test function reads the user data from the test case data (_tc->pUser).
+ * Test cases must be added before the test run starts.
+ *
+ * @param[inout] psRoot   Test run root, owning the test case
+ * @param[in] *pszFile    File name
+ * @param[in] ulLine      Line number
+ * @param[inout] psGroup  Group created by CuTest_NewGroup(), or NULL
+ * @param[in] *pszName    Test case name, copied
+ * @param[in] pfvFn       Test function
+ * @param[in] *pUser      User data
+ * @param[in] bPrint      Print the run result to stdout
+ * @return  (cutest_case_ptr_t)  Test case
+ * @date  17.10.2026
+ ******************************************************************************/
+cutest_case_ptr_t CuTest_NewCase(cutest_root_ptr_t psRoot, const char* pszFile, unsigned long ulLine, cutest_group_ptr_t psGroup, const char* pszName, cutest_test_fn_t pfvFn, void* pUser, _Bool bPrint)
+{
+  assert(psRoot != NULL);
+  assert(pszFile != NULL);
+  assert(pszName != NULL);
+  assert(pfvFn != NULL);
+
+  cutest_case_ptr_t psCase = CuTestArenaAlloc(&psRoot->sArena, sizeof(cutest_case_t));
+  memset(psCase, 0, sizeof(cutest_case_t));
+  psCase->pszName = CuTestArenaStrdup(&psRoot->sArena, pszName);
+  psCase->pszFile = pszFile;
+  psCase->ulLine = ulLine;
+  psCase->pfvTestFn = pfvFn;
+  psCase->pUser = pUser;
+  psCase->eResult = EN_CUTEST_RESULT_UNDEF;
+  psCase->pszMsgFile = pszFile;
+  psCase->ulMsgLine = ulLine;
+  psCase->bPrintResult = bPrint;
+
+  if (psGroup != NULL) CuTestGroupAppend(&psRoot->sArena, psGroup, psCase);
+  return psCase;
+}
@@ -0,0 +1,1086 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestRun.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - test run scheduling
+ *
+ * Runs the root items collected by CuTest_AppendRootItem. The run times of all
+ * test cases are kept in a history file between runs. With multiple jobs, root
+ * items are distributed to forked worker processes, longest first. With a time
+ * budget, only the most valuable test cases fitting into the budget are run:
+ * recently failed, changed since their last run, never run, and finally the
+ * ones not run for the longest time. Test cases can also be distributed to
+ * worker processes by a coordinator (see CuTestDistrib.c). With fail-fast, the
+ * test run stops after a number of failed test cases, cancelling the test
+ * cases in flight; all test cases not run are reported as such. Finished test
+ * cases are recorded in a progress journal, if enabled (see CuTestJournal.c).
+ * Declared dependencies (see CuTestDepend.c) hold back root items and test
+ * cases until the ones they depend on are finished, in all execution modes.
+ * Run state is kept in the test run root, so separate roots can be run
+ * concurrently on different threads. This source file is licensed under The
+ * MIT License. See https://opensource.org/license/mit/ for full license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "CuTestPrivate.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Estimated run time of test cases without history [ns]                     */
+#define CUTEST_DEFAULT_DURATION       1000000ull
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! Duration history entry                                                    */
+typedef struct tag_cutest_history_t
+{
+  char* pszName;                    ///< Test case path, escaped
+  uint64_t ullDuration;             ///< Run time [ns]
+  _Bool bFailed;                    ///< Failed in the last run
+  time_t tLastRun;                  ///< Time of the last run
+} cutest_history_t;
+
+/*! Duration history                                                          */
+typedef struct tag_cutest_history_list_t
+{
+  cutest_history_t* psEntries;      ///< Entries, sorted by name
+  size_t uCount;                    ///< Number of entries
+  cutest_history_t** ppsFound;      ///< Entry per test case of the run, or NULL
+} cutest_history_list_t;
+
+/*! Test case selection candidate                                             */
+typedef struct tag_cutest_candidate_t
+{
+  unsigned long ulCase;             ///< Test case index
+  unsigned uValue;                  ///< Selection tier, higher first
+  time_t tLastRun;                  ///< Time of the last run
+  uint64_t ullEstimate;             ///< Estimated run time [ns]
+} cutest_candidate_t;
+
+/*! Forked worker process                                                     */
+typedef struct tag_cutest_worker_t
+{
+  pid_t iPid;                       ///< Process ID, 0 if idle
+  int iFd;                          ///< Result pipe
+  unsigned long ulItem;             ///< Root item
+  unsigned long ulFirst;            ///< First test case run by the worker
+  char* pcBuf;                      ///< Received records
+  size_t uLen;                      ///< Received length
+  _Bool bCancelled;                 ///< Terminated by fail-fast
+  _Bool bMalformed;                 ///< Terminated after a malformed record
+} cutest_worker_t;
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static int              CuTestHistoryCompare(const void* pA, const void* pB);
+static void             CuTestHistoryLoad(const char* pszFile, const cutest_run_list_t* psRun, cutest_history_list_t* psList);
+static cutest_history_t* CuTestHistoryFind(const cutest_history_list_t* psList, const char* pszName);
+static void             CuTestHistorySave(const char* pszFile, cutest_history_list_t* psList, const cutest_run_list_t* psRun);
+static int              CuTestCandidateCompare(const void* pA, const void* pB);
+static void             CuTestSelectBudget(const cutest_root_ptr_t psRoot, const cutest_run_list_t* psRun, const cutest_history_list_t* psHistory, _Bool* pbSelected);
+static uint64_t         CuTestEstimate(const cutest_history_list_t* psHistory, unsigned long ulCase);
+static void             CuTestRunCases(const cutest_run_list_t* psRun, const _Bool* pbSelected, unsigned long ulFirst, unsigned long ulEnd);
+static void             CuTestRunSequential(const cutest_run_list_t* psRun, const _Bool* pbSelected);
+static void             CuTestRunParallel(const cutest_root_ptr_t psRoot, const cutest_run_list_t* psRun, const cutest_history_list_t* psHistory, const _Bool* pbSelected);
+static _Bool            CuTestNextReadyItem(const cutest_run_list_t* psRun, cutest_candidate_t* psItems, unsigned long ulNumItems, unsigned long ulNext);
+static unsigned long    CuTestOrderLongestFirst(const cutest_run_list_t* psRun, const cutest_history_list_t* psHistory, const _Bool* pbSelected, unsigned long* pulOrder);
+static void             CuTestReceiveWorker(const cutest_run_list_t* psRun, cutest_worker_t* psWorker);
+static unsigned long    CuTestCollectWorker(const cutest_run_list_t* psRun, const _Bool* pbSelected, cutest_worker_t* psWorker);
+static _Bool            CuTestStartWorker(const cutest_run_list_t* psRun, const _Bool* pbSelected, cutest_worker_t* psWorker, unsigned long ulItem, unsigned long ulFirst);
+static _Bool            CuTestRunDeferred(const cutest_root_ptr_t psRoot);
+
+
+/*- Private variables --------------------------------------------------------*/
+/*! Test run root of the calling thread, NULL outside CuTest_RunTests         */
+static _Thread_local cutest_root_ptr_t psActiveRoot;
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Order history entries by name
+ *
+ * @param[in] *pA         Entry A
+ * @param[in] *pB         Entry B
+ * @return  (int)  strcmp result
+ * @date  17.10.2026
+ ******************************************************************************/
+static int CuTestHistoryCompare(const void* pA, const void* pB)
+{
+  return strcmp(((const cutest_history_t*)pA)->pszName, ((const cutest_history_t*)pB)->pszName);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Load the duration history file, and look up the test cases of a run
+ *
+ * File format, one line per test case:
+ *   <path> TAB <run time [ns]> TAB <pass|fail> TAB <last run [s since epoch]>
+ *
+ * Test cases are identified by their path in the test hierarchy (see
+ * CuTestExpandNodes), so that equal names in different groups are kept apart.
+ *
+ * @param[in] *pszFile    History file name
+ * @param[in] psRun       Test cases of this run
+ * @param[out] psList     Loaded history
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestHistoryLoad(const char* pszFile, const cutest_run_list_t* psRun, cutest_history_list_t* psList)
+{
+  assert(psList != NULL);
+
+  *psList = (cutest_history_list_t){ .psEntries = NULL, .uCount = 0u, .ppsFound = NULL };
+  if (pszFile == NULL) return;
+
+  psList->ppsFound = calloc(psRun->ulCount + 1u, sizeof(cutest_history_t*));
+  assert(psList->ppsFound != NULL);
+
+  FILE* f = fopen(pszFile, "r");
+  if (f == NULL) return;
+
+  size_t uSize = 0u;
+  char* pszLine = NULL;
+  size_t uLineSize = 0u;
+  while (getline(&pszLine, &uLineSize, f) >= 0)
+  {
+    char* pszTab = strchr(pszLine, '\t');
+    if (pszTab == NULL) continue;
+    *pszTab = '\0';
+
+    unsigned long long ullDuration;
+    char acResult[8];
+    long long llLastRun;
+    if (sscanf(pszTab + 1, "%llu\t%7s\t%lld", &ullDuration, acResult, &llLastRun) != 3) continue;
+
+    if (psList->uCount == uSize)
+    {
+      uSize = (uSize == 0u) ? 64u : 2u * uSize;
+      cutest_history_t* psEntries = realloc(psList->psEntries, uSize * sizeof(cutest_history_t));
+      if (psEntries == NULL) break;
+      psList->psEntries = psEntries;
+    }
+    psList->psEntries[psList->uCount++] = (cutest_history_t){
+      .pszName = strdup(pszLine),
+      .ullDuration = ullDuration,
+      .bFailed = strcmp(acResult, "fail") == 0,
+      .tLastRun = (time_t)llLastRun
+    };
+  }
+  free(pszLine);
+  fclose(f);
+
+  if (psList->uCount > 0u) qsort(psList->psEntries, psList->uCount, sizeof(cutest_history_t), CuTestHistoryCompare);
+  for (unsigned long i = 0; i < psRun->ulCount; ++i) psList->ppsFound[i] = CuTestHistoryFind(psList, psRun->ppsCases[i]->pszPath);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Look up the history entry of a test case
+ *
+ * @param[in] psList      History
+ * @param[in] *pszName    Test case path
+ * @return  (cutest_history_t*)  Entry, NULL if never run
+ * @date  17.10.2026
+ ******************************************************************************/
+static cutest_history_t* CuTestHistoryFind(const cutest_history_list_t* psList, const char* pszName)
+{
+  if (psList->uCount == 0u) return NULL;
+
+  cutest_history_t sKey = { .pszName = (char*)pszName };
+  return bsearch(&sKey, psList->psEntries, psList->uCount, sizeof(cutest_history_t), CuTestHistoryCompare);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Update the history with the test cases run, and write the history file
+ *
+ * Entries of test cases not part of this test run are kept.
+ *
+ * @param[in] *pszFile    History file name
+ * @param[inout] psList   History, freed afterwards
+ * @param[in] psRun       Test cases of this run
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestHistorySave(const char* pszFile, cutest_history_list_t* psList, const cutest_run_list_t* psRun)
+{
+  assert(psList != NULL);
+  assert(psRun != NULL);
+
+  if (pszFile == NULL) return;
+
+  // Unique temporary file, concurrent test runs may share the history file
+  char* pszTemp = NULL;
+  if (asprintf(&pszTemp, "%s.XXXXXX", pszFile) < 0) pszTemp = NULL;
+  int iFd = (pszTemp != NULL) ? mkstemp(pszTemp) : -1;
+  if (iFd >= 0) (void)fchmod(iFd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+  FILE* f = (iFd >= 0) ? fdopen(iFd, "w") : NULL;
+  if ((f == NULL) && (iFd >= 0))
+  {
+    close(iFd);
+    remove(pszTemp);
+  }
+  if (f != NULL)
+  {
+    time_t tNow = time(NULL);
+    _Bool* pbWritten = calloc(psList->uCount + 1u, sizeof(_Bool));
+    assert(pbWritten != NULL);
+
+    for (unsigned long i = 0; i < psRun->ulCount; ++i)
+    {
+      const cutest_case_ptr_t psCase = psRun->ppsCases[i];
+      const cutest_history_t* psEntry = psList->ppsFound[i];
+      if (psEntry != NULL)
+      {
+        // Written once, even if the test case is part of several root items
+        if (pbWritten[psEntry - psList->psEntries]) continue;
+        pbWritten[psEntry - psList->psEntries] = 1;
+      }
+
+      if ((psCase->eResult == EN_CUTEST_RESULT_PASS) || (psCase->eResult == EN_CUTEST_RESULT_FAIL))
+      {
+        fprintf(f, "%s\t%llu\t%s\t%lld\n", psCase->pszPath, (unsigned long long)psCase->ullDuration, (psCase->eResult == EN_CUTEST_RESULT_FAIL) ? "fail" : "pass", (long long)tNow);
+      }
+      else if (psEntry != NULL)
+      {
+        fprintf(f, "%s\t%llu\t%s\t%lld\n", psEntry->pszName, (unsigned long long)psEntry->ullDuration, psEntry->bFailed ? "fail" : "pass", (long long)psEntry->tLastRun);
+      }
+    }
+
+    for (size_t i = 0; i < psList->uCount; ++i)
+    {
+      const cutest_history_t* psEntry = &psList->psEntries[i];
+      if (!pbWritten[i]) fprintf(f, "%s\t%llu\t%s\t%lld\n", psEntry->pszName, (unsigned long long)psEntry->ullDuration, psEntry->bFailed ? "fail" : "pass", (long long)psEntry->tLastRun);
+    }
+
+    free(pbWritten);
+    if ((fclose(f) == 0) && (rename(pszTemp, pszFile) != 0)) remove(pszTemp);
+  }
+  free(pszTemp);
+
+  for (size_t i = 0; i < psList->uCount; ++i) free(psList->psEntries[i].pszName);
+  free(psList->psEntries);
+  free(psList->ppsFound);
+  *psList = (cutest_history_list_t){ .psEntries = NULL, .uCount = 0u, .ppsFound = NULL };
+}
+
+/*!****************************************************************************
+ * @brief
+ * Order time budget candidates: by tier, then least recently run, then
+ * shortest first
+ *
+ * @param[in] *pA         Candidate A
+ * @param[in] *pB         Candidate B
+ * @return  (int)  Sort order
+ * @date  17.10.2026
+ ******************************************************************************/
+static int CuTestCandidateCompare(const void* pA, const void* pB)
+{
+  const cutest_candidate_t* psA = pA;
+  const cutest_candidate_t* psB = pB;
+
+  if (psA->uValue != psB->uValue) return (psA->uValue > psB->uValue) ? -1 : 1;
+  if (psA->tLastRun != psB->tLastRun) return (psA->tLastRun < psB->tLastRun) ? -1 : 1;
+  if (psA->ullEstimate != psB->ullEstimate) return (psA->ullEstimate < psB->ullEstimate) ? -1 : 1;
+  return (psA->ulCase < psB->ulCase) ? -1 : 1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Estimate the run time of a test case
+ *
+ * @param[in] psHistory   Duration history
+ * @param[in] ulCase      Test case index
+ * @return  (uint64_t)  Run time [ns]
+ * @date  17.10.2026
+ ******************************************************************************/
+static uint64_t CuTestEstimate(const cutest_history_list_t* psHistory, unsigned long ulCase)
+{
+  const cutest_history_t* psEntry = (psHistory->ppsFound != NULL) ? psHistory->ppsFound[ulCase] : NULL;
+  return (psEntry != NULL) ? psEntry->ullDuration : CUTEST_DEFAULT_DURATION;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Select the most valuable test cases fitting into the time budget
+ *
+ * Tiers: failed in the last run, source file changed since the last run,
+ * never run, all others.
+ *
+ * @param[in] psRoot      Test run root
+ * @param[in] psRun       Test cases
+ * @param[in] psHistory   Duration history
+ * @param[out] *pbSelected Selection per test case
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestSelectBudget(const cutest_root_ptr_t psRoot, const cutest_run_list_t* psRun, const cutest_history_list_t* psHistory, _Bool* pbSelected)
+{
+  cutest_candidate_t* psCandidates = calloc(psRun->ulCount + 1u, sizeof(cutest_candidate_t));
+  assert(psCandidates != NULL);
+
+  for (unsigned long i = 0; i < psRun->ulCount; ++i)
+  {
+    const cutest_case_ptr_t psCase = psRun->ppsCases[i];
+    const cutest_history_t* psEntry = (psHistory->ppsFound != NULL) ? psHistory->ppsFound[i] : NULL;
+
+    unsigned uValue = 0u;
+    struct stat sStat;
+    if (psEntry == NULL) uValue = 1u;
+    else if (psEntry->bFailed) uValue = 3u;
+    else if ((stat(psCase->pszFile, &sStat) == 0) && (sStat.st_mtime > psEntry->tLastRun)) uValue = 2u;
+
+    psCandidates[i] = (cutest_candidate_t){
+      .ulCase = i,
+      .uValue = uValue,
+      .tLastRun = (psEntry != NULL) ? psEntry->tLastRun : 0,
+      .ullEstimate = CuTestEstimate(psHistory, i)
+    };
+    pbSelected[i] = 0;
+  }
+  qsort(psCandidates, psRun->ulCount, sizeof(cutest_candidate_t), CuTestCandidateCompare);
+
+  // Greedy fill, all jobs contributing to the budget
+  uint64_t ullRemaining = (uint64_t)psRoot->ulTimeBudget * 1000000ull * (psRoot->uJobs > 0u ? psRoot->uJobs : 1u);
+  uint64_t ullPlanned = 0u;
+  unsigned long ulSelected = 0u;
+  for (unsigned long i = 0; i < psRun->ulCount; ++i)
+  {
+    const cutest_candidate_t* psCandidate = &psCandidates[i];
+    if (psCandidate->ullEstimate > ullRemaining) continue;
+
+    ullRemaining -= psCandidate->ullEstimate;
+    ullPlanned += psCandidate->ullEstimate;
+    pbSelected[psCandidate->ulCase] = 1;
+    ulSelected++;
+  }
+
+  printf("CuTest: time budget %.1f s, running %lu of %lu test cases (estimated %.1f s)\n",
+    (double)psRoot->ulTimeBudget / 1e3, ulSelected, psRun->ulCount, (double)ullPlanned / 1e9);
+  free(psCandidates);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Order selected test cases by estimated run time, longest first
+ *
+ * @param[in] psRun       Test cases
+ * @param[in] psHistory   Duration history
+ * @param[in] *pbSelected Selection per test case
+ * @param[out] *pulOrder  Test case indices
+ * @return  (unsigned long)  Number of selected test cases
+ * @date  17.10.2026
+ ******************************************************************************/
+static unsigned long CuTestOrderLongestFirst(const cutest_run_list_t* psRun, const cutest_history_list_t* psHistory, const _Bool* pbSelected, unsigned long* pulOrder)
+{
+  cutest_candidate_t* psCandidates = calloc(psRun->ulCount + 1u, sizeof(cutest_candidate_t));
+  assert(psCandidates != NULL);
+
+  unsigned long ulCount = 0u;
+  for (unsigned long i = 0; i < psRun->ulCount; ++i)
+  {
+    if (!pbSelected[i]) continue;
+
+    // Candidates are ordered shortest first, hence the inverted estimate
+    uint64_t ullEstimate = CuTestEstimate(psHistory, i);
+    psCandidates[ulCount++] = (cutest_candidate_t){ .ulCase = i, .uValue = 0u, .tLastRun = 0, .ullEstimate = UINT64_MAX - ullEstimate };
+  }
+  qsort(psCandidates, ulCount, sizeof(cutest_candidate_t), CuTestCandidateCompare);
+
+  for (unsigned long i = 0; i < ulCount; ++i) pulOrder[i] = psCandidates[i].ulCase;
+  free(psCandidates);
+
+  return ulCount;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run a range of selected test cases in this process, until a stop is
+ * requested. Test cases with a failed dependency are skipped.
+ *
+ * @param[in] psRun       Test cases
+ * @param[in] *pbSelected Selection per test case
+ * @param[in] ulFirst     First test case
+ * @param[in] ulEnd       End of the range (exclusive)
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestRunCases(const cutest_run_list_t* psRun, const _Bool* pbSelected, unsigned long ulFirst, unsigned long ulEnd)
+{
+  for (unsigned long i = ulFirst; i < ulEnd; ++i)
+  {
+    if (pbSelected[i] && !CuTestStopRequested() && !CuTestDependSkip(psRun, i)) CuTest_RunTestCase(psRun->ppsCases[i]);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run selected test cases in declaration order, or dependency order if
+ * declared, until a stop is requested
+ *
+ * @param[in] psRun       Test cases
+ * @param[in] *pbSelected Selection per test case
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestRunSequential(const cutest_run_list_t* psRun, const _Bool* pbSelected)
+{
+  for (unsigned long ulPos = 0; ulPos < psRun->ulItems; ++ulPos)
+  {
+    const unsigned long ulItem = CuTestDependItem(psRun, ulPos);
+    if (CuTestMutationEnabled()) CuTestMutationSetItem(ulItem);
+    CuTestRunCases(psRun, pbSelected, psRun->pulItemStart[ulItem], psRun->pulItemStart[ulItem + 1u]);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Apply the complete records received from a worker. A malformed record
+ * terminates the worker.
+ *
+ * @param[in] psRun       Test cases
+ * @param[inout] psWorker Worker
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestReceiveWorker(const cutest_run_list_t* psRun, cutest_worker_t* psWorker)
+{
+  size_t uPos = 0u;
+  cutest_record_t sRecord;
+  size_t uRecLen;
+  while (!psWorker->bMalformed && ((uRecLen = CuTestRecordParse(&psWorker->pcBuf[uPos], psWorker->uLen - uPos, psRun->ulCount, &sRecord)) > 0u))
+  {
+    if (uRecLen == CUTEST_RECORD_INVALID)
+    {
+      // The record stream is out of sync: stop the worker, and handle it like
+      // a crashed one
+      psWorker->bMalformed = 1;
+      kill(psWorker->iPid, SIGKILL);
+      break;
+    }
+
+    CuTestRecordApply(&sRecord, psRun->ppsCases[sRecord.ulIndex]);
+    CuTestCountResult(psRun->ppsCases[sRecord.ulIndex]);
+    uPos += uRecLen;
+  }
+
+  if (psWorker->bMalformed) uPos = psWorker->uLen;
+  memmove(psWorker->pcBuf, &psWorker->pcBuf[uPos], psWorker->uLen - uPos);
+  psWorker->uLen -= uPos;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Apply the results received from a finished worker
+ *
+ * If the worker crashed, sent a malformed record or exited before reporting
+ * all of its test cases, the test case in flight (the first one without
+ * result) is marked as failed, and the test cases after it are left to be run
+ * by a new worker. Test cases without result of cancelled workers, or workers
+ * stopped by fail-fast, are marked as not run.
+ *
+ * @param[in] psRun       Test cases
+ * @param[in] *pbSelected Selection per test case
+ * @param[inout] psWorker Finished worker
+ * @return  (unsigned long)  First test case still to be run, or the end of
+ *                           the root item
+ * @date  17.10.2026
+ * @date  17.10.2026  Treat early exits as crashes
+ ******************************************************************************/
+static unsigned long CuTestCollectWorker(const cutest_run_list_t* psRun, const _Bool* pbSelected, cutest_worker_t* psWorker)
+{
+  int iStatus = 0;
+  while ((waitpid(psWorker->iPid, &iStatus, 0) < 0) && (errno == EINTR));
+  close(psWorker->iFd);
+  if (psWorker->uLen > 0u) CuTestReceiveWorker(psRun, psWorker);
+
+  // Test case calling exit(0): successful exit, but results missing
+  const _Bool bExited = WIFEXITED(iStatus) && (WEXITSTATUS(iStatus) == EXIT_SUCCESS);
+  const _Bool bCrashed = psWorker->bMalformed || (!psWorker->bCancelled && (!bExited || !CuTestStopRequested()));
+  const unsigned long ulEnd = psRun->pulItemStart[psWorker->ulItem + 1u];
+  unsigned long ulResume = ulEnd;
+  for (unsigned long i = psWorker->ulFirst; i < ulEnd; ++i)
+  {
+    const cutest_case_ptr_t psCase = psRun->ppsCases[i];
+    if (!pbSelected[i] || (psCase->eResult != EN_CUTEST_RESULT_UNDEF)) continue;
+
+    if (bCrashed)
+    {
+      psCase->eResult = EN_CUTEST_RESULT_FAIL;
+      psCase->pszMsgFile = psCase->pszFile;
+      psCase->ulMsgLine = psCase->ulLine;
+      if (psWorker->bMalformed) snprintf(psCase->acMessage, sizeof(psCase->acMessage), "Worker sent a malformed result record");
+      else if (bExited) snprintf(psCase->acMessage, sizeof(psCase->acMessage), "Worker exited before reporting all test cases");
+      else if (WIFSIGNALED(iStatus)) snprintf(psCase->acMessage, sizeof(psCase->acMessage), "Worker terminated by signal %d", WTERMSIG(iStatus));
+      else snprintf(psCase->acMessage, sizeof(psCase->acMessage), "Worker exited with status %d", WEXITSTATUS(iStatus));
+      CuTestCountResult(psCase);
+      ulResume = i + 1u;
+      break;
+    }
+    psCase->eResult = EN_CUTEST_RESULT_SKIP;
+  }
+
+  free(psWorker->pcBuf);
+  *psWorker = (cutest_worker_t){ .iPid = 0, .iFd = -1 };
+  return ulResume;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Fork a worker process running the selected test cases of a root item,
+ * starting at a given test case
+ *
+ * @param[in] psRun       Test cases
+ * @param[in] *pbSelected Selection per test case
+ * @param[out] psWorker   Worker slot
+ * @param[in] ulItem      Root item
+ * @param[in] ulFirst     First test case to run
+ * @return  (_Bool)  false, if the worker could not be started
+ * @date  17.10.2026
+ ******************************************************************************/
+static _Bool CuTestStartWorker(const cutest_run_list_t* psRun, const _Bool* pbSelected, cutest_worker_t* psWorker, unsigned long ulItem, unsigned long ulFirst)
+{
+  int aiPipe[2];
+  if (pipe(aiPipe) != 0) return 0;
+
+  fflush(stdout);
+  fflush(stderr);
+  pid_t iPid = fork();
+  if (iPid == 0)
+  {
+    close(aiPipe[0]);
+    CuTestCaptureDetach();
+    for (unsigned long i = ulFirst; i < psRun->pulItemStart[ulItem + 1u]; ++i)
+    {
+      if (!pbSelected[i] || CuTestStopRequested()) continue;
+      if (!CuTestDependSkip(psRun, i)) CuTest_RunTestCase(psRun->ppsCases[i]);
+      fflush(stdout);
+      CuTestRecordWrite(aiPipe[1], i, psRun->ppsCases[i]);
+    }
+    _exit(EXIT_SUCCESS);
+  }
+
+  close(aiPipe[1]);
+  if (iPid < 0)
+  {
+    close(aiPipe[0]);
+    return 0;
+  }
+  *psWorker = (cutest_worker_t){ .iPid = iPid, .iFd = aiPipe[0], .ulItem = ulItem, .ulFirst = ulFirst, .pcBuf = NULL, .uLen = 0u, .bCancelled = 0, .bMalformed = 0 };
+  return 1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Move the first root item whose dependencies are finished to the front of the
+ * remaining ones
+ *
+ * @param[in] psRun       Test cases
+ * @param[inout] *psItems Root items in start order
+ * @param[in] ulNumItems  Number of root items
+ * @param[in] ulNext      First remaining root item
+ * @return  (_Bool)  true, if a remaining root item may be started
+ * @date  17.10.2026
+ ******************************************************************************/
+static _Bool CuTestNextReadyItem(const cutest_run_list_t* psRun, cutest_candidate_t* psItems, unsigned long ulNumItems, unsigned long ulNext)
+{
+  unsigned long j = ulNext;
+  while ((j < ulNumItems) && !CuTestDependItemReady(psRun, psItems[j].ulCase)) ++j;
+  if (j == ulNumItems) return 0;
+
+  const cutest_candidate_t sItem = psItems[j];
+  memmove(&psItems[ulNext + 1u], &psItems[ulNext], (j - ulNext) * sizeof(cutest_candidate_t));
+  psItems[ulNext] = sItem;
+  return 1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run root items in forked worker processes, longest first. Workers in
+ * flight are terminated when a stop is requested. A worker crashing in a test
+ * case is replaced by a new one, continuing after that test case.
+ *
+ * @param[in] psRoot      Test run root
+ * @param[in] psRun       Test cases
+ * @param[in] psHistory   Duration history
+ * @param[in] *pbSelected Selection per test case
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestRunParallel(const cutest_root_ptr_t psRoot, const cutest_run_list_t* psRun, const cutest_history_list_t* psHistory, const _Bool* pbSelected)
+{
+  // Order root items by estimated run time, longest first
+  cutest_candidate_t* psItems = malloc((psRun->ulItems + 1u) * sizeof(cutest_candidate_t));
+  assert(psItems != NULL);
+  unsigned long ulNumItems = 0u;
+  for (unsigned long ulItem = 0; ulItem < psRun->ulItems; ++ulItem)
+  {
+    uint64_t ullEstimate = 0u;
+    _Bool bAny = 0;
+    for (unsigned long i = psRun->pulItemStart[ulItem]; i < psRun->pulItemStart[ulItem + 1u]; ++i)
+    {
+      if (!pbSelected[i]) continue;
+      ullEstimate += CuTestEstimate(psHistory, i);
+      bAny = 1;
+    }
+    if (bAny) psItems[ulNumItems++] = (cutest_candidate_t){ .ulCase = ulItem, .uValue = 0u, .tLastRun = 0, .ullEstimate = UINT64_MAX - ullEstimate };
+  }
+
+  // Candidates are ordered shortest first, hence the inverted estimate. Equal
+  // estimates keep declaration order.
+  qsort(psItems, ulNumItems, sizeof(cutest_candidate_t), CuTestCandidateCompare);
+
+  unsigned uJobs = psRoot->uJobs;
+  cutest_worker_t* psWorkers = calloc(uJobs, sizeof(cutest_worker_t));
+  struct pollfd* psPoll = calloc(uJobs, sizeof(struct pollfd));
+  assert((psWorkers != NULL) && (psPoll != NULL));
+
+  unsigned long ulNext = 0u;
+  unsigned uRunning = 0u;
+  while (((ulNext < ulNumItems) && !CuTestStopRequested()) || (uRunning > 0u))
+  {
+    // Start workers on idle slots
+    for (unsigned w = 0; (w < uJobs) && (ulNext < ulNumItems) && !CuTestStopRequested(); ++w)
+    {
+      if (psWorkers[w].iPid != 0) continue;
+      if (!CuTestNextReadyItem(psRun, psItems, ulNumItems, ulNext)) break;
+
+      const unsigned long ulItem = psItems[ulNext].ulCase;
+      if (!CuTestStartWorker(psRun, pbSelected, &psWorkers[w], ulItem, psRun->pulItemStart[ulItem])) break;
+      ulNext++;
+      uRunning++;
+    }
+
+    // Fall back to running the remaining items here, if no worker could be started
+    if (uRunning == 0u)
+    {
+      for (; ulNext < ulNumItems; ++ulNext)
+      {
+        CuTestNextReadyItem(psRun, psItems, ulNumItems, ulNext);
+        const unsigned long ulItem = psItems[ulNext].ulCase;
+        CuTestRunCases(psRun, pbSelected, psRun->pulItemStart[ulItem], psRun->pulItemStart[ulItem + 1u]);
+      }
+      break;
+    }
+
+    // Receive results
+    for (unsigned w = 0; w < uJobs; ++w)
+    {
+      psPoll[w] = (struct pollfd){ .fd = (psWorkers[w].iPid != 0) ? psWorkers[w].iFd : -1, .events = POLLIN };
+    }
+    if (poll(psPoll, uJobs, -1) < 0) continue;
+
+    for (unsigned w = 0; w < uJobs; ++w)
+    {
+      if ((psWorkers[w].iPid == 0) || !(psPoll[w].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+
+      cutest_worker_t* psWorker = &psWorkers[w];
+      char acChunk[4096];
+      ssize_t iRead = read(psWorker->iFd, acChunk, sizeof(acChunk));
+      if ((iRead < 0) && (errno == EINTR)) continue;
+      if (iRead > 0)
+      {
+        char* pcBuf = realloc(psWorker->pcBuf, psWorker->uLen + (size_t)iRead);
+        assert(pcBuf != NULL);
+        memcpy(&pcBuf[psWorker->uLen], acChunk, (size_t)iRead);
+        psWorker->pcBuf = pcBuf;
+        psWorker->uLen += (size_t)iRead;
+        CuTestReceiveWorker(psRun, psWorker);
+        continue;
+      }
+
+      // Continue behind a crashed test case in a new worker, or here
+      const unsigned long ulItem = psWorker->ulItem;
+      const unsigned long ulEnd = psRun->pulItemStart[ulItem + 1u];
+      const unsigned long ulResume = CuTestCollectWorker(psRun, pbSelected, psWorker);
+      if ((ulResume < ulEnd) && !CuTestStopRequested() && CuTestStartWorker(psRun, pbSelected, psWorker, ulItem, ulResume)) continue;
+      uRunning--;
+      if (ulResume < ulEnd) CuTestRunCases(psRun, pbSelected, ulResume, ulEnd);
+    }
+
+    // Cancel workers in flight
+    for (unsigned w = 0; (w < uJobs) && CuTestStopRequested(); ++w)
+    {
+      if ((psWorkers[w].iPid == 0) || psWorkers[w].bCancelled) continue;
+      kill(psWorkers[w].iPid, SIGTERM);
+      psWorkers[w].bCancelled = 1;
+    }
+  }
+
+  free(psWorkers);
+  free(psPoll);
+  free(psItems);
+}
+
+
+/*!****************************************************************************
+ * @brief
+ * Check if the root items must be run together by CuTest_RunTests, instead of
+ * on the spot
+ *
+ * @param[in] psRoot      Test run root
+ * @return  (_Bool)  true, if scheduling options, a progress journal, mutants or
+ *                   dependencies require the whole test run
+ * @date  17.10.2026
+ ******************************************************************************/
+static _Bool CuTestRunDeferred(const cutest_root_ptr_t psRoot)
+{
+  return (psRoot->uJobs > 1u) || (psRoot->ulTimeBudget > 0u) || (psRoot->pszCoordinator != NULL) || (psRoot->pszWorker != NULL)
+      || (psRoot->pszJournalFile != NULL) || psRoot->bResume || (psRoot->ulNumDepends > 0u) || CuTestMutationEnabled();
+}
+
+
+/*- Test run scheduling ------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Parse test run command line options
+ *
+ * Options:
+ *   --jobs=N             Run root items in N parallel worker processes
+ *   --time-budget=SEC    Only run the most valuable test cases fitting into
+ *                        the given wall-clock time
+ *   --history=FILE       Duration history file
+ *   --coordinator=ADDR   Hand out test cases to workers connecting to ADDR
+ *   --worker=ADDR        Run test cases handed out by the coordinator at ADDR
+ *   --fail-fast[=N]      Stop the test run after N failed test cases
+ *                        (default: 1)
+ *   --journal=FILE       Progress journal file
+ *   --resume             Skip the test cases finished in the progress journal,
+ *                        and use their recorded results
+ *
+ * @param[inout] psRoot   Test run root
+ * @param[in] argc        Number of arguments
+ * @param[in] *argv       Arguments
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_ParseOptions(cutest_root_ptr_t psRoot, int argc, char* argv[])
+{
+  assert(psRoot != NULL);
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const char* pszArg = argv[i];
+    char* pszEnd = NULL;
+
+    if (strncmp(pszArg, "--jobs=", 7u) == 0)
+    {
+      unsigned long ulJobs = strtoul(&pszArg[7], &pszEnd, 10);
+      if ((*pszEnd != '\0') || (ulJobs == 0u)) pszEnd = NULL;
+      else psRoot->uJobs = (unsigned)ulJobs;
+    }
+    else if (strncmp(pszArg, "--time-budget=", 14u) == 0)
+    {
+      double fBudget = strtod(&pszArg[14], &pszEnd);
+      if ((*pszEnd != '\0') || (fBudget <= 0.0)) pszEnd = NULL;
+      else psRoot->ulTimeBudget = (unsigned long)(fBudget * 1e3);
+    }
+    else if (strncmp(pszArg, "--history=", 10u) == 0)
+    {
+      psRoot->pszHistoryFile = &pszArg[10];
+      pszEnd = "";
+    }
+    else if (strncmp(pszArg, "--coordinator=", 14u) == 0)
+    {
+      psRoot->pszCoordinator = &pszArg[14];
+      pszEnd = "";
+    }
+    else if (strncmp(pszArg, "--worker=", 9u) == 0)
+    {
+      psRoot->pszWorker = &pszArg[9];
+      pszEnd = "";
+    }
+    else if (strcmp(pszArg, "--fail-fast") == 0)
+    {
+      psRoot->ulFailFast = 1u;
+      pszEnd = "";
+    }
+    else if (strncmp(pszArg, "--fail-fast=", 12u) == 0)
+    {
+      unsigned long ulFailFast = strtoul(&pszArg[12], &pszEnd, 10);
+      if ((*pszEnd != '\0') || (ulFailFast == 0u)) pszEnd = NULL;
+      else psRoot->ulFailFast = ulFailFast;
+    }
+    else if (strncmp(pszArg, "--journal=", 10u) == 0)
+    {
+      psRoot->pszJournalFile = &pszArg[10];
+      pszEnd = "";
+    }
+    else if (strcmp(pszArg, "--resume") == 0)
+    {
+      psRoot->bResume = 1;
+      pszEnd = "";
+    }
+
+    if (pszEnd == NULL)
+    {
+      fprintf(stderr, "CuTest: invalid option '%s'\n", pszArg);
+      fprintf(stderr, "usage: %s [--jobs=N] [--time-budget=SEC] [--history=FILE] [--fail-fast[=N]] [--journal=FILE] [--resume] [--coordinator=ADDR | --worker=ADDR]\n", argv[0]);
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  if (psRoot->bResume && (psRoot->pszJournalFile == NULL))
+  {
+    fprintf(stderr, "CuTest: --resume requires a progress journal (--journal=FILE)\n");
+    exit(EXIT_FAILURE);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Count the result of a finished test case, and request a stop of the test
+ * run once the fail-fast limit is reached
+ *
+ * Applies to the test run of the calling thread. The result is also appended to
+ * the progress journal of the test run.
+ *
+ * @param[in] psTc        Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestCountResult(const cutest_case_ptr_t psTc)
+{
+  assert(psTc != NULL);
+
+  cutest_root_ptr_t psRoot = psActiveRoot;
+  if (psRoot == NULL) return;
+  CuTestJournalWrite(psRoot, psTc);
+
+  if ((psTc->eResult != EN_CUTEST_RESULT_FAIL) || (psRoot->ulFailFast == 0u)) return;
+  if (++psRoot->ulFailures >= psRoot->ulFailFast) psRoot->bStop = 1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if a stop of the test run was requested
+ *
+ * @return  (_Bool)  true, if no further test cases shall be run
+ * @date  17.10.2026
+ ******************************************************************************/
+_Bool CuTestStopRequested(void)
+{
+  return (psActiveRoot != NULL) && psActiveRoot->bStop;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Collect all test cases of a test run in declaration order
+ *
+ * @param[in] psRoot      Test run root
+ * @param[out] psRun      Test case list, release with CuTestFreeRunList
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestGetRunList(const cutest_root_ptr_t psRoot, cutest_run_list_t* psRun)
+{
+  assert(psRoot != NULL);
+  assert(psRun != NULL);
+
+  CuTestExpandNodes(psRoot);
+  *psRun = (cutest_run_list_t){
+    .ppsCases = malloc((psRoot->ulNumNodes + 1u) * sizeof(cutest_case_ptr_t)),
+    .ulCount = 0u,
+    .ulItems = psRoot->ulCount,
+    .pulItemStart = malloc((psRoot->ulCount + 1u) * sizeof(unsigned long)),
+    .psDepend = NULL
+  };
+  assert((psRun->ppsCases != NULL) && (psRun->pulItemStart != NULL));
+
+  // Depth-first through the child ranges of each root item
+  unsigned long* pulStack = malloc((psRoot->ulNumNodes + 1u) * sizeof(unsigned long));
+  assert(pulStack != NULL);
+  for (unsigned long ulItem = 0; ulItem < psRoot->ulCount; ++ulItem)
+  {
+    psRun->pulItemStart[ulItem] = psRun->ulCount;
+
+    unsigned long ulDepth = 0u;
+    pulStack[ulDepth++] = ulItem;
+    while (ulDepth > 0u)
+    {
+      const cutest_node_t* psNode = &psRoot->psNodes[pulStack[--ulDepth]];
+      if (psNode->sItem.eType == EN_CUTEST_TYPE_CASE) psRun->ppsCases[psRun->ulCount++] = psNode->psResult;
+      for (unsigned long i = psNode->ulCount; i > 0u; --i) pulStack[ulDepth++] = psNode->ulFirst + i - 1u;
+    }
+  }
+  psRun->pulItemStart[psRoot->ulCount] = psRun->ulCount;
+  free(pulStack);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Release a test case list
+ *
+ * @param[inout] psRun    Test case list
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestFreeRunList(cutest_run_list_t* psRun)
+{
+  assert(psRun != NULL);
+
+  CuTestDependRelease(psRun);
+  free(psRun->ppsCases);
+  free(psRun->pulItemStart);
+  psRun->ppsCases = NULL;
+  psRun->pulItemStart = NULL;
+  psRun->ulCount = 0u;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Hash the names and files of all test cases of a test run, in run order
+ *
+ * @param[in] psRun       Test cases
+ * @return  (uint64_t)  XXH64 hash
+ * @date  17.10.2026
+ ******************************************************************************/
+uint64_t CuTestRunListHash(const cutest_run_list_t* psRun)
+{
+  assert(psRun != NULL);
+
+  cutest_hash_t sHash;
+  CuTest_HashInit(&sHash, EN_CUTEST_HASH_XXH64);
+  for (unsigned long i = 0; i < psRun->ulCount; ++i)
+  {
+    const cutest_case_ptr_t psCase = psRun->ppsCases[i];
+    CuTest_HashUpdate(&sHash, psCase->pszName, strlen(psCase->pszName) + 1u);
+    CuTest_HashUpdate(&sHash, psCase->pszFile, strlen(psCase->pszFile) + 1u);
+  }
+  return CuTest_HashFinal(&sHash);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Append a root item and run its test cases on the spot
+ *
+ * Results are stored in the test case descriptors, and taken over by
+ * CuTest_RunTests, which does not run the item again. If the test run has to
+ * be scheduled as a whole (see CuTestRunDeferred), the item is only appended.
+ *
+ * @param[inout] psRoot   Test run root
+ * @param[in] eType       Item type (Test case, group, module or suite)
+ * @param[in] *pItem      Item data structure pointer
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_RunRootItem(cutest_root_ptr_t psRoot, cutest_type_t eType, void* pItem)
+{
+  assert(psRoot != NULL);
+  assert(pItem != NULL);
+
+  CuTest_AppendRootItem(psRoot, eType, pItem);
+  if (CuTestRunDeferred(psRoot) || (psRoot->ulNumDone + 1u < psRoot->ulCount)) return;
+
+  cutest_root_ptr_t psPrevRoot = psActiveRoot;
+  psActiveRoot = psRoot;
+  CuTestRunItem(eType, pItem);
+  psActiveRoot = psPrevRoot;
+  psRoot->ulNumDone = psRoot->ulCount;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run all root items
+ *
+ * Worker processes (--worker) do not return. With fail-fast, test cases not
+ * run due to the stop are reported as not run. A dependency cycle fails all
+ * test cases without running them. Separate roots may be run concurrently on
+ * different threads. Items already run by CuTest_RunRootItem are not run
+ * again.
+ *
+ * @param[inout] psRoot   Test run root
+ * @date  17.10.2026
+ * @date  17.10.2026  Fail the run on dependency cycles
+ * @date  17.10.2026  Keep the results of items run on the spot
+ ******************************************************************************/
+void CuTest_RunTests(cutest_root_ptr_t psRoot)
+{
+  assert(psRoot != NULL);
+
+  cutest_run_list_t sRun;
+  CuTestGetRunList(psRoot, &sRun);
+  if (!CuTestDependResolve(psRoot, &sRun))
+  {
+    // Dependency cycle, already reported: fail the run without running it
+    for (unsigned long i = 0; i < sRun.ulCount; ++i)
+    {
+      cutest_case_ptr_t psCase = sRun.ppsCases[i];
+      psCase->eResult = EN_CUTEST_RESULT_FAIL;
+      psCase->pszMsgFile = psCase->pszFile;
+      psCase->ulMsgLine = psCase->ulLine;
+      psCase->ullDuration = 0u;
+      snprintf(psCase->acMessage, sizeof(psCase->acMessage), "Dependency cycle");
+    }
+    CuTestFreeRunList(&sRun);
+    return;
+  }
+  if (psRoot->pszWorker != NULL) CuTestRunWorker(psRoot->pszWorker, &sRun);
+
+  cutest_history_list_t sHistory;
+  CuTestHistoryLoad(psRoot->pszHistoryFile, &sRun, &sHistory);
+
+  // Test cases of items run on the spot keep their results
+  const unsigned long ulDone = sRun.pulItemStart[psRoot->ulNumDone];
+  _Bool* pbSelected = malloc((sRun.ulCount + 1u) * sizeof(_Bool));
+  assert(pbSelected != NULL);
+  for (unsigned long i = 0; i < sRun.ulCount; ++i) pbSelected[i] = (i >= ulDone);
+  if (psRoot->ulTimeBudget > 0u) CuTestSelectBudget(psRoot, &sRun, &sHistory, pbSelected);
+
+  for (unsigned long i = ulDone; i < sRun.ulCount; ++i)
+  {
+    cutest_case_ptr_t psCase = sRun.ppsCases[i];
+    psCase->eResult = pbSelected[i] ? EN_CUTEST_RESULT_UNDEF : EN_CUTEST_RESULT_SKIP;
+    psCase->acMessage[0] = '\0';
+    psCase->ullDuration = 0u;
+  }
+  if (ulDone == 0u)
+  {
+    psRoot->ulFailures = 0u;
+    psRoot->bStop = 0;
+  }
+  CuTestJournalBegin(psRoot, &sRun, pbSelected);
+  cutest_root_ptr_t psPrevRoot = psActiveRoot;
+  psActiveRoot = psRoot;
+
+  // Mutant reach recording requires running in this process
+  if (CuTestMutationEnabled()) CuTestMutationBegin(sRun.ulItems);
+  _Bool bDone = 0;
+  if ((psRoot->pszCoordinator != NULL) && !CuTestMutationEnabled())
+  {
+    unsigned long* pulOrder = malloc((sRun.ulCount + 1u) * sizeof(unsigned long));
+    assert(pulOrder != NULL);
+    unsigned long ulNumOrder = CuTestOrderLongestFirst(&sRun, &sHistory, pbSelected, pulOrder);
+    bDone = CuTestRunCoordinator(psRoot->pszCoordinator, &sRun, pulOrder, ulNumOrder);
+    free(pulOrder);
+  }
+  if (!bDone)
+  {
+    if ((psRoot->uJobs > 1u) && !CuTestMutationEnabled()) CuTestRunParallel(psRoot, &sRun, &sHistory, pbSelected);
+    else CuTestRunSequential(&sRun, pbSelected);
+  }
+
+  // Test cases skipped or cancelled by fail-fast were not run
+  if (psRoot->bStop)
+  {
+    for (unsigned long i = 0; i < sRun.ulCount; ++i)
+    {
+      if (sRun.ppsCases[i]->eResult == EN_CUTEST_RESULT_UNDEF) sRun.ppsCases[i]->eResult = EN_CUTEST_RESULT_SKIP;
+    }
+    printf("CuTest: fail-fast, stopped after %lu failed test case%s\n", psRoot->ulFailures, (psRoot->ulFailures == 1u) ? "" : "s");
+  }
+
+  psActiveRoot = psPrevRoot;
+  CuTestJournalEnd(psRoot);
+  CuTestHistorySave(psRoot->pszHistoryFile, &sHistory, &sRun);
+  free(pbSelected);
+  CuTestFreeRunList(&sRun);
+}
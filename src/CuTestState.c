@@ -0,0 +1,368 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestState.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - global state isolation
+ *
+ * Test modules include the application sources, so all test cases share the
+ * application's static variables. This unit takes a snapshot of the writable
+ * data of the test binary (or of a list of registered regions) before the
+ * first test case, and restores it before each test case is run. This source
+ * file is licensed under The MIT License. See
+ * https://opensource.org/license/mit/ for full license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <assert.h>
+#include <link.h>
+#include <stdio.h>
+#include <string.h>
+#include "CuTestPrivate.h"
+
+
+/*- Macros -------------------------------------------------------------------*/
+/*! Copy relocation type of the target architecture                           */
+#if defined(__x86_64__)
+#define CUTEST_R_COPY                 R_X86_64_COPY
+#elif defined(__i386__)
+#define CUTEST_R_COPY                 R_386_COPY
+#elif defined(__aarch64__)
+#define CUTEST_R_COPY                 R_AARCH64_COPY
+#elif defined(__arm__)
+#define CUTEST_R_COPY                 R_ARM_COPY
+#endif
+
+/*! Relocation info field access for the native ELF class                     */
+#if defined(__LP64__)
+#define CUTEST_R_TYPE(info)           ELF64_R_TYPE(info)
+#define CUTEST_R_SYM(info)            ELF64_R_SYM(info)
+#else
+#define CUTEST_R_TYPE(info)           ELF32_R_TYPE(info)
+#define CUTEST_R_SYM(info)            ELF32_R_SYM(info)
+#endif
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! Address range                                                             */
+typedef struct tag_cutest_range_t
+{
+  uintptr_t uStart;                 ///< First address
+  uintptr_t uEnd;                   ///< Address past the last byte
+} cutest_range_t;
+
+/*! Snapshot region                                                           */
+typedef struct tag_cutest_region_t
+{
+  void* pStart;                     ///< Region start address
+  size_t uSize;                     ///< Region size in bytes
+  void* pCopy;                      ///< Snapshot data
+} cutest_region_t;
+
+/*! State isolation data                                                      */
+typedef struct tag_cutest_state_t
+{
+  unsigned long ulCount;            ///< Number of regions
+  cutest_region_t asRegions[CUTEST_MAX_NUM_STATE_REGIONS]; ///< Region list
+  void* pBuffer;                    ///< Snapshot buffer for all regions
+  _Bool bValid;                     ///< Snapshot taken
+} cutest_state_t;
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static uintptr_t      CuTestStateDynPtr(const struct dl_phdr_info* psInfo, ElfW(Addr) uPtr);
+static size_t         CuTestStateCopyRelocs(const struct dl_phdr_info* psInfo, cutest_range_t* psExcl, size_t uMax);
+static void           CuTestStateAddRange(uintptr_t uStart, uintptr_t uEnd, const cutest_range_t* psExcl, size_t uNumExcl);
+static int            CuTestStateDiscoverCb(struct dl_phdr_info* psInfo, size_t uSize, void* pData);
+
+
+/*- Private variables --------------------------------------------------------*/
+/*! Linker-generated bounds of the persistent framework data section          */
+extern char __start_cutest_persist[] __attribute__((weak));
+extern char __stop_cutest_persist[] __attribute__((weak));
+
+/*! State isolation data                                                      */
+static cutest_state_t sState _PERSISTENT;
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Convert an address from the dynamic section into a run-time address
+ *
+ * Depending on the architecture, the dynamic linker relocates the entries of
+ * the dynamic section in place or leaves them relative to the load address.
+ *
+ * @param[in] *psInfo     Loaded object information
+ * @param[in] uPtr        Address from dynamic section entry
+ * @return  (uintptr_t)  Run-time address
+ * @date  17.10.2026
+ ******************************************************************************/
+static uintptr_t CuTestStateDynPtr(const struct dl_phdr_info* psInfo, ElfW(Addr) uPtr)
+{
+  assert(psInfo != NULL);
+
+  return (uPtr < psInfo->dlpi_addr) ? psInfo->dlpi_addr + uPtr : uPtr;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Collect the copy-relocated objects of a loaded object
+ *
+ * Data objects of shared libraries referenced by the program (e.g. environ,
+ * stdout) are copied into the writable segment of the program at load time
+ * and used by the library from there. They belong to the C library state and
+ * must not be restored.
+ *
+ * @param[in] *psInfo     Loaded object information
+ * @param[out] *psExcl    Excluded range list, or NULL to count only
+ * @param[in] uMax        Max. number of ranges to store in list
+ * @return  (size_t)  Number of copy-relocated objects
+ * @date  17.10.2026
+ ******************************************************************************/
+static size_t CuTestStateCopyRelocs(const struct dl_phdr_info* psInfo, cutest_range_t* psExcl, size_t uMax)
+{
+  assert(psInfo != NULL);
+
+#ifdef CUTEST_R_COPY
+  const ElfW(Dyn)* psDyn = NULL;
+  for (size_t i = 0; i < psInfo->dlpi_phnum; ++i)
+  {
+    if (psInfo->dlpi_phdr[i].p_type == PT_DYNAMIC)
+      psDyn = (const ElfW(Dyn)*)(psInfo->dlpi_addr + psInfo->dlpi_phdr[i].p_vaddr);
+  }
+  if (psDyn == NULL) return 0u;
+
+  // Locate symbol and relocation tables
+  const ElfW(Sym)* psSyms = NULL;
+  const ElfW(Rela)* psRela = NULL;
+  const ElfW(Rel)* psRel = NULL;
+  size_t uRelaSize = 0u, uRelSize = 0u;
+  for (; psDyn->d_tag != DT_NULL; ++psDyn)
+  {
+    switch (psDyn->d_tag)
+    {
+      case DT_SYMTAB: psSyms = (const ElfW(Sym)*)CuTestStateDynPtr(psInfo, psDyn->d_un.d_ptr); break;
+      case DT_RELA:   psRela = (const ElfW(Rela)*)CuTestStateDynPtr(psInfo, psDyn->d_un.d_ptr); break;
+      case DT_RELASZ: uRelaSize = psDyn->d_un.d_val; break;
+      case DT_REL:    psRel = (const ElfW(Rel)*)CuTestStateDynPtr(psInfo, psDyn->d_un.d_ptr); break;
+      case DT_RELSZ:  uRelSize = psDyn->d_un.d_val; break;
+      default: break;
+    }
+  }
+  if (psSyms == NULL) return 0u;
+
+  size_t uCount = 0u;
+  for (size_t i = 0; (psRela != NULL) && (i < uRelaSize / sizeof(*psRela)); ++i)
+  {
+    if (CUTEST_R_TYPE(psRela[i].r_info) != CUTEST_R_COPY) continue;
+    if ((psExcl != NULL) && (uCount < uMax))
+    {
+      psExcl[uCount].uStart = psInfo->dlpi_addr + psRela[i].r_offset;
+      psExcl[uCount].uEnd = psExcl[uCount].uStart + psSyms[CUTEST_R_SYM(psRela[i].r_info)].st_size;
+    }
+    ++uCount;
+  }
+  for (size_t i = 0; (psRel != NULL) && (i < uRelSize / sizeof(*psRel)); ++i)
+  {
+    if (CUTEST_R_TYPE(psRel[i].r_info) != CUTEST_R_COPY) continue;
+    if ((psExcl != NULL) && (uCount < uMax))
+    {
+      psExcl[uCount].uStart = psInfo->dlpi_addr + psRel[i].r_offset;
+      psExcl[uCount].uEnd = psExcl[uCount].uStart + psSyms[CUTEST_R_SYM(psRel[i].r_info)].st_size;
+    }
+    ++uCount;
+  }
+
+  return uCount;
+#else
+  (void)psExcl;
+  (void)uMax;
+  return 0u;
+#endif
+}
+
+/*!****************************************************************************
+ * @brief
+ * Register an address range, skipping any excluded sub-ranges
+ *
+ * @param[in] uStart      First address
+ * @param[in] uEnd        Address past the last byte
+ * @param[in] *psExcl     List of excluded ranges
+ * @param[in] uNumExcl    Number of excluded ranges
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestStateAddRange(uintptr_t uStart, uintptr_t uEnd, const cutest_range_t* psExcl, size_t uNumExcl)
+{
+  if (uStart >= uEnd) return;
+
+  for (size_t i = 0; i < uNumExcl; ++i)
+  {
+    if ((psExcl[i].uStart < uEnd) && (psExcl[i].uEnd > uStart))
+    {
+      // Split around the excluded range
+      CuTestStateAddRange(uStart, psExcl[i].uStart, &psExcl[i + 1], uNumExcl - i - 1);
+      CuTestStateAddRange(psExcl[i].uEnd, uEnd, &psExcl[i + 1], uNumExcl - i - 1);
+      return;
+    }
+  }
+
+  CuTest_RegisterStateRegion((void*)uStart, (size_t)(uEnd - uStart));
+}
+
+/*!****************************************************************************
+ * @brief
+ * Program header iteration callback, registers the writable segments of the
+ * test binary
+ *
+ * The RELRO part (read-only after relocation), the persistent framework data
+ * section and copy-relocated shared library objects are excluded. Statically linked binaries are rejected, since
+ * their writable segments contain the C library state.
+ *
+ * @param[in] *psInfo     Loaded object information
+ * @param[in] uSize       Size of info structure
+ * @param[out] *pData     Discovery result (_Bool, true if successful)
+ * @return  (int)  Non-zero to stop iteration
+ * @date  17.10.2026
+ * @date  17.10.2026  Exclude copy-relocated objects
+ ******************************************************************************/
+static int CuTestStateDiscoverCb(struct dl_phdr_info* psInfo, size_t uSize, void* pData)
+{
+  assert(psInfo != NULL);
+  assert(pData != NULL);
+  (void)uSize;
+
+  // Excluded ranges: RELRO segment, framework data and copied library objects
+  const size_t uNumCopies = CuTestStateCopyRelocs(psInfo, NULL, 0u);
+  const size_t uNumExcl = 2u + uNumCopies;
+  cutest_range_t* psExcl = calloc(uNumExcl, sizeof(cutest_range_t));
+  assert(psExcl != NULL);
+  psExcl[1] = (cutest_range_t){ (uintptr_t)__start_cutest_persist, (uintptr_t)__stop_cutest_persist };
+  CuTestStateCopyRelocs(psInfo, &psExcl[2], uNumCopies);
+
+  _Bool bDynamic = 0;
+  for (size_t i = 0; i < psInfo->dlpi_phnum; ++i)
+  {
+    const ElfW(Phdr)* psPhdr = &psInfo->dlpi_phdr[i];
+    if (psPhdr->p_type == PT_INTERP) bDynamic = 1;
+    if (psPhdr->p_type == PT_GNU_RELRO)
+    {
+      psExcl[0].uStart = psInfo->dlpi_addr + psPhdr->p_vaddr;
+      psExcl[0].uEnd = psExcl[0].uStart + psPhdr->p_memsz;
+    }
+  }
+
+  if (bDynamic)
+  {
+    for (size_t i = 0; i < psInfo->dlpi_phnum; ++i)
+    {
+      const ElfW(Phdr)* psPhdr = &psInfo->dlpi_phdr[i];
+      if ((psPhdr->p_type == PT_LOAD) && (psPhdr->p_flags & PF_W))
+      {
+        uintptr_t uStart = psInfo->dlpi_addr + psPhdr->p_vaddr;
+        CuTestStateAddRange(uStart, uStart + psPhdr->p_memsz, psExcl, uNumExcl);
+      }
+    }
+  }
+
+  free(psExcl);
+
+  *(_Bool*)pData = bDynamic;
+
+  // First entry is the main program
+  return 1;
+}
+
+
+/*- Global state isolation ---------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Register a memory region for state isolation
+ *
+ * If no regions are registered before taking the snapshot, the writable data
+ * segments of the test binary are used.
+ *
+ * @param[in] *pStart     Region start address
+ * @param[in] uSize       Region size in bytes
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_RegisterStateRegion(void* pStart, size_t uSize)
+{
+  assert(pStart != NULL);
+  assert(!sState.bValid);
+  assert(sState.ulCount < CUTEST_MAX_NUM_STATE_REGIONS);
+
+  if (uSize == 0u) return;
+  sState.asRegions[sState.ulCount++] = (cutest_region_t){ .pStart = pStart, .uSize = uSize, .pCopy = NULL };
+}
+
+/*!****************************************************************************
+ * @brief
+ * Take a snapshot of all registered regions
+ *
+ * @note Heap memory is not part of the snapshot.
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_SnapshotState(void)
+{
+  if (sState.bValid) return;
+
+  // Default to writable segments of the test binary
+  if (sState.ulCount == 0u)
+  {
+    _Bool bFound = 0;
+    dl_iterate_phdr(CuTestStateDiscoverCb, &bFound);
+    if (!bFound)
+    {
+      fprintf(stderr, "CuTest: state isolation unavailable for static binaries, register regions explicitly.\n");
+      return;
+    }
+  }
+
+  // Allocate single buffer for all copies
+  size_t uTotal = 0u;
+  for (unsigned long i = 0; i < sState.ulCount; ++i) uTotal += sState.asRegions[i].uSize;
+
+  sState.pBuffer = malloc(uTotal);
+  if (sState.pBuffer == NULL)
+  {
+    fprintf(stderr, "CuTest: unable to allocate %zu bytes for state snapshot.\n", uTotal);
+    return;
+  }
+
+  uint8_t* pucCopy = sState.pBuffer;
+  for (unsigned long i = 0; i < sState.ulCount; ++i)
+  {
+    cutest_region_t* psRegion = &sState.asRegions[i];
+    psRegion->pCopy = pucCopy;
+    memcpy(psRegion->pCopy, psRegion->pStart, psRegion->uSize);
+    pucCopy += psRegion->uSize;
+  }
+
+  sState.bValid = 1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Restore the snapshot taken by CuTest_SnapshotState, if available
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestRestoreState(void)
+{
+  if (!sState.bValid) return;
+
+  for (unsigned long i = 0; i < sState.ulCount; ++i)
+  {
+    const cutest_region_t* psRegion = &sState.asRegions[i];
+    memcpy(psRegion->pStart, psRegion->pCopy, psRegion->uSize);
+  }
+}
@@ -0,0 +1,317 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestUsage.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - resource usage
+ *
+ * Records CPU time, page faults, context switches and I/O of the calling
+ * thread around each test case, from getrusage() and /proc/thread-self/io.
+ * The test cases using most of each resource are listed in the summary. This
+ * source file is licensed under The MIT License. See
+ * https://opensource.org/license/mit/ for full license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include "CuTestPrivate.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Per-thread I/O counters, and fallback for kernels before 3.17             */
+#define CUTEST_USAGE_IO_FILE          "/proc/thread-self/io"
+#define CUTEST_USAGE_IO_FILE_PROCESS  "/proc/self/io"
+
+/*! Max. I/O counter file length                                              */
+#define CUTEST_USAGE_IO_MAX_LEN       512u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! Resource usage recording data                                             */
+typedef struct tag_cutest_usage_data_t
+{
+  _Bool bEnabled;                   ///< Recording enabled
+  unsigned uTop;                    ///< Test cases listed per resource
+  const char* pszIoFile;            ///< I/O counter file, NULL if unavailable
+} cutest_usage_data_t;
+
+/*! Resource usage ranking entry                                              */
+typedef struct tag_cutest_usage_rank_t
+{
+  uint64_t ullKey;                  ///< Ranking value
+  cutest_case_ptr_t psCase;         ///< Test case
+} cutest_usage_rank_t;
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static uint64_t CuTestUsageReadIo(const char* pszFile, uint64_t* pullRead, uint64_t* pullWritten);
+static uint64_t CuTestUsageSample(cutest_usage_t* psUsage);
+static uint64_t CuTestUsageDelta(uint64_t ullEnd, uint64_t ullStart);
+static int      CuTestUsageCompare(const void* pA, const void* pB);
+static uint64_t CuTestUsageKey(const cutest_usage_t* psUsage, unsigned uResource);
+
+
+/*- Private variables --------------------------------------------------------*/
+/*! Resource usage recording data                                             */
+static cutest_usage_data_t sUsage _PERSISTENT;
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Read the I/O counters of the calling thread
+ *
+ * Counts all bytes passed through read and write calls, including pipes and
+ * terminals, not only storage accesses. The counters are formatted before the
+ * file is read, reading them is not included.
+ *
+ * @param[in] *pszFile    I/O counter file, NULL if unavailable
+ * @param[out] pullRead   Bytes read
+ * @param[out] pullWritten  Bytes written
+ * @return  (uint64_t)  Bytes read from the I/O counter file
+ * @date  17.10.2026
+ ******************************************************************************/
+static uint64_t CuTestUsageReadIo(const char* pszFile, uint64_t* pullRead, uint64_t* pullWritten)
+{
+  *pullRead = 0u;
+  *pullWritten = 0u;
+  if (pszFile == NULL) return 0u;
+
+  int iFd = open(pszFile, O_RDONLY | O_CLOEXEC);
+  if (iFd < 0) return 0u;
+  char acBuf[CUTEST_USAGE_IO_MAX_LEN];
+  ssize_t iLen = read(iFd, acBuf, sizeof(acBuf) - 1u);
+  close(iFd);
+  if (iLen <= 0) return 0u;
+  acBuf[iLen] = '\0';
+
+  unsigned long long ullRead, ullWritten;
+  if (sscanf(acBuf, "rchar: %llu wchar: %llu", &ullRead, &ullWritten) != 2) return 0u;
+  *pullRead = ullRead;
+  *pullWritten = ullWritten;
+  return (uint64_t)iLen;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Sample the absolute resource counters of the calling thread
+ *
+ * @param[out] psUsage    Counters
+ * @return  (uint64_t)  Bytes read from the I/O counter file
+ * @date  17.10.2026
+ ******************************************************************************/
+static uint64_t CuTestUsageSample(cutest_usage_t* psUsage)
+{
+  struct rusage sRu;
+  memset(&sRu, 0, sizeof(sRu));
+  getrusage(RUSAGE_THREAD, &sRu);
+
+  psUsage->ullUserTime = (uint64_t)sRu.ru_utime.tv_sec * 1000000000ull + (uint64_t)sRu.ru_utime.tv_usec * 1000ull;
+  psUsage->ullSysTime = (uint64_t)sRu.ru_stime.tv_sec * 1000000000ull + (uint64_t)sRu.ru_stime.tv_usec * 1000ull;
+  psUsage->ullMinFlt = (uint64_t)sRu.ru_minflt;
+  psUsage->ullMajFlt = (uint64_t)sRu.ru_majflt;
+  psUsage->ullNvcsw = (uint64_t)sRu.ru_nvcsw;
+  psUsage->ullNivcsw = (uint64_t)sRu.ru_nivcsw;
+  return CuTestUsageReadIo(sUsage.pszIoFile, &psUsage->ullRead, &psUsage->ullWritten);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Counter difference
+ *
+ * @param[in] ullEnd      Counter after the test case
+ * @param[in] ullStart    Counter before the test case
+ * @return  (uint64_t)  Difference, 0 if the counter went backwards
+ * @date  17.10.2026
+ ******************************************************************************/
+static uint64_t CuTestUsageDelta(uint64_t ullEnd, uint64_t ullStart)
+{
+  return (ullEnd > ullStart) ? ullEnd - ullStart : 0u;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Order ranking entries by value, highest first
+ *
+ * @param[in] *pA         Entry A
+ * @param[in] *pB         Entry B
+ * @return  (int)  Comparison result
+ * @date  17.10.2026
+ ******************************************************************************/
+static int CuTestUsageCompare(const void* pA, const void* pB)
+{
+  const cutest_usage_rank_t* psA = (const cutest_usage_rank_t*)pA;
+  const cutest_usage_rank_t* psB = (const cutest_usage_rank_t*)pB;
+
+  if (psA->ullKey != psB->ullKey) return (psA->ullKey > psB->ullKey) ? -1 : 1;
+  return strcmp(psA->psCase->pszName, psB->psCase->pszName);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get the ranking value of a resource
+ *
+ * @param[in] psUsage     Resource usage
+ * @param[in] uResource   0: CPU time, 1: page faults, 2: context switches,
+ *                        3: I/O bytes
+ * @return  (uint64_t)  Ranking value
+ * @date  17.10.2026
+ ******************************************************************************/
+static uint64_t CuTestUsageKey(const cutest_usage_t* psUsage, unsigned uResource)
+{
+  switch (uResource)
+  {
+    case 0u: return psUsage->ullUserTime + psUsage->ullSysTime;
+    case 1u: return psUsage->ullMinFlt + psUsage->ullMajFlt;
+    case 2u: return psUsage->ullNvcsw + psUsage->ullNivcsw;
+    default: return psUsage->ullRead + psUsage->ullWritten;
+  }
+}
+
+
+/*- Resource usage -----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Enable per-test case resource usage recording
+ *
+ * @param[in] uTop        Number of test cases listed per resource in the
+ *                        summary, 0 for none
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_EnableResourceUsage(unsigned uTop)
+{
+  if (sUsage.bEnabled) return;
+
+  const char* pszIoFile = CUTEST_USAGE_IO_FILE;
+  if (access(pszIoFile, R_OK) != 0) pszIoFile = CUTEST_USAGE_IO_FILE_PROCESS;
+  if (access(pszIoFile, R_OK) != 0) pszIoFile = NULL;
+
+  sUsage = (cutest_usage_data_t){
+    .bEnabled = 1,
+    .uTop = uTop,
+    .pszIoFile = pszIoFile
+  };
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if resource usage is recorded
+ *
+ * @return  (_Bool)  true, if enabled
+ * @date  17.10.2026
+ ******************************************************************************/
+_Bool CuTestUsageEnabled(void)
+{
+  return sUsage.bEnabled;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Sample the resource counters before a test case
+ *
+ * @param[out] psStart    Counters before the test case
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestUsageBegin(cutest_usage_t* psStart)
+{
+  assert(psStart != NULL);
+
+  if (!sUsage.bEnabled) return;
+
+  // Reading the I/O counter file is accounted after it has been formatted
+  uint64_t ullCounterRead = CuTestUsageSample(psStart);
+  psStart->ullRead += ullCounterRead;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Store the resource usage of a test case
+ *
+ * @param[in] psStart     Counters before the test case
+ * @param[out] psTc       Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestUsageEnd(const cutest_usage_t* psStart, cutest_case_ptr_t psTc)
+{
+  assert(psStart != NULL);
+  assert(psTc != NULL);
+
+  if (!sUsage.bEnabled) return;
+
+  cutest_usage_t sEnd;
+  (void)CuTestUsageSample(&sEnd);
+  psTc->sUsage = (cutest_usage_t){
+    .ullUserTime = CuTestUsageDelta(sEnd.ullUserTime, psStart->ullUserTime),
+    .ullSysTime = CuTestUsageDelta(sEnd.ullSysTime, psStart->ullSysTime),
+    .ullMinFlt = CuTestUsageDelta(sEnd.ullMinFlt, psStart->ullMinFlt),
+    .ullMajFlt = CuTestUsageDelta(sEnd.ullMajFlt, psStart->ullMajFlt),
+    .ullNvcsw = CuTestUsageDelta(sEnd.ullNvcsw, psStart->ullNvcsw),
+    .ullNivcsw = CuTestUsageDelta(sEnd.ullNivcsw, psStart->ullNivcsw),
+    .ullRead = CuTestUsageDelta(sEnd.ullRead, psStart->ullRead),
+    .ullWritten = CuTestUsageDelta(sEnd.ullWritten, psStart->ullWritten),
+    .ullInsns = psTc->sUsage.ullInsns
+  };
+}
+
+/*!****************************************************************************
+ * @brief
+ * Print the test cases using most of each resource
+ *
+ * @param[in] psRoot      Test run root
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestPrintUsage(const cutest_root_ptr_t psRoot)
+{
+  assert(psRoot != NULL);
+
+  if (!sUsage.bEnabled || (sUsage.uTop == 0u)) return;
+
+  cutest_usage_rank_t* psRank = malloc((psRoot->ulNumNodes + 1u) * sizeof(cutest_usage_rank_t));
+  if (psRank == NULL) return;
+
+  static const char* const apszTitle[] = { "CPU time [ms]", "Page faults", "Context switches", "I/O [bytes]" };
+  for (unsigned uResource = 0u; uResource < sizeof(apszTitle) / sizeof(apszTitle[0]); ++uResource)
+  {
+    unsigned long ulCount = 0u;
+    for (unsigned long i = 0; i < psRoot->ulNumNodes; ++i)
+    {
+      cutest_case_ptr_t psCase = psRoot->psNodes[i].psResult;
+      if (psCase == NULL) continue;
+      if ((psCase->eResult != EN_CUTEST_RESULT_PASS) && (psCase->eResult != EN_CUTEST_RESULT_FAIL)) continue;
+
+      uint64_t ullKey = CuTestUsageKey(&psCase->sUsage, uResource);
+      if (ullKey > 0u) psRank[ulCount++] = (cutest_usage_rank_t){ .ullKey = ullKey, .psCase = psCase };
+    }
+    if (ulCount == 0u) continue;
+    qsort(psRank, ulCount, sizeof(cutest_usage_rank_t), CuTestUsageCompare);
+
+    printf("\n%s, top %u:\n", apszTitle[uResource], sUsage.uTop);
+    for (unsigned long i = 0; (i < ulCount) && (i < sUsage.uTop); ++i)
+    {
+      const cutest_usage_t* psUse = &psRank[i].psCase->sUsage;
+      printf("\t%lu) %s -- ", i + 1u, psRank[i].psCase->pszName);
+      switch (uResource)
+      {
+        case 0u: printf("%.3f (user %.3f, system %.3f)\n", (double)psRank[i].ullKey / 1e6, (double)psUse->ullUserTime / 1e6, (double)psUse->ullSysTime / 1e6); break;
+        case 1u: printf("%llu (major %llu)\n", (unsigned long long)psRank[i].ullKey, (unsigned long long)psUse->ullMajFlt); break;
+        case 2u: printf("%llu (involuntary %llu)\n", (unsigned long long)psRank[i].ullKey, (unsigned long long)psUse->ullNivcsw); break;
+        default: printf("%llu (read %llu, written %llu)\n", (unsigned long long)psRank[i].ullKey, (unsigned long long)psUse->ullRead, (unsigned long long)psUse->ullWritten); break;
+      }
+    }
+  }
+
+  free(psRank);
+}
@@ -0,0 +1,600 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestVector.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - test vector files
+ *
+ * Runs a test case body once per record of a known-answer test vector file.
+ * The file is memory-mapped, records are parsed on demand as they are handed
+ * out, and fields are read in place, without copying. Supported are CAVP-style
+ * "key = value" records separated by blank lines, CSV files with field names
+ * in the first line, and fixed-size binary records. Records can be spread over
+ * several threads. This source file is licensed under The MIT License. See
+ * https://opensource.org/license/mit/ for full license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <assert.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "CuTestPrivate.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Max. number of worker threads                                             */
+#define CUTEST_VEC_MAX_THREADS        64u
+
+/*! Max. length of a numeric field                                            */
+#define CUTEST_VEC_MAX_LEN_NUMBER     32u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! Test vector file parser state                                             */
+typedef struct tag_cutest_vec_cursor_t
+{
+  const cutest_vec_t* psVec;        ///< Test vector file configuration
+  const char* pcBase;               ///< Mapped file
+  size_t uSize;                     ///< File size [bytes]
+  size_t uPos;                      ///< Parse position
+  unsigned long ulLine;             ///< Line number at the parse position
+  unsigned long ulIndex;            ///< Number of records handed out
+  const char* pcSection;            ///< KV: current section lines
+  size_t uSectionSize;              ///< KV: current section size [bytes]
+  const char* pcHeader;             ///< CSV: field name line
+  size_t uHeaderSize;               ///< CSV: field name line size [bytes]
+} cutest_vec_cursor_t;
+
+/*! Test vector run, shared by all worker threads                             */
+typedef struct tag_cutest_vec_run_t
+{
+  cutest_vec_cursor_t sCursor;      ///< Parser state
+  pthread_mutex_t sLock;            ///< Parser and result lock
+  const cutest_case_t* psTc;        ///< Test case data
+  cutest_vec_fn_t pfvFn;            ///< Test case body
+  unsigned long ulRecords;          ///< Number of records run
+  unsigned long ulFailed;           ///< Number of failed records
+  cutest_vec_record_t sFirst;       ///< First failed record
+  char acFirst[CUTEST_MAX_LEN_MESSAGE]; ///< Message of the first failed record
+  const char* pszMsgFile;           ///< Message file of the first failed record
+  unsigned long ulMsgLine;          ///< Message line of the first failed record
+} cutest_vec_run_t;
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static _Bool CuTestVecLine(cutest_vec_cursor_t* psCursor, const char** ppcLine, size_t* puLen);
+static void  CuTestVecTrim(const char** ppcText, size_t* puLen);
+static _Bool CuTestVecNext(cutest_vec_cursor_t* psCursor, cutest_vec_record_t* psRecord);
+static const char* CuTestVecFindKey(const char* pcText, size_t uSize, const char* pszName, size_t* puLen);
+static _Bool CuTestVecCsvField(const char* pcLine, size_t uLen, size_t* puPos, const char** ppcField, size_t* puFieldLen);
+static _Bool CuTestVecRunRecord(cutest_case_ptr_t psTc, cutest_vec_fn_t pfvFn, const cutest_vec_record_t* psRecord);
+static void* CuTestVecWorker(void* pArg);
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Read the next line of a text vector file
+ *
+ * @param[inout] psCursor Parser state
+ * @param[out] *ppcLine   Line start
+ * @param[out] puLen      Line length, without line ending
+ * @return  (_Bool)  false at the end of the file
+ * @date  17.10.2026
+ ******************************************************************************/
+static _Bool CuTestVecLine(cutest_vec_cursor_t* psCursor, const char** ppcLine, size_t* puLen)
+{
+  if (psCursor->uPos >= psCursor->uSize) return 0;
+
+  const char* pcLine = &psCursor->pcBase[psCursor->uPos];
+  const char* pcEnd = memchr(pcLine, '\n', psCursor->uSize - psCursor->uPos);
+  size_t uLen = (pcEnd != NULL) ? (size_t)(pcEnd - pcLine) : psCursor->uSize - psCursor->uPos;
+  psCursor->uPos += uLen + ((pcEnd != NULL) ? 1u : 0u);
+  psCursor->ulLine++;
+
+  if ((uLen > 0u) && (pcLine[uLen - 1u] == '\r')) uLen--;
+  *ppcLine = pcLine;
+  *puLen = uLen;
+  return 1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Remove leading and trailing white space
+ *
+ * @param[inout] *ppcText Text start
+ * @param[inout] puLen    Text length
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestVecTrim(const char** ppcText, size_t* puLen)
+{
+  while ((*puLen > 0u) && isspace((unsigned char)**ppcText))
+  {
+    (*ppcText)++;
+    (*puLen)--;
+  }
+  while ((*puLen > 0u) && isspace((unsigned char)(*ppcText)[*puLen - 1u])) (*puLen)--;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Parse the next record
+ *
+ * KV records are runs of lines, ended by blank lines or section lines ("[...]",
+ * applying to the following records). Comment lines ("#") are skipped in all
+ * text formats. CSV records are single lines, following the field name line.
+ *
+ * @param[inout] psCursor Parser state
+ * @param[out] psRecord   Record
+ * @return  (_Bool)  false if there are no more records
+ * @date  17.10.2026
+ ******************************************************************************/
+static _Bool CuTestVecNext(cutest_vec_cursor_t* psCursor, cutest_vec_record_t* psRecord)
+{
+  const cutest_vec_t* psVec = psCursor->psVec;
+  *psRecord = (cutest_vec_record_t){ .eFormat = psVec->eFormat };
+
+  if (psVec->eFormat == EN_CUTEST_VEC_RAW)
+  {
+    if (psCursor->uSize - psCursor->uPos < psVec->uRecordSize) return 0;
+    psRecord->uOffset = psCursor->uPos;
+    psRecord->pcData = &psCursor->pcBase[psCursor->uPos];
+    psRecord->uSize = psVec->uRecordSize;
+    psCursor->uPos += psVec->uRecordSize;
+    psRecord->ulIndex = ++psCursor->ulIndex;
+    return 1;
+  }
+
+  _Bool bSection = 0;
+  const char* pcLine;
+  size_t uLen;
+  for (;;)
+  {
+    const size_t uLineStart = psCursor->uPos;
+    if (!CuTestVecLine(psCursor, &pcLine, &uLen)) break;
+    const char* pcText = pcLine;
+    size_t uText = uLen;
+    CuTestVecTrim(&pcText, &uText);
+
+    if (uText == 0u)
+    {
+      if (psRecord->pcData != NULL) break;
+      bSection = 0;
+      continue;
+    }
+    if (pcText[0] == '#') continue;
+
+    if (psVec->eFormat == EN_CUTEST_VEC_CSV)
+    {
+      if (psCursor->pcHeader == NULL)
+      {
+        psCursor->pcHeader = pcLine;
+        psCursor->uHeaderSize = uLen;
+        continue;
+      }
+      psRecord->ulLine = psCursor->ulLine;
+      psRecord->uOffset = uLineStart;
+      psRecord->pcData = pcLine;
+      psRecord->uSize = uLen;
+      break;
+    }
+
+    if (pcText[0] == '[')
+    {
+      // Section lines end a record, and are parsed again for the next one
+      if (psRecord->pcData != NULL)
+      {
+        psCursor->uPos = uLineStart;
+        psCursor->ulLine--;
+        break;
+      }
+      if (!bSection) psCursor->pcSection = pcLine;
+      psCursor->uSectionSize = (size_t)(&pcLine[uLen] - psCursor->pcSection);
+      bSection = 1;
+      continue;
+    }
+
+    if (psRecord->pcData == NULL)
+    {
+      psRecord->ulLine = psCursor->ulLine;
+      psRecord->uOffset = uLineStart;
+      psRecord->pcData = pcLine;
+    }
+    psRecord->uSize = (size_t)(&pcLine[uLen] - psRecord->pcData);
+    bSection = 0;
+  }
+
+  if (psRecord->pcData == NULL) return 0;
+  psRecord->pcSection = psCursor->pcSection;
+  psRecord->uSectionSize = psCursor->uSectionSize;
+  psRecord->pcHeader = psCursor->pcHeader;
+  psRecord->uHeaderSize = psCursor->uHeaderSize;
+  psRecord->ulIndex = ++psCursor->ulIndex;
+  return 1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Find a "key = value" line, optionally enclosed in brackets
+ *
+ * @param[in] *pcText     Lines
+ * @param[in] uSize       Size of the lines [bytes]
+ * @param[in] *pszName    Key
+ * @param[out] puLen      Value length
+ * @return  (const char*)  Value, or NULL if not found
+ * @date  17.10.2026
+ ******************************************************************************/
+static const char* CuTestVecFindKey(const char* pcText, size_t uSize, const char* pszName, size_t* puLen)
+{
+  const size_t uName = strlen(pszName);
+  const char* pcEnd = &pcText[uSize];
+  while (pcText < pcEnd)
+  {
+    const char* pcLineEnd = memchr(pcText, '\n', (size_t)(pcEnd - pcText));
+    if (pcLineEnd == NULL) pcLineEnd = pcEnd;
+    const char* pcLine = pcText;
+    size_t uLen = (size_t)(pcLineEnd - pcLine);
+    pcText = pcLineEnd + 1;
+
+    CuTestVecTrim(&pcLine, &uLen);
+    if ((uLen >= 2u) && (pcLine[0] == '[') && (pcLine[uLen - 1u] == ']'))
+    {
+      pcLine++;
+      uLen -= 2u;
+    }
+    const char* pcEq = memchr(pcLine, '=', uLen);
+    if (pcEq == NULL) continue;
+
+    const char* pcKey = pcLine;
+    size_t uKey = (size_t)(pcEq - pcLine);
+    CuTestVecTrim(&pcKey, &uKey);
+    if ((uKey != uName) || (memcmp(pcKey, pszName, uName) != 0)) continue;
+
+    const char* pcValue = pcEq + 1;
+    size_t uValue = (size_t)(&pcLine[uLen] - pcValue);
+    CuTestVecTrim(&pcValue, &uValue);
+    *puLen = uValue;
+    return pcValue;
+  }
+
+  return NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get the next field of a CSV line
+ *
+ * Fields in double quotes may contain commas, the quotes are removed.
+ *
+ * @param[in] *pcLine     Line
+ * @param[in] uLen        Line length
+ * @param[inout] puPos    Parse position, start of the next field
+ * @param[out] *ppcField  Field
+ * @param[out] puFieldLen Field length
+ * @return  (_Bool)  false if there are no more fields
+ * @date  17.10.2026
+ ******************************************************************************/
+static _Bool CuTestVecCsvField(const char* pcLine, size_t uLen, size_t* puPos, const char** ppcField, size_t* puFieldLen)
+{
+  if (*puPos > uLen) return 0;
+
+  size_t uEnd = *puPos;
+  _Bool bQuoted = 0;
+  while ((uEnd < uLen) && (bQuoted || (pcLine[uEnd] != ',')))
+  {
+    if (pcLine[uEnd] == '"') bQuoted = !bQuoted;
+    uEnd++;
+  }
+
+  const char* pcField = &pcLine[*puPos];
+  size_t uField = uEnd - *puPos;
+  CuTestVecTrim(&pcField, &uField);
+  if ((uField >= 2u) && (pcField[0] == '"') && (pcField[uField - 1u] == '"'))
+  {
+    pcField++;
+    uField -= 2u;
+  }
+
+  *ppcField = pcField;
+  *puFieldLen = uField;
+  *puPos = uEnd + 1u;
+  return 1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run the test case body on one record
+ *
+ * @param[inout] psTc     Test case data of the worker
+ * @param[in] pfvFn       Test case body
+ * @param[in] psRecord    Record
+ * @return  (_Bool)  true, if the record failed
+ * @date  17.10.2026
+ ******************************************************************************/
+static _Bool CuTestVecRunRecord(cutest_case_ptr_t psTc, cutest_vec_fn_t pfvFn, const cutest_vec_record_t* psRecord)
+{
+  psTc->eResult = EN_CUTEST_RESULT_UNDEF;
+  if (setjmp(psTc->sEnv) == 0) pfvFn(psTc, psRecord);
+  return psTc->eResult == EN_CUTEST_RESULT_FAIL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run records until all are handed out
+ *
+ * Each worker has its own copy of the test case data, assertions leave the
+ * body of a record using longjmp.
+ *
+ * @param[inout] pArg     Test vector run
+ * @return  (void*)  NULL
+ * @date  17.10.2026
+ ******************************************************************************/
+static void* CuTestVecWorker(void* pArg)
+{
+  cutest_vec_run_t* psRun = pArg;
+  cutest_case_t sTc;
+  memcpy(&sTc, psRun->psTc, sizeof(cutest_case_t));
+  sTc.pfvFailFn = NULL;
+
+  for (;;)
+  {
+    cutest_vec_record_t sRecord;
+    pthread_mutex_lock(&psRun->sLock);
+    _Bool bNext = CuTestVecNext(&psRun->sCursor, &sRecord);
+    if (bNext) psRun->ulRecords++;
+    pthread_mutex_unlock(&psRun->sLock);
+    if (!bNext) break;
+
+    if (!CuTestVecRunRecord(&sTc, psRun->pfvFn, &sRecord)) continue;
+
+    pthread_mutex_lock(&psRun->sLock);
+    if ((psRun->ulFailed++ == 0u) || (sRecord.ulIndex < psRun->sFirst.ulIndex))
+    {
+      psRun->sFirst = sRecord;
+      memcpy(psRun->acFirst, sTc.acMessage, sizeof(psRun->acFirst));
+      psRun->pszMsgFile = sTc.pszMsgFile;
+      psRun->ulMsgLine = sTc.ulMsgLine;
+    }
+    pthread_mutex_unlock(&psRun->sLock);
+  }
+
+  return NULL;
+}
+
+
+/*- Test vectors -------------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Evaluate a test vector case
+ *
+ * All records are run, also after a failed one. The body must be thread-safe
+ * if run by several threads; assertions use longjmp, also in C++ sources.
+ *
+ * @note longjmp on failed records, or if the file cannot be read
+ * @param[in] psTc        Test case data
+ * @param[in] *pszFile    File name
+ * @param[in] ulLine      Line number
+ * @param[in] psVec       Test vector file configuration
+ * @param[in] pfvFn       Test case body
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_EvalVectors(cutest_case_ptr_t psTc, const char* pszFile, unsigned long ulLine, const cutest_vec_t* psVec, cutest_vec_fn_t pfvFn)
+{
+  assert(psTc != NULL);
+  assert(pszFile != NULL);
+  assert(psVec != NULL);
+  assert(psVec->pszPath != NULL);
+  assert(pfvFn != NULL);
+
+  int fd = open(psVec->pszPath, O_RDONLY | O_CLOEXEC);
+  struct stat sStat;
+  if ((fd < 0) || (fstat(fd, &sStat) != 0))
+  {
+    if (fd >= 0) close(fd);
+    CuTestFail(psTc, pszFile, ulLine, "Test vectors: cannot open <%s>", psVec->pszPath);
+  }
+
+  size_t uSize = (size_t)sStat.st_size;
+  void* pMap = (uSize > 0u) ? mmap(NULL, uSize, PROT_READ, MAP_PRIVATE, fd, 0) : NULL;
+  close(fd);
+  if (pMap == MAP_FAILED)
+  {
+    CuTestFail(psTc, pszFile, ulLine, "Test vectors: cannot map <%s>", psVec->pszPath);
+  }
+  if (pMap != NULL) madvise(pMap, uSize, MADV_SEQUENTIAL);
+
+  if ((psVec->eFormat == EN_CUTEST_VEC_RAW) && ((psVec->uRecordSize == 0u) || ((uSize % psVec->uRecordSize) != 0u)))
+  {
+    if (pMap != NULL) munmap(pMap, uSize);
+    CuTestFail(psTc, pszFile, ulLine, "Test vectors: size of <%s> is not a multiple of the record size <%zu>", psVec->pszPath, psVec->uRecordSize);
+  }
+
+  cutest_vec_run_t sRun = {
+    .sCursor = { .psVec = psVec, .pcBase = pMap, .uSize = uSize },
+    .psTc = psTc,
+    .pfvFn = pfvFn
+  };
+  pthread_mutex_init(&sRun.sLock, NULL);
+
+  // The calling thread is one of the workers
+  pthread_t asThreads[CUTEST_VEC_MAX_THREADS];
+  unsigned uThreads = 0u;
+  const unsigned uMax = (psVec->uThreads < CUTEST_VEC_MAX_THREADS) ? psVec->uThreads : CUTEST_VEC_MAX_THREADS;
+  while ((uThreads + 1u < uMax) && (pthread_create(&asThreads[uThreads], NULL, CuTestVecWorker, &sRun) == 0)) uThreads++;
+  CuTestVecWorker(&sRun);
+  for (unsigned i = 0u; i < uThreads; ++i) pthread_join(asThreads[i], NULL);
+
+  pthread_mutex_destroy(&sRun.sLock);
+  if (pMap != NULL) munmap(pMap, uSize);
+
+  if (sRun.ulRecords == 0u)
+  {
+    CuTestFail(psTc, pszFile, ulLine, "Test vectors: no records in <%s>", psVec->pszPath);
+  }
+  if (sRun.ulFailed > 0u)
+  {
+    char acWhere[64];
+    if (psVec->eFormat == EN_CUTEST_VEC_RAW) snprintf(acWhere, sizeof(acWhere), "offset 0x%zX", sRun.sFirst.uOffset);
+    else snprintf(acWhere, sizeof(acWhere), "line %lu", sRun.sFirst.ulLine);
+    CuTestFail(psTc, sRun.pszMsgFile, sRun.ulMsgLine, "Test vectors: %lu of %lu records failed, first record <%lu> (%s %s): %s", sRun.ulFailed, sRun.ulRecords, sRun.sFirst.ulIndex, psVec->pszPath, acWhere, sRun.acFirst);
+  }
+
+  snprintf(psTc->acMessage, sizeof(psTc->acMessage), "%lu records of <%s> passed", sRun.ulRecords, psVec->pszPath);
+  CuTestPass(psTc);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get a field of a test vector record
+ *
+ * KV fields not found in the record are looked up in its section lines, e.g.
+ * "[L = 32]". CSV fields are named in the first line, quoted fields are returned
+ * without the outer quotes, escaped quotes ("") are kept as in the file.
+ * Binary records have no fields.
+ *
+ * @param[in] psRecord    Record
+ * @param[in] *pszName    Field name
+ * @param[out] puLen      Field length, may be NULL
+ * @return  (const char*)  Field value (not terminated), or NULL if not found
+ * @date  17.10.2026
+ ******************************************************************************/
+const char* CuTest_VecField(const cutest_vec_record_t* psRecord, const char* pszName, size_t* puLen)
+{
+  assert(psRecord != NULL);
+  assert(pszName != NULL);
+
+  size_t uLen = 0u;
+  const char* pcValue = NULL;
+  switch (psRecord->eFormat)
+  {
+    case EN_CUTEST_VEC_KV:
+      pcValue = CuTestVecFindKey(psRecord->pcData, psRecord->uSize, pszName, &uLen);
+      if ((pcValue == NULL) && (psRecord->pcSection != NULL)) pcValue = CuTestVecFindKey(psRecord->pcSection, psRecord->uSectionSize, pszName, &uLen);
+      break;
+
+    case EN_CUTEST_VEC_CSV:
+    {
+      const char* pcField;
+      size_t uField, uPos = 0u;
+      unsigned long ulColumn = 0u;
+      _Bool bFound = 0;
+      while (!bFound && CuTestVecCsvField(psRecord->pcHeader, psRecord->uHeaderSize, &uPos, &pcField, &uField))
+      {
+        bFound = (uField == strlen(pszName)) && (memcmp(pcField, pszName, uField) == 0);
+        if (!bFound) ulColumn++;
+      }
+      if (!bFound) break;
+
+      uPos = 0u;
+      for (unsigned long i = 0; i <= ulColumn; ++i)
+      {
+        if (!CuTestVecCsvField(psRecord->pcData, psRecord->uSize, &uPos, &pcField, &uField)) return NULL;
+      }
+      pcValue = pcField;
+      uLen = uField;
+      break;
+    }
+
+    default:;
+  }
+
+  if (puLen != NULL) *puLen = uLen;
+  return pcValue;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get a numeric field of a test vector record (decimal, 0x hexadecimal)
+ *
+ * @note longjmp if the field is missing or not a number
+ * @param[in] psTc        Test case data
+ * @param[in] *pszFile    File name
+ * @param[in] ulLine      Line number
+ * @param[in] psRecord    Record
+ * @param[in] *pszName    Field name
+ * @return  (uint64_t)  Field value
+ * @date  17.10.2026
+ ******************************************************************************/
+uint64_t CuTest_VecInt(cutest_case_ptr_t psTc, const char* pszFile, unsigned long ulLine, const cutest_vec_record_t* psRecord, const char* pszName)
+{
+  assert(psTc != NULL);
+  assert(pszFile != NULL);
+
+  size_t uLen;
+  const char* pcValue = CuTest_VecField(psRecord, pszName, &uLen);
+  if (pcValue == NULL) CuTestFail(psTc, pszFile, ulLine, "Test vector field <%s> missing", pszName);
+
+  char acNumber[CUTEST_VEC_MAX_LEN_NUMBER + 1u];
+  char* pcEnd = acNumber;
+  unsigned long long ullValue = 0u;
+  if ((uLen > 0u) && (uLen <= CUTEST_VEC_MAX_LEN_NUMBER) && (pcValue[0] != '-'))
+  {
+    memcpy(acNumber, pcValue, uLen);
+    acNumber[uLen] = '\0';
+    ullValue = strtoull(acNumber, &pcEnd, 0);
+  }
+  if ((pcEnd == acNumber) || (*pcEnd != '\0'))
+  {
+    CuTestFail(psTc, pszFile, ulLine, "Test vector field <%s> is not a number: <%.*s>", pszName, (int)((uLen < 32u) ? uLen : 32u), pcValue);
+  }
+  return (uint64_t)ullValue;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Decode a hexadecimal field of a test vector record
+ *
+ * @note longjmp if the field is missing, not hexadecimal or too long
+ * @param[in] psTc        Test case data
+ * @param[in] *pszFile    File name
+ * @param[in] ulLine      Line number
+ * @param[in] psRecord    Record
+ * @param[in] *pszName    Field name
+ * @param[out] *pBuf      Decoded bytes
+ * @param[in] uSize       Buffer size [bytes]
+ * @return  (size_t)  Number of decoded bytes
+ * @date  17.10.2026
+ ******************************************************************************/
+size_t CuTest_VecHex(cutest_case_ptr_t psTc, const char* pszFile, unsigned long ulLine, const cutest_vec_record_t* psRecord, const char* pszName, void* pBuf, size_t uSize)
+{
+  assert(psTc != NULL);
+  assert(pszFile != NULL);
+  assert((pBuf != NULL) || (uSize == 0u));
+
+  size_t uLen;
+  const char* pcValue = CuTest_VecField(psRecord, pszName, &uLen);
+  if (pcValue == NULL) CuTestFail(psTc, pszFile, ulLine, "Test vector field <%s> missing", pszName);
+  if ((uLen >= 2u) && (pcValue[0] == '0') && ((pcValue[1] == 'x') || (pcValue[1] == 'X')))
+  {
+    pcValue += 2;
+    uLen -= 2u;
+  }
+
+  if ((uLen % 2u) != 0u) CuTestFail(psTc, pszFile, ulLine, "Test vector field <%s> has an odd number of digits", pszName);
+  if (uLen / 2u > uSize) CuTestFail(psTc, pszFile, ulLine, "Test vector field <%s> exceeds <%zu> bytes", pszName, uSize);
+
+  uint8_t* pucBuf = pBuf;
+  for (size_t i = 0u; i < uLen; ++i)
+  {
+    char c = pcValue[i];
+    if (!isxdigit((unsigned char)c)) CuTestFail(psTc, pszFile, ulLine, "Test vector field <%s> is not hexadecimal at digit <%zu>", pszName, i);
+    uint8_t ucNibble = (uint8_t)(isdigit((unsigned char)c) ? c - '0' : (tolower((unsigned char)c) - 'a' + 10));
+    if ((i % 2u) == 0u) pucBuf[i / 2u] = (uint8_t)(ucNibble << 4);
+    else pucBuf[i / 2u] |= ucNibble;
+  }
+  return uLen / 2u;
+}
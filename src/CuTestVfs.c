@@ -0,0 +1,435 @@
+/*!*****************************************************************************
+ * @file
+ * CuTestVfs.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - in-memory file system
+ *
+ * Serves paths below a configurable prefix from in-memory files. The file
+ * functions of the code under test are interposed using the linker option
+ * -Wl,--wrap=fopen,--wrap=open,--wrap=remove,--wrap=unlink. Each file is backed
+ * by a memfd and is re-opened through /proc/self/fd, so every open call gets
+ * its own file offset and the usual mode semantics. All files are removed be-
+ * fore each test case. This source file is licensed under The MIT License. See
+ * https://opensource.org/license/mit/ for full license text.
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "CuTestPrivate.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Max. length of a path to a backing file descriptor                        */
+#define CUTEST_VFS_FD_PATH_LEN        32u
+
+/*! Block size for content comparison                                         */
+#define CUTEST_VFS_BLOCK_SIZE         256u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! In-memory file                                                            */
+typedef struct tag_cutest_vfs_file_t
+{
+  char acPath[CUTEST_MAX_LEN_VFS_PATH]; ///< Full path
+  int iFd;                          ///< Backing memfd
+} cutest_vfs_file_t;
+
+/*! In-memory file system data                                                */
+typedef struct tag_cutest_vfs_t
+{
+  const char* pszPrefix;            ///< Mount prefix, NULL if disabled
+  size_t uPrefixLen;                ///< Length of mount prefix
+  unsigned long ulCount;            ///< Number of files
+  cutest_vfs_file_t asFiles[CUTEST_MAX_NUM_VFS_FILES]; ///< File table
+} cutest_vfs_t;
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static _Bool              CuTestVfsMatch(const char* pszPath);
+static cutest_vfs_file_t* CuTestVfsFind(const char* pszPath);
+static cutest_vfs_file_t* CuTestVfsCreate(const char* pszPath);
+static void               CuTestVfsFdPath(const cutest_vfs_file_t* psFile, char* pszBuf);
+static void               CuTestVfsRemove(cutest_vfs_file_t* psFile);
+
+/*! Real functions, resolved by the linker if the respective --wrap is used   */
+extern FILE* __real_fopen(const char* pszPath, const char* pszMode) __attribute__((weak));
+extern int   __real_open(const char* pszPath, int iFlags, ...) __attribute__((weak));
+extern int   __real_remove(const char* pszPath) __attribute__((weak));
+extern int   __real_unlink(const char* pszPath) __attribute__((weak));
+
+FILE* __wrap_fopen(const char* pszPath, const char* pszMode);
+int   __wrap_open(const char* pszPath, int iFlags, ...);
+int   __wrap_remove(const char* pszPath);
+int   __wrap_unlink(const char* pszPath);
+
+
+/*- Private variables --------------------------------------------------------*/
+/*! In-memory file system data                                                */
+static cutest_vfs_t sVfs _PERSISTENT;
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Check if a path is served by the in-memory file system
+ *
+ * @param[in] *pszPath    Path
+ * @return  (_Bool)  true, if below mount prefix
+ * @date  17.10.2026
+ ******************************************************************************/
+static _Bool CuTestVfsMatch(const char* pszPath)
+{
+  return (sVfs.pszPrefix != NULL) && (pszPath != NULL) && (strncmp(pszPath, sVfs.pszPrefix, sVfs.uPrefixLen) == 0);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Find an in-memory file
+ *
+ * @param[in] *pszPath    Full path
+ * @return  (cutest_vfs_file_t*)  File entry, or NULL if not existing
+ * @date  17.10.2026
+ ******************************************************************************/
+static cutest_vfs_file_t* CuTestVfsFind(const char* pszPath)
+{
+  for (unsigned long i = 0; i < sVfs.ulCount; ++i)
+  {
+    if (strcmp(sVfs.asFiles[i].acPath, pszPath) == 0) return &sVfs.asFiles[i];
+  }
+
+  return NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Create an empty in-memory file
+ *
+ * @param[in] *pszPath    Full path
+ * @return  (cutest_vfs_file_t*)  File entry, or NULL on error (errno set)
+ * @date  17.10.2026
+ ******************************************************************************/
+static cutest_vfs_file_t* CuTestVfsCreate(const char* pszPath)
+{
+  if (strlen(pszPath) >= CUTEST_MAX_LEN_VFS_PATH)
+  {
+    errno = ENAMETOOLONG;
+    return NULL;
+  }
+  if (sVfs.ulCount >= CUTEST_MAX_NUM_VFS_FILES)
+  {
+    errno = ENOSPC;
+    return NULL;
+  }
+
+  int iFd = memfd_create("cutest-vfs", MFD_CLOEXEC);
+  if (iFd < 0) return NULL;
+
+  cutest_vfs_file_t* psFile = &sVfs.asFiles[sVfs.ulCount++];
+  strcpy(psFile->acPath, pszPath);
+  psFile->iFd = iFd;
+
+  return psFile;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Format the path for re-opening a backing file descriptor
+ *
+ * @param[in] *psFile     File entry
+ * @param[out] *pszBuf    Path buffer (CUTEST_VFS_FD_PATH_LEN)
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestVfsFdPath(const cutest_vfs_file_t* psFile, char* pszBuf)
+{
+  snprintf(pszBuf, CUTEST_VFS_FD_PATH_LEN, "/proc/self/fd/%d", psFile->iFd);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Remove an in-memory file. Open handles remain valid.
+ *
+ * @param[inout] *psFile  File entry
+ * @date  17.10.2026
+ ******************************************************************************/
+static void CuTestVfsRemove(cutest_vfs_file_t* psFile)
+{
+  close(psFile->iFd);
+  *psFile = sVfs.asFiles[--sVfs.ulCount];
+}
+
+
+/*- Interposed functions -----------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * fopen replacement (-Wl,--wrap=fopen)
+ *
+ * @param[in] *pszPath    Path
+ * @param[in] *pszMode    Open mode
+ * @return  (FILE*)  Stream, or NULL on error
+ * @date  17.10.2026
+ ******************************************************************************/
+FILE* __wrap_fopen(const char* pszPath, const char* pszMode)
+{
+  FILE* (*pfnFopen)(const char*, const char*) = (__real_fopen != NULL) ? __real_fopen : fopen;
+  if (!CuTestVfsMatch(pszPath)) return pfnFopen(pszPath, pszMode);
+
+  cutest_vfs_file_t* psFile = CuTestVfsFind(pszPath);
+  if (psFile == NULL)
+  {
+    if (pszMode[0] == 'r')
+    {
+      errno = ENOENT;
+      return NULL;
+    }
+    if ((psFile = CuTestVfsCreate(pszPath)) == NULL) return NULL;
+  }
+  else if (strchr(pszMode, 'x') != NULL)
+  {
+    errno = EEXIST;
+    return NULL;
+  }
+
+  char acFdPath[CUTEST_VFS_FD_PATH_LEN];
+  CuTestVfsFdPath(psFile, acFdPath);
+  return pfnFopen(acFdPath, pszMode);
+}
+
+/*!****************************************************************************
+ * @brief
+ * open replacement (-Wl,--wrap=open)
+ *
+ * @param[in] *pszPath    Path
+ * @param[in] iFlags      Open flags
+ * @param[in] ...         File mode, if creating
+ * @return  (int)  File descriptor, or -1 on error
+ * @date  17.10.2026
+ ******************************************************************************/
+int __wrap_open(const char* pszPath, int iFlags, ...)
+{
+  int (*pfnOpen)(const char*, int, ...) = (__real_open != NULL) ? __real_open : open;
+
+  mode_t uMode = 0;
+  if (iFlags & O_CREAT)
+  {
+    va_list args;
+    va_start(args, iFlags);
+    uMode = va_arg(args, mode_t);
+    va_end(args);
+  }
+
+  if (!CuTestVfsMatch(pszPath)) return pfnOpen(pszPath, iFlags, uMode);
+
+  cutest_vfs_file_t* psFile = CuTestVfsFind(pszPath);
+  if (psFile == NULL)
+  {
+    if (!(iFlags & O_CREAT))
+    {
+      errno = ENOENT;
+      return -1;
+    }
+    if ((psFile = CuTestVfsCreate(pszPath)) == NULL) return -1;
+  }
+  else if ((iFlags & O_CREAT) && (iFlags & O_EXCL))
+  {
+    errno = EEXIST;
+    return -1;
+  }
+
+  char acFdPath[CUTEST_VFS_FD_PATH_LEN];
+  CuTestVfsFdPath(psFile, acFdPath);
+  return pfnOpen(acFdPath, iFlags & ~(O_CREAT | O_EXCL), uMode);
+}
+
+/*!****************************************************************************
+ * @brief
+ * remove replacement (-Wl,--wrap=remove)
+ *
+ * @param[in] *pszPath    Path
+ * @return  (int)  0 on success, -1 on error
+ * @date  17.10.2026
+ ******************************************************************************/
+int __wrap_remove(const char* pszPath)
+{
+  if (!CuTestVfsMatch(pszPath)) return (__real_remove != NULL) ? __real_remove(pszPath) : remove(pszPath);
+
+  cutest_vfs_file_t* psFile = CuTestVfsFind(pszPath);
+  if (psFile == NULL)
+  {
+    errno = ENOENT;
+    return -1;
+  }
+
+  CuTestVfsRemove(psFile);
+  return 0;
+}
+
+/*!****************************************************************************
+ * @brief
+ * unlink replacement (-Wl,--wrap=unlink)
+ *
+ * @param[in] *pszPath    Path
+ * @return  (int)  0 on success, -1 on error
+ * @date  17.10.2026
+ ******************************************************************************/
+int __wrap_unlink(const char* pszPath)
+{
+  if (!CuTestVfsMatch(pszPath)) return (__real_unlink != NULL) ? __real_unlink(pszPath) : unlink(pszPath);
+
+  return __wrap_remove(pszPath);
+}
+
+
+/*- In-memory file system ----------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Serve all paths starting with a prefix from memory
+ *
+ * @param[in] *pszPrefix  Path prefix, e.g. "/vfs/". NULL to disable.
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_MountVfs(const char* pszPrefix)
+{
+  CuTestResetVfs();
+
+  sVfs.pszPrefix = pszPrefix;
+  sVfs.uPrefixLen = (pszPrefix != NULL) ? strlen(pszPrefix) : 0u;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Create or replace an in-memory file
+ *
+ * @param[in] *pszPath    Full path (below mount prefix)
+ * @param[in] *pData      File contents
+ * @param[in] uSize       Size of contents in bytes
+ * @return  (_Bool)  true, if the file was created
+ * @date  17.10.2026
+ ******************************************************************************/
+_Bool CuTest_VfsAddFile(const char* pszPath, const void* pData, size_t uSize)
+{
+  assert(pszPath != NULL);
+  assert((pData != NULL) || (uSize == 0u));
+  assert(CuTestVfsMatch(pszPath));
+
+  cutest_vfs_file_t* psFile = CuTestVfsFind(pszPath);
+  if (psFile == NULL) psFile = CuTestVfsCreate(pszPath);
+  if (psFile == NULL) return 0;
+
+  if (ftruncate(psFile->iFd, 0) != 0) return 0;
+
+  const uint8_t* pucData = pData;
+  size_t uDone = 0u;
+  while (uDone < uSize)
+  {
+    ssize_t iRet = pwrite(psFile->iFd, &pucData[uDone], uSize - uDone, (off_t)uDone);
+    if (iRet <= 0) return 0;
+    uDone += (size_t)iRet;
+  }
+
+  return 1;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Read the contents of an in-memory file
+ *
+ * @param[in] *pszPath    Full path (below mount prefix)
+ * @param[out] *pBuf      Output buffer (optional)
+ * @param[in] uBufSize    Size of output buffer in bytes
+ * @return  (long)  File size in bytes, or -1 if not existing
+ * @date  17.10.2026
+ ******************************************************************************/
+long CuTest_VfsReadFile(const char* pszPath, void* pBuf, size_t uBufSize)
+{
+  assert(pszPath != NULL);
+
+  const cutest_vfs_file_t* psFile = CuTestVfsFind(pszPath);
+  if (psFile == NULL) return -1;
+
+  off_t lSize = lseek(psFile->iFd, 0, SEEK_END);
+  if ((pBuf != NULL) && (uBufSize > 0u))
+  {
+    ssize_t iRet = pread(psFile->iFd, pBuf, uBufSize, 0);
+    (void)iRet;
+  }
+
+  return (long)lSize;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Remove all in-memory files
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTestResetVfs(void)
+{
+  while (sVfs.ulCount > 0u) CuTestVfsRemove(&sVfs.asFiles[0]);
+}
+
+
+/*- Result evaluation functions ----------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Evaluate the contents of an in-memory file
+ *
+ * @note longjmp on missing file or mismatch
+ * @param[in] psTc        Test case data
+ * @param[in] *pszFile    File name
+ * @param[in] ulLine      Line number
+ * @param[in] *pszPath    In-memory file path
+ * @param[in] *pExpected  Expected contents
+ * @param[in] uSize       Size of expected contents in bytes
+ * @date  17.10.2026
+ ******************************************************************************/
+void CuTest_EvalAssertVfsFile(cutest_case_ptr_t psTc, const char* pszFile, unsigned long ulLine, const char* pszPath, const void* pExpected, size_t uSize)
+{
+  assert(psTc != NULL);
+  assert(pszFile != NULL);
+  assert(pszPath != NULL);
+  assert((pExpected != NULL) || (uSize == 0u));
+
+  const cutest_vfs_file_t* psFile = CuTestVfsFind(pszPath);
+  if (psFile == NULL) CuTestFail(psTc, pszFile, ulLine, "file <%s> does not exist", pszPath);
+
+  off_t lSize = lseek(psFile->iFd, 0, SEEK_END);
+  if (lSize != (off_t)uSize)
+  {
+    CuTestFail(psTc, pszFile, ulLine, "<%s> size mismatch: expected <%zu> bytes, but was <%lld>", pszPath, uSize, (long long)lSize);
+  }
+
+  const uint8_t* pucExpected = pExpected;
+  uint8_t aucBlock[CUTEST_VFS_BLOCK_SIZE];
+  for (size_t uOffset = 0u; uOffset < uSize; uOffset += sizeof(aucBlock))
+  {
+    size_t uLen = uSize - uOffset;
+    if (uLen > sizeof(aucBlock)) uLen = sizeof(aucBlock);
+    if (pread(psFile->iFd, aucBlock, uLen, (off_t)uOffset) != (ssize_t)uLen)
+    {
+      CuTestFail(psTc, pszFile, ulLine, "unable to read <%s>", pszPath);
+    }
+
+    for (size_t i = 0u; i < uLen; ++i) if (aucBlock[i] != pucExpected[uOffset + i])
+    {
+      CuTestFail(psTc, pszFile, ulLine, "<%s> mismatch at offset <%zu>: expected <0x%02X>, but was <0x%02X>", pszPath, uOffset + i, (unsigned)pucExpected[uOffset + i], (unsigned)aucBlock[i]);
+    }
+  }
+
+  CuTestPass(psTc);
+}
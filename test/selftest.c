@@ -0,0 +1,1781 @@
+/*!****************************************************************************
+ * @file
+ * selftest.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * CuTest framework self-test
+ *
+ * Checks framework behavior not covered by the demo project. Each test case
+ * sets up a separate test run root with test cases created at run time, runs
+ * it and checks the results. Build and run (see src/Makefile):
+ *   make -C src check
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include "CuTest.h"
+#include "CuTestPrivate.h"
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+extern pid_t __real_fork(void);
+pid_t __wrap_fork(void);
+EXTERN_TEST_GROUP(TestSelf_Cpp);    // test/selftest.cpp
+
+
+/*- Private variables --------------------------------------------------------*/
+/*! Number of runs of SelfCountFn                                             */
+static unsigned long ulSelfRuns = 0u;
+
+/*! Application state for state isolation checks                              */
+static int iSelfState = 1;
+
+/*! Process environment, referenced to force a copy relocation                */
+extern char** environ;
+
+/*! Coverage data directories written by SelfGcovDump                         */
+static char acSelfGcovDirs[128] = "";
+
+/*! Let fork() fail, see __wrap_fork                                          */
+static _Bool bSelfForkFail = 0;
+
+/*! Mutant sites and table, as generated by cutest-mutate                     */
+static const cutest_mutant_site_t asSelfMutants[] = { { 42u, "'<' -> '<='" } };
+static cutest_mutant_table_t sSelfMutants = { "self.c", asSelfMutants, 1u, 0u };
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * fork replacement (-Wl,--wrap=fork), fails on request
+ *
+ * @return  (pid_t)  Process ID, 0 in the child, -1 on error
+ * @date  17.10.2026
+ ******************************************************************************/
+pid_t __wrap_fork(void)
+{
+  if (bSelfForkFail)
+  {
+    errno = EAGAIN;
+    return -1;
+  }
+
+  return __real_fork();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test function of an inner test run, passes
+ *
+ * @param[in] _tc         Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfPassFn(cutest_case_ptr_t _tc)
+{
+  CuPass();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test function of an inner test run, fails
+ *
+ * @param[in] _tc         Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfFailFn(cutest_case_ptr_t _tc)
+{
+  CuFail("inner failure");
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test function of an inner test run, counts its runs and passes
+ *
+ * @param[in] _tc         Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfCountFn(cutest_case_ptr_t _tc)
+{
+  ulSelfRuns++;
+  CuPass();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test function of an inner test run, exits the process if its user data is
+ * set, passes otherwise
+ *
+ * @param[in] _tc         Test case data, user data pointing to a flag
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfExitFn(cutest_case_ptr_t _tc)
+{
+  if (*(const _Bool*)_tc->pUser) _exit(EXIT_FAILURE);
+  CuPass();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test function of an inner test run, prints to stdout and stderr, then fails
+ * if its user data is set, passes otherwise
+ *
+ * @param[in] _tc         Test case data, user data pointing to a flag
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfPrintFn(cutest_case_ptr_t _tc)
+{
+  printf("0123456789ABCDEF\n");
+  fflush(stdout);
+  fprintf(stderr, "stderr line\n");
+  if (*(const _Bool*)_tc->pUser) CuFail("inner failure");
+  CuPass();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test function of an inner test run, reaches the mutant and passes
+ *
+ * @param[in] _tc         Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfMutantFn(cutest_case_ptr_t _tc)
+{
+  (void)CuTest_IsMutant(&sSelfMutants, 1u);
+  CuPass();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test function of an inner test run, exits the process successfully
+ *
+ * @param[in] _tc         Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfQuitFn(cutest_case_ptr_t _tc)
+{
+  (void)_tc;
+  exit(EXIT_SUCCESS);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test function of an inner test run, terminates the process
+ *
+ * @param[in] _tc         Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfCrashFn(cutest_case_ptr_t _tc)
+{
+  (void)_tc;
+  abort();
+}
+
+/*!****************************************************************************
+ * @brief
+ * Use CPU time in a function without external linkage, without calls
+ *
+ * @return  (unsigned long)  Result, prevents optimizing the loop away
+ * @date  17.10.2026
+ ******************************************************************************/
+static unsigned long SelfSpin(void)
+{
+  volatile unsigned long ulSum = 0u;
+  for (unsigned long i = 0; i < 100000000ul; ++i) ulSum += i;
+  return ulSum;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test function of an inner test run, profiled
+ *
+ * @param[in] _tc         Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfSpinFn(cutest_case_ptr_t _tc)
+{
+  CuAssert(SelfSpin() > 0u, "no time spent");
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test function of an inner test run, writes 64 KiB to /dev/null
+ *
+ * @param[in] _tc         Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfWriteFn(cutest_case_ptr_t _tc)
+{
+  static const char acBlock[4096];
+  int iFd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+  CuAssert(iFd >= 0, "cannot open /dev/null");
+  for (int i = 0; i < 16; ++i) CuAssert(write(iFd, acBlock, sizeof(acBlock)) == (ssize_t)sizeof(acBlock), "write failed");
+  close(iFd);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Differential test reference: triple a 32 bit value
+ *
+ * @param[in] *pIn        Input value
+ * @param[out] *pOut      Output value
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfTripleRef(const void* pIn, void* pOut)
+{
+  *(uint32_t*)pOut = *(const uint32_t*)pIn * 3u;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Differential test candidate, equivalent to SelfTripleRef
+ *
+ * @param[in] *pIn        Input value
+ * @param[out] *pOut      Output value
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfTripleOpt(const void* pIn, void* pOut)
+{
+  const uint32_t ulIn = *(const uint32_t*)pIn;
+  *(uint32_t*)pOut = (ulIn << 1) + ulIn;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Differential test candidate, wrong for the input 5
+ *
+ * @param[in] *pIn        Input value
+ * @param[out] *pOut      Output value
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfTripleBad(const void* pIn, void* pOut)
+{
+  const uint32_t ulIn = *(const uint32_t*)pIn;
+  *(uint32_t*)pOut = (ulIn == 5u) ? 0u : ulIn * 3u;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Differential test input generator: edge cases 0 and 5, then random values
+ *
+ * @param[in] ulIndex     Input index
+ * @param[inout] *pullRng Random generator state
+ * @param[out] *pIn       Input value
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfTripleGen(unsigned long ulIndex, uint64_t* pullRng, void* pIn)
+{
+  static const uint32_t aulEdge[] = { 0u, 5u };
+  *(uint32_t*)pIn = (ulIndex < 2u) ? aulEdge[ulIndex] : (uint32_t)CuTest_Random(pullRng) | 0x100u;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test function of an inner test run, differential test of SelfTripleOpt
+ *
+ * @param[in] _tc         Test case data, user data pointing to the config
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfDiffOptFn(cutest_case_ptr_t _tc)
+{
+  CuTest_EvalDiff(_tc, __FILE__, __LINE__, _tc->pUser, SelfTripleRef, SelfTripleOpt, SelfTripleGen);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test function of an inner test run, differential test of SelfTripleBad
+ *
+ * @param[in] _tc         Test case data, user data pointing to the config
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfDiffBadFn(cutest_case_ptr_t _tc)
+{
+  CuTest_EvalDiff(_tc, __FILE__, __LINE__, _tc->pUser, SelfTripleRef, SelfTripleBad, SelfTripleGen);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get the path of a test vector fixture file in test/vectors/
+ *
+ * @param[in] *pszName    File name
+ * @param[out] *pszPath   Path buffer
+ * @param[in] uSize       Path buffer size
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfVectorPath(const char* pszName, char* pszPath, size_t uSize)
+{
+  const char* pcSep = strrchr(__FILE__, '/');
+  const int iDirLen = (pcSep != NULL) ? (int)(pcSep - __FILE__ + 1) : 0;
+  snprintf(pszPath, uSize, "%.*svectors/%s", iDirLen, __FILE__, pszName);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test vector body: byte sum of "Msg" equals "Sum", "L" from the section
+ *
+ * @param[in] _tc         Test case data
+ * @param[in] _rec        Record
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfVecSumFn(cutest_case_ptr_t _tc, const cutest_vec_record_t* _rec)
+{
+  uint8_t aucMsg[8];
+  const size_t uLen = CuVecHex("Msg", aucMsg, sizeof(aucMsg));
+  unsigned long ulSum = 0u;
+  for (size_t i = 0; i < uLen; ++i) ulSum += aucMsg[i];
+  CuAssertIntEquals((int)CuVecInt("L"), (int)uLen);
+  CuAssertIntEquals((int)CuVecInt("Sum"), (int)ulSum);
+  CuAssertIntEquals((int)_rec->ulIndex - 1, (int)CuVecInt("COUNT"));
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test vector body: quoted CSV "note" fields of the records 2 and 3
+ *
+ * @param[in] _tc         Test case data
+ * @param[in] _rec        Record
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfVecNoteFn(cutest_case_ptr_t _tc, const cutest_vec_record_t* _rec)
+{
+  static const char* const apszNotes[] = { "plain", "with, comma", "say \"\"hi\"\", twice" };
+  const char* pszExpected = apszNotes[(_rec->ulIndex == 2u) || (_rec->ulIndex == 3u) ? _rec->ulIndex - 1u : 0u];
+  size_t uLen = 0u;
+  const char* pcNote = CuVecField("note", &uLen);
+  CuAssertPtrNotNull(pcNote);
+  CuAssertIntEquals((int)strlen(pszExpected), (int)uLen);
+  CuAssert(strncmp(pszExpected, pcNote, uLen) == 0, pszExpected);
+  CuAssertIntEquals((int)_rec->ulIndex, (int)CuVecInt("x"));
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test vector body: CSV "doubled" field is twice the "x" field
+ *
+ * @param[in] _tc         Test case data
+ * @param[in] _rec        Record
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfVecDoubleFn(cutest_case_ptr_t _tc, const cutest_vec_record_t* _rec)
+{
+  CuAssertIntEquals((int)(2u * CuVecInt("x")), (int)CuVecInt("doubled"));
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test vector body: binary records hold ascending bytes
+ *
+ * @param[in] _tc         Test case data
+ * @param[in] _rec        Record
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfVecRawFn(cutest_case_ptr_t _tc, const cutest_vec_record_t* _rec)
+{
+  CuAssertIntEquals((int)_rec->uOffset, (int)(uint8_t)_rec->pcData[0]);
+  CuAssertIntEquals((int)_rec->uOffset + (int)_rec->uSize - 1, (int)(uint8_t)_rec->pcData[_rec->uSize - 1u]);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test function of an inner test run, evaluates the test vectors of the
+ * user data with the body SelfVecSumFn
+ *
+ * @param[in] _tc         Test case data, user data pointing to the config
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfVecSumCase(cutest_case_ptr_t _tc)
+{
+  CuTest_EvalVectors(_tc, __FILE__, __LINE__, _tc->pUser, SelfVecSumFn);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test function of an inner test run, evaluates the test vectors of the
+ * user data with the body SelfVecNoteFn
+ *
+ * @param[in] _tc         Test case data, user data pointing to the config
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfVecNoteCase(cutest_case_ptr_t _tc)
+{
+  CuTest_EvalVectors(_tc, __FILE__, __LINE__, _tc->pUser, SelfVecNoteFn);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test function of an inner test run, evaluates the test vectors of the
+ * user data with the body SelfVecDoubleFn
+ *
+ * @param[in] _tc         Test case data, user data pointing to the config
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfVecDoubleCase(cutest_case_ptr_t _tc)
+{
+  CuTest_EvalVectors(_tc, __FILE__, __LINE__, _tc->pUser, SelfVecDoubleFn);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test function of an inner test run, evaluates the test vectors of the
+ * user data with the body SelfVecRawFn
+ *
+ * @param[in] _tc         Test case data, user data pointing to the config
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfVecRawCase(cutest_case_ptr_t _tc)
+{
+  CuTest_EvalVectors(_tc, __FILE__, __LINE__, _tc->pUser, SelfVecRawFn);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Register read hook, sets a status bit
+ *
+ * @param[in] uAddr       Register address
+ * @param[in] ulValue     Register content
+ * @param[in] *pUser      Unused
+ * @return  (uint32_t)  Value presented to the reading instruction
+ * @date  17.10.2026
+ ******************************************************************************/
+static uint32_t SelfStatusHook(uintptr_t uAddr, uint32_t ulValue, void* pUser)
+{
+  (void)uAddr;
+  (void)pUser;
+  return ulValue | 0x10u;
+}
+
+/*!****************************************************************************
+ * @brief
+ * gcov counter reset replacement, does nothing
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfGcovReset(void)
+{
+}
+
+/*!****************************************************************************
+ * @brief
+ * gcov data dump replacement, records the data directory
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfGcovDump(void)
+{
+  const char* pszPrefix = getenv("GCOV_PREFIX");
+  strncat(acSelfGcovDirs, (pszPrefix != NULL) ? pszPrefix : "(none)", sizeof(acSelfGcovDirs) - strlen(acSelfGcovDirs) - 2u);
+  strcat(acSelfGcovDirs, ";");
+}
+
+/*!****************************************************************************
+ * @brief
+ * Generate the HTML report of an inner test run
+ *
+ * @param[in] psRoot      Inner test run root
+ * @param[out] *pszReport Report contents
+ * @param[in] uSize       Report buffer size
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfReport(const cutest_root_ptr_t psRoot, char* pszReport, size_t uSize)
+{
+  char acFile[] = "/tmp/cutest-report-XXXXXX";
+  int iFd = mkstemp(acFile);
+  *pszReport = '\0';
+  if (iFd < 0) return;
+  close(iFd);
+
+  const time_t tNow = time(NULL);
+  CuTest_GenerateRunReport(psRoot, &tNow, acFile);
+  FILE* f = fopen(acFile, "r");
+  if (f != NULL)
+  {
+    pszReport[fread(pszReport, 1u, uSize - 1u, f)] = '\0';
+    fclose(f);
+  }
+  remove(acFile);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get the result data of a test case of an inner test run
+ *
+ * @param[in] psRoot      Inner test run root
+ * @param[in] *pszName    Test case name
+ * @return  (cutest_case_ptr_t)  Test case data of the run, or NULL
+ * @date  17.10.2026
+ ******************************************************************************/
+static cutest_case_ptr_t SelfResult(const cutest_root_ptr_t psRoot, const char* pszName)
+{
+  for (unsigned long i = 0; i < psRoot->ulNumNodes; ++i)
+  {
+    cutest_case_ptr_t psResult = psRoot->psNodes[i].psResult;
+    if ((psResult != NULL) && (strcmp(psResult->pszName, pszName) == 0)) return psResult;
+  }
+
+  return NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get the result codes of test cases of an inner test run, named by single
+ * characters, as summary tape characters
+ *
+ * @param[in] psRoot      Inner test run root
+ * @param[in] *pszNames   Test case names, one character each
+ * @param[out] *pszTape   Result codes, same length as pszNames
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfTape(const cutest_root_ptr_t psRoot, const char* pszNames, char* pszTape)
+{
+  for (; *pszNames != '\0'; ++pszNames)
+  {
+    const char acName[2] = { *pszNames, '\0' };
+    const cutest_case_ptr_t psResult = SelfResult(psRoot, acName);
+    switch ((psResult != NULL) ? psResult->eResult : EN_CUTEST_RESULT_UNDEF)
+    {
+      case EN_CUTEST_RESULT_PASS: *pszTape++ = '.'; break;
+      case EN_CUTEST_RESULT_FAIL: *pszTape++ = 'F'; break;
+      case EN_CUTEST_RESULT_SKIP: *pszTape++ = (psResult->acMessage[0] != '\0') ? 'S' : '-'; break;
+      default:                    *pszTape++ = '?';
+    }
+  }
+  *pszTape = '\0';
+}
+
+
+/*!****************************************************************************
+ * @brief
+ * Wait until a coordinator accepts connections on a Unix domain socket
+ *
+ * @param[in] *pszPath    Socket path
+ * @return  (_Bool)  true, if a connection was accepted within 5 s
+ * @date  17.10.2026
+ ******************************************************************************/
+static _Bool SelfDistribWait(const char* pszPath)
+{
+  struct sockaddr_un sAddr = { .sun_family = AF_UNIX };
+  strncpy(sAddr.sun_path, pszPath, sizeof(sAddr.sun_path) - 1u);
+
+  for (int i = 0; i < 500; ++i)
+  {
+    int iFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (iFd < 0) return 0;
+    int iRet = connect(iFd, (struct sockaddr*)&sAddr, sizeof(sAddr));
+    close(iFd);
+    if (iRet == 0) return 1;
+    usleep(10000);
+  }
+  return 0;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Run a worker of an inner test run with the test cases <pszFirst> and "B",
+ * does not return
+ *
+ * @param[in] *pszAddress Coordinator address
+ * @param[in] *pszFirst   Name of the first test case
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfDistribWorker(const char* pszAddress, const char* pszFirst)
+{
+  cutest_root_t sRoot;
+  CuTest_InitRoot(&sRoot, "Worker");
+  sRoot.pszWorker = pszAddress;
+  cutest_group_ptr_t psGroup = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "Group");
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, pszFirst, SelfPassFn, NULL, 0);
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "B", SelfPassFn, NULL, 0);
+  CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psGroup);
+  CuTest_RunTests(&sRoot);
+  _exit(EXIT_FAILURE);
+}
+
+/*- Test run execution -------------------------------------------------------*/
+TEST_CASE(TEST_Run_WorkerCrash)
+{
+  cutest_root_t sRoot;
+  CuTest_InitRoot(&sRoot, "WorkerCrash");
+  sRoot.uJobs = 2u;
+  cutest_group_ptr_t psGroup = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "Group");
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "A", SelfPassFn, NULL, 0);
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "B", SelfCrashFn, NULL, 0);
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "C", SelfCrashFn, NULL, 0);
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "D", SelfFailFn, NULL, 0);
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "E", SelfPassFn, NULL, 0);
+  CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psGroup);
+  CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_CASE, CuTest_NewCase(&sRoot, __FILE__, __LINE__, NULL, "F", SelfPassFn, NULL, 0));
+  CuTest_RunTests(&sRoot);
+
+  char acTape[8];
+  SelfTape(&sRoot, "ABCDEF", acTape);
+  char acMessage[CUTEST_MAX_LEN_MESSAGE];
+  strcpy(acMessage, SelfResult(&sRoot, "B")->acMessage);
+  CuTest_ReleaseRoot(&sRoot);
+
+  // Only the crashed test cases fail, all others are run in new workers
+  CuAssertStrEquals(".FFF..", acTape);
+  CuAssertStrEquals("Worker terminated by signal 6", acMessage);
+}
+
+TEST_CASE(TEST_Run_WorkerExit)
+{
+  cutest_root_t sRoot;
+  CuTest_InitRoot(&sRoot, "WorkerExit");
+  sRoot.uJobs = 2u;
+  cutest_group_ptr_t psGroup = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "Group");
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "A", SelfPassFn, NULL, 0);
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "B", SelfQuitFn, NULL, 0);
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "C", SelfPassFn, NULL, 0);
+  CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psGroup);
+  CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_CASE, CuTest_NewCase(&sRoot, __FILE__, __LINE__, NULL, "D", SelfPassFn, NULL, 0));
+  CuTest_RunTests(&sRoot);
+
+  char acTape[8];
+  SelfTape(&sRoot, "ABCD", acTape);
+  char acMessage[CUTEST_MAX_LEN_MESSAGE];
+  strcpy(acMessage, SelfResult(&sRoot, "B")->acMessage);
+  const cutest_result_t eRun = CuTest_GetRunResult(&sRoot);
+  CuTest_ReleaseRoot(&sRoot);
+
+  // Successful exit of a worker with results missing fails the run
+  CuAssertStrEquals(".F..", acTape);
+  CuAssertStrEquals("Worker exited before reporting all test cases", acMessage);
+  CuAssertIntEquals(EN_CUTEST_RESULT_FAIL, eRun);
+}
+
+TEST_CASE(TEST_Run_HistoryKeys)
+{
+  char acFile[] = "/tmp/cutest-history-XXXXXX";
+  int iFd = mkstemp(acFile);
+  CuAssert(iFd >= 0, "cannot create history file");
+  close(iFd);
+
+  cutest_root_t sRoot;
+  CuTest_InitRoot(&sRoot, "HistoryKeys");
+  sRoot.pszHistoryFile = acFile;
+  cutest_group_ptr_t psFirst = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "First");
+  cutest_group_ptr_t psSecond = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "Sec/ond");
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psFirst, "Case", SelfPassFn, NULL, 0);
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psSecond, "Case", SelfFailFn, NULL, 0);
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psSecond, "Tab\tLine\n", SelfPassFn, NULL, 0);
+  CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psFirst);
+  CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psSecond);
+  CuTest_RunTests(&sRoot);
+  CuTest_RunTests(&sRoot);
+  CuTest_ReleaseRoot(&sRoot);
+
+  // One line per test case, with unique, escaped paths
+  char acHistory[512] = "";
+  FILE* f = fopen(acFile, "r");
+  char acLine[128];
+  while ((f != NULL) && (fgets(acLine, sizeof(acLine), f) != NULL))
+  {
+    char* pszTab = strchr(acLine, '\t');
+    if (pszTab != NULL) strcpy(pszTab, strstr(pszTab, "\tfail\t") ? " fail;" : " pass;");
+    strncat(acHistory, acLine, sizeof(acHistory) - strlen(acHistory) - 1u);
+  }
+  if (f != NULL) fclose(f);
+  remove(acFile);
+
+  CuAssertStrEquals("First/Case pass;Sec\\/ond/Case fail;Sec\\/ond/Tab\\tLine\\n pass;", acHistory);
+}
+
+TEST_CASE(TEST_Run_Direct)
+{
+  cutest_root_t sRoot;
+  CuTest_InitRoot(&sRoot, "Direct");
+  cutest_group_ptr_t psGroup = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "Group");
+  cutest_case_ptr_t psPass = CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "A", SelfPassFn, NULL, 0);
+  cutest_case_ptr_t psFail = CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "B", SelfFailFn, NULL, 0);
+  CuTest_RunTestGroup(psGroup);
+  const cutest_result_t ePass = psPass->eResult;
+  const cutest_result_t eFail = psFail->eResult;
+  CuTest_ReleaseRoot(&sRoot);
+
+  // Direct runners store their results in the test case descriptors
+  CuAssertIntEquals(EN_CUTEST_RESULT_PASS, ePass);
+  CuAssertIntEquals(EN_CUTEST_RESULT_FAIL, eFail);
+}
+
+TEST_CASE(TEST_Run_RecordParse)
+{
+  cutest_root_t sRoot;
+  CuTest_InitRoot(&sRoot, "Records");
+  cutest_case_ptr_t psCase = CuTest_NewCase(&sRoot, __FILE__, __LINE__, NULL, "A", SelfFailFn, NULL, 0);
+  psCase->eResult = EN_CUTEST_RESULT_FAIL;
+  strcpy(psCase->acMessage, "message");
+
+  int aiPipe[2];
+  CuAssert(pipe(aiPipe) == 0, "cannot create pipe");
+  const _Bool bWritten = CuTestRecordWrite(aiPipe[1], 1u, psCase);
+  char acRec[256];
+  const ssize_t iLen = read(aiPipe[0], acRec, sizeof(acRec));
+  close(aiPipe[0]);
+  close(aiPipe[1]);
+  CuTest_ReleaseRoot(&sRoot);
+  CuAssertIntEquals(1, bWritten);
+  CuAssert(iLen > 0, "no record written");
+  const size_t uLen = (size_t)iLen;
+
+  // Complete and incomplete records
+  cutest_record_t sRecord;
+  CuAssertIntEquals((int)uLen, (int)CuTestRecordParse(acRec, uLen, 2u, &sRecord));
+  CuAssertIntEquals(1, (int)sRecord.ulIndex);
+  CuAssertStrEquals("message", sRecord.pszMessage);
+  CuAssertIntEquals(0, (int)CuTestRecordParse(acRec, uLen - 1u, 2u, &sRecord));
+
+  // Index out of range, including the idle marker of distributed workers
+  CuAssert(CuTestRecordParse(acRec, uLen, 1u, &sRecord) == CUTEST_RECORD_INVALID, "index not checked");
+  char acBad[256];
+  memcpy(acBad, acRec, uLen);
+  memset(acBad, 0xFF, sizeof(uint32_t));
+  CuAssert(CuTestRecordParse(acBad, uLen, 2u, &sRecord) == CUTEST_RECORD_INVALID, "idle index accepted");
+
+  // Unknown result code (second header field)
+  memcpy(acBad, acRec, uLen);
+  memset(&acBad[sizeof(uint32_t)], 0x7F, sizeof(uint32_t));
+  CuAssert(CuTestRecordParse(acBad, uLen, 2u, &sRecord) == CUTEST_RECORD_INVALID, "result code not checked");
+
+  // Missing string terminator
+  memcpy(acBad, acRec, uLen);
+  acBad[uLen - 1u] = 'x';
+  CuAssert(CuTestRecordParse(acBad, uLen, 2u, &sRecord) == CUTEST_RECORD_INVALID, "terminator not checked");
+}
+
+TEST_CASE(TEST_Run_DependSkip)
+{
+  for (unsigned uJobs = 1u; uJobs <= 2u; ++uJobs)
+  {
+    cutest_root_t sRoot;
+    CuTest_InitRoot(&sRoot, "DependSkip");
+    sRoot.uJobs = uJobs;
+    cutest_group_ptr_t psGroupA = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "GA");
+    cutest_group_ptr_t psGroupB = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "GB");
+    cutest_group_ptr_t psGroupC = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "GC");
+    CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroupA, "A", SelfFailFn, NULL, 0);
+    CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroupB, "B", SelfPassFn, NULL, 0);
+    CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroupC, "C", SelfPassFn, NULL, 0);
+    CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psGroupC);
+    CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psGroupB);
+    CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psGroupA);
+    CuTest_AddDependency(&sRoot, EN_CUTEST_TYPE_GROUP, psGroupB, EN_CUTEST_TYPE_GROUP, psGroupA);
+    CuTest_AddDependency(&sRoot, EN_CUTEST_TYPE_GROUP, psGroupC, EN_CUTEST_TYPE_GROUP, psGroupB);
+    CuTest_RunTests(&sRoot);
+
+    char acTape[4];
+    SelfTape(&sRoot, "ABC", acTape);
+    char acMessageB[CUTEST_MAX_LEN_MESSAGE];
+    char acMessageC[CUTEST_MAX_LEN_MESSAGE];
+    strcpy(acMessageB, SelfResult(&sRoot, "B")->acMessage);
+    strcpy(acMessageC, SelfResult(&sRoot, "C")->acMessage);
+    CuTest_ReleaseRoot(&sRoot);
+
+    // Transitive skips name the failed item causing them
+    CuAssertStrEquals("FSS", acTape);
+    CuAssertStrEquals("dependency GA failed", acMessageB);
+    CuAssertStrEquals("dependency GB skipped, GA failed", acMessageC);
+  }
+}
+
+TEST_CASE(TEST_Run_DependCycle)
+{
+  // Between root items, and between test cases of a root item
+  for (int iCase = 0; iCase < 2; ++iCase)
+  {
+    cutest_root_t sRoot;
+    CuTest_InitRoot(&sRoot, "DependCycle");
+    cutest_group_ptr_t psGroupA = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "GA");
+    cutest_group_ptr_t psGroupB = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "GB");
+    cutest_case_ptr_t psCaseA = CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroupA, "A", SelfPassFn, NULL, 0);
+    cutest_case_ptr_t psCaseB = CuTest_NewCase(&sRoot, __FILE__, __LINE__, (iCase > 0) ? psGroupA : psGroupB, "B", SelfPassFn, NULL, 0);
+    CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psGroupA);
+    CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psGroupB);
+    CuTest_AddDependency(&sRoot, EN_CUTEST_TYPE_CASE, psCaseA, EN_CUTEST_TYPE_CASE, psCaseB);
+    CuTest_AddDependency(&sRoot, EN_CUTEST_TYPE_CASE, psCaseB, EN_CUTEST_TYPE_CASE, psCaseA);
+    CuTest_RunTests(&sRoot);
+
+    char acTape[3];
+    SelfTape(&sRoot, "AB", acTape);
+    char acMessage[CUTEST_MAX_LEN_MESSAGE];
+    strcpy(acMessage, SelfResult(&sRoot, "A")->acMessage);
+    const cutest_result_t eResult = CuTest_GetRunResult(&sRoot);
+    CuTest_ReleaseRoot(&sRoot);
+
+    // The run fails without running any test case, and without exiting
+    CuAssertStrEquals("FF", acTape);
+    CuAssertStrEquals("Dependency cycle", acMessage);
+    CuAssertIntEquals(EN_CUTEST_RESULT_FAIL, eResult);
+  }
+}
+
+TEST_CASE(TEST_Run_JournalResume)
+{
+  char acFile[] = "/tmp/cutest-journal-XXXXXX";
+  int iFd = mkstemp(acFile);
+  CuAssert(iFd >= 0, "cannot create journal file");
+  close(iFd);
+
+  // The first run is killed in test case C, the second one resumes it
+  for (int iRun = 0; iRun < 2; ++iRun)
+  {
+    _Bool bExit = (iRun == 0);
+    pid_t iPid = (iRun == 0) ? fork() : 0;
+    CuAssert(iPid >= 0, "cannot fork");
+    if (iPid > 0)
+    {
+      int iStatus = 0;
+      waitpid(iPid, &iStatus, 0);
+      CuAssertIntEquals(1, WIFEXITED(iStatus) && (WEXITSTATUS(iStatus) == EXIT_FAILURE));
+
+      // Incomplete record at the end of the journal, dropped on resume
+      FILE* f = fopen(acFile, "a");
+      if (f != NULL)
+      {
+        fputs("xyz", f);
+        fclose(f);
+      }
+      continue;
+    }
+
+    cutest_root_t sRoot;
+    CuTest_InitRoot(&sRoot, "Journal");
+    sRoot.pszJournalFile = acFile;
+    sRoot.bResume = (iRun > 0);
+    cutest_group_ptr_t psGroup = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "Group");
+    CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "A", SelfCountFn, NULL, 0);
+    CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "B", SelfFailFn, NULL, 0);
+    CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "C", SelfExitFn, &bExit, 0);
+    CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "D", SelfCountFn, NULL, 0);
+    CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psGroup);
+    ulSelfRuns = 0u;
+    CuTest_RunTests(&sRoot);
+
+    char acTape[5];
+    SelfTape(&sRoot, "ABCD", acTape);
+    char acMessage[CUTEST_MAX_LEN_MESSAGE];
+    strcpy(acMessage, SelfResult(&sRoot, "B")->acMessage);
+    CuTest_ReleaseRoot(&sRoot);
+    remove(acFile);
+
+    // Results of A and B are taken from the journal, only C and D are run
+    CuAssertStrEquals(".F..", acTape);
+    CuAssertStrEquals("inner failure", acMessage);
+    CuAssertIntEquals(1, (int)ulSelfRuns);
+  }
+}
+
+TEST_CASE(TEST_Run_OnTheSpot)
+{
+  for (int iDeferred = 0; iDeferred < 2; ++iDeferred)
+  {
+    cutest_root_t sRoot;
+    CuTest_InitRoot(&sRoot, "OnTheSpot");
+    sRoot.ulTimeBudget = iDeferred ? 60000u : 0u;
+    cutest_group_ptr_t psGroup = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "Group");
+    CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "A", SelfCountFn, NULL, 0);
+    CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "B", SelfFailFn, NULL, 0);
+    ulSelfRuns = 0u;
+    CuTest_RunRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psGroup);
+    const unsigned long ulSpot = ulSelfRuns;
+    CuTest_RunRootItem(&sRoot, EN_CUTEST_TYPE_CASE, CuTest_NewCase(&sRoot, __FILE__, __LINE__, NULL, "C", SelfCountFn, NULL, 0));
+    CuTest_RunTests(&sRoot);
+
+    char acTape[4];
+    SelfTape(&sRoot, "ABC", acTape);
+    char acMessage[CUTEST_MAX_LEN_MESSAGE];
+    strcpy(acMessage, SelfResult(&sRoot, "B")->acMessage);
+    CuTest_ReleaseRoot(&sRoot);
+
+    // Run on the spot without scheduling options, results kept for the run
+    CuAssertIntEquals(iDeferred ? 0 : 1, (int)ulSpot);
+    CuAssertIntEquals(2, (int)ulSelfRuns);
+    CuAssertStrEquals(".F.", acTape);
+    CuAssertStrEquals("inner failure", acMessage);
+  }
+}
+
+TEST_GROUP(TestSelf_Run)
+{
+  TEST_Run_WorkerCrash,
+  TEST_Run_WorkerExit,
+  TEST_Run_HistoryKeys,
+  TEST_Run_Direct,
+  TEST_Run_RecordParse,
+  TEST_Run_DependSkip,
+  TEST_Run_DependCycle,
+  TEST_Run_JournalResume,
+  TEST_Run_OnTheSpot
+};
+
+/*- Distributed execution ----------------------------------------------------*/
+TEST_CASE(TEST_Distrib_Hello)
+{
+  char acAddress[64];
+  snprintf(acAddress, sizeof(acAddress), "unix:/tmp/cutest-distrib-%ld", (long)getpid());
+
+  fflush(NULL);
+  const pid_t iPid = fork();
+  CuAssert(iPid >= 0, "cannot fork");
+  if (iPid == 0)
+  {
+    // Worker with the same number of test cases, but different names first
+    if (!SelfDistribWait(&acAddress[5])) _exit(EXIT_FAILURE);
+    const pid_t iOther = fork();
+    if (iOther == 0) SelfDistribWorker(acAddress, "X");
+    if (iOther > 0) waitpid(iOther, NULL, 0);
+    SelfDistribWorker(acAddress, "A");
+  }
+
+  cutest_root_t sRoot;
+  CuTest_InitRoot(&sRoot, "Coordinator");
+  sRoot.pszCoordinator = acAddress;
+  cutest_group_ptr_t psGroup = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "Group");
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "A", SelfPassFn, NULL, 0);
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "B", SelfPassFn, NULL, 0);
+  CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psGroup);
+
+  // Diagnostics printed to a temporary file
+  FILE* f = tmpfile();
+  CuAssertPtrNotNull(f);
+  fflush(stdout);
+  fflush(stderr);
+  const int iStdout = dup(STDOUT_FILENO);
+  const int iStderr = dup(STDERR_FILENO);
+  dup2(fileno(f), STDOUT_FILENO);
+  dup2(fileno(f), STDERR_FILENO);
+  CuTest_RunTests(&sRoot);
+  fflush(stdout);
+  fflush(stderr);
+  dup2(iStdout, STDOUT_FILENO);
+  dup2(iStderr, STDERR_FILENO);
+  close(iStdout);
+  close(iStderr);
+
+  char acLog[512] = "";
+  rewind(f);
+  size_t uLen = fread(acLog, 1u, sizeof(acLog) - 1u, f);
+  acLog[uLen] = '\0';
+  fclose(f);
+  char acTape[3];
+  SelfTape(&sRoot, "AB", acTape);
+  CuTest_ReleaseRoot(&sRoot);
+  int iStatus = 0;
+  waitpid(iPid, &iStatus, 0);
+
+  // Only the matching worker runs test cases
+  CuAssertStrEquals("..", acTape);
+  CuAssertPtrNotNull(strstr(acLog, "rejected worker running a different test runner"));
+  CuAssert(WIFEXITED(iStatus) && (WEXITSTATUS(iStatus) == EXIT_SUCCESS), "worker failed");
+}
+
+TEST_GROUP(TestSelf_Distrib)
+{
+  TEST_Distrib_Hello
+};
+
+
+/*- Report generation --------------------------------------------------------*/
+TEST_CASE(TEST_Report_NotRun)
+{
+  cutest_root_t sRoot;
+  CuTest_InitRoot(&sRoot, "NotRun");
+  sRoot.ulFailFast = 1u;
+  cutest_group_ptr_t psGroup = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "Group");
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "A", SelfFailFn, NULL, 0);
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "B", SelfPassFn, NULL, 0);
+  CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psGroup);
+  CuTest_RunTests(&sRoot);
+
+  char acReport[4096];
+  SelfReport(&sRoot, acReport, sizeof(acReport));
+  CuTest_ReleaseRoot(&sRoot);
+
+  // Footer matches the console result line
+  CuAssertPtrNotNull(strstr(acReport, "<p>2 runs, 0 passes, 1 fails, 1 not run\n</p>"));
+}
+
+TEST_CASE(TEST_Report_ProfileStatic)
+{
+  // The profiler is process-wide and cannot be disabled: profile in a child
+  char acDir[] = "/tmp/cutest-profile-XXXXXX";
+  CuAssertPtrNotNull(mkdtemp(acDir));
+  pid_t iPid = fork();
+  CuAssert(iPid >= 0, "cannot fork");
+  if (iPid == 0)
+  {
+    CuTest_EnableProfiler(acDir, 1000u);
+    cutest_root_t sRoot;
+    CuTest_InitRoot(&sRoot, "Profile");
+    CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_CASE, CuTest_NewCase(&sRoot, __FILE__, __LINE__, NULL, "Spin", SelfSpinFn, NULL, 0));
+    CuTest_RunTests(&sRoot);
+    CuTest_ReleaseRoot(&sRoot);
+    _exit(EXIT_SUCCESS);
+  }
+  int iStatus = 0;
+  waitpid(iPid, &iStatus, 0);
+
+  char acPath[sizeof(acDir) + 16u];
+  snprintf(acPath, sizeof(acPath), "%s/Spin.folded", acDir);
+  char acFolded[4096] = "";
+  FILE* f = fopen(acPath, "r");
+  if (f != NULL)
+  {
+    acFolded[fread(acFolded, 1u, sizeof(acFolded) - 1u, f)] = '\0';
+    fclose(f);
+  }
+  remove(acPath);
+  rmdir(acDir);
+
+  // Static functions are named, not listed per code address
+  CuAssertIntEquals(1, WIFEXITED(iStatus) && (WEXITSTATUS(iStatus) == EXIT_SUCCESS));
+  CuAssertPtrNotNull(strstr(acFolded, ";SelfSpinFn;SelfSpin"));
+  CuAssertPtrEquals(NULL, strstr(acFolded, "+0x"));
+}
+
+TEST_CASE(TEST_Report_RuntimeItems)
+{
+  // Many test cases per group, spanning several arena blocks, and a name
+  // larger than an arena block
+  cutest_root_t sRoot;
+  CuTest_InitRoot(&sRoot, "Runtime <items>");
+  cutest_group_ptr_t psGroup = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "G<&>");
+  char acName[32];
+  for (unsigned i = 0; i < 1000u; ++i)
+  {
+    snprintf(acName, sizeof(acName), "C<&%u>", i);
+    CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, acName, SelfPassFn, NULL, 0);
+  }
+  char* pszLong = malloc(100000u);
+  CuAssertPtrNotNull(pszLong);
+  memset(pszLong, 'L', 99999u);
+  pszLong[99999u] = '\0';
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, pszLong, SelfPassFn, NULL, 0);
+  free(pszLong);
+  CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psGroup);
+  CuTest_RunTests(&sRoot);
+
+  const cutest_result_t eResult = CuTest_GetRunResult(&sRoot);
+  const size_t uLong = strlen(psGroup->ppItems[1000u]->pszName);
+  const size_t uSize = 1024u * 1024u;
+  char* pszReport = malloc(uSize);
+  CuAssertPtrNotNull(pszReport);
+  SelfReport(&sRoot, pszReport, uSize);
+  CuTest_ReleaseRoot(&sRoot);
+
+  const _Bool bTitle = strstr(pszReport, "Unit Test Report &ndash; Runtime &lt;items&gt;</h1>") != NULL;
+  const _Bool bHeading = strstr(pszReport, "<h3>G&lt;&amp;&gt;</h3>") != NULL;
+  const _Bool bCase = strstr(pszReport, "<td>C&lt;&amp;999&gt;</td>") != NULL;
+  free(pszReport);
+
+  CuAssertIntEquals(EN_CUTEST_RESULT_PASS, eResult);
+  CuAssertIntEquals(99999, (int)uLong);
+  CuAssertIntEquals(1, bTitle);
+  CuAssertIntEquals(1, bHeading);
+  CuAssertIntEquals(1, bCase);
+}
+
+TEST_GROUP(TestSelf_Report)
+{
+  TEST_Report_NotRun,
+  TEST_Report_RuntimeItems,
+  TEST_Report_ProfileStatic
+};
+
+
+/*- Per-test coverage --------------------------------------------------------*/
+TEST_CASE(TEST_Coverage_Paths)
+{
+  cutest_root_t sRoot;
+  CuTest_InitRoot(&sRoot, "Coverage");
+  cutest_group_ptr_t psFirst = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "First");
+  cutest_group_ptr_t psSecond = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "Sec ond");
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psFirst, "Case", SelfPassFn, NULL, 0);
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psSecond, "Case", SelfPassFn, NULL, 0);
+  CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psFirst);
+  CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psSecond);
+
+  acSelfGcovDirs[0] = '\0';
+  CuTest_EnableCoverage("cov", SelfGcovReset, SelfGcovDump);
+  CuTest_RunTests(&sRoot);
+  CuTest_EnableCoverage(NULL, SelfGcovReset, SelfGcovDump);
+  CuTest_ReleaseRoot(&sRoot);
+
+  // Equal test case names in different groups get separate directories
+  CuAssertStrEquals("cov/First.Case;cov/Sec_ond.Case;", acSelfGcovDirs);
+}
+
+TEST_GROUP(TestSelf_Coverage)
+{
+  TEST_Coverage_Paths
+};
+
+
+/*- Mutation testing ---------------------------------------------------------*/
+TEST_CASE(TEST_Mutation_ForkError)
+{
+  fflush(NULL);
+  const pid_t iPid = fork();
+  CuAssert(iPid >= 0, "cannot fork");
+  if (iPid == 0)
+  {
+    // Mutant registration is process-wide, use a child process only
+    CuTest_RegisterMutants(&sSelfMutants);
+    cutest_root_t sRoot;
+    CuTest_InitRoot(&sRoot, "Mutation");
+    CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_CASE, CuTest_NewCase(&sRoot, __FILE__, __LINE__, NULL, "A", SelfMutantFn, NULL, 0));
+    CuTest_RunTests(&sRoot);
+
+    // Diagnostics and summary printed to a temporary file
+    FILE* f = tmpfile();
+    if (f == NULL) _exit(8);
+    fflush(stdout);
+    dup2(fileno(f), STDOUT_FILENO);
+    dup2(fileno(f), STDERR_FILENO);
+    bSelfForkFail = 1;
+    const unsigned long ulSurvived = CuTest_RunMutationTests(&sRoot, 1u, 0u);
+    bSelfForkFail = 0;
+    fflush(stdout);
+    CuTest_ReleaseRoot(&sRoot);
+
+    // Untested mutant neither survived nor killed, excluded from the score
+    char acSummary[512] = "";
+    rewind(f);
+    size_t uLen = fread(acSummary, 1u, sizeof(acSummary) - 1u, f);
+    acSummary[uLen] = '\0';
+    int iExit = (ulSurvived == 0u) ? 0 : 1;
+    if (strstr(acSummary, "self.c:42:0: error: mutant #1 not tested") == NULL) iExit |= 2;
+    if (strstr(acSummary, "1 mutants, 0 killed, 0 survived (0 not covered), 1 errors, score 100%") == NULL) iExit |= 4;
+    _exit(iExit);
+  }
+
+  int iStatus = 0;
+  waitpid(iPid, &iStatus, 0);
+  CuAssert(WIFEXITED(iStatus), "child terminated abnormally");
+  CuAssertIntEquals(0, WEXITSTATUS(iStatus));
+}
+
+TEST_GROUP(TestSelf_Mutation)
+{
+  TEST_Mutation_ForkError
+};
+
+
+/*- Output capture -----------------------------------------------------------*/
+TEST_CASE(TEST_Capture_Truncate)
+{
+  fflush(NULL);
+  const pid_t iPid = fork();
+  CuAssert(iPid >= 0, "cannot fork");
+  if (iPid == 0)
+  {
+    // Capture is process-wide, enable it in a child process only
+    CuTest_EnableOutputCapture(16u);
+    static const _Bool bFail = 1, bPass = 0;
+    cutest_root_t sRoot;
+    CuTest_InitRoot(&sRoot, "Capture");
+    cutest_group_ptr_t psGroup = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "Group");
+    CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "A", SelfPrintFn, (void*)&bFail, 0);
+    CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "B", SelfPrintFn, (void*)&bPass, 0);
+    CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psGroup);
+    CuTest_RunTests(&sRoot);
+
+    // Failed case keeps the end of its output, passed case none
+    const char* pszFail = SelfResult(&sRoot, "A")->pszOutput;
+    int iExit = ((pszFail != NULL) && (strcmp(pszFail, "[...]\nDEF\nstderr line\n") == 0)) ? 0 : 1;
+    if (SelfResult(&sRoot, "B")->pszOutput != NULL) iExit |= 2;
+    CuTest_ReleaseRoot(&sRoot);
+    _exit(iExit);
+  }
+
+  int iStatus = 0;
+  waitpid(iPid, &iStatus, 0);
+  CuAssert(WIFEXITED(iStatus), "child terminated abnormally");
+  CuAssertIntEquals(0, WEXITSTATUS(iStatus));
+}
+
+TEST_GROUP(TestSelf_Capture)
+{
+  TEST_Capture_Truncate
+};
+
+/*- Resource usage -----------------------------------------------------------*/
+TEST_CASE(TEST_Usage_Accounting)
+{
+  fflush(NULL);
+  const pid_t iPid = fork();
+  CuAssert(iPid >= 0, "cannot fork");
+  if (iPid == 0)
+  {
+    // Resource usage recording is process-wide, use a child process only
+    CuTest_EnableResourceUsage(1u);
+    cutest_root_t sRoot;
+    CuTest_InitRoot(&sRoot, "Usage");
+    cutest_group_ptr_t psGroup = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "Group");
+    CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "Spin", SelfSpinFn, NULL, 0);
+    CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "Write", SelfWriteFn, NULL, 0);
+    CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psGroup);
+    CuTest_RunTests(&sRoot);
+
+    // Ranking printed to a temporary file
+    FILE* f = tmpfile();
+    if (f == NULL) _exit(32);
+    fflush(stdout);
+    dup2(fileno(f), STDOUT_FILENO);
+    CuTestPrintUsage(&sRoot);
+    fflush(stdout);
+    char acRanking[1024] = "";
+    rewind(f);
+    size_t uLen = fread(acRanking, 1u, sizeof(acRanking) - 1u, f);
+    acRanking[uLen] = '\0';
+
+    // CPU time of the spinning test case, bytes written by the other one
+    const cutest_usage_t* psSpin = &SelfResult(&sRoot, "Spin")->sUsage;
+    const cutest_usage_t* psWrite = &SelfResult(&sRoot, "Write")->sUsage;
+    const _Bool bIo = (access("/proc/thread-self/io", R_OK) == 0) || (access("/proc/self/io", R_OK) == 0);
+    int iExit = 0;
+    if (psSpin->ullUserTime + psSpin->ullSysTime < 10000000ull) iExit |= 1;
+    if (psSpin->ullUserTime + psSpin->ullSysTime <= psWrite->ullUserTime + psWrite->ullSysTime) iExit |= 2;
+    if (bIo && ((psWrite->ullWritten < 65536u) || (psSpin->ullWritten >= 65536u))) iExit |= 4;
+    if (strstr(acRanking, "CPU time [ms], top 1:\n\t1) Spin -- ") == NULL) iExit |= 8;
+    if (bIo && (strstr(acRanking, "I/O [bytes], top 1:\n\t1) Write -- ") == NULL)) iExit |= 16;
+    CuTest_ReleaseRoot(&sRoot);
+    _exit(iExit);
+  }
+
+  int iStatus = 0;
+  waitpid(iPid, &iStatus, 0);
+  CuAssert(WIFEXITED(iStatus), "child terminated abnormally");
+  CuAssertIntEquals(0, WEXITSTATUS(iStatus));
+}
+
+TEST_GROUP(TestSelf_Usage)
+{
+  TEST_Usage_Accounting
+};
+
+
+/*- Hash calculation ---------------------------------------------------------*/
+TEST_CASE(TEST_Hash_KnownAnswer)
+{
+  CuAssertCrc32cEquals(0xE3069283ul, "123456789", 9u);
+  CuAssertHashEquals(0xEF46DB3751D8E999ull, "", 0u);
+  CuAssertHashEquals(0x44BC2CF5AD770999ull, "abc", 3u);
+}
+
+TEST_CASE(TEST_Hash_Streaming)
+{
+  // Lengths around the XXH64 stripe size, reference values from xxHash
+  static const struct
+  {
+    size_t uLen;
+    uint64_t ullXxh64;
+    uint32_t ulCrc32c;
+  } asVectors[] = {
+    {  0u, 0xEF46DB3751D8E999ull, 0x00000000ul },
+    {  1u, 0x8A4127811B21E730ull, 0xA016D052ul },
+    { 31u, 0x6AB1C40E29F50073ull, 0x1ADDDD6Dul },
+    { 32u, 0x5A0756FBE9ECD3D1ull, 0x34B898AEul },
+    { 33u, 0xDC50CDC37BB9C183ull, 0x4D21CA51ul }
+  };
+
+  uint8_t aucData[40 + 8];
+  for (size_t i = 0; i < sizeof(asVectors) / sizeof(asVectors[0]); ++i)
+  {
+    const size_t uLen = asVectors[i].uLen;
+    for (size_t uOffset = 0; uOffset < 8u; ++uOffset)
+    {
+      // Unaligned start and tail
+      uint8_t* pucData = &aucData[uOffset];
+      for (size_t j = 0; j < uLen; ++j) pucData[j] = (uint8_t)(j * 7u + 1u);
+      CuAssertHashEquals(asVectors[i].ullXxh64, pucData, uLen);
+      CuAssertCrc32cEquals(asVectors[i].ulCrc32c, pucData, uLen);
+
+      // Byte-wise and chunked updates crossing stripe boundaries
+      cutest_hash_t sXxh, sCrc, sChunked;
+      CuTest_HashInit(&sXxh, EN_CUTEST_HASH_XXH64);
+      CuTest_HashInit(&sCrc, EN_CUTEST_HASH_CRC32C);
+      CuTest_HashInit(&sChunked, EN_CUTEST_HASH_XXH64);
+      for (size_t j = 0; j < uLen; ++j)
+      {
+        CuTest_HashUpdate(&sXxh, &pucData[j], 1u);
+        CuTest_HashUpdate(&sCrc, &pucData[j], 1u);
+      }
+      for (size_t j = 0; j < uLen; j += 5u) CuTest_HashUpdate(&sChunked, &pucData[j], (uLen - j < 5u) ? uLen - j : 5u);
+      CuAssertHashStateEquals(asVectors[i].ullXxh64, &sXxh);
+      CuAssertHashStateEquals(asVectors[i].ulCrc32c, &sCrc);
+      CuAssertHashStateEquals(asVectors[i].ullXxh64, &sChunked);
+    }
+  }
+}
+
+TEST_GROUP(TestSelf_Hash)
+{
+  TEST_Hash_KnownAnswer,
+  TEST_Hash_Streaming
+};
+
+/*- Differential testing -----------------------------------------------------*/
+TEST_CASE(TEST_Diff_Results)
+{
+  static const cutest_diff_t sEdge = { .uInSize = sizeof(uint32_t), .uOutSize = sizeof(uint32_t), .ulInputs = 64u, .ulEdgeCases = 2u, .ullSeed = 0x1234u };
+  static const cutest_diff_t sRandom = { .uInSize = sizeof(uint32_t), .uOutSize = sizeof(uint32_t), .ulInputs = 64u, .ulEdgeCases = 1u, .ullSeed = 0x1234u };
+  static const cutest_diff_t sSpeed = { .uInSize = sizeof(uint32_t), .uOutSize = sizeof(uint32_t), .ulInputs = 64u, .ulEdgeCases = 2u, .dMinSpeedup = 1000.0 };
+
+  cutest_root_t sRoot;
+  CuTest_InitRoot(&sRoot, "Diff");
+  cutest_group_ptr_t psGroup = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "Group");
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "A", SelfDiffOptFn, (void*)&sEdge, 0);
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "B", SelfDiffBadFn, (void*)&sEdge, 0);
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "C", SelfDiffBadFn, (void*)&sRandom, 0);
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "D", SelfDiffOptFn, (void*)&sSpeed, 0);
+  CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psGroup);
+  CuTest_RunTests(&sRoot);
+
+  char acTape[5];
+  SelfTape(&sRoot, "ABCD", acTape);
+  static const char* const apszNames[] = { "A", "B", "C", "D" };
+  char aacMessage[4][CUTEST_MAX_LEN_MESSAGE];
+  for (int i = 0; i < 4; ++i) strcpy(aacMessage[i], SelfResult(&sRoot, apszNames[i])->acMessage);
+  CuTest_ReleaseRoot(&sRoot);
+
+  // First diverging input reported with its kind and the seed to reproduce it
+  CuAssertStrEquals(".FFF", acTape);
+  CuAssert(strncmp(aacMessage[0], "equivalent on 64 inputs, speedup ", 33u) == 0, aacMessage[0]);
+  CuAssertStrEquals("Differential test: outputs differ for input <1> (edge case, seed <0x0000000000001234>)", aacMessage[1]);
+  CuAssertStrEquals("Differential test: outputs differ for input <1> (random, seed <0x0000000000001234>)", aacMessage[2]);
+  CuAssert(strncmp(aacMessage[3], "Differential test: speedup <", 28u) == 0, aacMessage[3]);
+  CuAssertPtrNotNull(strstr(aacMessage[3], "below minimum <1000.00>"));
+}
+
+TEST_CASE(TEST_Diff_Random)
+{
+  // Same seed, same sequence; different seeds diverge
+  uint64_t ullA = 42u, ullB = 42u, ullC = 43u;
+  const uint64_t ullFirst = CuTest_Random(&ullA);
+  CuAssert(ullFirst == CuTest_Random(&ullB), "not reproducible");
+  CuAssert(CuTest_Random(&ullA) == CuTest_Random(&ullB), "not reproducible");
+  CuAssert(ullFirst != CuTest_Random(&ullC), "seed ignored");
+}
+
+TEST_GROUP(TestSelf_Diff)
+{
+  TEST_Diff_Results,
+  TEST_Diff_Random
+};
+
+
+/*- Test vectors -------------------------------------------------------------*/
+TEST_CASE(TEST_Vector_Formats)
+{
+  char acKv[128], acCsv[128], acRaw[128];
+  SelfVectorPath("kv.rsp", acKv, sizeof(acKv));
+  SelfVectorPath("table.csv", acCsv, sizeof(acCsv));
+  SelfVectorPath("raw.bin", acRaw, sizeof(acRaw));
+  const cutest_vec_t sKv = { .pszPath = acKv, .eFormat = EN_CUTEST_VEC_KV };
+  const cutest_vec_t sCsv = { .pszPath = acCsv, .eFormat = EN_CUTEST_VEC_CSV };
+  const cutest_vec_t sRaw = { .pszPath = acRaw, .eFormat = EN_CUTEST_VEC_RAW, .uRecordSize = 5u };
+  const cutest_vec_t sRawSize = { .pszPath = acRaw, .eFormat = EN_CUTEST_VEC_RAW, .uRecordSize = 4u };
+
+  cutest_root_t sRoot;
+  CuTest_InitRoot(&sRoot, "Vector");
+  cutest_group_ptr_t psGroup = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "Group");
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "A", SelfVecSumCase, (void*)&sKv, 0);
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "B", SelfVecNoteCase, (void*)&sCsv, 0);
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "C", SelfVecRawCase, (void*)&sRaw, 0);
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "D", SelfVecRawCase, (void*)&sRawSize, 0);
+  CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psGroup);
+  CuTest_RunTests(&sRoot);
+
+  char acTape[5];
+  SelfTape(&sRoot, "ABCD", acTape);
+  static const char* const apszNames[] = { "A", "B", "C", "D" };
+  char aacMessage[4][CUTEST_MAX_LEN_MESSAGE];
+  for (int i = 0; i < 4; ++i) strcpy(aacMessage[i], SelfResult(&sRoot, apszNames[i])->acMessage);
+  CuTest_ReleaseRoot(&sRoot);
+
+  // Section fields, quoted CSV fields and binary records; partial records fail
+  char acExpected[4][CUTEST_MAX_LEN_MESSAGE];
+  snprintf(acExpected[0], sizeof(acExpected[0]), "3 records of <%s> passed", acKv);
+  snprintf(acExpected[1], sizeof(acExpected[1]), "40 records of <%s> passed", acCsv);
+  snprintf(acExpected[2], sizeof(acExpected[2]), "2 records of <%s> passed", acRaw);
+  snprintf(acExpected[3], sizeof(acExpected[3]), "Test vectors: size of <%s> is not a multiple of the record size <4>", acRaw);
+  CuAssertStrEquals("...F", acTape);
+  for (int i = 0; i < 4; ++i) CuAssertStrEquals(acExpected[i], aacMessage[i]);
+}
+
+TEST_CASE(TEST_Vector_FirstFailure)
+{
+  char acCsv[128];
+  SelfVectorPath("table.csv", acCsv, sizeof(acCsv));
+  const cutest_vec_t sSerial = { .pszPath = acCsv, .eFormat = EN_CUTEST_VEC_CSV };
+  const cutest_vec_t sThreads = { .pszPath = acCsv, .eFormat = EN_CUTEST_VEC_CSV, .uThreads = 4u };
+
+  cutest_root_t sRoot;
+  CuTest_InitRoot(&sRoot, "Vector");
+  cutest_group_ptr_t psGroup = CuTest_NewGroup(&sRoot, __FILE__, __LINE__, "Group");
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "A", SelfVecDoubleCase, (void*)&sSerial, 0);
+  CuTest_NewCase(&sRoot, __FILE__, __LINE__, psGroup, "B", SelfVecDoubleCase, (void*)&sThreads, 0);
+  CuTest_AppendRootItem(&sRoot, EN_CUTEST_TYPE_GROUP, psGroup);
+  CuTest_RunTests(&sRoot);
+
+  char acTape[3];
+  SelfTape(&sRoot, "AB", acTape);
+  char acSerial[CUTEST_MAX_LEN_MESSAGE], acThreads[CUTEST_MAX_LEN_MESSAGE];
+  strcpy(acSerial, SelfResult(&sRoot, "A")->acMessage);
+  strcpy(acThreads, SelfResult(&sRoot, "B")->acMessage);
+  CuTest_ReleaseRoot(&sRoot);
+
+  // Records 17, 29 and 35 fail; the lowest record is reported, also if a later
+  // one failed first on another thread. Record 17 is in line 19 of the file
+  char acExpected[CUTEST_MAX_LEN_MESSAGE];
+  snprintf(acExpected, sizeof(acExpected), "Test vectors: 3 of 40 records failed, first record <17> (%s line 19): expected <34>, but was <33>", acCsv);
+  CuAssertStrEquals("FF", acTape);
+  CuAssertStrEquals(acExpected, acSerial);
+  CuAssertStrEquals(acExpected, acThreads);
+}
+
+TEST_GROUP(TestSelf_Vector)
+{
+  TEST_Vector_Formats,
+  TEST_Vector_FirstFailure
+};
+
+
+/*- Global state isolation ---------------------------------------------------*/
+TEST_CASE(TEST_State_CopyReloc)
+{
+  fflush(NULL);
+  const pid_t iPid = fork();
+  CuAssert(iPid >= 0, "cannot fork");
+  if (iPid == 0)
+  {
+    // Snapshot is process-wide, take it in a child process only. The empty
+    // environment makes setenv() allocate a new one.
+    clearenv();
+    CuTest_SnapshotState();
+    iSelfState = 2;
+    setenv("CUTEST_SELFTEST_STATE", "1", 1);
+    CuTestRestoreState();
+
+    // Application data is restored, the environment is kept
+    int iExit = (iSelfState == 1) ? 0 : 1;
+    if ((environ == NULL) || (getenv("CUTEST_SELFTEST_STATE") == NULL)) iExit |= 2;
+    _exit(iExit);
+  }
+
+  int iStatus = 0;
+  waitpid(iPid, &iStatus, 0);
+  CuAssert(WIFEXITED(iStatus), "child terminated abnormally");
+  CuAssertIntEquals(0, WEXITSTATUS(iStatus));
+}
+
+TEST_GROUP(TestSelf_State)
+{
+  TEST_State_CopyReloc
+};
+
+
+/*- In-memory file system ----------------------------------------------------*/
+TEST_CASE(TEST_Vfs_ReadWrite)
+{
+  CuTest_MountVfs("/vfs/");
+  CuAssert(CuTest_VfsAddFile("/vfs/in.txt", "hello", 5u), "cannot add file");
+
+  // Registered file, read through fopen and open
+  char acBuf[8] = "";
+  FILE* f = fopen("/vfs/in.txt", "r");
+  CuAssertPtrNotNull(f);
+  const size_t uRead = fread(acBuf, 1u, sizeof(acBuf) - 1u, f);
+  fclose(f);
+  int iFd = open("/vfs/in.txt", O_RDONLY);
+  CuAssert(iFd >= 0, "cannot open file");
+  char acFdBuf[8] = "";
+  const ssize_t iFdRead = read(iFd, acFdBuf, sizeof(acFdBuf) - 1u);
+  close(iFd);
+
+  // New files, written through fopen and open
+  f = fopen("/vfs/out.txt", "w");
+  CuAssertPtrNotNull(f);
+  fputs("data", f);
+  fclose(f);
+  iFd = open("/vfs/raw.bin", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  CuAssert(iFd >= 0, "cannot create file");
+  const ssize_t iWritten = write(iFd, "\x01\x02", 2u);
+  close(iFd);
+  char acOut[8] = "";
+  const long lOutSize = CuTest_VfsReadFile("/vfs/out.txt", acOut, sizeof(acOut) - 1u);
+  uint8_t aucRaw[4] = { 0u };
+  const long lRawSize = CuTest_VfsReadFile("/vfs/raw.bin", aucRaw, sizeof(aucRaw));
+  CuTest_MountVfs(NULL);
+
+  CuAssertIntEquals(5, (int)uRead);
+  CuAssertStrEquals("hello", acBuf);
+  CuAssertIntEquals(5, (int)iFdRead);
+  CuAssertStrEquals("hello", acFdBuf);
+  CuAssertIntEquals(2, (int)iWritten);
+  CuAssertIntEquals(4, (int)lOutSize);
+  CuAssertStrEquals("data", acOut);
+  CuAssertIntEquals(2, (int)lRawSize);
+  CuAssertMemEquals("\x01\x02", aucRaw, 2u);
+}
+
+TEST_CASE(TEST_Vfs_Exclusive)
+{
+  CuTest_MountVfs("/vfs/");
+  CuTest_VfsAddFile("/vfs/in.txt", "hello", 5u);
+
+  errno = 0;
+  const int iFd = open("/vfs/in.txt", O_WRONLY | O_CREAT | O_EXCL, 0644);
+  const int iOpenErr = errno;
+  errno = 0;
+  FILE* f = fopen("/vfs/in.txt", "wx");
+  const int iFopenErr = errno;
+  const long lSize = CuTest_VfsReadFile("/vfs/in.txt", NULL, 0u);
+  CuTest_MountVfs(NULL);
+
+  // Existing file is kept
+  CuAssertIntEquals(-1, iFd);
+  CuAssertIntEquals(EEXIST, iOpenErr);
+  CuAssertPtrEquals(NULL, f);
+  CuAssertIntEquals(EEXIST, iFopenErr);
+  CuAssertIntEquals(5, (int)lSize);
+}
+
+TEST_CASE(TEST_Vfs_Remove)
+{
+  CuTest_MountVfs("/vfs/");
+  CuTest_VfsAddFile("/vfs/a.txt", "a", 1u);
+  CuTest_VfsAddFile("/vfs/b.txt", "b", 1u);
+
+  const int iRemove = remove("/vfs/a.txt");
+  const int iUnlink = unlink("/vfs/b.txt");
+  errno = 0;
+  const int iMissing = unlink("/vfs/a.txt");
+  const int iMissingErr = errno;
+  errno = 0;
+  FILE* f = fopen("/vfs/b.txt", "r");
+  const int iFopenErr = errno;
+  const long lSizeA = CuTest_VfsReadFile("/vfs/a.txt", NULL, 0u);
+  const long lSizeB = CuTest_VfsReadFile("/vfs/b.txt", NULL, 0u);
+  CuTest_MountVfs(NULL);
+
+  CuAssertIntEquals(0, iRemove);
+  CuAssertIntEquals(0, iUnlink);
+  CuAssertIntEquals(-1, iMissing);
+  CuAssertIntEquals(ENOENT, iMissingErr);
+  CuAssertPtrEquals(NULL, f);
+  CuAssertIntEquals(ENOENT, iFopenErr);
+  CuAssertIntEquals(-1, (int)lSizeA);
+  CuAssertIntEquals(-1, (int)lSizeB);
+}
+
+TEST_CASE(TEST_Vfs_Limit)
+{
+  CuTest_MountVfs("/vfs/");
+
+  // Fill the file table, one more file does not fit
+  char acPath[32];
+  int iFailed = -1;
+  for (unsigned i = 0; i < CUTEST_MAX_NUM_VFS_FILES; ++i)
+  {
+    snprintf(acPath, sizeof(acPath), "/vfs/%u.bin", i);
+    const int iFd = open(acPath, O_WRONLY | O_CREAT, 0644);
+    if ((iFd < 0) && (iFailed < 0)) iFailed = (int)i;
+    if (iFd >= 0) close(iFd);
+  }
+  errno = 0;
+  const int iFd = open("/vfs/full.bin", O_WRONLY | O_CREAT, 0644);
+  const int iErr = errno;
+  if (iFd >= 0) close(iFd);
+  CuTest_MountVfs(NULL);
+
+  CuAssertIntEquals(-1, iFailed);
+  CuAssertIntEquals(-1, iFd);
+  CuAssertIntEquals(ENOSPC, iErr);
+}
+
+TEST_GROUP(TestSelf_Vfs)
+{
+  TEST_Vfs_ReadWrite,
+  TEST_Vfs_Exclusive,
+  TEST_Vfs_Remove,
+  TEST_Vfs_Limit
+};
+
+
+/*- Peripheral simulation ----------------------------------------------------*/
+#if defined(__i386__) || defined(__x86_64__)
+/*! Simulated register bank address                                           */
+#define SELF_PERIPH_BASE              0x40011000u
+
+/*!****************************************************************************
+ * @brief
+ * Map the simulated register bank on first use
+ *
+ * @return  (_Bool)  true, if the bank is mapped
+ * @date  17.10.2026
+ ******************************************************************************/
+static _Bool SelfPeriphMap(void)
+{
+  static _Bool bMapped = 0;
+  if (!bMapped) bMapped = CuTest_MapPeripheral("Self", SELF_PERIPH_BASE, 0x400u);
+  return bMapped;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Register read hook, models a read-to-clear register
+ *
+ * @param[in] uAddr       Register address
+ * @param[in] ulValue     Register content
+ * @param[in] *pUser      Unused
+ * @return  (uint32_t)  Value presented to the reading instruction
+ * @date  17.10.2026
+ ******************************************************************************/
+static uint32_t SelfClearHook(uintptr_t uAddr, uint32_t ulValue, void* pUser)
+{
+  (void)pUser;
+  CuTest_PokeRegister(uAddr, 0u);
+  return ulValue;
+}
+
+TEST_CASE(TEST_Periph_ReadModifyWrite)
+{
+  CuAssert(SelfPeriphMap(), "cannot map register bank");
+  CuTest_HookRegister(SELF_PERIPH_BASE, SelfStatusHook, NULL, NULL);
+
+  // Single "or" instruction with a memory operand, then a plain store
+  volatile uint32_t* pulReg = (volatile uint32_t*)(uintptr_t)SELF_PERIPH_BASE;
+  __asm__ volatile ("orl $1, %0" : "+m"(*pulReg));
+  *pulReg = 0x20u;
+
+  size_t uCount;
+  const cutest_reg_access_t* psTrace = CuTest_GetRegisterTrace(&uCount);
+  CuAssertIntEquals(3, (int)uCount);
+  CuAssertIntEquals(0, psTrace[0].bWrite);
+  CuAssertIntEquals(0x10, (int)psTrace[0].ulValue);
+  CuAssertIntEquals(1, psTrace[1].bWrite);
+  CuAssertIntEquals(0x11, (int)psTrace[1].ulValue);
+  CuAssertIntEquals(1, psTrace[2].bWrite);
+  CuAssertIntEquals(0x20, (int)psTrace[2].ulValue);
+  CuAssertIntEquals(4, psTrace[0].ucWidth);
+  CuAssertIntEquals(4, psTrace[1].ucWidth);
+  CuAssertIntEquals(4, psTrace[2].ucWidth);
+}
+
+TEST_CASE(TEST_Periph_ReadHook)
+{
+  CuAssert(SelfPeriphMap(), "cannot map register bank");
+  CuTest_HookRegister(SELF_PERIPH_BASE, SelfStatusHook, NULL, NULL);
+
+  // Hooked value is seen by the reading instruction only
+  volatile uint32_t* pulReg = (volatile uint32_t*)(uintptr_t)SELF_PERIPH_BASE;
+  const uint32_t ulRead = *pulReg;
+  CuAssertIntEquals(0x10, (int)ulRead);
+  CuAssertIntEquals(0x00, (int)CuTest_PeekRegister(SELF_PERIPH_BASE));
+
+  // Read-to-clear register, modelled by poking from the hook
+  CuTest_PokeRegister(SELF_PERIPH_BASE + 4u, 0x80u);
+  CuTest_HookRegister(SELF_PERIPH_BASE + 4u, SelfClearHook, NULL, NULL);
+  const uint32_t ulFirst = pulReg[1];
+  const uint32_t ulSecond = pulReg[1];
+  CuAssertIntEquals(0x80, (int)ulFirst);
+  CuAssertIntEquals(0x00, (int)ulSecond);
+}
+
+TEST_CASE(TEST_Periph_Width)
+{
+  CuAssert(SelfPeriphMap(), "cannot map register bank");
+
+  volatile uint32_t* pulReg = (volatile uint32_t*)(uintptr_t)SELF_PERIPH_BASE;
+  *(volatile uint16_t*)pulReg = 0x1234u;
+  const uint8_t ucByte = *(volatile uint8_t*)pulReg;
+  *pulReg = 0x5678u;
+
+  size_t uCount;
+  const cutest_reg_access_t* psTrace = CuTest_GetRegisterTrace(&uCount);
+  CuAssertIntEquals(3, (int)uCount);
+  CuAssertIntEquals(0x34, ucByte);
+  CuAssertIntEquals(2, psTrace[0].ucWidth);
+  CuAssertIntEquals(1, psTrace[1].ucWidth);
+  CuAssertIntEquals(4, psTrace[2].ucWidth);
+}
+
+TEST_CASE(TEST_Periph_NoReplace)
+{
+  const size_t uPage = (size_t)sysconf(_SC_PAGESIZE);
+  void* pMap = mmap(NULL, uPage, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  CuAssert(pMap != MAP_FAILED, "cannot create mapping");
+  *(volatile uint32_t*)pMap = 0x5Au;
+
+  const _Bool bMapped = CuTest_MapPeripheral("Taken", (uintptr_t)pMap, 4u);
+  const uint32_t ulContent = *(volatile uint32_t*)pMap;
+  munmap(pMap, uPage);
+
+  // Existing mappings are kept
+  CuAssertIntEquals(0, bMapped);
+  CuAssertIntEquals(0x5A, (int)ulContent);
+}
+
+TEST_GROUP(TestSelf_Periph)
+{
+  TEST_Periph_ReadModifyWrite,
+  TEST_Periph_ReadHook,
+  TEST_Periph_Width,
+  TEST_Periph_NoReplace
+};
+#endif
+
+
+/*!****************************************************************************
+ * @brief
+ * Self-test runner
+ *
+ * @param[in] argc        Number of arguments
+ * @param[in] *argv[]     Arguments
+ * @return  (int)  Exit code
+ * @date  17.10.2026
+ ******************************************************************************/
+int main(int argc, char* argv[])
+{
+  BEGIN_TEST_RUN();
+  PARSE_TEST_ARGS(argc, argv);
+  RUN_TEST_GROUP(TestSelf_Run);
+  RUN_TEST_GROUP(TestSelf_Distrib);
+  RUN_TEST_GROUP(TestSelf_Cpp);
+  RUN_TEST_GROUP(TestSelf_Report);
+  RUN_TEST_GROUP(TestSelf_Coverage);
+  RUN_TEST_GROUP(TestSelf_Mutation);
+  RUN_TEST_GROUP(TestSelf_Capture);
+  RUN_TEST_GROUP(TestSelf_Usage);
+  RUN_TEST_GROUP(TestSelf_Hash);
+  RUN_TEST_GROUP(TestSelf_Diff);
+  RUN_TEST_GROUP(TestSelf_Vector);
+  RUN_TEST_GROUP(TestSelf_State);
+  RUN_TEST_GROUP(TestSelf_Vfs);
+#if defined(__i386__) || defined(__x86_64__)
+  RUN_TEST_GROUP(TestSelf_Periph);
+#endif
+  END_TEST_RUN();
+
+  int iResult = GET_RUN_RESULT();
+  CuTest_ReleaseRoot(&_root);
+  return iResult;
+}
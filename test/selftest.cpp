@@ -0,0 +1,236 @@
+/*!*****************************************************************************
+ * @file
+ * selftest.cpp
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * CuTest framework self-test - C++ front end
+ *
+ * Inner C++ test items are defined statically, and run by test cases of this
+ * file in separate test run roots. Built with -pedantic-errors for C++14, the
+ * oldest language standard evaluating compile-time test cases, and linked
+ * into the C self-test runner (see test/selftest.c and src/Makefile).
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include "CuTest.hpp"
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! Local object of inner test cases, counts its destructor runs              */
+struct SelfGuard
+{
+  static unsigned long ulDestroyed; ///< Number of destructor runs
+
+  ~SelfGuard() { ulDestroyed++; }
+};
+
+
+/*- Private variables --------------------------------------------------------*/
+unsigned long SelfGuard::ulDestroyed = 0u;
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Run an inner test group in a separate test run root, without printing
+ * test case results
+ *
+ * @param[inout] psRoot   Test run root, release with CuTest_ReleaseRoot
+ * @param[in] psGroup     Test group
+ * @date  17.10.2026
+ ******************************************************************************/
+static void SelfCppRun(cutest_root_ptr_t psRoot, cutest_group_ptr_t psGroup)
+{
+  for (unsigned long i = 0; (i < psGroup->ulNumItems) && (psGroup->ppItems[i] != NULL); ++i) psGroup->ppItems[i]->bPrintResult = 0;
+
+  CuTest_InitRoot(psRoot, "Cpp");
+  CuTest_AppendRootItem(psRoot, EN_CUTEST_TYPE_GROUP, psGroup);
+  CuTest_RunTests(psRoot);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Find the result of an inner test case by name
+ *
+ * @param[in] psRoot      Test run root, after the run
+ * @param[in] *pszName    Test case name
+ * @return  (cutest_case_ptr_t)  Test case data, NULL if not found
+ * @date  17.10.2026
+ ******************************************************************************/
+static cutest_case_ptr_t SelfCppResult(const cutest_root_ptr_t psRoot, const char* pszName)
+{
+  for (unsigned long i = 0; i < psRoot->ulNumNodes; ++i)
+  {
+    cutest_case_ptr_t psResult = psRoot->psNodes[i].psResult;
+    if ((psResult != NULL) && (std::strcmp(psResult->pszName, pszName) == 0)) return psResult;
+  }
+  return NULL;
+}
+
+
+/*!****************************************************************************
+ * @brief
+ * CRC-8 (polynomial 0x07) of a single byte, checked at compile time
+ *
+ * @param[in] ucData      Input byte
+ * @return  (uint8_t)  CRC
+ * @date  17.10.2026
+ ******************************************************************************/
+static constexpr uint8_t SelfCppCrc8(uint8_t ucData)
+{
+  unsigned uCrc = ucData;
+  for (unsigned i = 0; i < 8u; ++i) uCrc = (uCrc & 0x80u) ? ((uCrc << 1) ^ 0x07u) : (uCrc << 1);
+  return (uint8_t)uCrc;
+}
+
+
+/*- Inner test items ---------------------------------------------------------*/
+TEST_CASE(SelfCppFail)
+{
+  SelfGuard sGuard;
+  CuAssertIntEquals(1, 2);
+}
+
+TEST_CASE(SelfCppThrow)
+{
+  SelfGuard sGuard;
+  throw std::runtime_error("out of range");
+}
+
+TEST_CASE(SelfCppPass)
+{
+  SelfGuard sGuard;
+  CuAssertIntEquals(2, 1 + 1);
+}
+
+TEST_GROUP(SelfCppInner)
+{
+  SelfCppFail,
+  SelfCppThrow,
+  SelfCppPass
+};
+
+TYPED_TEST_CASE(SelfCppTyped, int8_t, uint16_t, long)
+{
+  CuAssert(TypeParam(200) > TypeParam(0), "value out of range");
+}
+
+CONSTEXPR_TEST_CASE(SelfCppConst)
+{
+  CuConstAssert(SelfCppCrc8(0x00u) == 0x00u);
+  CuConstAssert(SelfCppCrc8(0x01u) == 0x07u);
+  CuConstAssert(SelfCppCrc8(0x80u) == 0x89u);
+}
+
+TEST_GROUP(SelfCppConstInner)
+{
+  SelfCppConst
+};
+
+TEST_SUITE(SelfCppSuite)
+{
+  TEST_SUITE_ITEM(SelfCppInner),
+  TEST_SUITE_ITEM(SelfCppPass)
+};
+
+
+/*- C++ front end ------------------------------------------------------------*/
+TEST_CASE(TEST_Cpp_Failure)
+{
+  cutest_root_t sRoot;
+  SelfGuard::ulDestroyed = 0u;
+  SelfCppRun(&sRoot, SelfCppInner);
+
+  const cutest_case_ptr_t psFail = SelfCppResult(&sRoot, "SelfCppFail");
+  const cutest_case_ptr_t psThrow = SelfCppResult(&sRoot, "SelfCppThrow");
+  const cutest_case_ptr_t psPass = SelfCppResult(&sRoot, "SelfCppPass");
+  const bool bFound = (psFail != NULL) && (psThrow != NULL) && (psPass != NULL);
+  const cutest_result_t aeResults[3] = {
+    bFound ? psFail->eResult : EN_CUTEST_RESULT_UNDEF,
+    bFound ? psThrow->eResult : EN_CUTEST_RESULT_UNDEF,
+    bFound ? psPass->eResult : EN_CUTEST_RESULT_UNDEF
+  };
+  char acFail[CUTEST_MAX_LEN_MESSAGE] = "";
+  char acThrow[CUTEST_MAX_LEN_MESSAGE] = "";
+  if (bFound) std::strcpy(acFail, psFail->acMessage);
+  if (bFound) std::strcpy(acThrow, psThrow->acMessage);
+  CuTest_ReleaseRoot(&sRoot);
+
+  // Failures unwind the test case, exceptions are reported with what()
+  CuAssert(bFound, "inner test case missing");
+  CuAssertIntEquals(EN_CUTEST_RESULT_FAIL, aeResults[0]);
+  CuAssertIntEquals(EN_CUTEST_RESULT_FAIL, aeResults[1]);
+  CuAssertIntEquals(EN_CUTEST_RESULT_PASS, aeResults[2]);
+  CuAssertStrEquals("expected <1>, but was <2>", acFail);
+  CuAssertStrEquals("unexpected exception: out of range", acThrow);
+  CuAssertIntEquals(3, (int)SelfGuard::ulDestroyed);
+}
+
+TEST_CASE(TEST_Cpp_Descriptor)
+{
+  // Positionally initialized descriptor, as with TEST_CASE in C sources
+  CuAssertStrEquals("SelfCppPass", SelfCppPass->pszName);
+  CuAssertStrEquals(__FILE__, SelfCppPass->pszFile);
+  CuAssert(SelfCppPass->pfvFailFn == CuTestThrowFailure, "longjmp failure");
+  CuAssertStrEquals("SelfCppInner", SelfCppInner->pszName);
+  CuAssertIntEquals(CUTEST_MAX_NUM_CASES, (int)SelfCppInner->ulNumItems);
+  CuAssertPtrEquals(SelfCppFail, SelfCppInner->ppItems[0]);
+  CuAssertIntEquals(EN_CUTEST_TYPE_GROUP, SelfCppSuite->psItems[0].eType);
+  CuAssertPtrEquals(SelfCppInner, SelfCppSuite->psItems[0].psGroup);
+  CuAssertIntEquals(EN_CUTEST_TYPE_CASE, SelfCppSuite->psItems[1].eType);
+  CuAssertPtrEquals(SelfCppPass, SelfCppSuite->psItems[1].psCase);
+}
+
+TEST_CASE(TEST_Cpp_Typed)
+{
+  cutest_root_t sRoot;
+  SelfCppRun(&sRoot, SelfCppTyped);
+
+  // One test case per type, in declaration order
+  const char* const apszNames[3] = { "SelfCppTyped<int8_t>", "SelfCppTyped<uint16_t>", "SelfCppTyped<long>" };
+  const cutest_result_t aeExpected[3] = { EN_CUTEST_RESULT_FAIL, EN_CUTEST_RESULT_PASS, EN_CUTEST_RESULT_PASS };
+  cutest_result_t aeResults[3];
+  for (unsigned i = 0; i < 3u; ++i)
+  {
+    const cutest_case_ptr_t psResult = SelfCppResult(&sRoot, apszNames[i]);
+    aeResults[i] = (psResult != NULL) ? psResult->eResult : EN_CUTEST_RESULT_UNDEF;
+  }
+  const unsigned long ulNumCases = sRoot.psNodes[0].ulCount;
+  CuTest_ReleaseRoot(&sRoot);
+
+  CuAssertStrEquals("SelfCppTyped", SelfCppTyped->pszName);
+  CuAssertIntEquals(3, (int)ulNumCases);
+  CuAssertStrEquals(apszNames[1], SelfCppTyped->ppItems[1]->pszName);
+  for (unsigned i = 0; i < 3u; ++i) CuAssertIntEquals(aeExpected[i], aeResults[i]);
+}
+
+TEST_CASE(TEST_Cpp_Constexpr)
+{
+  cutest_root_t sRoot;
+  SelfCppRun(&sRoot, SelfCppConstInner);
+  const cutest_case_ptr_t psResult = SelfCppResult(&sRoot, "SelfCppConst");
+  const cutest_result_t eResult = (psResult != NULL) ? psResult->eResult : EN_CUTEST_RESULT_UNDEF;
+  CuTest_ReleaseRoot(&sRoot);
+
+  // Assertions were checked by the compiler, registered test case passes
+  static_assert(SelfCppCrc8(0x80u) == 0x89u, "not evaluated at compile time");
+  CuAssertIntEquals(EN_CUTEST_RESULT_PASS, eResult);
+}
+
+TEST_GROUP(TestSelf_Cpp)
+{
+  TEST_Cpp_Failure,
+  TEST_Cpp_Descriptor,
+  TEST_Cpp_Typed,
+  TEST_Cpp_Constexpr
+};
@@ -0,0 +1,414 @@
+/*!*****************************************************************************
+ * @file
+ * cutest-bench.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - self-benchmark
+ *
+ * Measures the framework overhead: test case dispatch (state reset, setjmp and
+ * the result line), passing and failing assertions, and the run, summary and
+ * report of synthetic test suites of 1k, 10k and 100k test cases at several
+ * failure rates. Each figure is the median of several repetitions, printed as
+ * a fixed-format table to compare library versions. Framework output is sent
+ * to /dev/null. This source file is licensed under The MIT License. See
+ * https://opensource.org/license/mit/ for full license text.
+ *
+ * Build and run (see src/Makefile):
+ *   make -C src bench
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "CuTest.h"
+
+
+/*- Macro definitions --------------------------------------------------------*/
+#ifndef CUTEST_VERSION
+#define CUTEST_VERSION                "unknown"
+#endif /* CUTEST_VERSION */
+
+/*! Number of repetitions per figure, the median is reported                  */
+#define BENCH_REPEAT                  5u
+
+/*! Number of test case runs per dispatch figure                              */
+#define BENCH_DISPATCH_OPS            100000ul
+
+/*! Number of calls per assertion figure                                      */
+#define BENCH_ASSERT_OPS              1000000ul
+
+/*! Report file, removed after the benchmark                                  */
+#define BENCH_REPORT_FILE             "cutest-bench.html"
+
+/*! Max. test case name length                                                */
+#define BENCH_MAX_LEN_NAME            32u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! Synthetic test suite                                                      */
+typedef struct tag_bench_suite_t
+{
+  unsigned long ulCases;            ///< Number of test cases
+  unsigned uFailRate;               ///< Failing test cases [%]
+  cutest_case_ptr_t psCases;        ///< Test case data
+  char* pszNames;                   ///< Test case names
+  cutest_root_t sRoot;              ///< Test run root
+} bench_suite_t;
+
+/*! Suite figures [ns/case]                                                   */
+typedef struct tag_bench_suite_result_t
+{
+  double dRun;                      ///< Test run
+  double dSummary;                  ///< Summary printout
+  double dReport;                   ///< HTML report
+} bench_suite_result_t;
+
+
+/*- Prototypes ---------------------------------------------------------------*/
+static uint64_t BenchNow(void);
+static int      BenchCompare(const void* pA, const void* pB);
+static double   BenchMedian(uint64_t* pullTimes, unsigned uCount, unsigned long ulOps);
+static void     BenchEmptyFn(cutest_case_ptr_t _tc);
+static void     BenchPassFn(cutest_case_ptr_t _tc);
+static void     BenchFailFn(cutest_case_ptr_t _tc);
+static void     BenchInitCase(cutest_case_ptr_t psCase, const char* pszName, cutest_test_fn_t pfvFn, _Bool bPrint);
+static double   BenchDispatch(cutest_test_fn_t pfvFn, _Bool bPrint);
+static double   BenchAssertPass(void);
+static double   BenchAssertFail(void);
+static void     BenchSuiteInit(bench_suite_t* psSuite, unsigned long ulCases, unsigned uFailRate);
+static void     BenchSuiteFree(bench_suite_t* psSuite);
+static bench_suite_result_t BenchSuite(unsigned long ulCases, unsigned uFailRate);
+
+
+/*- Private variables --------------------------------------------------------*/
+/*! Synthetic suite sizes                                                     */
+static const unsigned long aulSuiteCases[] = { 1000ul, 10000ul, 100000ul };
+
+/*! Synthetic suite failure rates [%]                                         */
+static const unsigned auSuiteFailRates[] = { 0u, 10u, 50u };
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Get the monotonic clock
+ *
+ * @return  (uint64_t)  Time [ns]
+ * @date  17.10.2026
+ ******************************************************************************/
+static uint64_t BenchNow(void)
+{
+  struct timespec sNow;
+  clock_gettime(CLOCK_MONOTONIC, &sNow);
+  return (uint64_t)sNow.tv_sec * 1000000000ull + (uint64_t)sNow.tv_nsec;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Compare two times, for qsort
+ *
+ * @param[in] pA          First time
+ * @param[in] pB          Second time
+ * @return  (int)  <0, 0 or >0
+ * @date  17.10.2026
+ ******************************************************************************/
+static int BenchCompare(const void* pA, const void* pB)
+{
+  uint64_t ullA = *(const uint64_t*)pA;
+  uint64_t ullB = *(const uint64_t*)pB;
+  return (ullA > ullB) - (ullA < ullB);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Get the median time per operation
+ *
+ * @param[inout] pullTimes  Repetition times [ns], sorted on return
+ * @param[in] uCount      Number of repetitions
+ * @param[in] ulOps       Number of operations per repetition
+ * @return  (double)  Median time per operation [ns]
+ * @date  17.10.2026
+ ******************************************************************************/
+static double BenchMedian(uint64_t* pullTimes, unsigned uCount, unsigned long ulOps)
+{
+  qsort(pullTimes, uCount, sizeof(uint64_t), BenchCompare);
+  return (double)pullTimes[uCount / 2u] / (double)ulOps;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Empty test function
+ *
+ * @param[in] _tc         Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+static void BenchEmptyFn(cutest_case_ptr_t _tc)
+{
+  (void)_tc;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test function with one passing assertion
+ *
+ * @param[in] _tc         Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+static void BenchPassFn(cutest_case_ptr_t _tc)
+{
+  CuAssertIntEquals(1, 1);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Test function with one failing assertion
+ *
+ * @param[in] _tc         Test case data
+ * @date  17.10.2026
+ ******************************************************************************/
+static void BenchFailFn(cutest_case_ptr_t _tc)
+{
+  CuAssertIntEquals(0, 1);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Initialize a test case, as TEST_CASE() does
+ *
+ * @param[out] psCase     Test case data
+ * @param[in] *pszName    Test case name
+ * @param[in] pfvFn       Test function
+ * @param[in] bPrint      Print the result line
+ * @date  17.10.2026
+ ******************************************************************************/
+static void BenchInitCase(cutest_case_ptr_t psCase, const char* pszName, cutest_test_fn_t pfvFn, _Bool bPrint)
+{
+  memset(psCase, 0, sizeof(cutest_case_t));
+  psCase->pszName = pszName;
+  psCase->pszFile = __FILE__;
+  psCase->ulLine = __LINE__;
+  psCase->pfvTestFn = pfvFn;
+  psCase->eResult = EN_CUTEST_RESULT_UNDEF;
+  psCase->pszMsgFile = __FILE__;
+  psCase->ulMsgLine = __LINE__;
+  psCase->bPrintResult = bPrint;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Measure the dispatch of a single test case
+ *
+ * @param[in] pfvFn       Test function
+ * @param[in] bPrint      Print the result line
+ * @return  (double)  Time per test case run [ns]
+ * @date  17.10.2026
+ ******************************************************************************/
+static double BenchDispatch(cutest_test_fn_t pfvFn, _Bool bPrint)
+{
+  cutest_case_t sCase;
+  BenchInitCase(&sCase, "BENCH_Dispatch", pfvFn, bPrint);
+
+  uint64_t aullTimes[BENCH_REPEAT];
+  for (unsigned r = 0u; r < BENCH_REPEAT; ++r)
+  {
+    uint64_t ullStart = BenchNow();
+    for (unsigned long i = 0; i < BENCH_DISPATCH_OPS; ++i) CuTest_RunTestCase(&sCase);
+    aullTimes[r] = BenchNow() - ullStart;
+  }
+  return BenchMedian(aullTimes, BENCH_REPEAT, BENCH_DISPATCH_OPS);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Measure a passing assertion
+ *
+ * @return  (double)  Time per assertion [ns]
+ * @date  17.10.2026
+ ******************************************************************************/
+static double BenchAssertPass(void)
+{
+  cutest_case_t sCase;
+  BenchInitCase(&sCase, "BENCH_AssertPass", BenchEmptyFn, 0);
+
+  uint64_t aullTimes[BENCH_REPEAT];
+  for (unsigned r = 0u; r < BENCH_REPEAT; ++r)
+  {
+    uint64_t ullStart = BenchNow();
+    for (unsigned long i = 0; i < BENCH_ASSERT_OPS; ++i) CuTest_EvalAssertIntEquals(&sCase, __FILE__, __LINE__, (intmax_t)i, (intmax_t)i);
+    aullTimes[r] = BenchNow() - ullStart;
+  }
+  return BenchMedian(aullTimes, BENCH_REPEAT, BENCH_ASSERT_OPS);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Measure a failing assertion, including message formatting and longjmp
+ *
+ * @return  (double)  Time per assertion [ns]
+ * @date  17.10.2026
+ ******************************************************************************/
+static double BenchAssertFail(void)
+{
+  cutest_case_t sCase;
+  BenchInitCase(&sCase, "BENCH_AssertFail", BenchEmptyFn, 0);
+
+  // Loop counters are kept in memory across longjmp
+  uint64_t aullTimes[BENCH_REPEAT];
+  for (volatile unsigned r = 0u; r < BENCH_REPEAT; ++r)
+  {
+    uint64_t ullStart = BenchNow();
+    for (volatile unsigned long i = 0; i < BENCH_ASSERT_OPS; ++i)
+    {
+      if (setjmp(sCase.sEnv) == 0) CuTest_EvalAssertIntEquals(&sCase, __FILE__, __LINE__, 0, (intmax_t)i + 1);
+    }
+    aullTimes[r] = BenchNow() - ullStart;
+  }
+  return BenchMedian(aullTimes, BENCH_REPEAT, BENCH_ASSERT_OPS);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Create a synthetic test suite
+ *
+ * Failing test cases are spread evenly over the suite.
+ *
+ * @param[out] psSuite    Test suite
+ * @param[in] ulCases     Number of test cases
+ * @param[in] uFailRate   Failing test cases [%]
+ * @date  17.10.2026
+ ******************************************************************************/
+static void BenchSuiteInit(bench_suite_t* psSuite, unsigned long ulCases, unsigned uFailRate)
+{
+  psSuite->ulCases = ulCases;
+  psSuite->uFailRate = uFailRate;
+  psSuite->psCases = malloc(ulCases * sizeof(cutest_case_t));
+  psSuite->pszNames = malloc(ulCases * BENCH_MAX_LEN_NAME);
+  if ((psSuite->psCases == NULL) || (psSuite->pszNames == NULL))
+  {
+    fprintf(stderr, "cutest-bench: cannot allocate %lu test cases\n", ulCases);
+    exit(EXIT_FAILURE);
+  }
+
+  CuTest_InitRoot(&psSuite->sRoot, "CuTest benchmark");
+  for (unsigned long i = 0; i < ulCases; ++i)
+  {
+    char* pszName = &psSuite->pszNames[i * BENCH_MAX_LEN_NAME];
+    snprintf(pszName, BENCH_MAX_LEN_NAME, "BENCH_Case%06lu", i);
+    _Bool bFail = ((i * uFailRate) % 100u) + uFailRate >= 100u;
+    BenchInitCase(&psSuite->psCases[i], pszName, bFail ? BenchFailFn : BenchPassFn, 1);
+    CuTest_AppendRootItem(&psSuite->sRoot, EN_CUTEST_TYPE_CASE, &psSuite->psCases[i]);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Release a synthetic test suite
+ *
+ * @param[inout] psSuite  Test suite
+ * @date  17.10.2026
+ ******************************************************************************/
+static void BenchSuiteFree(bench_suite_t* psSuite)
+{
+  CuTest_ReleaseRoot(&psSuite->sRoot);
+  free(psSuite->psCases);
+  free(psSuite->pszNames);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Measure the run, summary and report of a synthetic test suite
+ *
+ * @param[in] ulCases     Number of test cases
+ * @param[in] uFailRate   Failing test cases [%]
+ * @return  (bench_suite_result_t)  Times per test case [ns]
+ * @date  17.10.2026
+ ******************************************************************************/
+static bench_suite_result_t BenchSuite(unsigned long ulCases, unsigned uFailRate)
+{
+  bench_suite_t sSuite;
+  BenchSuiteInit(&sSuite, ulCases, uFailRate);
+
+  uint64_t aullRun[BENCH_REPEAT], aullSummary[BENCH_REPEAT], aullReport[BENCH_REPEAT];
+  time_t tNow = time(NULL);
+  for (unsigned r = 0u; r < BENCH_REPEAT; ++r)
+  {
+    uint64_t ullStart = BenchNow();
+    CuTest_RunTests(&sSuite.sRoot);
+    aullRun[r] = BenchNow() - ullStart;
+
+    ullStart = BenchNow();
+    CuTest_PrintRunResults(&sSuite.sRoot, &tNow);
+    fflush(stdout);
+    aullSummary[r] = BenchNow() - ullStart;
+
+    ullStart = BenchNow();
+    CuTest_GenerateRunReport(&sSuite.sRoot, &tNow, BENCH_REPORT_FILE);
+    aullReport[r] = BenchNow() - ullStart;
+  }
+  unlink(BENCH_REPORT_FILE);
+  BenchSuiteFree(&sSuite);
+
+  return (bench_suite_result_t){
+    .dRun = BenchMedian(aullRun, BENCH_REPEAT, ulCases),
+    .dSummary = BenchMedian(aullSummary, BENCH_REPEAT, ulCases),
+    .dReport = BenchMedian(aullReport, BENCH_REPEAT, ulCases)
+  };
+}
+
+
+/*- Benchmark ----------------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Run all benchmarks and print the results table
+ *
+ * @return  (int)  Exit code
+ * @date  17.10.2026
+ ******************************************************************************/
+int main(void)
+{
+  // Table to the original stdout, framework output discarded
+  FILE* psOut = fdopen(dup(STDOUT_FILENO), "w");
+  if ((psOut == NULL) || (freopen("/dev/null", "w", stdout) == NULL))
+  {
+    fprintf(stderr, "cutest-bench: cannot redirect stdout\n");
+    return EXIT_FAILURE;
+  }
+  setvbuf(psOut, NULL, _IOLBF, 0);
+
+  fprintf(psOut, "CuTest self-benchmark, framework version " CUTEST_VERSION "\n");
+  fprintf(psOut, "Median of %u repetitions\n\n", BENCH_REPEAT);
+
+  fprintf(psOut, "%-44s %10s %12s\n", "Per-operation overhead", "ops", "ns/op");
+  fprintf(psOut, "%-44s %10lu %12.1f\n", "case dispatch, passing", BENCH_DISPATCH_OPS, BenchDispatch(BenchEmptyFn, 0));
+  fprintf(psOut, "%-44s %10lu %12.1f\n", "case dispatch, passing, result line", BENCH_DISPATCH_OPS, BenchDispatch(BenchEmptyFn, 1));
+  fprintf(psOut, "%-44s %10lu %12.1f\n", "case dispatch, failing", BENCH_DISPATCH_OPS, BenchDispatch(BenchFailFn, 0));
+  fprintf(psOut, "%-44s %10lu %12.1f\n", "case dispatch, failing, result line", BENCH_DISPATCH_OPS, BenchDispatch(BenchFailFn, 1));
+  fprintf(psOut, "%-44s %10lu %12.1f\n", "assertion, passing", BENCH_ASSERT_OPS, BenchAssertPass());
+  fprintf(psOut, "%-44s %10lu %12.1f\n", "assertion, failing (snprintf, longjmp)", BENCH_ASSERT_OPS, BenchAssertFail());
+
+  fprintf(psOut, "\n%-24s %9s %9s %12s %12s %12s\n", "Synthetic suites", "cases", "fail [%]", "run", "summary", "report");
+  fprintf(psOut, "%-24s %9s %9s %12s %12s %12s\n", "", "", "", "[ns/case]", "[ns/case]", "[ns/case]");
+  for (size_t i = 0u; i < sizeof(aulSuiteCases) / sizeof(aulSuiteCases[0]); ++i)
+  {
+    for (size_t j = 0u; j < sizeof(auSuiteFailRates) / sizeof(auSuiteFailRates[0]); ++j)
+    {
+      bench_suite_result_t sResult = BenchSuite(aulSuiteCases[i], auSuiteFailRates[j]);
+      fprintf(psOut, "%-24s %9lu %9u %12.1f %12.1f %12.1f\n", "", aulSuiteCases[i], auSuiteFailRates[j], sResult.dRun, sResult.dSummary, sResult.dReport);
+    }
+  }
+
+  fclose(psOut);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,133 @@
+#!/bin/sh
+#-------------------------------------------------------------------------------
+# cutest-coverage
+#
+# Copyright (c) 2023 islandcontroller
+#
+# Merges the per-test coverage data written by CuTest runners built with
+# --coverage and CUTEST_COVERAGE_DIR into a compact test-to-lines index
+# (coverage.idx) and an HTML page (coverage.html) in the same directory.
+#
+# Index format, one line per test case and source file:
+#   <test case> TAB <source file> TAB <line ranges, e.g. 12-15,18>
+#
+# Usage:
+#   cutest-coverage <coverage dir>
+#   cutest-coverage -a <source file>[:<line>] <coverage dir>
+#
+# The second form lists all test cases covering a source file or line, e.g.
+# for selecting the test cases affected by a change.
+#
+# SPDX-License-Identifier: MIT
+#-------------------------------------------------------------------------------
+set -e
+
+usage() {
+  echo "usage: $0 [-a <file>[:<line>]] <coverage dir>" >&2
+  exit 2
+}
+
+AFFECTED=
+while getopts "a:" opt; do
+  case "$opt" in
+    (a) AFFECTED="$OPTARG" ;;
+    (*) usage ;;
+  esac
+done
+shift $((OPTIND - 1))
+[ $# -eq 1 ] || usage
+COVDIR="${1%/}"
+[ -d "$COVDIR" ] || { echo "$0: $COVDIR: no such directory" >&2; exit 1; }
+
+#--[ Query mode ]---------------------------------------------------------------
+if [ -n "$AFFECTED" ]; then
+  [ -f "$COVDIR/coverage.idx" ] || { echo "$0: run without -a first" >&2; exit 1; }
+  awk -F '\t' -v q="$AFFECTED" '
+    BEGIN { file = q; line = 0; if (match(q, /:[0-9]+$/)) { file = substr(q, 1, RSTART - 1); line = substr(q, RSTART + 1) + 0 } }
+    {
+      if (substr($2, length($2) - length(file) + 1) != file) next
+      if (line == 0) { print $1; next }
+      n = split($3, r, ",")
+      for (i = 1; i <= n; ++i) {
+        lo = r[i]; hi = r[i]
+        if (split(r[i], b, "-") == 2) { lo = b[1]; hi = b[2] }
+        if ((line >= lo + 0) && (line <= hi + 0)) { print $1; next }
+      }
+    }' "$COVDIR/coverage.idx" | sort -u
+  exit 0
+fi
+
+#--[ Index generation ]---------------------------------------------------------
+INDEX="$COVDIR/coverage.idx"
+: > "$INDEX.tmp"
+
+for CASEDIR in "$COVDIR"/*/; do
+  [ -d "$CASEDIR" ] || continue
+  CASE=$(basename "$CASEDIR")
+  CASEDIR="${CASEDIR%/}"
+
+  find "$CASEDIR" -name '*.gcda' | while read -r GCDA; do
+    # Data is stored below the original object path; link the notes file
+    ORIG="${GCDA#"$CASEDIR"}"
+    GCNO="${ORIG%.gcda}.gcno"
+    [ -f "$GCNO" ] || continue
+    ln -sf "$GCNO" "${GCDA%.gcda}.gcno"
+
+    # Source paths are relative to the compiler working directory, which is
+    # emitted after the file list: pass it ahead of the data
+    JSON=$(gcov -t --json-format "$GCDA" 2>/dev/null)
+    CWD=$(printf '%s' "$JSON" | sed -n 's/.*"current_working_directory": "\([^"]*\)".*/\1/p')
+    printf '"cutest_cwd": "%s"\n%s\n' "$CWD" "$JSON"
+  done | awk -v tc="$CASE" '
+    BEGIN { RS = "\"lines\": \\[" }
+    {
+      rec = $0
+      if (match(rec, /"file": "[^"]*"/)) file = substr(rec, RSTART + 9, RLENGTH - 10)
+      else                               file = ""
+      if (match(rec, /"cutest_cwd": "[^"]*"/)) nextcwd = substr(rec, RSTART + 15, RLENGTH - 16)
+      else                                     nextcwd = cwd
+      if (file == "") { cwd = nextcwd; next }
+      if ((substr(file, 1, 1) != "/") && (cwd != "")) file = cwd "/" file
+
+      gsub(/\{[^{}]*"fallthrough"[^{}]*\}/, "", rec)
+      while (match(rec, /\{[^{}]*"line_number": [0-9]+[^{}]*\}/)) {
+        obj = substr(rec, RSTART, RLENGTH)
+        rec = substr(rec, RSTART + RLENGTH)
+        match(obj, /"line_number": [0-9]+/); ln = substr(obj, RSTART + 15, RLENGTH - 15) + 0
+        match(obj, /"count": [0-9]+/);       cnt = substr(obj, RSTART + 9, RLENGTH - 9) + 0
+        if (cnt > 0) hit[file, ln] = 1
+        if (!(file in files)) { files[file] = 1; order[++nfiles] = file }
+      }
+      cwd = nextcwd
+    }
+    END {
+      for (f = 1; f <= nfiles; ++f) {
+        file = order[f]; out = ""; lo = 0; prev = 0
+        for (key in hit) { split(key, k, SUBSEP); if ((k[1] == file) && (k[2] + 0 > max[file] + 0)) max[file] = k[2] + 0 }
+        for (ln = 1; ln <= max[file] + 1; ++ln) {
+          if ((file, ln) in hit) { if (lo == 0) lo = ln; prev = ln; continue }
+          if (lo != 0) { out = out ((out == "") ? "" : ",") ((lo == prev) ? lo : lo "-" prev); lo = 0 }
+        }
+        if (out != "") printf "%s\t%s\t%s\n", tc, file, out
+      }
+    }' >> "$INDEX.tmp"
+done
+
+sort "$INDEX.tmp" > "$INDEX"
+rm -f "$INDEX.tmp"
+
+#--[ HTML page ]----------------------------------------------------------------
+awk -F '\t' '
+  BEGIN {
+    print "<!DOCTYPE html>\n<html>\n    <head>\n        <title>Per-Test Coverage</title>\n    </head>\n    <body>"
+    print "        <h1>Per-Test Coverage</h1><hr/>"
+    print "        <table border=\"1\"><tr><th>Test case</th><th>File</th><th>Covered lines</th></tr>"
+  }
+  {
+    gsub(/&/, "\\&amp;"); gsub(/</, "\\&lt;"); gsub(/>/, "\\&gt;")
+    name = ($1 == last) ? "" : $1; last = $1
+    printf "<tr><td>%s</td><td>%s</td><td>%s</td></tr>\n", name, $2, $3
+  }
+  END { print "        </table>\n    </body>\n</html>" }' "$INDEX" > "$COVDIR/coverage.html"
+
+echo "$INDEX: $(cut -f 1 "$INDEX" | sort -u | wc -l) test cases"
@@ -0,0 +1,208 @@
+/*!*****************************************************************************
+ * @file
+ * cutest-insn.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - instruction counter
+ *
+ * QEMU TCG plugin counting the guest instructions executed by each test case
+ * of a cross-compiled test runner. Instructions are counted per translation
+ * block and vCPU. Calls to CuTest_InsnMarkBegin() and CuTest_InsnMarkEnd()
+ * mark the test case boundaries; at the end marker, the count is written to
+ * "<file>.<pid>", where the runner reads it back. The runner must keep its
+ * symbol table (not stripped). This source file is licensed under The MIT
+ * License. See https://opensource.org/license/mit/ for full license text.
+ *
+ * Build, using the plugin header of the installed QEMU version:
+ *   gcc -shared -fPIC -O2 $(pkg-config --cflags glib-2.0) -I<qemu>/include
+ *       -o cutest-insn.so cutest-insn.c
+ *
+ * Usage (see cutest-qemu):
+ *   qemu-arm -plugin cutest-insn.so,file=<file> <runner>
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <qemu-plugin.h>
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Max. number of guest threads counted                                      */
+#define INSN_MAX_VCPUS                256u
+
+/*! Marker function symbols, see CuTestInsn.c                                 */
+#define INSN_MARK_BEGIN               "CuTest_InsnMarkBegin"
+#define INSN_MARK_END                 "CuTest_InsnMarkEnd"
+
+/*! Max. count file path length                                               */
+#define INSN_MAX_PATH                 512u
+
+
+/*- Private variables --------------------------------------------------------*/
+/*! Plugin API version                                                        */
+QEMU_PLUGIN_EXPORT int qemu_plugin_version = QEMU_PLUGIN_VERSION;
+
+/*! Count file base name                                                      */
+static const char* pszFile;
+
+/*! Instructions executed, and count at the begin marker, per vCPU            */
+static uint64_t aullCount[INSN_MAX_VCPUS];
+static uint64_t aullStart[INSN_MAX_VCPUS];
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Get the count file path of the current process
+ *
+ * Forked test runner workers run in separate QEMU processes.
+ *
+ * @param[out] *pszPath   Path buffer
+ * @param[in] uSize       Path buffer size
+ * @return  (int)  1, if the path fits into the buffer
+ * @date  17.10.2026
+ ******************************************************************************/
+static int GetPath(char* pszPath, size_t uSize)
+{
+  int iLen = snprintf(pszPath, uSize, "%s.%ld", pszFile, (long)getpid());
+  return (iLen >= 0) && ((size_t)iLen < uSize);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Count the instructions of an executed translation block
+ *
+ * @param[in] uVcpu       vCPU index
+ * @param[in] *pUser      Number of instructions
+ * @date  17.10.2026
+ ******************************************************************************/
+static void OnTbExec(unsigned int uVcpu, void* pUser)
+{
+  if (uVcpu < INSN_MAX_VCPUS) aullCount[uVcpu] += (uintptr_t)pUser;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Begin marker reached, start counting
+ *
+ * @param[in] uVcpu       vCPU index
+ * @param[in] *pUser      Unused
+ * @date  17.10.2026
+ ******************************************************************************/
+static void OnMarkBegin(unsigned int uVcpu, void* pUser)
+{
+  (void)pUser;
+
+  if (uVcpu < INSN_MAX_VCPUS) aullStart[uVcpu] = aullCount[uVcpu];
+}
+
+/*!****************************************************************************
+ * @brief
+ * End marker reached, store the number of instructions since the begin marker
+ *
+ * @param[in] uVcpu       vCPU index
+ * @param[in] *pUser      Unused
+ * @date  17.10.2026
+ ******************************************************************************/
+static void OnMarkEnd(unsigned int uVcpu, void* pUser)
+{
+  (void)pUser;
+
+  char acPath[INSN_MAX_PATH];
+  if ((uVcpu >= INSN_MAX_VCPUS) || !GetPath(acPath, sizeof(acPath))) return;
+
+  int iFd = open(acPath, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (iFd < 0) return;
+  dprintf(iFd, "%" PRIu64 "\n", aullCount[uVcpu] - aullStart[uVcpu]);
+  close(iFd);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Instrument a translated block
+ *
+ * Calls end translation blocks, so marker functions are always entered at the
+ * first instruction of a block.
+ *
+ * @param[in] id          Plugin ID
+ * @param[in] *psTb       Translation block
+ * @date  17.10.2026
+ ******************************************************************************/
+static void OnTbTrans(qemu_plugin_id_t id, struct qemu_plugin_tb* psTb)
+{
+  (void)id;
+
+  size_t uInsns = qemu_plugin_tb_n_insns(psTb);
+  if (uInsns == 0u) return;
+  qemu_plugin_register_vcpu_tb_exec_cb(psTb, OnTbExec, QEMU_PLUGIN_CB_NO_REGS, (void*)(uintptr_t)uInsns);
+
+  struct qemu_plugin_insn* psInsn = qemu_plugin_tb_get_insn(psTb, 0);
+  const char* pszSym = qemu_plugin_insn_symbol(psInsn);
+  if (pszSym == NULL) return;
+  if (strcmp(pszSym, INSN_MARK_BEGIN) == 0) qemu_plugin_register_vcpu_insn_exec_cb(psInsn, OnMarkBegin, QEMU_PLUGIN_CB_NO_REGS, NULL);
+  else if (strcmp(pszSym, INSN_MARK_END) == 0) qemu_plugin_register_vcpu_insn_exec_cb(psInsn, OnMarkEnd, QEMU_PLUGIN_CB_NO_REGS, NULL);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Remove the count file of the exiting process
+ *
+ * @param[in] id          Plugin ID
+ * @param[in] *pUser      Unused
+ * @date  17.10.2026
+ ******************************************************************************/
+static void OnExit(qemu_plugin_id_t id, void* pUser)
+{
+  (void)id;
+  (void)pUser;
+
+  char acPath[INSN_MAX_PATH];
+  if (GetPath(acPath, sizeof(acPath))) unlink(acPath);
+}
+
+
+/*- Plugin interface ---------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Plugin entry point
+ *
+ * @param[in] id          Plugin ID
+ * @param[in] *psInfo     QEMU information
+ * @param[in] iArgc       Number of plugin arguments
+ * @param[in] *apszArgv[] Plugin arguments, file=<count file>
+ * @return  (int)  0 on success
+ * @date  17.10.2026
+ ******************************************************************************/
+QEMU_PLUGIN_EXPORT int qemu_plugin_install(qemu_plugin_id_t id, const qemu_info_t* psInfo, int iArgc, char** apszArgv)
+{
+  (void)psInfo;
+
+  for (int i = 0; i < iArgc; ++i)
+  {
+    if (strncmp(apszArgv[i], "file=", 5u) == 0) pszFile = strdup(&apszArgv[i][5]);
+  }
+  if (pszFile == NULL) pszFile = getenv("CUTEST_INSN_FILE");
+  if (pszFile == NULL)
+  {
+    fprintf(stderr, "cutest-insn: missing argument file=<count file>\n");
+    return -1;
+  }
+
+  qemu_plugin_register_vcpu_tb_trans_cb(id, OnTbTrans);
+  qemu_plugin_register_atexit_cb(id, OnExit, NULL);
+  return 0;
+}
@@ -0,0 +1,775 @@
+/*!*****************************************************************************
+ * @file
+ * cutest-mutate.c
+ *
+ * @copyright Copyright (c) 2023 islandcontroller
+ *
+ * @brief
+ * C Unit-Testing Framework for Embedded Applications - mutant schema generator
+ *
+ * Rewrites an application source file into a mutant schema: every mutant is
+ * compiled into the same object, and selected at runtime through
+ * CuTest_IsMutant(). Mutated expressions are conditions of if, while and for
+ * statements, and return values within function bodies:
+ *
+ *   cond  negated condition
+ *   ror   relational operator replacement (<, <=, >, >=, ==, !=)
+ *   lcr   logical connector replacement (&&, ||)
+ *   aor   arithmetic operator replacement (+, -, *, /, %)
+ *
+ * Line numbering of the original source is preserved. Lines containing the
+ * comment "cutest:nomutate" are skipped. With -c, the generated schema is
+ * compile-checked, and mutants on lines failing to compile (e.g. pointer
+ * differences mutated into additions) are dropped. This source file is
+ * licensed under The MIT License. See https://opensource.org/license/mit/ for
+ * full license text.
+ *
+ * Usage:
+ *   cutest-mutate [-m cond,ror,lcr,aor] [-c <compile command>] [-o <output>]
+ *                 <source file>
+ *
+ * The full framework source code is published at:
+ * https://github.com/islandcontroller/cutest
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+
+/*- Header files -------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+
+/*- Macro definitions --------------------------------------------------------*/
+/*! Marker comment for excluding a source line                                */
+#define MUTATE_SKIP_MARKER            "cutest:nomutate"
+
+/*! Max. compile check iterations                                             */
+#define MUTATE_MAX_CHECK_PASSES       16u
+
+/*! Mutation operator classes                                                 */
+#define MUTATE_COND                   0x01u
+#define MUTATE_ROR                    0x02u
+#define MUTATE_LCR                    0x04u
+#define MUTATE_AOR                    0x08u
+
+
+/*- Type definitions ---------------------------------------------------------*/
+/*! Token kinds                                                               */
+typedef enum
+{
+  EN_TOKEN_IDENT,                   ///< Identifier or keyword
+  EN_TOKEN_NUMBER,                  ///< Numeric constant
+  EN_TOKEN_LITERAL,                 ///< String or character literal
+  EN_TOKEN_PUNCT                    ///< Punctuator
+} token_kind_t;
+
+/*! Source token                                                              */
+typedef struct tag_token_t
+{
+  token_kind_t eKind;               ///< Token kind
+  size_t uStart;                    ///< Source offset
+  size_t uLen;                      ///< Token length
+  unsigned long ulLine;             ///< Source line
+  int bDirective;                   ///< Preceded by a preprocessor directive
+} token_t;
+
+/*! Mutated expression                                                        */
+typedef struct tag_site_t
+{
+  size_t uFirst;                    ///< First token
+  size_t uLast;                     ///< Last token
+  int bCondition;                   ///< Expression is a statement condition
+} site_t;
+
+/*! Single mutant                                                             */
+typedef struct tag_mutant_t
+{
+  size_t uSite;                     ///< Expression
+  size_t uToken;                    ///< Replaced token, or SIZE_MAX if negated
+  const char* pszReplace;           ///< Replacement operator
+  unsigned long ulLine;             ///< Source line
+  int bDisabled;                    ///< Dropped by compile check
+} mutant_t;
+
+/*! Growing output buffer                                                     */
+typedef struct tag_buffer_t
+{
+  char* pcData;                     ///< Contents
+  size_t uLen;                      ///< Used length
+  size_t uSize;                     ///< Allocated size
+} buffer_t;
+
+
+/*- Private variables --------------------------------------------------------*/
+/*! Source file contents                                                      */
+static char* pcSrc;
+static size_t uSrcLen;
+
+/*! Token list                                                                */
+static token_t* psTokens;
+static size_t uNumTokens;
+
+/*! Expression list                                                           */
+static site_t* psSites;
+static size_t uNumSites;
+
+/*! Mutant list                                                               */
+static mutant_t* psMutants;
+static size_t uNumMutants;
+
+/*! Operator replacements                                                     */
+static const struct { unsigned uClass; const char* pszOp; const char* pszReplace; } asOperators[] = {
+  { MUTATE_ROR, "<",  "<="  }, { MUTATE_ROR, "<=", "<"   }, { MUTATE_ROR, ">",  ">="  },
+  { MUTATE_ROR, ">=", ">"   }, { MUTATE_ROR, "==", "!="  }, { MUTATE_ROR, "!=", "=="  },
+  { MUTATE_LCR, "&&", "||"  }, { MUTATE_LCR, "||", "&&"  },
+  { MUTATE_AOR, "+",  "-"   }, { MUTATE_AOR, "-",  "+"   }, { MUTATE_AOR, "*",  "/"   },
+  { MUTATE_AOR, "/",  "*"   }, { MUTATE_AOR, "%",  "*"   }
+};
+
+/*! Multi-character punctuators, longest first                                */
+static const char* const apszPunct[] = {
+  "...", "<<=", ">>=", "->", "++", "--", "<<", ">>", "<=", ">=", "==", "!=",
+  "&&", "||", "*=", "/=", "%=", "+=", "-=", "&=", "^=", "|=", "##"
+};
+
+/*! Keywords not ending an operand                                            */
+static const char* const apszKeywords[] = {
+  "return", "sizeof", "case", "else", "do", "goto", "_Alignof", "alignof"
+};
+
+
+/*- Local functions ----------------------------------------------------------*/
+/*!****************************************************************************
+ * @brief
+ * Print error message and exit
+ *
+ * @param[in] *pszFmt     Format string
+ * @param[in] ...         Arguments
+ * @date  17.10.2026
+ ******************************************************************************/
+static void __attribute__((noreturn, format(printf, 1, 2))) Die(const char* pszFmt, ...)
+{
+  va_list args;
+  va_start(args, pszFmt);
+  fputs("cutest-mutate: ", stderr);
+  vfprintf(stderr, pszFmt, args);
+  fputc('\n', stderr);
+  va_end(args);
+  exit(EXIT_FAILURE);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Grow an array to hold one more element
+ *
+ * @param[inout] *ppArray Array pointer
+ * @param[in] uCount      Current number of elements
+ * @param[in] uElemSize   Element size
+ * @date  17.10.2026
+ ******************************************************************************/
+static void Grow(void* ppArray, size_t uCount, size_t uElemSize)
+{
+  // Capacity doubles from 16 elements onwards
+  if ((uCount != 0u) && ((uCount < 16u) || ((uCount & (uCount - 1u)) != 0u))) return;
+
+  void* p = realloc(*(void**)ppArray, ((uCount == 0u) ? 16u : 2u * uCount) * uElemSize);
+  if (p == NULL) Die("out of memory");
+  *(void**)ppArray = p;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Append text to an output buffer
+ *
+ * @param[inout] psBuf    Output buffer
+ * @param[in] *pcText     Text
+ * @param[in] uLen        Text length
+ * @date  17.10.2026
+ ******************************************************************************/
+static void Append(buffer_t* psBuf, const char* pcText, size_t uLen)
+{
+  if (psBuf->uLen + uLen + 1u > psBuf->uSize)
+  {
+    psBuf->uSize = 2u * (psBuf->uLen + uLen + 1u);
+    psBuf->pcData = realloc(psBuf->pcData, psBuf->uSize);
+    if (psBuf->pcData == NULL) Die("out of memory");
+  }
+
+  memcpy(&psBuf->pcData[psBuf->uLen], pcText, uLen);
+  psBuf->uLen += uLen;
+  psBuf->pcData[psBuf->uLen] = '\0';
+}
+
+/*!****************************************************************************
+ * @brief
+ * Append formatted text to an output buffer
+ *
+ * @param[inout] psBuf    Output buffer
+ * @param[in] *pszFmt     Format string
+ * @param[in] ...         Arguments
+ * @date  17.10.2026
+ ******************************************************************************/
+static void __attribute__((format(printf, 2, 3))) AppendFmt(buffer_t* psBuf, const char* pszFmt, ...)
+{
+  char* psz;
+  va_list args;
+  va_start(args, pszFmt);
+  int iLen = vasprintf(&psz, pszFmt, args);
+  va_end(args);
+  if (iLen < 0) Die("out of memory");
+
+  Append(psBuf, psz, (size_t)iLen);
+  free(psz);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Compare token text
+ *
+ * @param[in] uToken      Token index
+ * @param[in] *pszText    Text
+ * @return  (int)  Non-zero if equal
+ * @date  17.10.2026
+ ******************************************************************************/
+static int TokenIs(size_t uToken, const char* pszText)
+{
+  if (uToken >= uNumTokens) return 0;
+
+  const token_t* psTok = &psTokens[uToken];
+  return (strlen(pszText) == psTok->uLen) && (memcmp(&pcSrc[psTok->uStart], pszText, psTok->uLen) == 0);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Split source file into tokens. Comments and preprocessor directives are
+ * skipped.
+ *
+ * @date  17.10.2026
+ ******************************************************************************/
+static void Tokenize(void)
+{
+  size_t i = 0u;
+  unsigned long ulLine = 1u;
+  int bLineStart = 1;
+  int bDirective = 0;
+
+  while (i < uSrcLen)
+  {
+    char c = pcSrc[i];
+
+    // Whitespace, comments and directives
+    if (c == '\n')
+    {
+      ulLine++;
+      bLineStart = 1;
+      i++;
+      continue;
+    }
+    if (isspace((unsigned char)c))
+    {
+      i++;
+      continue;
+    }
+    if ((c == '/') && (pcSrc[i + 1u] == '/'))
+    {
+      while ((i < uSrcLen) && (pcSrc[i] != '\n')) i++;
+      continue;
+    }
+    if ((c == '/') && (pcSrc[i + 1u] == '*'))
+    {
+      for (i += 2u; (i < uSrcLen) && !((pcSrc[i] == '*') && (pcSrc[i + 1u] == '/')); ++i)
+      {
+        if (pcSrc[i] == '\n') ulLine++;
+      }
+      i += 2u;
+      continue;
+    }
+    if ((c == '#') && bLineStart)
+    {
+      while ((i < uSrcLen) && (pcSrc[i] != '\n'))
+      {
+        if ((pcSrc[i] == '\\') && (pcSrc[i + 1u] == '\n')) ulLine++, i++;
+        else if ((pcSrc[i] == '/') && (pcSrc[i + 1u] == '*'))
+        {
+          for (i += 2u; (i < uSrcLen) && !((pcSrc[i] == '*') && (pcSrc[i + 1u] == '/')); ++i)
+          {
+            if (pcSrc[i] == '\n') ulLine++;
+          }
+          i++;
+        }
+        i++;
+      }
+      bDirective = 1;
+      continue;
+    }
+
+    // Tokens
+    bLineStart = 0;
+    size_t uStart = i;
+    token_kind_t eKind;
+    if (isalpha((unsigned char)c) || (c == '_'))
+    {
+      eKind = EN_TOKEN_IDENT;
+      while ((i < uSrcLen) && (isalnum((unsigned char)pcSrc[i]) || (pcSrc[i] == '_'))) i++;
+
+      // String prefixes (L, u, U, u8)
+      if ((i < uSrcLen) && ((pcSrc[i] == '"') || (pcSrc[i] == '\'')) && (i - uStart <= 2u)) c = pcSrc[i];
+    }
+    else if (isdigit((unsigned char)c) || ((c == '.') && isdigit((unsigned char)pcSrc[i + 1u])))
+    {
+      eKind = EN_TOKEN_NUMBER;
+      for (i++; i < uSrcLen; ++i)
+      {
+        if (strchr("eEpP", pcSrc[i - 1u]) && strchr("+-", pcSrc[i])) continue;
+        if (!isalnum((unsigned char)pcSrc[i]) && (pcSrc[i] != '.') && (pcSrc[i] != '_') && (pcSrc[i] != '\'')) break;
+      }
+    }
+    else
+    {
+      eKind = EN_TOKEN_PUNCT;
+      size_t uLen = 1u;
+      for (size_t j = 0; j < sizeof(apszPunct) / sizeof(apszPunct[0]); ++j)
+      {
+        size_t uPunctLen = strlen(apszPunct[j]);
+        if ((uPunctLen > uLen) && (strncmp(&pcSrc[i], apszPunct[j], uPunctLen) == 0)) uLen = uPunctLen;
+      }
+      if ((c != '"') && (c != '\'')) i += uLen;
+    }
+
+    // String and character literals
+    if ((c == '"') || (c == '\''))
+    {
+      eKind = EN_TOKEN_LITERAL;
+      for (i++; (i < uSrcLen) && (pcSrc[i] != c) && (pcSrc[i] != '\n'); ++i)
+      {
+        if (pcSrc[i] == '\\') i++;
+      }
+      i++;
+    }
+
+    Grow(&psTokens, uNumTokens, sizeof(token_t));
+    psTokens[uNumTokens++] = (token_t){ .eKind = eKind, .uStart = uStart, .uLen = i - uStart, .ulLine = ulLine, .bDirective = bDirective };
+    bDirective = 0;
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Find the matching closing parenthesis
+ *
+ * @param[in] uOpen       Opening parenthesis token
+ * @return  (size_t)  Closing parenthesis token, or uNumTokens
+ * @date  17.10.2026
+ ******************************************************************************/
+static size_t MatchParen(size_t uOpen)
+{
+  int iDepth = 0;
+  for (size_t i = uOpen; i < uNumTokens; ++i)
+  {
+    if (TokenIs(i, "(")) iDepth++;
+    else if (TokenIs(i, ")") && (--iDepth == 0)) return i;
+  }
+
+  return uNumTokens;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if a token ends an operand, i.e. a following +, -, * is binary
+ *
+ * @param[in] uToken      Token index
+ * @param[in] *pszOp      Following operator
+ * @return  (int)  Non-zero if operand end
+ * @date  17.10.2026
+ ******************************************************************************/
+static int IsOperandEnd(size_t uToken, const char* pszOp)
+{
+  const token_t* psTok = &psTokens[uToken];
+
+  if (psTok->eKind == EN_TOKEN_IDENT)
+  {
+    for (size_t i = 0; i < sizeof(apszKeywords) / sizeof(apszKeywords[0]); ++i)
+    {
+      if (TokenIs(uToken, apszKeywords[i])) return 0;
+    }
+    return 1;
+  }
+  if ((psTok->eKind == EN_TOKEN_NUMBER) || (psTok->eKind == EN_TOKEN_LITERAL)) return 1;
+  if (TokenIs(uToken, "]")) return 1;
+
+  // Closing parentheses may end a cast, with '*' being a dereference
+  return TokenIs(uToken, ")") && (strcmp(pszOp, "*") != 0);
+}
+
+/*!****************************************************************************
+ * @brief
+ * Check if a source line is excluded from mutation
+ *
+ * @param[in] ulLine      Source line
+ * @return  (int)  Non-zero if excluded
+ * @date  17.10.2026
+ ******************************************************************************/
+static int IsLineSkipped(unsigned long ulLine)
+{
+  const char* p = pcSrc;
+  for (unsigned long l = 1u; (l < ulLine) && (p != NULL); ++l)
+  {
+    p = strchr(p, '\n');
+    if (p != NULL) p++;
+  }
+  if (p == NULL) return 1;
+
+  const char* pEnd = strchr(p, '\n');
+  size_t uLen = (pEnd != NULL) ? (size_t)(pEnd - p) : strlen(p);
+  return memmem(p, uLen, MUTATE_SKIP_MARKER, strlen(MUTATE_SKIP_MARKER)) != NULL;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Add an expression and its mutants
+ *
+ * @param[in] uFirst      First token
+ * @param[in] uLast       Last token
+ * @param[in] bCondition  Statement condition
+ * @param[in] uClasses    Enabled mutation operator classes
+ * @date  17.10.2026
+ ******************************************************************************/
+static void AddSite(size_t uFirst, size_t uLast, int bCondition, unsigned uClasses)
+{
+  if ((uFirst > uLast) || (uLast >= uNumTokens)) return;
+  for (size_t i = uFirst + 1u; i <= uLast; ++i)
+  {
+    if (psTokens[i].bDirective) return;
+  }
+
+  size_t uSite = uNumSites;
+  size_t uCount = uNumMutants;
+
+  if (bCondition && (uClasses & MUTATE_COND) && !IsLineSkipped(psTokens[uFirst].ulLine))
+  {
+    Grow(&psMutants, uNumMutants, sizeof(mutant_t));
+    psMutants[uNumMutants++] = (mutant_t){ .uSite = uSite, .uToken = SIZE_MAX, .pszReplace = NULL, .ulLine = psTokens[uFirst].ulLine };
+  }
+
+  for (size_t i = uFirst; i <= uLast; ++i)
+  {
+    if ((psTokens[i].eKind != EN_TOKEN_PUNCT) || IsLineSkipped(psTokens[i].ulLine)) continue;
+
+    for (size_t j = 0; j < sizeof(asOperators) / sizeof(asOperators[0]); ++j)
+    {
+      if (!(uClasses & asOperators[j].uClass) || !TokenIs(i, asOperators[j].pszOp)) continue;
+      if ((asOperators[j].uClass == MUTATE_AOR) && ((i == uFirst) || !IsOperandEnd(i - 1u, asOperators[j].pszOp))) continue;
+
+      Grow(&psMutants, uNumMutants, sizeof(mutant_t));
+      psMutants[uNumMutants++] = (mutant_t){ .uSite = uSite, .uToken = i, .pszReplace = asOperators[j].pszReplace, .ulLine = psTokens[i].ulLine };
+    }
+  }
+
+  if (uNumMutants == uCount) return;
+
+  Grow(&psSites, uNumSites, sizeof(site_t));
+  psSites[uNumSites++] = (site_t){ .uFirst = uFirst, .uLast = uLast, .bCondition = bCondition };
+}
+
+/*!****************************************************************************
+ * @brief
+ * Collect expressions within function bodies
+ *
+ * @param[in] uClasses    Enabled mutation operator classes
+ * @date  17.10.2026
+ ******************************************************************************/
+static void FindSites(unsigned uClasses)
+{
+  int iDepth = 0;
+  int bFunction = 0;
+
+  for (size_t i = 0; i < uNumTokens; ++i)
+  {
+    if (TokenIs(i, "{"))
+    {
+      if (iDepth++ == 0) bFunction = (i > 0u) && TokenIs(i - 1u, ")");
+      continue;
+    }
+    if (TokenIs(i, "}"))
+    {
+      if (iDepth > 0) iDepth--;
+      continue;
+    }
+    if (!bFunction || (iDepth == 0) || (psTokens[i].eKind != EN_TOKEN_IDENT)) continue;
+
+    if ((TokenIs(i, "if") || TokenIs(i, "while")) && TokenIs(i + 1u, "("))
+    {
+      size_t uClose = MatchParen(i + 1u);
+      AddSite(i + 2u, uClose - 1u, 1, uClasses);
+      i = uClose;
+    }
+    else if (TokenIs(i, "for") && TokenIs(i + 1u, "("))
+    {
+      size_t uClose = MatchParen(i + 1u);
+      size_t uSemi[2] = { 0u, 0u };
+      size_t uNumSemi = 0u;
+      int iParen = 0;
+      for (size_t j = i + 2u; (j < uClose) && (uNumSemi < 2u); ++j)
+      {
+        if (TokenIs(j, "(")) iParen++;
+        else if (TokenIs(j, ")")) iParen--;
+        else if (TokenIs(j, ";") && (iParen == 0)) uSemi[uNumSemi++] = j;
+      }
+      if (uNumSemi == 2u) AddSite(uSemi[0] + 1u, uSemi[1] - 1u, 1, uClasses);
+      i = uClose;
+    }
+    else if (TokenIs(i, "return"))
+    {
+      int iParen = 0;
+      size_t j;
+      for (j = i + 1u; j < uNumTokens; ++j)
+      {
+        if (TokenIs(j, "(") || TokenIs(j, "[") || TokenIs(j, "{")) iParen++;
+        else if (TokenIs(j, ")") || TokenIs(j, "]") || TokenIs(j, "}")) iParen--;
+        else if (TokenIs(j, ";") && (iParen == 0)) break;
+      }
+      AddSite(i + 1u, j - 1u, 0, uClasses);
+      i = j;
+    }
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Append a single-line copy of an expression, with one token replaced
+ *
+ * @param[inout] psBuf    Output buffer
+ * @param[in] psSite      Expression
+ * @param[in] psMutant    Mutant
+ * @date  17.10.2026
+ ******************************************************************************/
+static void AppendVariant(buffer_t* psBuf, const site_t* psSite, const mutant_t* psMutant)
+{
+  for (size_t i = psSite->uFirst; i <= psSite->uLast; ++i)
+  {
+    if (i > psSite->uFirst) Append(psBuf, " ", 1u);
+    if (i == psMutant->uToken) Append(psBuf, psMutant->pszReplace, strlen(psMutant->pszReplace));
+    else Append(psBuf, &pcSrc[psTokens[i].uStart], psTokens[i].uLen);
+  }
+}
+
+/*!****************************************************************************
+ * @brief
+ * Generate the mutant schema source
+ *
+ * @param[in] *pszInput   Original source file name
+ * @param[out] psOut      Output buffer
+ * @return  (unsigned long)  Number of enabled mutants
+ * @date  17.10.2026
+ ******************************************************************************/
+static unsigned long Generate(const char* pszInput, buffer_t* psOut)
+{
+  // Unique table name per source file
+  const char* pszBase = strrchr(pszInput, '/');
+  pszBase = (pszBase != NULL) ? pszBase + 1 : pszInput;
+  char* pszTable = NULL;
+  if (asprintf(&pszTable, "_cutest_mutants_%s", pszBase) < 0) Die("out of memory");
+  for (char* p = pszTable; *p != '\0'; ++p)
+  {
+    if (!isalnum((unsigned char)*p)) *p = '_';
+  }
+
+  // Mutant table
+  psOut->uLen = 0u;
+  AppendFmt(psOut, "/* Mutant schema of %s, generated by cutest-mutate. Do not edit. */\n", pszInput);
+  AppendFmt(psOut, "#include \"CuTest.h\"\n");
+  AppendFmt(psOut, "static const cutest_mutant_site_t %s_sites[] = {\n", pszTable);
+  unsigned long ulCount = 0u;
+  for (size_t i = 0; i < uNumMutants; ++i)
+  {
+    const mutant_t* psMutant = &psMutants[i];
+    if (psMutant->bDisabled) continue;
+
+    ulCount++;
+    if (psMutant->uToken == SIZE_MAX) AppendFmt(psOut, "  { %lu, \"negated condition\" },\n", psMutant->ulLine);
+    else AppendFmt(psOut, "  { %lu, \"'%.*s' -> '%s'\" },\n", psMutant->ulLine, (int)psTokens[psMutant->uToken].uLen, &pcSrc[psTokens[psMutant->uToken].uStart], psMutant->pszReplace);
+  }
+  if (ulCount == 0u) AppendFmt(psOut, "  { 0, \"\" }\n");
+  AppendFmt(psOut, "};\n");
+  AppendFmt(psOut, "static cutest_mutant_table_t %s = { \"%s\", %s_sites, %luu, 0u };\n", pszTable, pszInput, pszTable, ulCount);
+  AppendFmt(psOut, "static void __attribute__((constructor)) %s_init(void) { CuTest_RegisterMutants(&%s); }\n", pszTable, pszTable);
+  AppendFmt(psOut, "#line 1 \"%s\"\n", pszInput);
+
+  // Source with mutated expressions
+  size_t uPos = 0u;
+  unsigned long ulId = 0u;
+  size_t uMutant = 0u;
+  for (size_t s = 0; s < uNumSites; ++s)
+  {
+    const site_t* psSite = &psSites[s];
+    size_t uStart = psTokens[psSite->uFirst].uStart;
+    size_t uEnd = psTokens[psSite->uLast].uStart + psTokens[psSite->uLast].uLen;
+
+    Append(psOut, &pcSrc[uPos], uStart - uPos);
+    Append(psOut, "(", 1u);
+    for (; (uMutant < uNumMutants) && (psMutants[uMutant].uSite == s); ++uMutant)
+    {
+      const mutant_t* psMutant = &psMutants[uMutant];
+      if (psMutant->bDisabled) continue;
+
+      AppendFmt(psOut, "CuTest_IsMutant(&%s, %lu) ? ", pszTable, ++ulId);
+      if (psMutant->uToken == SIZE_MAX)
+      {
+        Append(psOut, "!(", 2u);
+        AppendVariant(psOut, psSite, &(mutant_t){ .uToken = SIZE_MAX });
+      }
+      else
+      {
+        Append(psOut, "(", 1u);
+        AppendVariant(psOut, psSite, psMutant);
+      }
+      Append(psOut, ") : ", 4u);
+    }
+    Append(psOut, psSite->bCondition ? "!!(" : "(", psSite->bCondition ? 3u : 1u);
+    Append(psOut, &pcSrc[uStart], uEnd - uStart);
+    Append(psOut, "))", 2u);
+    uPos = uEnd;
+  }
+  Append(psOut, &pcSrc[uPos], uSrcLen - uPos);
+
+  free(pszTable);
+  return ulCount;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Compile-check the generated schema and drop mutants on failing lines
+ *
+ * @param[in] *pszCommand Compile command, the output file name is appended
+ * @param[in] *pszInput   Original source file name
+ * @param[in] *pszOutput  Generated source file name
+ * @return  (int)  -1 if errors remain outside of mutated lines, 0 if the
+ *                 schema compiles, 1 if mutants were dropped
+ * @date  17.10.2026
+ ******************************************************************************/
+static int Check(const char* pszCommand, const char* pszInput, const char* pszOutput)
+{
+  char* pszCmd = NULL;
+  if (asprintf(&pszCmd, "%s '%s' 2>&1", pszCommand, pszOutput) < 0) Die("out of memory");
+
+  FILE* f = popen(pszCmd, "r");
+  if (f == NULL) Die("cannot run '%s'", pszCmd);
+
+  int iResult = 0;
+  char acLine[1024];
+  size_t uInputLen = strlen(pszInput);
+  while (fgets(acLine, sizeof(acLine), f) != NULL)
+  {
+    unsigned long ulLine;
+    if ((strncmp(acLine, pszInput, uInputLen) != 0) || (sscanf(&acLine[uInputLen], ":%lu:", &ulLine) != 1)) continue;
+    if (strstr(acLine, ": error:") == NULL) continue;
+
+    int bDropped = 0;
+    for (size_t i = 0; i < uNumMutants; ++i)
+    {
+      const site_t* psSite = &psSites[psMutants[i].uSite];
+      if (psMutants[i].bDisabled || (ulLine < psTokens[psSite->uFirst].ulLine) || (ulLine > psTokens[psSite->uLast].ulLine)) continue;
+
+      psMutants[i].bDisabled = 1;
+      bDropped = 1;
+    }
+    if (bDropped && (iResult == 0)) iResult = 1;
+    if (!bDropped) fputs(acLine, stderr);
+  }
+
+  int iStatus = pclose(f);
+  free(pszCmd);
+  if ((iStatus != 0) && (iResult == 0)) return -1;
+  return iResult;
+}
+
+/*!****************************************************************************
+ * @brief
+ * Write output buffer to file
+ *
+ * @param[in] *pszOutput  Output file name, NULL for stdout
+ * @param[in] psBuf       Output buffer
+ * @date  17.10.2026
+ ******************************************************************************/
+static void WriteOutput(const char* pszOutput, const buffer_t* psBuf)
+{
+  FILE* f = (pszOutput != NULL) ? fopen(pszOutput, "w") : stdout;
+  if (f == NULL) Die("cannot write '%s'", pszOutput);
+
+  fwrite(psBuf->pcData, 1u, psBuf->uLen, f);
+  if (pszOutput != NULL) fclose(f);
+}
+
+
+/*- Main ---------------------------------------------------------------------*/
+int main(int argc, char* argv[])
+{
+  const char* pszOutput = NULL;
+  const char* pszCheck = NULL;
+  unsigned uClasses = MUTATE_COND | MUTATE_ROR | MUTATE_LCR | MUTATE_AOR;
+
+  int iOpt;
+  while ((iOpt = getopt(argc, argv, "o:c:m:")) != -1)
+  {
+    switch (iOpt)
+    {
+      case 'o': pszOutput = optarg; break;
+      case 'c': pszCheck = optarg; break;
+      case 'm':
+        uClasses = 0u;
+        for (char* psz = strtok(optarg, ","); psz != NULL; psz = strtok(NULL, ","))
+        {
+          if (strcmp(psz, "cond") == 0) uClasses |= MUTATE_COND;
+          else if (strcmp(psz, "ror") == 0) uClasses |= MUTATE_ROR;
+          else if (strcmp(psz, "lcr") == 0) uClasses |= MUTATE_LCR;
+          else if (strcmp(psz, "aor") == 0) uClasses |= MUTATE_AOR;
+          else Die("unknown mutation operator class '%s'", psz);
+        }
+        break;
+      default:
+        fprintf(stderr, "usage: %s [-m cond,ror,lcr,aor] [-c <compile command>] [-o <output>] <source file>\n", argv[0]);
+        return 2;
+    }
+  }
+  if (optind != argc - 1) Die("expected a single source file");
+  if ((pszCheck != NULL) && (pszOutput == NULL)) Die("-c requires -o");
+  const char* pszInput = argv[optind];
+
+  // Read source
+  FILE* f = fopen(pszInput, "r");
+  if (f == NULL) Die("cannot read '%s'", pszInput);
+  buffer_t sSrc = { 0 };
+  char acChunk[4096];
+  size_t uRead;
+  while ((uRead = fread(acChunk, 1u, sizeof(acChunk), f)) > 0u) Append(&sSrc, acChunk, uRead);
+  fclose(f);
+  Append(&sSrc, "\0", 1u);
+  pcSrc = sSrc.pcData;
+  uSrcLen = sSrc.uLen - 1u;
+
+  Tokenize();
+  FindSites(uClasses);
+
+  // Generate, optionally compile-check and prune
+  buffer_t sOut = { 0 };
+  unsigned long ulCount = Generate(pszInput, &sOut);
+  WriteOutput(pszOutput, &sOut);
+  for (unsigned uPass = 0; (pszCheck != NULL) && (uPass < MUTATE_MAX_CHECK_PASSES); ++uPass)
+  {
+    int iResult = Check(pszCheck, pszInput, pszOutput);
+    if (iResult < 0) Die("'%s' does not compile", pszOutput);
+    if (iResult == 0) break;
+
+    ulCount = Generate(pszInput, &sOut);
+    WriteOutput(pszOutput, &sOut);
+  }
+
+  fprintf(stderr, "cutest-mutate: %s: %lu mutants\n", pszInput, ulCount);
+  return EXIT_SUCCESS;
+}
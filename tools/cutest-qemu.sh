@@ -0,0 +1,69 @@
+#!/bin/sh
+#-------------------------------------------------------------------------------
+# cutest-qemu
+#
+# Copyright (c) 2023 islandcontroller
+#
+# Runs a cross-compiled CuTest runner under QEMU user mode, with the
+# cutest-insn TCG plugin counting the instructions executed by each test case.
+# The counts are reported by the runner itself, in the "Instructions" column
+# of the HTML report.
+#
+# Build the library and runner for the target, e.g.:
+#   make -C src all CROSS_COMPILE=arm-linux-gnueabihf-
+#   arm-linux-gnueabihf-gcc -static -o runner test.c -Isrc src/libcutest.a -lm
+#
+# Usage:
+#   cutest-qemu [-q <qemu binary>] [-L <sysroot>] [-p <plugin>] <runner> [args]
+#
+# Defaults: qemu-arm, and cutest-insn.so next to this script or in /usr/lib.
+# Runners linked dynamically need the target sysroot (-L).
+#
+# SPDX-License-Identifier: MIT
+#-------------------------------------------------------------------------------
+set -e
+
+usage() {
+  echo "usage: $0 [-q <qemu>] [-L <sysroot>] [-p <plugin>] <runner> [args]" >&2
+  exit 2
+}
+
+QEMU=qemu-arm
+SYSROOT=
+PLUGIN=
+while getopts "q:L:p:" opt; do
+  case "$opt" in
+    (q) QEMU="$OPTARG" ;;
+    (L) SYSROOT="$OPTARG" ;;
+    (p) PLUGIN="$OPTARG" ;;
+    (*) usage ;;
+  esac
+done
+shift $((OPTIND - 1))
+[ $# -ge 1 ] || usage
+
+#--[ Plugin lookup ]------------------------------------------------------------
+if [ -z "$PLUGIN" ]; then
+  for CANDIDATE in "$(dirname "$0")/cutest-insn.so" /usr/lib/cutest-insn.so; do
+    [ -f "$CANDIDATE" ] && { PLUGIN="$CANDIDATE"; break; }
+  done
+fi
+[ -n "$PLUGIN" ] || { echo "$0: cutest-insn.so not found, use -p" >&2; exit 1; }
+command -v "$QEMU" > /dev/null || { echo "$0: $QEMU not found" >&2; exit 1; }
+
+#--[ Test run ]-----------------------------------------------------------------
+# Counts are exchanged through one file per runner process
+WORKDIR=$(mktemp -d)
+trap 'rm -rf "$WORKDIR"' EXIT
+export CUTEST_INSN_FILE="$WORKDIR/insn"
+
+set +e
+if [ -n "$SYSROOT" ]; then
+  "$QEMU" -L "$SYSROOT" -plugin "$PLUGIN,file=$CUTEST_INSN_FILE" "$@"
+else
+  "$QEMU" -plugin "$PLUGIN,file=$CUTEST_INSN_FILE" "$@"
+fi
+RESULT=$?
+set -e
+
+exit $RESULT